@@ -52,6 +52,8 @@ LIST(APPEND CPU_SOURCES "${SOURCES_DIR}/actions/CPUEulerBDIntegrator.cpp")
 LIST(APPEND CPU_SOURCES "${SOURCES_DIR}/actions/CPUCalculateForces.cpp")
 LIST(APPEND CPU_SOURCES "${SOURCES_DIR}/actions/CPUEvaluateCompartments.cpp")
 LIST(APPEND CPU_SOURCES "${SOURCES_DIR}/actions/CPUEvaluateTopologyReactions.cpp")
+LIST(APPEND CPU_SOURCES "${SOURCES_DIR}/actions/CPUBreakBonds.cpp")
+LIST(APPEND CPU_SOURCES "${SOURCES_DIR}/actions/CPUCompiledStep.cpp")
 LIST(APPEND CPU_SOURCES "${SOURCES_DIR}/actions/reactions/ReactionUtils.cpp")
 LIST(APPEND CPU_SOURCES "${SOURCES_DIR}/actions/reactions/Event.cpp")
 LIST(APPEND CPU_SOURCES "${SOURCES_DIR}/actions/reactions/CPUUncontrolledApproximation.cpp")
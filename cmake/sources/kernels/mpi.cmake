@@ -48,7 +48,7 @@ LIST(APPEND MPI_SOURCES "${SOURCES_DIR}/actions/MPIEulerBDIntegrator.cpp")
 LIST(APPEND MPI_SOURCES "${SOURCES_DIR}/actions/MPICalculateForces.cpp")
 LIST(APPEND MPI_SOURCES "${SOURCES_DIR}/actions/MPIUncontrolledApproximation.cpp")
 #LIST(APPEND MPI_SOURCES "${SOURCES_DIR}/actions/MPIEvaluateCompartments.cpp")
-#LIST(APPEND MPI_SOURCES "${SOURCES_DIR}/actions/MPIEvaluateTopologyReactions.cpp")
+LIST(APPEND MPI_SOURCES "${SOURCES_DIR}/actions/MPITopologyReactions.cpp")
 
 # --- model ---
 #LIST(APPEND MPI_SOURCES "${SOURCES_DIR}/MPIParticleData.cpp")
@@ -58,7 +58,7 @@ LIST(APPEND MPI_SOURCES "${SOURCES_DIR}/observables/MPIObservableFactory.cpp")
 LIST(APPEND MPI_SOURCES "${SOURCES_DIR}/observables/MPIObservables.cpp")
 
 # --- topology actions ---
-#LIST(APPEND MPI_SOURCES "${SOURCES_DIR}/topologies/MPITopologyActionFactory.cpp")
+LIST(APPEND MPI_SOURCES "${SOURCES_DIR}/topologies/MPITopologyActionFactory.cpp")
 
 # --- all sources ---
 LIST(APPEND READDY_ALL_SOURCES ${MPI_SOURCES})
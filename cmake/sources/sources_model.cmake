@@ -53,9 +53,11 @@ LIST(APPEND READDY_MODEL_SOURCES "${SOURCES_DIR}/IOUtils.cpp")
 # compartments
 LIST(APPEND READDY_MODEL_SOURCES "${SOURCES_DIR}/compartments/Compartments.cpp")
 LIST(APPEND READDY_MODEL_SOURCES "${SOURCES_DIR}/compartments/CompartmentRegistry.cpp")
+LIST(APPEND READDY_MODEL_SOURCES "${SOURCES_DIR}/compartments/CompartmentGrid.cpp")
 
 # potentials
 LIST(APPEND READDY_MODEL_SOURCES "${SOURCES_DIR}/potentials/Potentials.cpp")
+LIST(APPEND READDY_MODEL_SOURCES "${SOURCES_DIR}/potentials/PotentialGrid.cpp")
 
 # reactions
 LIST(APPEND READDY_MODEL_SOURCES "${SOURCES_DIR}/reactions/Reactions.cpp")
@@ -0,0 +1,359 @@
+/**
+ * Benchmarks of whole simulation steps for tracking the performance of the kernels across commits. A benchmark
+ * configures a context and populates a simulation with a given number of particles, the Harness then measures the
+ * wall clock time of a fixed number of steps of the default simulation loop. Each measurement is repeated and reported
+ * by its median, so that results of two builds can be compared with compare_benchmarks.py.
+ *
+ * @file Benchmarks.h
+ * @brief Benchmark definitions and the harness measuring them
+ * @author EricArkfeld
+ * @date 19.10.26
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <readdy/api/Simulation.h>
+#include <readdy/api/KernelConfiguration.h>
+#include <readdy/common/boundary_condition_operations.h>
+
+namespace readdy::benchmark {
+
+using Json = nlohmann::json;
+namespace rnd = readdy::model::rnd;
+
+/**
+ * One point of the benchmark grid
+ */
+struct Setup {
+    std::string kernel;
+    std::size_t nParticles;
+    std::size_t nThreads;
+};
+
+class Benchmark {
+public:
+    Benchmark(std::string name, std::string description)
+            : _name(std::move(name)), _description(std::move(description)) {}
+
+    virtual ~Benchmark() = default;
+
+    [[nodiscard]] const std::string &name() const { return _name; }
+
+    [[nodiscard]] const std::string &description() const { return _description; }
+
+    /**
+     * @param kernel the kernel name
+     * @return whether the benchmark can be run on the kernel
+     */
+    [[nodiscard]] virtual bool supports(const std::string &kernel) const { return true; }
+
+    /**
+     * Registers types, potentials, reactions and so on. The box is scaled with the number of particles.
+     * @param context the context
+     * @param nParticles the number of particles
+     */
+    virtual void setUp(model::Context &context, std::size_t nParticles) const = 0;
+
+    /**
+     * Adds the particles and possibly observables to the simulation.
+     * @param simulation the simulation
+     * @param nParticles the number of particles
+     */
+    virtual void populate(Simulation &simulation, std::size_t nParticles) const {
+        addUniformly(simulation, "A", nParticles);
+    }
+
+    /**
+     * Adapts the simulation loop, e.g., the reaction scheduler.
+     * @param loop the loop
+     */
+    virtual void configure(api::SimulationLoop &loop) const {}
+
+protected:
+    static void setBox(model::Context &context, std::size_t nParticles, scalar density) {
+        auto length = std::cbrt(static_cast<scalar>(nParticles) / density);
+        context.boxSize() = {{length, length, length}};
+        context.periodicBoundaryConditions() = {{true, true, true}};
+    }
+
+    static void addUniformly(Simulation &simulation, const std::string &type, std::size_t n) {
+        const auto &box = simulation.context().boxSize();
+        for (std::size_t i = 0; i < n; ++i) {
+            simulation.addParticle(type, rnd::uniform_real() * box[0] - 0.5 * box[0],
+                                   rnd::uniform_real() * box[1] - 0.5 * box[1],
+                                   rnd::uniform_real() * box[2] - 0.5 * box[2]);
+        }
+    }
+
+private:
+    std::string _name;
+    std::string _description;
+};
+
+class FreeDiffusion : public Benchmark {
+public:
+    FreeDiffusion() : Benchmark("FreeDiffusion", "Particles diffusing without any interaction") {}
+
+    void setUp(model::Context &context, std::size_t nParticles) const override {
+        setBox(context, nParticles, 1.);
+        context.particleTypes().add("A", 1.);
+    }
+};
+
+class PairPotential : public Benchmark {
+public:
+    PairPotential() : Benchmark("PairPotential", "Particles diffusing with harmonic repulsion") {}
+
+    void setUp(model::Context &context, std::size_t nParticles) const override {
+        setBox(context, nParticles, .5);
+        context.particleTypes().add("A", 1.);
+        context.potentials().addHarmonicRepulsion("A", "A", 10., 1.);
+    }
+};
+
+class LennardJones : public Benchmark {
+public:
+    explicit LennardJones(bool tabulated)
+            : Benchmark(tabulated ? "TabulatedLennardJones" : "LennardJones",
+                        tabulated ? "Lennard-Jones tabulated on 2000 distances with cubic spline interpolation"
+                                  : "Analytic 12-6 Lennard-Jones with a cutoff of 2.5"),
+              _tabulated(tabulated) {}
+
+    void setUp(model::Context &context, std::size_t nParticles) const override {
+        setBox(context, nParticles, .5);
+        // slow diffusion keeps pairs out of the singular core of the analytic potential for the time step of the harness
+        context.particleTypes().add("A", .01);
+        if (_tabulated) {
+            model::potentials::LennardJones lj(0, 0, 12, 6, cutoff, true, epsilon, 1.);
+            std::vector<scalar> distances, energies, forces;
+            for (std::size_t i = 0; i < tableSize; ++i) {
+                auto r = static_cast<scalar>(.8 + static_cast<double>(i) * (cutoff - .8) / (tableSize - 1));
+                Vec3 x{r, 0, 0};
+                Vec3 f{0, 0, 0};
+                lj.calculateForce(f, x);
+                distances.push_back(r);
+                energies.push_back(lj.calculateEnergy(x));
+                forces.push_back(-f.x);
+            }
+            context.potentials().addTabulated("A", "A", distances, energies, forces);
+        } else {
+            context.potentials().addLennardJones("A", "A", 12, 6, cutoff, true, epsilon, 1.);
+        }
+    }
+
+    /**
+     * Particles start on a cubic lattice, so that no pair starts in the steep core of the potential.
+     */
+    void populate(Simulation &simulation, std::size_t nParticles) const override {
+        const auto &box = simulation.context().boxSize();
+        auto perDim = static_cast<std::size_t>(std::ceil(std::cbrt(static_cast<scalar>(nParticles))));
+        auto spacing = box[0] / static_cast<scalar>(perDim);
+        for (std::size_t i = 0; i < nParticles; ++i) {
+            simulation.addParticle("A", static_cast<scalar>(i % perDim) * spacing - .5 * box[0],
+                                   static_cast<scalar>((i / perDim) % perDim) * spacing - .5 * box[1],
+                                   static_cast<scalar>(i / (perDim * perDim)) * spacing - .5 * box[2]);
+        }
+    }
+
+private:
+    static constexpr scalar cutoff = 2.5;
+    static constexpr scalar epsilon = .1;
+    static constexpr std::size_t tableSize = 2000;
+    bool _tabulated;
+};
+
+class Reactions : public Benchmark {
+public:
+    explicit Reactions(std::string scheduler)
+            : Benchmark("Reactions" + scheduler, "Reversible association A + B <-> C handled by " + scheduler),
+              _scheduler(std::move(scheduler)) {}
+
+    [[nodiscard]] bool supports(const std::string &kernel) const override {
+        return _scheduler != "DetailedBalance" || kernel == "SingleCPU";
+    }
+
+    void setUp(model::Context &context, std::size_t nParticles) const override {
+        setBox(context, nParticles, .5);
+        context.particleTypes().add("A", 1.);
+        context.particleTypes().add("B", 1.);
+        context.particleTypes().add("C", 1.);
+        context.reactions().add("fusion: A +(1) B -> C", 1.);
+        context.reactions().add("fission: C -> A +(1) B", 1.);
+    }
+
+    void populate(Simulation &simulation, std::size_t nParticles) const override {
+        addUniformly(simulation, "A", nParticles / 3);
+        addUniformly(simulation, "B", nParticles / 3);
+        addUniformly(simulation, "C", nParticles - 2 * (nParticles / 3));
+    }
+
+    void configure(api::SimulationLoop &loop) const override {
+        loop.useReactionScheduler(_scheduler);
+    }
+
+private:
+    std::string _scheduler;
+};
+
+class Polymers : public Benchmark {
+public:
+    Polymers() : Benchmark("Polymers", "Linear topologies of 10 monomers connected by harmonic bonds") {}
+
+    void setUp(model::Context &context, std::size_t nParticles) const override {
+        setBox(context, nParticles, .5);
+        context.particleTypes().addTopologyType("monomer", 1.);
+        context.topologyRegistry().addType("polymer");
+        context.topologyRegistry().configureBondPotential("monomer", "monomer", {10., 1.});
+        context.potentials().addHarmonicRepulsion("monomer", "monomer", 10., 1.);
+    }
+
+    void populate(Simulation &simulation, std::size_t nParticles) const override {
+        const auto &box = simulation.context().boxSize();
+        for (std::size_t i = 0; i < nParticles / chainLength; ++i) {
+            Vec3 start{rnd::uniform_real() * box[0] - 0.5 * box[0], rnd::uniform_real() * box[1] - 0.5 * box[1],
+                       rnd::uniform_real() * box[2] - 0.5 * box[2]};
+            std::vector<model::Particle> monomers;
+            for (std::size_t j = 0; j < chainLength; ++j) {
+                auto pos = start + Vec3{static_cast<scalar>(j), 0., 0.};
+                bcs::fixPosition(pos, box, simulation.context().periodicBoundaryConditions());
+                monomers.push_back(simulation.createTopologyParticle("monomer", pos));
+            }
+            auto topology = simulation.addTopology("polymer", monomers);
+            auto it = topology->graph().vertices().begin();
+            auto it2 = std::next(it);
+            for (; it2 != topology->graph().vertices().end(); ++it, ++it2) {
+                topology->addEdge(it.persistent_index(), it2.persistent_index());
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t chainLength = 10;
+};
+
+class Compartments : public Benchmark {
+public:
+    Compartments() : Benchmark("Compartments", "Conversion A -> B inside and B -> A outside of a sphere") {}
+
+    void setUp(model::Context &context, std::size_t nParticles) const override {
+        setBox(context, nParticles, 1.);
+        context.particleTypes().add("A", 1.);
+        context.particleTypes().add("B", 1.);
+        auto radius = .25 * context.boxSize()[0];
+        context.compartments().addSphere({{"A", "B"}}, "inside", {0., 0., 0.}, radius, false);
+        context.compartments().addSphere({{"B", "A"}}, "outside", {0., 0., 0.}, radius, true);
+    }
+};
+
+class Observables : public Benchmark {
+public:
+    Observables() : Benchmark("Observables", "Free diffusion with several observables evaluated in every step") {}
+
+    void setUp(model::Context &context, std::size_t nParticles) const override {
+        setBox(context, nParticles, 1.);
+        context.particleTypes().add("A", 1.);
+    }
+
+    void populate(Simulation &simulation, std::size_t nParticles) const override {
+        Benchmark::populate(simulation, nParticles);
+        std::vector<scalar> binBorders;
+        for (int i = 0; i <= 20; ++i) {
+            binBorders.push_back(static_cast<scalar>(.1 * i));
+        }
+        auto density = static_cast<scalar>(nParticles) / simulation.context().boxVolume();
+        simulation.registerObservable(simulation.observe().positions(1));
+        simulation.registerObservable(simulation.observe().particles(1));
+        simulation.registerObservable(simulation.observe().nParticles(1, std::vector<std::string>{"A"}));
+        simulation.registerObservable(simulation.observe().energy(1));
+        simulation.registerObservable(simulation.observe().radialDistribution(1, binBorders, {"A"}, {"A"}, density));
+    }
+};
+
+/**
+ * All benchmarks of the suite
+ */
+inline std::vector<std::unique_ptr<Benchmark>> allBenchmarks() {
+    std::vector<std::unique_ptr<Benchmark>> benchmarks;
+    benchmarks.push_back(std::make_unique<FreeDiffusion>());
+    benchmarks.push_back(std::make_unique<PairPotential>());
+    benchmarks.push_back(std::make_unique<LennardJones>(false));
+    benchmarks.push_back(std::make_unique<LennardJones>(true));
+    benchmarks.push_back(std::make_unique<Reactions>("UncontrolledApproximation"));
+    benchmarks.push_back(std::make_unique<Reactions>("Gillespie"));
+    benchmarks.push_back(std::make_unique<Reactions>("DetailedBalance"));
+    benchmarks.push_back(std::make_unique<Polymers>());
+    benchmarks.push_back(std::make_unique<Compartments>());
+    benchmarks.push_back(std::make_unique<Observables>());
+    return benchmarks;
+}
+
+class Harness {
+public:
+    Harness(std::size_t nSteps, std::size_t nWarmupSteps, std::size_t nRepetitions, scalar timeStep,
+            bool compiledLoop = false, conf::cpu::NeighborList neighborList = {})
+            : _nSteps(nSteps), _nWarmupSteps(nWarmupSteps), _nRepetitions(nRepetitions), _timeStep(timeStep),
+              _compiledLoop(compiledLoop), _neighborList(neighborList) {}
+
+    /**
+     * Measures one benchmark for one setup.
+     * @return the result in the json format understood by compare_benchmarks.py
+     */
+    [[nodiscard]] Json run(const Benchmark &benchmark, const Setup &setup) const {
+        model::Context context;
+        context.kernelConfiguration().cpu.threadConfig.nThreads = static_cast<int>(setup.nThreads);
+        context.kernelConfiguration().cpu.neighborList = _neighborList;
+        benchmark.setUp(context, setup.nParticles);
+        Simulation simulation(setup.kernel, context);
+        benchmark.populate(simulation, setup.nParticles);
+
+        auto loop = simulation.createLoop(_timeStep);
+        loop.progressOutputStride() = 0;
+        loop.useCompiledLoop(_compiledLoop);
+        benchmark.configure(loop);
+        loop.run(_nWarmupSteps);
+
+        std::vector<double> timesPerStep;
+        for (std::size_t i = 0; i < _nRepetitions; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            loop.run(_nSteps);
+            auto end = std::chrono::steady_clock::now();
+            auto ns = std::chrono::duration<double, std::nano>(end - start).count();
+            timesPerStep.push_back(ns / static_cast<double>(_nSteps));
+        }
+        std::sort(timesPerStep.begin(), timesPerStep.end());
+
+        Json result;
+        result["name"] = fmt::format("{}/{}/n:{}/threads:{}", benchmark.name(), setup.kernel, setup.nParticles,
+                                     setup.nThreads);
+        result["benchmark"] = benchmark.name();
+        result["kernel"] = setup.kernel;
+        result["n_particles"] = setup.nParticles;
+        result["n_threads"] = setup.nThreads;
+        result["n_steps"] = _nSteps;
+        result["repetitions"] = _nRepetitions;
+        result["compiled_loop"] = _compiledLoop;
+        result["reorder_interval"] = _neighborList.reorder_interval;
+        result["reorder_threshold"] = _neighborList.reorder_threshold;
+        result["time_per_step_ns"] = timesPerStep[timesPerStep.size() / 2];
+        result["min_time_per_step_ns"] = timesPerStep.front();
+        result["max_time_per_step_ns"] = timesPerStep.back();
+        return result;
+    }
+
+private:
+    std::size_t _nSteps;
+    std::size_t _nWarmupSteps;
+    std::size_t _nRepetitions;
+    scalar _timeStep;
+    bool _compiledLoop;
+    conf::cpu::NeighborList _neighborList;
+};
+
+}
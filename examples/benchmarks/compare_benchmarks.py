@@ -0,0 +1,69 @@
+#!/usr/bin/env python
+"""
+Compares two result files of readdy_benchmarks, e.g., of the base and the head of a branch. Benchmarks are matched by
+name, the relative change of the median time per step is printed for each of them. Exits with status 1 if any
+benchmark got slower by more than the threshold, so that it can be used as a check in scripts.
+
+Usage:
+    python compare_benchmarks.py baseline.json contender.json [--threshold=0.1]
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        results = json.load(f)
+    return {b["name"]: b for b in results["benchmarks"]}
+
+
+def compare(baseline, contender, threshold):
+    """
+    :param baseline: benchmarks of the baseline by name
+    :param contender: benchmarks of the contender by name
+    :param threshold: relative slowdown above which a benchmark counts as regression
+    :return: the names of the regressed benchmarks
+    """
+    regressions = []
+    width = max([len(name) for name in baseline] + [len("benchmark")])
+    print("{:<{w}}  {:>14}  {:>14}  {:>8}".format("benchmark", "baseline [us]", "contender [us]", "change",
+                                                   w=width))
+    for name in sorted(baseline):
+        if name not in contender:
+            print("{:<{w}}  only in baseline".format(name, w=width))
+            continue
+        t_base = baseline[name]["time_per_step_ns"]
+        t_cont = contender[name]["time_per_step_ns"]
+        change = (t_cont - t_base) / t_base
+        flag = ""
+        if change > threshold:
+            flag = "  REGRESSION"
+            regressions.append(name)
+        elif change < -threshold:
+            flag = "  improvement"
+        print("{:<{w}}  {:>14.2f}  {:>14.2f}  {:>+7.1%}{}".format(name, t_base / 1e3, t_cont / 1e3, change, flag,
+                                                                 w=width))
+    for name in sorted(set(contender) - set(baseline)):
+        print("{:<{w}}  only in contender".format(name, w=width))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two readdy_benchmarks result files.")
+    parser.add_argument("baseline", help="result file of the baseline")
+    parser.add_argument("contender", help="result file to check for regressions")
+    parser.add_argument("--threshold", type=float, default=0.1,
+                        help="relative slowdown of the median time per step that is flagged, default 0.1")
+    args = parser.parse_args()
+
+    regressions = compare(load(args.baseline), load(args.contender), args.threshold)
+    if regressions:
+        print("\n{} benchmark(s) slower by more than {:.0%}".format(len(regressions), args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,136 @@
+/**
+ * @file main.cpp
+ * @brief Run the benchmark suite on a grid of kernels, particle numbers and thread counts, save the results to json
+ * @author EricArkfeld
+ * @date 19.10.26
+ */
+
+#include <chrono>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "Benchmarks.h"
+
+namespace bench = readdy::benchmark;
+
+namespace {
+
+std::string getOption(int argc, char **argv, const std::string &option, const std::string &defaultValue) {
+    for (int i = 0; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg.find(option) == 0) {
+            return arg.substr(option.size());
+        }
+    }
+    return defaultValue;
+}
+
+std::vector<std::string> split(const std::string &list) {
+    std::vector<std::string> result;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) {
+            result.push_back(item);
+        }
+    }
+    return result;
+}
+
+std::vector<std::size_t> splitNumbers(const std::string &list) {
+    std::vector<std::size_t> result;
+    for (const auto &item : split(list)) {
+        result.push_back(std::stoul(item));
+    }
+    return result;
+}
+
+std::string datetime() {
+    auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::stringstream ss;
+    ss << std::put_time(std::gmtime(&now), "%F-%T");
+    return ss.str();
+}
+
+}
+
+/**
+ * Arguments (all optional):
+ * --out (output file, default readdy_benchmarks.json)
+ * --kernels (comma separated, default SingleCPU,CPU)
+ * --n (comma separated particle numbers, default 1000,10000)
+ * --threads (comma separated thread counts of the CPU kernel, default 1,2,4; SingleCPU always runs with one)
+ * --steps (steps per repetition, default 100)
+ * --warmup (steps before measuring, default 10)
+ * --repetitions (default 5)
+ * --filter (only run benchmarks whose name contains this string)
+ * --compiled-loop (1 to run the simulation loop in compiled loop mode, default 0)
+ * --reorder-interval (reorder particles of the CPU kernel every n neighbor list updates, default 0)
+ * --reorder-threshold (reorder particles of the CPU kernel once their locality has degraded this much, default 0)
+ * --version (e.g. `git describe --always`, embedded in the output)
+ *
+ * Compare two output files with
+ * python compare_benchmarks.py baseline.json contender.json --threshold=0.1
+ */
+int main(int argc, char **argv) {
+    readdy::log::set_level(spdlog::level::warn);
+
+    auto out = getOption(argc, argv, "--out=", "readdy_benchmarks.json");
+    auto kernels = split(getOption(argc, argv, "--kernels=", "SingleCPU,CPU"));
+    auto nParticles = splitNumbers(getOption(argc, argv, "--n=", "1000,10000"));
+    auto threads = splitNumbers(getOption(argc, argv, "--threads=", "1,2,4"));
+    auto nSteps = std::stoul(getOption(argc, argv, "--steps=", "100"));
+    auto nWarmupSteps = std::stoul(getOption(argc, argv, "--warmup=", "10"));
+    auto nRepetitions = std::stoul(getOption(argc, argv, "--repetitions=", "5"));
+    auto filter = getOption(argc, argv, "--filter=", "");
+    auto compiledLoop = getOption(argc, argv, "--compiled-loop=", "0") == "1";
+    readdy::conf::cpu::NeighborList neighborList;
+    neighborList.reorder_interval = std::stoul(getOption(argc, argv, "--reorder-interval=", "0"));
+    neighborList.reorder_threshold = std::stod(getOption(argc, argv, "--reorder-threshold=", "0"));
+    auto version = getOption(argc, argv, "--version=", "no version info provided");
+
+    if (nSteps == 0 || nRepetitions == 0) {
+        throw std::invalid_argument("The number of steps and repetitions must be positive.");
+    }
+
+    bench::Harness harness(nSteps, nWarmupSteps, nRepetitions, 1e-2, compiledLoop, neighborList);
+    bench::Json results = bench::Json::array();
+    for (const auto &benchmark : bench::allBenchmarks()) {
+        if (benchmark->name().find(filter) == std::string::npos) {
+            continue;
+        }
+        for (const auto &kernel : kernels) {
+            if (!benchmark->supports(kernel)) {
+                continue;
+            }
+            auto kernelThreads = kernel == "SingleCPU" ? std::vector<std::size_t>{1} : threads;
+            for (auto n : nParticles) {
+                for (auto nThreads : kernelThreads) {
+                    auto result = harness.run(*benchmark, {kernel, n, nThreads});
+                    std::cout << result["name"].get<std::string>() << ": "
+                              << result["time_per_step_ns"].get<double>() / 1e3 << " us/step" << std::endl;
+                    results.push_back(result);
+                }
+            }
+        }
+    }
+
+    bench::Json output;
+    output["context"] = {
+            {"datetime", datetime()},
+            {"version", version},
+            {"default_n_threads", readdy::readdy_default_n_threads()},
+            {"n_steps", nSteps},
+            {"n_warmup_steps", nWarmupSteps},
+            {"repetitions", nRepetitions},
+            {"compiled_loop", compiledLoop},
+            {"reorder_interval", neighborList.reorder_interval},
+            {"reorder_threshold", neighborList.reorder_threshold}
+    };
+    output["benchmarks"] = results;
+    std::ofstream stream(out, std::ofstream::out | std::ofstream::trunc);
+    stream << output.dump(2) << std::endl;
+    return 0;
+}
@@ -74,6 +74,11 @@ public:
 
     typename VertexList::size_type nVertices() const;
 
+    /**
+     * Removes all vertices and edges. The vertex and edge lists keep their allocated storage.
+     */
+    void clear();
+
     bool containsEdge(const Edge &edge) const;
 
     bool containsEdge(PersistentVertexIndex v1, PersistentVertexIndex v2) const;
@@ -128,6 +133,32 @@ public:
     template<typename T1, typename T2>
     std::int32_t graphDistance(T1 it1, T2 it2) const;
 
+    /**
+     * Reusable buffers for graphDistance with bounded depth. Can be kept alive across calls and graphs, so that
+     * repeated queries do not allocate.
+     */
+    struct DistanceScratch {
+        std::vector<char> visited;
+        std::vector<PersistentVertexIndex> touched;
+        std::vector<PersistentVertexIndex> frontier;
+        std::vector<PersistentVertexIndex> next;
+    };
+
+    /**
+     * Find shortest distance between two vertices in a graph, only searching paths of length up to maxDistance. The
+     * cost depends on the size of the maxDistance-neighborhood of the first vertex, not on the size of the graph.
+     *
+     * @tparam T1 vertex1 type
+     * @tparam T2 vertex2 type
+     * @param it1 vertex1
+     * @param it2 vertex2
+     * @param maxDistance maximal depth of the breadth first search
+     * @param scratch reusable buffers
+     * @return shortest distance or -1 if there is no path of length at most maxDistance
+     */
+    template<typename T1, typename T2>
+    std::int32_t graphDistance(T1 it1, T2 it2, std::int32_t maxDistance, DistanceScratch &scratch) const;
+
     const std::vector<Edge> &edges() const;
 
     std::size_t nEdges() const;
@@ -45,7 +45,7 @@ inline void Graph<VertexCollection, Vertex, Rest...>::findNTuples(const PairCall
         // vertex v1
         auto pvix = PersistentVertexIndex{vertexIndex};
         visited.at(vertexIndex) = true;
-        const auto &v1 = vertices().at(PersistentVertexIndex{vertexIndex});
+        const auto &v1 = *(_vertices.begin_persistent() + vertexIndex);
         if(!v1.deactivated()) {
             auto &neighbors = v1.neighbors();
             for (auto neighborIndex : neighbors) {
@@ -306,6 +306,55 @@ std::int32_t Graph<VertexCollection, Vertex, Rest...>::graphDistance(T1 it1, T2
     return -1;
 }
 
+template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
+template<typename T1, typename T2>
+std::int32_t Graph<VertexCollection, Vertex, Rest...>::graphDistance(T1 it1, T2 it2, std::int32_t maxDistance,
+                                                                     DistanceScratch &scratch) const {
+    const_persistent_iterator it1Persistent = toPersistentIterator(it1);
+    const_persistent_iterator it2Persistent = toPersistentIterator(it2);
+    PersistentIndex ixSource = _vertices.persistentIndex(it1Persistent);
+    PersistentIndex ixTarget = _vertices.persistentIndex(it2Persistent);
+
+    if (ixSource == ixTarget) {
+        return 0;
+    }
+
+    // the visited flags are only ever reset for touched vertices, so the buffer grows but is never cleared as a whole
+    if (scratch.visited.size() < _vertices.size_persistent()) {
+        scratch.visited.resize(_vertices.size_persistent(), false);
+    }
+    scratch.touched.clear();
+    scratch.frontier.clear();
+    scratch.frontier.push_back(ixSource);
+    scratch.visited[ixSource.value] = true;
+    scratch.touched.push_back(ixSource);
+
+    std::int32_t result = -1;
+    for (std::int32_t depth = 1; depth <= maxDistance && result == -1 && !scratch.frontier.empty(); ++depth) {
+        scratch.next.clear();
+        for (auto ix : scratch.frontier) {
+            for (auto neighbor : _vertices.at(ix).neighbors()) {
+                if (neighbor == ixTarget) {
+                    result = depth;
+                    break;
+                }
+                if (!scratch.visited[neighbor.value]) {
+                    scratch.visited[neighbor.value] = true;
+                    scratch.touched.push_back(neighbor);
+                    scratch.next.push_back(neighbor);
+                }
+            }
+            if (result != -1) break;
+        }
+        std::swap(scratch.frontier, scratch.next);
+    }
+
+    for (auto ix : scratch.touched) {
+        scratch.visited[ix.value] = false;
+    }
+    return result;
+}
+
 template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
 inline bool Graph<VertexCollection, Vertex, Rest...>::isConnected() const {
     if(_vertices.empty()) return true;
@@ -348,7 +397,7 @@ inline auto Graph<VertexCollection, Vertex, Rest...>::connectedComponents() -> s
         std::vector<char> visited (_vertices.size_persistent(), false);
 
         for(std::size_t ix = 0; ix < _vertices.size_persistent(); ++ix) {
-            if(!_vertices.at(PersistentVertexIndex{ix}).deactivated() && !visited.at(ix)) {
+            if(!(_vertices.begin_persistent() + ix)->deactivated() && !visited.at(ix)) {
                 // got a new component
                 components.emplace_back();
                 subVertexLists.emplace_back();
@@ -501,6 +550,12 @@ inline typename Graph<VertexCollection, Vertex, Rest...>::VertexList::size_type
     return _vertices.size();
 }
 
+template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
+inline void Graph<VertexCollection, Vertex, Rest...>::clear() {
+    _vertices.clear();
+    _edges.clear();
+}
+
 template<template<typename...> class VertexCollection, typename Vertex, typename... Rest>
 inline std::string Graph<VertexCollection, Vertex, Rest...>::gexf() const {
     std::ostringstream ss;
@@ -58,9 +58,9 @@ public:
 
     DataSet &operator=(const DataSet &) = delete;
 
-    DataSet(DataSet &&) = default;
+    DataSet(DataSet &&rhs) noexcept;
 
-    DataSet &operator=(DataSet &&) = default;
+    DataSet &operator=(DataSet &&rhs) noexcept;
 
     template<typename T>
     void append(std::vector<T> &data);
@@ -68,23 +68,65 @@ public:
     template<typename T>
     void append(const dimensions &dims, const T *data);
 
+    /**
+     * Appends a block that is distributed over the processes of a collectively opened file. Every process has to
+     * call this with the same `total`, which is the size of the whole block along the extension dimension. A process
+     * then writes its `dims`-shaped part at `offset` (along the extension dimension, relative to the current end of
+     * the data set). Processes without data pass zero-sized `dims` and still take part in the extent change.
+     * @param dims the dimensions of this process' part
+     * @param data this process' data, may be nullptr if dims is zero along the extension dimension
+     * @param offset offset of this process' part relative to the current end of the data set
+     * @param total number of elements along the extension dimension that are appended in total
+     */
+    template<typename T>
+    void appendCollective(const dimensions &dims, const T *data, dimension offset, dimension total);
+
     ~DataSet() override;
 
     void close() override;
 
+    /**
+     * Writes buffered appends (if any) and flushes the file.
+     */
     void flush();
 
+    /**
+     * Enables write combining: appends are buffered in memory and written with one extent change and one write
+     * once `nAppends` of them are pending, once the buffer exceeds `maxPendingBytes`, or when the data set or its
+     * file are flushed or closed. Choosing `nAppends` as the chunk size along the extension dimension writes whole
+     * chunks at a time. Only data sets that are extended along their first dimension are buffered.
+     * @param nAppends number of appends to combine, 0 or 1 writes every append immediately
+     */
+    void setWriteCombining(dimension nAppends);
+
+    dimension writeCombining() const;
+
+    /**
+     * Writes all buffered appends.
+     */
+    void commitPending();
+
     std::shared_ptr<DataSpace> getFileSpace() const;
 
     dimension &extensionDim();
 
     const dimension &extensionDim() const;
 
+    static constexpr std::size_t maxPendingBytes = 16u * 1024u * 1024u;
+
 private:
+    void writeBlock(const dimensions &dims, const void *data);
+
     dimension _extensionDim;
     std::unique_ptr<DataSpace> _memorySpace{nullptr};
     DataSetType _memoryType;
     DataSetType _fileType;
+
+    dimension _combinedAppends{0};
+    dimension _nPendingAppends{0};
+    dimensions _pendingDims;
+    std::vector<char> _pendingData;
+    std::shared_ptr<std::function<void()>> _pendingWritesHook;
 };
 
 }
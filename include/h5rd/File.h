@@ -70,6 +70,26 @@ public:
 
     static std::shared_ptr<File> create(const std::string &path, const Flags &flags);
 
+#ifdef H5_HAVE_PARALLEL
+    /**
+     * Collectively opens a file through the MPI-IO driver, all processes in `comm` have to take part. Creating groups
+     * and data sets as well as extending data sets become collective operations on such a file.
+     */
+    static std::shared_ptr<File> open(const std::string &path, const Flag &flag, MPI_Comm comm);
+
+    /**
+     * Collectively creates a file through the MPI-IO driver, see open(path, flag, comm).
+     */
+    static std::shared_ptr<File> create(const std::string &path, const Flag &flag, MPI_Comm comm);
+
+    const MPI_Comm &comm() const;
+#endif
+
+    /**
+     * @return true if the file was opened with an MPI communicator, i.e., writes can and have to be collective
+     */
+    bool collective() const;
+
     File(const File &) = delete;
 
     File &operator=(const File &) = delete;
@@ -99,6 +119,9 @@ protected:
     std::string path;
     Action action;
     Flags flags;
+#ifdef H5_HAVE_PARALLEL
+    MPI_Comm _comm {MPI_COMM_NULL};
+#endif
 };
 
 }
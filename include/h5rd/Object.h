@@ -77,10 +77,20 @@ public:
 
     const ParentFileRef &parentFile() const;
 
+    /**
+     * Registers a callback that writes out data which a sub object keeps buffered in memory. Callbacks that are still
+     * alive are invoked when this object (i.e., the file) is flushed and before it is closed.
+     * @param commit the callback, expired references are dropped
+     */
+    void registerPendingWrites(std::weak_ptr<std::function<void()>> commit);
+
 protected:
+    void commitPendingWrites();
+
     handle_id _hid{H5I_INVALID_HID};
     ParentFileRef _parentFile;
     bool _closed{false};
+    std::vector<std::weak_ptr<std::function<void()>>> _pendingWrites;
 
 private:
     template<typename Container> friend
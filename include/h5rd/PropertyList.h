@@ -87,6 +87,10 @@ public:
     void set_close_degree_default();
 
     void set_use_latest_libver();
+
+#ifdef H5_HAVE_PARALLEL
+    void set_mpio(MPI_Comm comm, MPI_Info info = MPI_INFO_NULL);
+#endif
 };
 
 class DataSetCreatePropertyList : public PropertyList {
@@ -105,6 +109,17 @@ public:
 
 };
 
+class DataSetTransferPropertyList : public PropertyList {
+public:
+    explicit DataSetTransferPropertyList(ParentFileRef parentFile);
+
+#ifdef H5_HAVE_PARALLEL
+    void set_io_collective();
+
+    void set_io_independent();
+#endif
+};
+
 }
 
 #include "detail/PropertyList_detail.h"
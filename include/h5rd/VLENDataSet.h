@@ -63,8 +63,25 @@ public:
 
     void close() override;
 
+    /**
+     * Writes buffered appends (if any) and flushes the file.
+     */
     void flush();
 
+    /**
+     * Enables write combining, see DataSet::setWriteCombining(). The entries' contents are copied into one flat
+     * buffer, so the appended vectors can be reused right away.
+     * @param nAppends number of appends to combine, 0 or 1 writes every append immediately
+     */
+    void setWriteCombining(dimension nAppends);
+
+    dimension writeCombining() const;
+
+    /**
+     * Writes all buffered appends.
+     */
+    void commitPending();
+
     std::shared_ptr<DataSpace> getFileSpace() const;
 
     dimension &extensionDim();
@@ -72,10 +89,20 @@ public:
     const dimension &extensionDim() const;
 
 private:
+    void writeBlock(const dimensions &dims, hvl_t *entries);
+
     dimension _extensionDim;
     std::unique_ptr<DataSpace> _memorySpace{nullptr};
     DataSetType _memoryType;
     DataSetType _fileType;
+
+    dimension _combinedAppends{0};
+    dimension _nPendingAppends{0};
+    dimensions _pendingDims;
+    std::size_t _pendingElementSize{0};
+    std::vector<char> _pendingData;
+    std::vector<std::size_t> _pendingLengths;
+    std::shared_ptr<std::function<void()>> _pendingWritesHook;
 };
 
 }
@@ -49,6 +49,8 @@
 #include <array>
 #include <vector>
 #include <memory>
+#include <functional>
+#include <algorithm>
 
 #include <H5Gpublic.h>
 #include <H5Spublic.h>
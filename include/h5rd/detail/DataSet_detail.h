@@ -64,15 +64,55 @@ inline h5rd::DataSet::~DataSet() {
 inline void h5rd::DataSet::close() {
     auto pf = _parentFile.lock();
     if (pf) {
-        if (!pf->closed() && valid() && H5Dclose(id()) < 0) {
-            throw Exception("Error on closing HDF5 data set");
+        if (!pf->closed() && valid()) {
+            commitPending();
+            if (H5Dclose(id()) < 0) {
+                throw Exception("Error on closing HDF5 data set");
+            }
         }
     }
+    _pendingWritesHook.reset();
 }
 
 inline h5rd::DataSet::DataSet(ParentFileRef parentFile, const DataSetType &memoryType, const DataSetType &fileType)
         : SubObject(std::move(parentFile)), _memoryType(memoryType), _fileType(fileType) {}
 
+inline h5rd::DataSet::DataSet(DataSet &&rhs) noexcept
+        : SubObject(std::move(rhs)), _extensionDim(rhs._extensionDim), _memorySpace(std::move(rhs._memorySpace)),
+          _memoryType(std::move(rhs._memoryType)), _fileType(std::move(rhs._fileType)),
+          _combinedAppends(rhs._combinedAppends), _nPendingAppends(rhs._nPendingAppends),
+          _pendingDims(std::move(rhs._pendingDims)), _pendingData(std::move(rhs._pendingData)),
+          _pendingWritesHook(std::move(rhs._pendingWritesHook)) {
+    rhs._nPendingAppends = 0;
+    if (_pendingWritesHook) {
+        // the file holds on to the hook, it has to refer to the new location
+        *_pendingWritesHook = [this] { commitPending(); };
+    }
+}
+
+inline h5rd::DataSet &h5rd::DataSet::operator=(DataSet &&rhs) noexcept {
+    try {
+        commitPending();
+    } catch (const Exception &e) {
+        std::cerr << "Unable to write pending appends of hdf5 data set: " << e.what() << std::endl;
+    }
+    SubObject::operator=(std::move(rhs));
+    _extensionDim = rhs._extensionDim;
+    _memorySpace = std::move(rhs._memorySpace);
+    _memoryType = std::move(rhs._memoryType);
+    _fileType = std::move(rhs._fileType);
+    _combinedAppends = rhs._combinedAppends;
+    _nPendingAppends = rhs._nPendingAppends;
+    _pendingDims = std::move(rhs._pendingDims);
+    _pendingData = std::move(rhs._pendingData);
+    _pendingWritesHook = std::move(rhs._pendingWritesHook);
+    rhs._nPendingAppends = 0;
+    if (_pendingWritesHook) {
+        *_pendingWritesHook = [this] { commitPending(); };
+    }
+    return *this;
+}
+
 inline h5rd::dimension &h5rd::DataSet::extensionDim() {
     return _extensionDim;
 }
@@ -90,8 +130,34 @@ inline std::shared_ptr<h5rd::DataSpace> h5rd::DataSet::getFileSpace() const {
 }
 
 inline void h5rd::DataSet::flush() {
-    if (valid() && H5Fflush(id(), H5F_SCOPE_LOCAL) < 0) {
-        throw Exception("error when flushing HDF5 data set with handle " + std::to_string(id()));
+    if (valid()) {
+        commitPending();
+        if (H5Fflush(id(), H5F_SCOPE_LOCAL) < 0) {
+            throw Exception("error when flushing HDF5 data set with handle " + std::to_string(id()));
+        }
+    }
+}
+
+inline void h5rd::DataSet::setWriteCombining(dimension nAppends) {
+    commitPending();
+    _combinedAppends = nAppends;
+    if (nAppends > 1 && !_pendingWritesHook) {
+        _pendingWritesHook = std::make_shared<std::function<void()>>([this] { commitPending(); });
+        if (auto pf = _parentFile.lock()) {
+            pf->registerPendingWrites(_pendingWritesHook);
+        }
+    }
+}
+
+inline h5rd::dimension h5rd::DataSet::writeCombining() const {
+    return _combinedAppends;
+}
+
+inline void h5rd::DataSet::commitPending() {
+    if (_nPendingAppends > 0) {
+        // reset first, a failing write must not be retried with the same data on close
+        _nPendingAppends = 0;
+        writeBlock(_pendingDims, _pendingData.data());
     }
 }
 
@@ -102,13 +168,78 @@ inline void h5rd::DataSet::append(std::vector<T> &data) {
 
 template<typename T>
 inline void h5rd::DataSet::append(const h5rd::dimensions &dims, const T *data) {
-    {
-        std::stringstream result;
-        std::copy(dims.begin(), dims.end(), std::ostream_iterator<int>(result, ", "));
-        // todo log::trace("appending to regular data set with data size = ({})", result.str());
+    if (_combinedAppends > 1 && _extensionDim == 0) {
+        if (_nPendingAppends > 0 && (dims.size() != _pendingDims.size()
+                                     || !std::equal(dims.begin() + 1, dims.end(), _pendingDims.begin() + 1))) {
+            // the shape of a block changed, it cannot be concatenated with the pending ones
+            commitPending();
+        }
+        if (_nPendingAppends == 0) {
+            if (dims.size() != getFileSpace()->ndim()) {
+                throw std::invalid_argument("tried to append data with wrong dimensionality!");
+            }
+            _pendingDims = dims;
+            _pendingDims[_extensionDim] = 0;
+            _pendingData.clear();
+        }
+        std::size_t nElements = 1;
+        for (auto d : dims) nElements *= d;
+        if (nElements > 0) {
+            const auto *bytes = reinterpret_cast<const char *>(data);
+            _pendingData.insert(_pendingData.end(), bytes, bytes + nElements * sizeof(T));
+        }
+        _pendingDims[_extensionDim] += dims[_extensionDim];
+        ++_nPendingAppends;
+        if (_nPendingAppends >= _combinedAppends || _pendingData.size() >= maxPendingBytes) {
+            commitPending();
+        }
+    } else {
+        if (dims.size() != getFileSpace()->ndim()) {
+            // todo log::error("Tried to append data with ndims={} to set with ndims={}", dims.size(), getFileSpace().ndim());
+            throw std::invalid_argument("tried to append data with wrong dimensionality!");
+        }
+        writeBlock(dims, data);
     }
+}
+
+inline void h5rd::DataSet::writeBlock(const dimensions &dims, const void *data) {
+    if (!_memorySpace) {
+        _memorySpace = std::make_unique<DataSpace>(_parentFile, dims);
+    } else {
+        H5Sset_extent_simple(_memorySpace->id(), static_cast<int>(dims.size()), dims.data(), nullptr);
+    }
+    // this also runs while the parent file is being destroyed, hence the file space is handled without DataSpace
+    auto fileSpace = H5Dget_space(id());
+    if (fileSpace < 0) {
+        throw Exception("Failed to get file space for data set!");
+    }
+    dimensions extent(dims.size());
+    H5Sget_simple_extent_dims(fileSpace, extent.data(), nullptr);
+    H5Sclose(fileSpace);
+
+    dimensions offset(dims.size(), 0);
+    offset[_extensionDim] = extent[_extensionDim];
+    extent[_extensionDim] += dims[_extensionDim];
+    H5Dset_extent(id(), extent.data());
+
+    fileSpace = H5Dget_space(id());
+    if (fileSpace < 0) {
+        throw Exception("Failed to get file space for data set!");
+    }
+    H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, offset.data(), nullptr, dims.data(), nullptr);
+    auto status = H5Dwrite(id(), _memoryType.id(), _memorySpace->id(), fileSpace, H5P_DEFAULT, data);
+    H5Sclose(fileSpace);
+    if (status < 0) {
+        throw Exception("Error on writing data set " + std::to_string(id()));
+    }
+}
+
+template<typename T>
+inline void h5rd::DataSet::appendCollective(const h5rd::dimensions &dims, const T *data, h5rd::dimension offset,
+                                            h5rd::dimension total) {
+    // all processes have to agree on the extent, buffered appends go first
+    commitPending();
     if (dims.size() != getFileSpace()->ndim()) {
-        // todo log::error("Tried to append data with ndims={} to set with ndims={}", dims.size(), getFileSpace().ndim());
         throw std::invalid_argument("tried to append data with wrong dimensionality!");
     }
     if (!_memorySpace) {
@@ -116,34 +247,38 @@ inline void h5rd::DataSet::append(const h5rd::dimensions &dims, const T *data) {
     } else {
         H5Sset_extent_simple(_memorySpace->id(), static_cast<int>(dims.size()), dims.data(), nullptr);
     }
-    dimensions currentExtent;
-    dimensions offset;
-    offset.resize(dims.size());
-    {
-        currentExtent = getFileSpace()->dims();
-    }
-    offset[_extensionDim] = currentExtent[_extensionDim];
+    dimensions fileOffset;
+    fileOffset.resize(dims.size());
     {
-        dimensions newExtent(currentExtent);
-        newExtent[_extensionDim] += dims[_extensionDim];
+        dimensions newExtent = getFileSpace()->dims();
+        fileOffset[_extensionDim] = newExtent[_extensionDim] + offset;
+        newExtent[_extensionDim] += total;
+        // collective, all processes have to agree on the new extent
         H5Dset_extent(id(), newExtent.data());
     }
-    // todo log::trace("selecting hyperslab with:");
-    {
-        std::stringstream result;
-        std::copy(offset.begin(), offset.end(), std::ostream_iterator<int>(result, ", "));
-        // todo log::trace("    current extent = {}", result.str());
+    auto fileSpace = getFileSpace();
+    if (dims[_extensionDim] > 0) {
+        H5Sselect_hyperslab(fileSpace->id(), H5S_SELECT_SET, fileOffset.data(), nullptr, dims.data(), nullptr);
+    } else {
+        H5Sselect_none(fileSpace->id());
+        H5Sselect_none(_memorySpace->id());
     }
+    DataSetTransferPropertyList dxpl(_parentFile);
+#ifdef H5_HAVE_PARALLEL
     {
-        std::stringstream result;
-        std::copy(dims.begin(), dims.end(), std::ostream_iterator<int>(result, ", "));
-        // todo log::trace("    size = {}", result.str());
+        // request collective transfer if the data set lives in a file that was opened through MPI-IO
+        auto fileId = H5Iget_file_id(id());
+        auto fapl = H5Fget_access_plist(fileId);
+        if (H5Pget_driver(fapl) == H5FD_MPIO) {
+            dxpl.set_io_collective();
+        }
+        H5Pclose(fapl);
+        H5Fclose(fileId);
     }
-    auto fileSpace = getFileSpace();
-    H5Sselect_hyperslab(fileSpace->id(), H5S_SELECT_SET, offset.data(), nullptr, dims.data(), nullptr);
-    if (H5Dwrite(id(), _memoryType.id(), _memorySpace->id(), fileSpace->id(), H5P_DEFAULT, data) < 0) {
-        //log::error("Error with data set {}", hid());
-        //H5Eprint(H5Eget_current_stack(), stderr);
-        throw Exception("Error on writing data set " + std::to_string(id()));
+#endif
+    if (H5Dwrite(id(), _memoryType.id(), _memorySpace->id(), fileSpace->id(), dxpl.id(), data) < 0) {
+        throw Exception("Error on collectively writing data set " + std::to_string(id()));
     }
+    // the memory space is shared with append(), which expects everything to be selected
+    H5Sselect_all(_memorySpace->id());
 }
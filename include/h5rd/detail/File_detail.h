@@ -77,6 +77,7 @@ inline h5rd::File::File(const std::string &path, const Action &action, const Fla
         : Object(), path(path), action(action), flags(flags) {}
 
 inline void h5rd::File::flush() {
+    commitPendingWrites();
     if (H5Fflush(_hid, H5F_SCOPE_LOCAL) < 0) {
         throw Exception("error when flushing HDF5 file \"" + path + "\"");
     }
@@ -92,6 +93,8 @@ inline h5rd::File::~File() {
 
 inline void h5rd::File::close() {
     if (!closed() && _hid != H5I_INVALID_HID && H5Iis_valid(_hid) > 0) {
+        // the strong close degree closes all data sets along with the file, buffered appends have to go first
+        commitPendingWrites();
         if (H5Fclose(id()) < 0) {
             throw Exception("Error on closing HDF5 file \"" + path + "\"");
         }
@@ -127,6 +130,38 @@ inline std::shared_ptr<h5rd::File> h5rd::File::create(const std::string &path, c
     return f;
 }
 
+#ifdef H5_HAVE_PARALLEL
+
+inline std::shared_ptr<h5rd::File> h5rd::File::open(const std::string &path, const Flag &flag, MPI_Comm comm) {
+    auto f = std::shared_ptr<h5rd::File>(new File(path, h5rd::File::Action::OPEN, flag));
+    f->_parentFile = f->getptr();
+    f->_comm = comm;
+    setUp(f);
+    return f;
+}
+
+inline std::shared_ptr<h5rd::File> h5rd::File::create(const std::string &path, const Flag &flag, MPI_Comm comm) {
+    auto f = std::shared_ptr<h5rd::File>(new File(path, h5rd::File::Action::CREATE, flag));
+    f->_parentFile = f->getptr();
+    f->_comm = comm;
+    setUp(f);
+    return f;
+}
+
+inline const MPI_Comm &h5rd::File::comm() const {
+    return _comm;
+}
+
+#endif
+
+inline bool h5rd::File::collective() const {
+#ifdef H5_HAVE_PARALLEL
+    return _comm != MPI_COMM_NULL;
+#else
+    return false;
+#endif
+}
+
 inline void h5rd::File::setUp(std::shared_ptr<File> file) {
     unsigned flag = 0x0000u;
     for (const auto &f : file->flags) {
@@ -135,6 +170,11 @@ inline void h5rd::File::setUp(std::shared_ptr<File> file) {
     FileAccessPropertyList fapl(file);
     fapl.set_close_degree_strong();
     fapl.set_use_latest_libver();
+#ifdef H5_HAVE_PARALLEL
+    if (file->collective()) {
+        fapl.set_mpio(file->_comm);
+    }
+#endif
     handle_id val = 0;
     switch (file->action) {
         case Action::CREATE: {
@@ -68,7 +68,8 @@ inline h5rd::handle_id h5rd::Object::id() const {
 }
 
 inline h5rd::Object::Object(h5rd::Object &&rhs) noexcept
-        : _hid(std::move(rhs._hid)), _parentFile(std::move(rhs._parentFile)), _closed(std::move(rhs._closed)) {
+        : _hid(std::move(rhs._hid)), _parentFile(std::move(rhs._parentFile)), _closed(std::move(rhs._closed)),
+          _pendingWrites(std::move(rhs._pendingWrites)) {
     rhs._closed = true;
 }
 
@@ -76,10 +77,26 @@ inline h5rd::Object &h5rd::Object::operator=(h5rd::Object &&rhs) noexcept {
     _hid = rhs._hid;
     _parentFile = std::move(rhs._parentFile);
     _closed = rhs._closed;
+    _pendingWrites = std::move(rhs._pendingWrites);
     rhs._closed = true;
     return *this;
 }
 
+inline void h5rd::Object::registerPendingWrites(std::weak_ptr<std::function<void()>> commit) {
+    _pendingWrites.erase(std::remove_if(_pendingWrites.begin(), _pendingWrites.end(), [](const auto &ref) {
+        return ref.expired();
+    }), _pendingWrites.end());
+    _pendingWrites.push_back(std::move(commit));
+}
+
+inline void h5rd::Object::commitPendingWrites() {
+    for (const auto &ref : _pendingWrites) {
+        if (auto commit = ref.lock()) {
+            (*commit)();
+        }
+    }
+}
+
 inline h5rd::SubObject::SubObject(ParentFileRef parentFile) : Object() {
     _parentFile = std::move(parentFile);
 }
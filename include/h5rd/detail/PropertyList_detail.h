@@ -128,6 +128,14 @@ inline void FileAccessPropertyList::set_use_latest_libver() {
     H5Pset_libver_bounds(id(), H5F_LIBVER_LATEST, H5F_LIBVER_LATEST);
 }
 
+#ifdef H5_HAVE_PARALLEL
+inline void FileAccessPropertyList::set_mpio(MPI_Comm comm, MPI_Info info) {
+    if (H5Pset_fapl_mpio(id(), comm, info) < 0) {
+        throw Exception("Failed to set MPI-IO file access property");
+    }
+}
+#endif
+
 inline DataSetCreatePropertyList::DataSetCreatePropertyList(ParentFileRef parentFile)
                     : PropertyList(H5P_DATASET_CREATE, std::move(parentFile)) {}
 
@@ -151,5 +159,18 @@ inline void DataSetCreatePropertyList::activate_filter(Filter *filter) {
     filter->activate(*this);
 }
 
+inline DataSetTransferPropertyList::DataSetTransferPropertyList(ParentFileRef parentFile)
+        : PropertyList(H5P_DATASET_XFER, std::move(parentFile)) {}
+
+#ifdef H5_HAVE_PARALLEL
+inline void DataSetTransferPropertyList::set_io_collective() {
+    H5Pset_dxpl_mpio(id(), H5FD_MPIO_COLLECTIVE);
+}
+
+inline void DataSetTransferPropertyList::set_io_independent() {
+    H5Pset_dxpl_mpio(id(), H5FD_MPIO_INDEPENDENT);
+}
+#endif
+
 
 }
\ No newline at end of file
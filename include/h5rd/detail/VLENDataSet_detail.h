@@ -46,6 +46,7 @@
 #pragma once
 
 #include "../VLENDataSet.h"
+#include "../DataSet.h"
 #include "../DataSpace.h"
 
 namespace h5rd {
@@ -70,17 +71,56 @@ inline const dimension &VLENDataSet::extensionDim() const {
 }
 
 inline void VLENDataSet::flush() {
-    if (valid() && H5Fflush(id(), H5F_SCOPE_LOCAL) < 0) {
-        throw Exception("error when flushing HDF5 vlen data set with handle " + std::to_string(id()));
+    if (valid()) {
+        commitPending();
+        if (H5Fflush(id(), H5F_SCOPE_LOCAL) < 0) {
+            throw Exception("error when flushing HDF5 vlen data set with handle " + std::to_string(id()));
+        }
     }
 }
 
 inline void VLENDataSet::close() {
     auto pf = _parentFile.lock();
     if (pf) {
-        if (!pf->closed() && valid() && H5Dclose(id()) < 0) {
-            throw Exception("Error on closing HDF5 vlen data set");
+        if (!pf->closed() && valid()) {
+            commitPending();
+            if (H5Dclose(id()) < 0) {
+                throw Exception("Error on closing HDF5 vlen data set");
+            }
+        }
+    }
+    _pendingWritesHook.reset();
+}
+
+inline void VLENDataSet::setWriteCombining(dimension nAppends) {
+    commitPending();
+    _combinedAppends = nAppends;
+    if (nAppends > 1 && !_pendingWritesHook) {
+        _pendingWritesHook = std::make_shared<std::function<void()>>([this] { commitPending(); });
+        if (auto pf = _parentFile.lock()) {
+            pf->registerPendingWrites(_pendingWritesHook);
+        }
+    }
+}
+
+inline dimension VLENDataSet::writeCombining() const {
+    return _combinedAppends;
+}
+
+inline void VLENDataSet::commitPending() {
+    if (_nPendingAppends > 0) {
+        _nPendingAppends = 0;
+        std::vector<hvl_t> entries;
+        entries.reserve(_pendingLengths.size());
+        auto *p = _pendingData.data();
+        for (auto len : _pendingLengths) {
+            hvl_t entry{};
+            entry.len = len;
+            entry.p = p;
+            entries.push_back(entry);
+            p += len * _pendingElementSize;
         }
+        writeBlock(_pendingDims, entries.data());
     }
 }
 
@@ -99,73 +139,83 @@ inline void VLENDataSet::append(std::vector<std::vector<T>> &data) {
 
 template<typename T>
 inline void VLENDataSet::append(const dimensions &dims, std::vector<T> *const data) {
-    /*{
-        std::stringstream result;
-        std::copy(dims.begin(), dims.end(), std::ostream_iterator<int>(result, ", "));
-        log::trace("appending to vlen data set with data size = ({})", result.str());
-    }*/
-    {
-        auto fs = getFileSpace();
-        if (dims.size() != fs->ndim()) {
-            throw Exception("Tried to append data with ndims=" + std::to_string(dims.size()) + " to set with ndims=" +
-                            std::to_string(fs->ndim()));
+    const auto n = dims[_extensionDim];
+    if (_combinedAppends > 1 && _extensionDim == 0 && dims.size() == 1) {
+        if (_nPendingAppends > 0 && _pendingElementSize != sizeof(T)) {
+            commitPending();
+        }
+        if (_nPendingAppends == 0) {
+            auto fs = getFileSpace();
+            if (dims.size() != fs->ndim()) {
+                throw Exception("Tried to append data with ndims=" + std::to_string(dims.size()) +
+                                " to set with ndims=" + std::to_string(fs->ndim()));
+            }
+            _pendingDims = {0};
+            _pendingElementSize = sizeof(T);
+            _pendingData.clear();
+            _pendingLengths.clear();
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto *bytes = reinterpret_cast<const char *>(data[i].data());
+            _pendingData.insert(_pendingData.end(), bytes, bytes + data[i].size() * sizeof(T));
+            _pendingLengths.push_back(data[i].size());
+        }
+        _pendingDims[0] += n;
+        ++_nPendingAppends;
+        if (_nPendingAppends >= _combinedAppends || _pendingData.size() >= DataSet::maxPendingBytes) {
+            commitPending();
         }
-    }
-    if (!_memorySpace) {
-        _memorySpace = std::make_unique<DataSpace>(_parentFile, dims);
     } else {
-        H5Sset_extent_simple(_memorySpace->id(), static_cast<int>(dims.size()), dims.data(), nullptr);
-    }
-    dimensions currentExtent;
-    {
-        auto fs = getFileSpace();
-        currentExtent = fs->dims();
-    }
-    dimensions offset;
-    {
-        offset.resize(dims.size());
-        offset[_extensionDim] = currentExtent[_extensionDim];
-    }
-    dimensions newExtent(currentExtent.begin(), currentExtent.end());
-    {
-        newExtent[_extensionDim] += dims[_extensionDim];
-        H5Dset_extent(id(), newExtent.data());
         {
-            // todo log::trace("setting new extent to:");
-            /*std::stringstream result;
-            std::copy(newExtent.begin(), newExtent.end(), std::ostream_iterator<int>(result, ", "));
-            log::trace("    size = {}", result.str());*/
+            auto fs = getFileSpace();
+            if (dims.size() != fs->ndim()) {
+                throw Exception("Tried to append data with ndims=" + std::to_string(dims.size()) +
+                                " to set with ndims=" + std::to_string(fs->ndim()));
+            }
         }
-    }
-    // todo log::trace("selecting hyperslab with:");
-    {
-        /*std::stringstream result;
-        std::copy(offset.begin(), offset.end(), std::ostream_iterator<int>(result, ", "));
-        log::trace("    current extent = {}", result.str());*/
-    }
-    {
-        /*std::stringstream result;
-        std::copy(dims.begin(), dims.end(), std::ostream_iterator<int>(result, ", "));
-        log::trace("    size = {}", result.str());*/
-    }
-    std::vector<hvl_t> traj;
-    {
-        const auto n = dims[_extensionDim];
-        // log::trace("appending n={} vlen entries", n);
+        std::vector<hvl_t> traj;
         traj.reserve(n);
-        for (auto i = 0; i < n; ++i) {
+        for (std::size_t i = 0; i < n; ++i) {
             auto val = &data[i];
             hvl_t entry{};
             entry.len = val->size();
             entry.p = val->data();
             traj.push_back(entry);
         }
+        writeBlock(dims, traj.data());
     }
-    {
-        auto fileSpace = getFileSpace();
-        H5Sselect_hyperslab(fileSpace->id(), H5S_SELECT_SET, offset.data(), nullptr, dims.data(), nullptr);
-        H5Dwrite(id(), _memoryType.id(), _memorySpace->id(), fileSpace->id(), H5P_DEFAULT, traj.data());
+}
+
+inline void VLENDataSet::writeBlock(const dimensions &dims, hvl_t *entries) {
+    if (!_memorySpace) {
+        _memorySpace = std::make_unique<DataSpace>(_parentFile, dims);
+    } else {
+        H5Sset_extent_simple(_memorySpace->id(), static_cast<int>(dims.size()), dims.data(), nullptr);
+    }
+    // this also runs while the parent file is being destroyed, hence the file space is handled without DataSpace
+    auto fileSpace = H5Dget_space(id());
+    if (fileSpace < 0) {
+        throw Exception("Failed to get file space for vlen data set!");
+    }
+    dimensions extent(dims.size());
+    H5Sget_simple_extent_dims(fileSpace, extent.data(), nullptr);
+    H5Sclose(fileSpace);
+
+    dimensions offset(dims.size(), 0);
+    offset[_extensionDim] = extent[_extensionDim];
+    extent[_extensionDim] += dims[_extensionDim];
+    H5Dset_extent(id(), extent.data());
+
+    fileSpace = H5Dget_space(id());
+    if (fileSpace < 0) {
+        throw Exception("Failed to get file space for vlen data set!");
+    }
+    H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, offset.data(), nullptr, dims.data(), nullptr);
+    auto status = H5Dwrite(id(), _memoryType.id(), _memorySpace->id(), fileSpace, H5P_DEFAULT, entries);
+    H5Sclose(fileSpace);
+    if (status < 0) {
+        throw Exception("Error on writing vlen data set " + std::to_string(id()));
     }
 }
 
-}
\ No newline at end of file
+}
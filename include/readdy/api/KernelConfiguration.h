@@ -61,6 +61,17 @@ struct NeighborList {
      * drastically increase memory requirements.
      */
     std::uint8_t cll_radius{1};
+    /**
+     * Reorder the particles along a space-filling curve every this many neighbor list updates, 0 disables the
+     * periodic reordering.
+     */
+    std::size_t reorder_interval{0};
+    /**
+     * Reorder the particles once the fraction of consecutive particles in memory that lie in different cells has
+     * degraded by this fraction of the way from its value right after the last reordering towards 1 (random order).
+     * A value of 0 disables locality-triggered reordering.
+     */
+    double reorder_threshold{0};
 };
 
 /**
@@ -111,6 +122,33 @@ void to_json(json &j, const ThreadConfig &nl);
  */
 void from_json(const json &j, ThreadConfig &nl);
 
+/**
+ * Struct with configuration attributes for the evaluation of first order (external) potentials in the CPU kernel
+ */
+struct ExternalPotentials {
+    /**
+     * If positive, the built-in first order potentials acting on each particle type are tabulated on a grid with (at
+     * most) this spacing spanning the simulation box and evaluated by trilinear interpolation. Other potentials and
+     * particles outside of the box are evaluated exactly. The grid may have at most PotentialGrid::maxNodes nodes.
+     * A value of 0 disables the grid.
+     */
+    scalar grid_spacing{0};
+};
+
+/**
+ * Json serialization of ExternalPotentials config struct
+ * @param j the json object
+ * @param conf the configurational object
+ */
+void to_json(json &j, const ExternalPotentials &conf);
+
+/**
+ * Json deserialization to ExternalPotentials config struct
+ * @param j the json object
+ * @param conf the configurational object
+ */
+void from_json(const json &j, ExternalPotentials &conf);
+
 /**
  * Struct that contains configuration information for the CPU kernel.
  */
@@ -123,6 +161,10 @@ struct Configuration {
      * Configuration of the threading behavior
      */
     ThreadConfig threadConfig{};
+    /**
+     * Configuration of the first order potential evaluation
+     */
+    ExternalPotentials externalPotentials{};
 };
 
 /**
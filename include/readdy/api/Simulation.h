@@ -163,14 +163,12 @@ public:
      */
     [[nodiscard]] std::vector<Vec3> getParticlePositions(const std::string &type) {
         auto typeId = _kernel->context().particleTypes().idOf(type);
-        const auto particles = _kernel->stateModel().getParticles();
         std::vector<Vec3> positions;
-        positions.reserve(particles.size());
-        for (const auto &p : particles) {
-            if (p.type() == typeId) {
-                positions.push_back(p.pos());
+        _kernel->stateModel().forEachParticle([&](ParticleTypeId t, ParticleId, const Vec3 &pos, const Vec3 &) {
+            if (t == typeId) {
+                positions.push_back(pos);
             }
-        }
+        });
         return positions;
     }
 
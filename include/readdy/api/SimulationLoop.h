@@ -162,8 +162,15 @@ public:
         if (_clearNeighborList) _clearNeighborList->perform();
     }
 
-    void runForces() {
-        if (_forces) _forces->perform();
+    /**
+     * Evaluates the forces.
+     * @param computeEnergy whether the energy of the state model is updated as well
+     */
+    void runForces(bool computeEnergy = true) {
+        if (_forces) {
+            setForcesMode(computeEnergy);
+            _forces->perform();
+        }
     }
 
     void runEvaluateObservables(TimeStep t) {
@@ -217,6 +224,35 @@ public:
         _forces = include ? _kernel->actions().calculateForces() : nullptr;
     }
 
+    /**
+     * In the compiled loop mode, the integrator, the neighbor list updates, the reactions, the topology reactions and
+     * the forces of a step are performed by one compiled step of the kernel, which is specialized for the
+     * configuration of the context when the simulation starts. Kernels or actions that have no compiled step fall
+     * back to performing the actions one by one.
+     * @param use whether to use the compiled loop
+     */
+    void useCompiledLoop(bool use) {
+        _useCompiledLoop = use;
+    }
+
+    [[nodiscard]] bool usesCompiledLoop() const {
+        return _useCompiledLoop;
+    }
+
+    /**
+     * By default, the energy of the state model is updated in every time step. If unobserved energies are skipped,
+     * it is only computed on time steps where an observable connected to the kernel reads it, e.g., the Energy
+     * observable. Callbacks that read the energy of the state model then see the value of the last evaluation.
+     * @param skip whether to skip the energy computation on time steps where no observable reads it
+     */
+    void skipUnobservedEnergies(bool skip) {
+        _skipUnobservedEnergies = skip;
+    }
+
+    [[nodiscard]] bool skipsUnobservedEnergies() const {
+        return _skipUnobservedEnergies;
+    }
+
     void writeConfigToFile(File &file) {
         configGroup = std::make_unique<h5rd::Group>(file.createGroup("readdy/config"));
     }
@@ -269,8 +305,23 @@ public:
             }
             runInitialize();
             if (requiresNeighborList) runInitializeNeighborList();
-            runForces();
+            std::unique_ptr<model::actions::CompiledStep> compiledStep;
+            if (_useCompiledLoop) {
+                compiledStep = _kernel->actions().compiledStep(
+                        _integrator.get(), requiresNeighborList ? _updateNeighborList.get() : nullptr,
+                        _reactions.get(), _topologyReactions.get(), _forces.get());
+                if (!compiledStep) {
+                    log::debug("Kernel {} has no compiled step for the configured actions, performing them one by "
+                               "one", _kernel->name());
+                }
+            }
+            // leave the force action in its default mode, also if a step throws
+            struct ResetForcesMode {
+                SimulationLoop *loop;
+                ~ResetForcesMode() { if (loop->_forces) loop->setForcesMode(true); }
+            } resetForcesMode{this};
             TimeStep t = _start;
+            runForces(energyRequired(t));
             if(_makeCheckpoint) {
                 // this needs to happen before observables because observables can in principle influence the state
                 _makeCheckpoint->perform(t);
@@ -281,12 +332,17 @@ public:
             });
             while (continueFun(t)) {
                 runCompartments();
-                runIntegrator();
-                if (requiresNeighborList) runUpdateNeighborList();
-                runReactions();
-                runTopologyReactions();
-                if (requiresNeighborList) runUpdateNeighborList();
-                runForces();
+                if (compiledStep) {
+                    if (_forces) setForcesMode(energyRequired(t + 1));
+                    compiledStep->perform();
+                } else {
+                    runIntegrator();
+                    if (requiresNeighborList) runUpdateNeighborList();
+                    runReactions();
+                    runTopologyReactions();
+                    if (requiresNeighborList) runUpdateNeighborList();
+                    runForces(energyRequired(t + 1));
+                }
                 if(_makeCheckpoint && (t + 1) % _checkpointingStride == 0) {
                     // this needs to happen before observables because observables can in principle influence the state
                     _makeCheckpoint->perform(t + 1);
@@ -357,6 +413,8 @@ public:
         description += fmt::format(" - timeStep = {}\n", _timeStep);
         description += fmt::format(" - evaluateObservables = {}\n", _evaluateObservables);
         description += fmt::format(" - progressOutputStride = {}\n", _progressOutputStride);
+        description += fmt::format(" - compiled loop = {}\n", _useCompiledLoop);
+        description += fmt::format(" - skip unobserved energies = {}\n", _skipUnobservedEnergies);
         description += fmt::format(" - context written to file = {}\n", static_cast<bool>(configGroup));
         // todo let actions know their name?
         description += fmt::format(" - Performing actions:\n");
@@ -380,7 +438,7 @@ protected:
     std::shared_ptr<model::actions::InitializeKernel> _initializeKernel{nullptr};
     std::shared_ptr<model::actions::TimeStepDependentAction> _integrator{nullptr};
     std::shared_ptr<model::actions::EvaluateCompartments> _compartments{nullptr};
-    std::shared_ptr<model::actions::Action> _forces{nullptr};
+    std::shared_ptr<model::actions::CalculateForces> _forces{nullptr};
     std::shared_ptr<model::actions::TimeStepDependentAction> _reactions{nullptr};
     std::shared_ptr<model::actions::CreateNeighborList> _initNeighborList{nullptr};
     std::shared_ptr<model::actions::UpdateNeighborList> _updateNeighborList{nullptr};
@@ -390,6 +448,8 @@ protected:
     std::shared_ptr<h5rd::Group> configGroup{nullptr};
 
     bool _evaluateObservables = true;
+    bool _useCompiledLoop = false;
+    bool _skipUnobservedEnergies = false;
     TimeStep _start = 0;
     std::size_t _progressOutputStride = 100;
     std::size_t _checkpointingStride = 10000;
@@ -397,6 +457,16 @@ protected:
     scalar _timeStep;
 
     std::vector<std::function<void(TimeStep)>> _callbacks;
+
+private:
+    [[nodiscard]] bool energyRequired(TimeStep t) const {
+        return !_skipUnobservedEnergies || _kernel->energyRequired(t);
+    }
+
+    void setForcesMode(bool computeEnergy) {
+        _forces->mode() = computeEnergy ? model::actions::CalculateForces::Mode::forcesAndEnergy
+                                        : model::actions::CalculateForces::Mode::forces;
+    }
 };
 
 }
@@ -59,10 +59,19 @@ namespace readdy {
 
 constexpr inline std::size_t operator "" _z(unsigned long long n) { return n; }
 
+#ifdef READDY_SINGLE_PRECISION
+using scalar = float;
+#else
 using scalar = double;
+#endif
+/**
+ * Type of quantities that are summed up over all particles, i.e., energies and the virial. They are kept in double
+ * precision also when particle positions and forces are stored in single precision.
+ */
+using ScalarAccumulator = double;
 using Stride = std::uint32_t;
 using Vec3 = _internal::ReaDDyVec3<scalar>;
-using Matrix33 = _internal::ReaDDyMatrix33<scalar>;
+using Matrix33 = _internal::ReaDDyMatrix33<ScalarAccumulator>;
 using DiffusionConstant = scalar;
 using TimeStep = unsigned long;
 using ParticleTypeId = unsigned short;
@@ -368,6 +368,56 @@ public:
         return _backing_vector.crend();
     }
 
+    /**
+     * Yields a pointer to the element that the next push_back will overwrite, or nullptr if there are no blanks.
+     * This allows to recycle the resources held by a deactivated element before it is replaced.
+     * @return pointer to the next blank element or nullptr
+     */
+    T *next_blank() {
+        return _blanks.empty() ? nullptr : &_backing_vector.at(_blanks.back());
+    }
+
+    /**
+     * Removes all blanks from this container by moving the active elements to the front, preserving their order.
+     * Each blank element is handed to the callback before it is dropped, so that its resources can be recycled.
+     * Afterwards, all indices into this container are invalidated and have to be translated with the returned
+     * mapping.
+     * @tparam Removed callback type, invoked as removed(T&&)
+     * @param removed the callback
+     * @return a mapping old index -> new index, with -1 for indices that were blanks
+     */
+    template<typename Removed>
+    std::vector<std::ptrdiff_t> compact(Removed &&removed) {
+        std::vector<std::ptrdiff_t> mapping(_backing_vector.size(), -1);
+        std::vector<bool> isBlank(_backing_vector.size(), false);
+        for (auto blank : _blanks) {
+            isBlank[blank] = true;
+        }
+        std::size_t next = 0;
+        for (std::size_t i = 0; i < _backing_vector.size(); ++i) {
+            if (isBlank[i]) {
+                removed(std::move(_backing_vector[i]));
+            } else {
+                if (next != i) {
+                    _backing_vector[next] = std::move(_backing_vector[i]);
+                }
+                mapping[i] = static_cast<std::ptrdiff_t>(next);
+                ++next;
+            }
+        }
+        _backing_vector.erase(_backing_vector.begin() + next, _backing_vector.end());
+        _blanks.clear();
+        return mapping;
+    }
+
+    /**
+     * Removes all blanks from this container, see compact(Removed&&).
+     * @return a mapping old index -> new index, with -1 for indices that were blanks
+     */
+    std::vector<std::ptrdiff_t> compact() {
+        return compact([](T &&) {});
+    }
+
 private:
 
     /**
@@ -87,21 +87,41 @@ public:
     void configure(const readdy::conf::cpu::Configuration &configuration) {
         const auto& nl = configuration.neighborList;
         _neighborListCellRadius = nl.cll_radius;
+        _reorderInterval = nl.reorder_interval;
+        _reorderThreshold = static_cast<scalar>(nl.reorder_threshold);
     }
 
     std::vector<Vec3> getParticlePositions() const override;
 
     std::vector<particle_type> getParticles() const override;
 
+    void forEachParticle(const ParticleVisitor &visitor) const override;
+
+    void updateParticlePositions(const ParticlePositionUpdate &update) override;
+
     void initializeNeighborList(scalar interactionDistance) override {
         _neighborList->setUp(interactionDistance, _neighborListCellRadius);
         _neighborList->update();
+        if (reorderDue()) {
+            reorderParticles();
+        }
     };
 
     void updateNeighborList() override {
-        _neighborList->update();
+        if (reorderDue()) {
+            reorderParticles();
+        } else {
+            _neighborList->update();
+        }
     };
 
+    /**
+     * Sorts the particles along a space-filling curve so that spatially close particles are close in memory, and
+     * rebuilds the neighbor list. Particle indices held by topologies are translated through the reorder signal of
+     * the particle data, all other particle indices are invalidated.
+     */
+    void reorderParticles();
+
     void addParticle(const particle_type &p) override {
         getParticleData()->addParticle(p);
     };
@@ -134,19 +154,19 @@ public:
         return _observableData.virial;
     }
     
-    scalar energy() const override {
+    ScalarAccumulator energy() const override {
         return _observableData.energy;
     };
 
-    scalar &energy() override {
+    ScalarAccumulator &energy() override {
         return _observableData.energy;
     };
 
-    scalar time() const override {
+    ScalarAccumulator time() const override {
         return _observableData.time;
     };
 
-    void setTime(scalar t) override {
+    void setTime(ScalarAccumulator t) override {
         _observableData.time = t;
     };
 
@@ -238,7 +258,37 @@ public:
         return _topologies;
     };
 
-    void insert_topology(topology&& top);
+    /**
+     * Inserts a topology into the topology container and updates the topology indices of its particles. A
+     * deactivated topology in the slot that is reused goes to the recycling pool.
+     * @param top the topology
+     * @return a pointer to the inserted topology
+     */
+    topology *insert_topology(topology&& top);
+
+    /**
+     * Yields an empty topology of the given type to build a new topology into. If the recycling pool is not empty,
+     * the storage of a deactivated topology is taken over, so that building the graph does not reallocate its vertex
+     * list and particle to vertex index.
+     * @param type the topology type
+     * @return the empty topology
+     */
+    topology spareTopology(TopologyTypeId type);
+
+    /**
+     * @return a provider for structural topology reactions that builds the resulting topologies into spare ones
+     */
+    readdy::model::top::TopologyProvider topologyProvider() {
+        return [this](TopologyTypeId type) { return spareTopology(type); };
+    }
+
+    /**
+     * Removes deactivated topologies from the topology container once they make up at least half of it, translating
+     * the particles' topology indices accordingly. Pointers to active topologies stay valid, indices do not. The
+     * removed topology objects are kept in a bounded pool for recycling by spareTopology.
+     * @param force compact regardless of the number of deactivated topologies
+     */
+    void compactTopologies(bool force = false);
 
     std::vector<readdy::model::top::GraphTopology *> getTopologies() override;
 
@@ -256,5 +306,21 @@ private:
     neighbor_list::cell_radius_type _neighborListCellRadius {1};
     std::reference_wrapper<const readdy::model::top::TopologyActionFactory> _topologyActionFactory;
     topologies_vec _topologies{};
+    readdy::signals::scoped_connection _reorderConnection;
+    std::size_t _reorderInterval{0};
+    std::size_t _updatesSinceReorder{0};
+    scalar _reorderThreshold{0};
+    // cell change fraction right after the last reordering, negative if there was none
+    scalar _localityAfterReorder{-1};
+    std::vector<topology_ref> _topologyPool{};
+    // number of vertex slots held by the pooled topologies
+    std::size_t _topologyPoolVertices{0};
+    static constexpr std::size_t topologyPoolCapacity = 1024;
+    static constexpr std::size_t topologyPoolVertexCapacity = 1 << 16;
+    static constexpr std::size_t minDeactivatedForCompaction = 64;
+
+    bool reorderDue();
+
+    void recycleTopology(topology_ref &&dead);
 };
 }
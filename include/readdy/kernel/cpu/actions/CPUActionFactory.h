@@ -92,6 +92,13 @@ public:
     makeCheckpoint(std::string base, std::size_t maxNSaves) const override;
 
     std::unique_ptr<model::actions::InitializeKernel> initializeKernel() const override;
+
+    std::unique_ptr<model::actions::CompiledStep>
+    compiledStep(model::actions::TimeStepDependentAction *integrator,
+                 model::actions::UpdateNeighborList *updateNeighborList,
+                 model::actions::TimeStepDependentAction *reactionScheduler,
+                 model::actions::top::EvaluateTopologyReactions *topologyReactions,
+                 model::actions::CalculateForces *forces) const override;
 };
 
 }
@@ -53,15 +53,34 @@ public:
     explicit CPUBreakBonds(CPUKernel *kernel, scalar timeStep, readdy::model::actions::top::BreakConfig config)
             : BreakBonds(timeStep, std::move(config)), kernel(kernel) {}
 
-    void perform() override {
-        auto &topologies = kernel->getCPUKernelStateModel().topologies();
-        auto &model = kernel->getCPUKernelStateModel();
-        auto &particleData = *(kernel->getCPUKernelStateModel().getParticleData());
-        genericPerform(topologies, model, kernel, particleData);
-    }
+    void perform() override;
 
 private:
+    struct BreakableBond {
+        scalar thresholdEnergy;
+        scalar rate;
+    };
+
+    struct BondCandidate {
+        std::size_t particle1, particle2;
+        std::size_t breakableIdx;
+        scalar energy;
+    };
+
+    struct BrokenBond {
+        std::size_t topologyIdx;
+        std::size_t particle1, particle2;
+    };
+
+    void indexBreakableTypes();
+
+    void gatherBrokenBonds(std::size_t topologyBegin, std::size_t topologyEnd, std::vector<BrokenBond> &broken) const;
+
     CPUKernel *kernel;
+    // dense (type1, type2) -> index into _breakable, -1 if bonds between the two types cannot break
+    std::vector<std::ptrdiff_t> _breakableIndex;
+    std::vector<BreakableBond> _breakable;
+    std::size_t _nTypes{0};
 };
 
 }
@@ -43,6 +43,7 @@
 #pragma once
 
 #include <readdy/model/actions/Actions.h>
+#include <readdy/model/potentials/PotentialGrid.h>
 #include <readdy/kernel/cpu/CPUKernel.h>
 #include <readdy/common/thread/barrier.h>
 
@@ -61,24 +62,35 @@ public:
 
     void perform() override;
 
+    /**
+     * Evaluation for a fixed mode and virial flag, perform() dispatches to this and the compiled step calls it directly.
+     * It is instantiated for all combinations.
+     */
+    template<Mode MODE, bool COMPUTE_VIRIAL>
+    void performImpl();
+
 protected:
 
-    template<bool COMPUTE_VIRIAL>
+    template<Mode MODE, bool COMPUTE_VIRIAL>
     static void calculateOrder2(std::size_t, nl_bounds nlBounds, CPUStateModel::data_type *data,
-                                const CPUStateModel::neighbor_list &nl, std::promise<scalar> &energyPromise,
+                                const CPUStateModel::neighbor_list &nl, std::promise<ScalarAccumulator> &energyPromise,
                                 std::promise<Matrix33> &virialPromise,
-                                model::potentials::PotentialRegistry::PotentialsO2Map pot2,
+                                const model::potentials::PotentialRegistry::PotentialsO2Map &pot2,
                                 model::Context::BoxSize box, model::Context::PeriodicBoundaryConditions pbc);
 
+    template<Mode MODE>
     static void calculateTopologies(std::size_t /*tid*/, top_bounds topBounds, model::top::TopologyActionFactory *taf,
-                                    std::promise<scalar> &energyPromise);
-
+                                    CPUStateModel::data_type *data, std::promise<ScalarAccumulator> &energyPromise);
 
+    template<Mode MODE>
     static void calculateOrder1(std::size_t /*tid*/, data_bounds dataBounds,
-                                std::promise<scalar> &energyPromise, CPUStateModel::data_type *data,
-                                model::potentials::PotentialRegistry::PotentialsO1Map pot1);
+                                std::promise<ScalarAccumulator> &energyPromise, CPUStateModel::data_type *data,
+                                const model::potentials::PotentialRegistry::PotentialsO1Map &pot1,
+                                const model::potentials::PotentialGrid *grid);
 
     CPUKernel *const kernel;
+    // built on first use if a grid spacing is configured and whenever the potentials, the box or the spacing change
+    std::unique_ptr<model::potentials::PotentialGrid> potentialGrid;
 };
 }
 }
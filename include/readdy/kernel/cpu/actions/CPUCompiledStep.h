@@ -0,0 +1,110 @@
+/********************************************************************
+ * Copyright © 2018 Computational Molecular Biology Group,          *
+ *                  Freie Universität Berlin (GER)                  *
+ *                                                                  *
+ * Redistribution and use in source and binary forms, with or       *
+ * without modification, are permitted provided that the            *
+ * following conditions are met:                                    *
+ *  1. Redistributions of source code must retain the above         *
+ *     copyright notice, this list of conditions and the            *
+ *     following disclaimer.                                        *
+ *  2. Redistributions in binary form must reproduce the above      *
+ *     copyright notice, this list of conditions and the following  *
+ *     disclaimer in the documentation and/or other materials       *
+ *     provided with the distribution.                              *
+ *  3. Neither the name of the copyright holder nor the names of    *
+ *     its contributors may be used to endorse or promote products  *
+ *     derived from this software without specific                  *
+ *     prior written permission.                                    *
+ *                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND           *
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,      *
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF         *
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE         *
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR            *
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,         *
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER *
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,      *
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)    *
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF      *
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
+ ********************************************************************/
+
+
+/**
+ * The compiled step of the CPU kernel performs the integrator, the neighbor list updates, the reactions, the topology
+ * reactions and the force evaluation of one time step. Which of these are performed, the reaction scheduler and the
+ * recording flags of the context are template parameters of the step function, which is selected once when the step
+ * is created. Per step there is a single indirect call instead of one virtual call per phase plus the flag checks
+ * inside of each action.
+ *
+ * @file CPUCompiledStep.h
+ * @brief CPU kernel declaration of the compiled simulation step
+ * @author EricArkfeld
+ * @date 19.10.26
+ * @copyright BSD-3
+ */
+
+#pragma once
+
+#include <array>
+
+#include <readdy/kernel/cpu/CPUKernel.h>
+#include <readdy/kernel/cpu/actions/CPUEulerBDIntegrator.h>
+#include <readdy/kernel/cpu/actions/CPUCreateNeighborList.h>
+#include <readdy/kernel/cpu/actions/CPUCalculateForces.h>
+#include <readdy/kernel/cpu/actions/CPUEvaluateTopologyReactions.h>
+#include <readdy/kernel/cpu/actions/reactions/CPUGillespie.h>
+#include <readdy/kernel/cpu/actions/reactions/CPUUncontrolledApproximation.h>
+
+namespace readdy::kernel::cpu::actions {
+
+class CPUCompiledStep : public readdy::model::actions::CompiledStep {
+    using Mode = readdy::model::actions::CalculateForces::Mode;
+public:
+    /**
+     * Creates the step for the current configuration of the context. Null actions are not performed.
+     * @param kernel the kernel
+     * @param integrator the integrator
+     * @param updateNeighborList the neighbor list update, performed after the integrator and after the reactions
+     * @param gillespie the reaction scheduler if it is Gillespie, otherwise null
+     * @param uncontrolledApproximation the reaction scheduler if it is UncontrolledApproximation, otherwise null
+     * @param topologyReactions the topology reactions
+     * @param forces the force evaluation, its mode is read in every step
+     */
+    CPUCompiledStep(CPUKernel *kernel, CPUEulerBDIntegrator *integrator, CPUUpdateNeighborList *updateNeighborList,
+                    reactions::CPUGillespie *gillespie,
+                    reactions::CPUUncontrolledApproximation *uncontrolledApproximation,
+                    top::CPUEvaluateTopologyReactions *topologyReactions, CPUCalculateForces *forces);
+
+    void perform() override {
+        (this->*_step)();
+    }
+
+private:
+    // the flags in the order of the template parameters of step()
+    static constexpr std::size_t nFlags = 6;
+
+    template<typename Reactions, bool RECORD_COUNTS, bool RECORD_POSITIONS, bool COMPUTE_VIRIAL, bool NEIGHBOR_LIST,
+             bool TOPOLOGY_REACTIONS, bool FORCES>
+    void step();
+
+    template<typename Reactions, bool... FLAGS>
+    void selectStep(const std::array<bool, nFlags> &flags);
+
+    template<typename Reactions>
+    Reactions *reactionScheduler() const;
+
+    CPUKernel *const kernel;
+    CPUEulerBDIntegrator *const integrator;
+    CPUUpdateNeighborList *const updateNeighborList;
+    reactions::CPUGillespie *const gillespie;
+    reactions::CPUUncontrolledApproximation *const uncontrolledApproximation;
+    top::CPUEvaluateTopologyReactions *const topologyReactions;
+    CPUCalculateForces *const forces;
+    void (CPUCompiledStep::*_step)() {nullptr};
+};
+
+}
@@ -43,6 +43,7 @@
 #pragma once
 #include <readdy/kernel/singlecpu/actions/SCPUEvaluateCompartments.h>
 #include <readdy/kernel/cpu/CPUKernel.h>
+#include <readdy/model/compartments/CompartmentGrid.h>
 
 namespace readdy {
 namespace kernel {
@@ -57,6 +58,8 @@ public:
 
 protected:
     CPUKernel *const kernel;
+    // built on first use and whenever compartments, particle types or the box change
+    std::unique_ptr<readdy::model::compartments::CompartmentGrid> grid;
 };
 
 }
@@ -69,6 +69,9 @@ private:
 
     topology_reaction_events gatherEvents();
 
+    void gatherSpatialEvents(std::size_t cellBegin, std::size_t cellEnd, topology_reaction_events &events,
+                             readdy::model::top::Graph::DistanceScratch &scratch) const;
+
     bool topologyDeactivated(std::ptrdiff_t index) const;
 
     void handleStructuralReactionEvent(CPUStateModel::topologies_vec &topologies,
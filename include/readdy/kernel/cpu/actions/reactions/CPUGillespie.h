@@ -64,6 +64,13 @@ public:
 
     void perform() override;
 
+    /**
+     * Reaction handling with the recording flags of the context as template parameters, perform() dispatches to this
+     * and the compiled step calls it directly. It is instantiated for all combinations.
+     */
+    template<bool RECORD_COUNTS, bool RECORD_POSITIONS>
+    void performImpl();
+
 protected:
     CPUKernel *const kernel;
 };
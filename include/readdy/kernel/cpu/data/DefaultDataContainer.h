@@ -48,6 +48,7 @@
 #include <readdy/model/Particle.h>
 #include <readdy/kernel/cpu/pool.h>
 #include <readdy/common/boundary_condition_operations.h>
+#include <readdy/common/signals.h>
 #include "DataContainer.h"
 
 namespace readdy {
@@ -63,6 +64,7 @@ class DefaultDataContainer : public EntryDataContainer {
 public:
 
     using entry_type = typename super::Entries::value_type;
+    using reorder_signal_type = readdy::signals::signal<void(const std::vector<size_type> &)>;
 
     explicit DefaultDataContainer(EntryDataContainer *entryDataContainer)
             : DataContainer(entryDataContainer->context(), entryDataContainer->pool()) {
@@ -145,58 +147,102 @@ public:
                          _context.get().periodicBoundaryConditions().data());
     };
 
-    /*void hilbertSort(scalar gridWidth) {
-        if(!empty()) {
-            using indices_it = std::vector<std::size_t>::iterator;
-            std::vector<std::size_t> hilbert_indices;
-            std::vector<std::size_t> indices(size());
-
-            const auto grainSize = size() / _pool.get().size();
-            std::iota(indices.begin(), indices.end(), 0);
-            hilbert_indices.resize(size());
-
-            auto worker = [&](std::size_t, const_iterator begin, const_iterator end, indices_it hilbert_begin) {
-                {
-                    auto it = begin;
-                    auto hilbert_it = hilbert_begin;
-                    for (; it != end; ++it, ++hilbert_it) {
-                        if (!it->deactivated) {
-                            const auto integer_coordinates = project(it->pos, gridWidth);
-                            *hilbert_it = 1 + static_cast<std::size_t>(hilbert_c2i(3, CHAR_BIT, integer_coordinates.data()));
-                        } else {
-                            *hilbert_it = 0;
+    /**
+     * Sorts the particles along a Morton (Z-order) curve with the given grid width and drops all blanks, so that
+     * particles which are close in space are also close in memory. Afterwards the reorder signal is fired with the
+     * mapping old index -> new index, deactivated entries are mapped to the maximal size_type value.
+     * @param gridWidth the widths of the grid that is used to discretize positions
+     */
+    void mortonSort(const Vec3 &gridWidth) {
+        const auto nEntries = size();
+        auto &pool = _pool.get();
+        const auto nThreads = std::max<std::size_t>(pool.size(), 1);
+        const auto grainSize = std::max<std::size_t>(nEntries / nThreads, 1);
+        const auto &boxSize = _context.get().boxSize();
+
+        // (key, old index) for every entry, deactivated entries get the largest key and end up at the back
+        std::vector<std::tuple<std::uint64_t, size_type>> keys(nEntries);
+        std::vector<std::tuple<size_type, size_type>> chunks;
+        for (std::size_t t = 0; t < nThreads && t * grainSize < nEntries; ++t) {
+            const auto begin = t * grainSize;
+            chunks.emplace_back(begin, t == nThreads - 1 ? nEntries : std::min(begin + grainSize, nEntries));
+        }
+        if (!chunks.empty()) {
+            std::get<1>(chunks.back()) = nEntries;
+        }
+        {
+            auto worker = [&](std::size_t, size_type begin, size_type end) {
+                for (auto i = begin; i < end; ++i) {
+                    const auto &entry = _entries[i];
+                    std::uint64_t key = std::numeric_limits<std::uint64_t>::max();
+                    if (!entry.deactivated) {
+                        key = 0;
+                        for (std::uint8_t d = 0; d < 3; ++d) {
+                            const scalar cell = std::floor((entry.pos[d] + .5 * boxSize[d]) / gridWidth[d]);
+                            const auto clamped = static_cast<std::uint64_t>(
+                                    std::clamp(cell, static_cast<scalar>(0), static_cast<scalar>(mortonMask)));
+                            key |= spreadBits(clamped) << d;
                         }
                     }
+                    keys[i] = std::make_tuple(key, i);
                 }
+                std::sort(keys.begin() + begin, keys.begin() + end);
             };
-            {
-                std::vector<util::thread::joining_future<void>> futures;
-                futures.reserve(_pool.get().size());
-                auto data_it = begin();
-                auto hilberts_it = hilbert_indices.begin();
-                for (std::size_t i = 0; i < _pool.get().size() - 1; ++i) {
-                    futures.emplace_back(_pool.get().push(worker, data_it, data_it + grainSize, hilberts_it));
-                    data_it += grainSize;
-                    hilberts_it += grainSize;
-                }
-                futures.emplace_back(_pool.get().push(worker, data_it, end(), hilberts_it));
+            std::vector<util::thread::joining_future<void>> futures;
+            futures.reserve(chunks.size());
+            for (const auto &[begin, end] : chunks) {
+                futures.emplace_back(pool.push(worker, begin, end));
             }
-            {
-                std::sort(indices.begin(), indices.end(),
-                          [&hilbert_indices](std::size_t i, std::size_t j) -> bool {
-                              return hilbert_indices[i] < hilbert_indices[j];
-                          });
+        }
+        // merge the sorted chunks pairwise
+        for (std::size_t width = 1; width < chunks.size(); width *= 2) {
+            for (std::size_t i = 0; i + width < chunks.size(); i += 2 * width) {
+                const auto last = std::min(i + 2 * width, chunks.size()) - 1;
+                std::inplace_merge(keys.begin() + std::get<0>(chunks[i]), keys.begin() + std::get<0>(chunks[i + width]),
+                                   keys.begin() + std::get<1>(chunks[last]));
             }
+        }
 
-            blanks_moved_to_front();
-            std::vector<std::size_t> inverseIndices(indices.size());
-            for(std::size_t i = 0; i < indices.size(); ++i) {
-                inverseIndices[indices[i]] = i;
-            }
-            reorderSignal->fire_signal(inverseIndices);
-            readdy::util::collections::reorder_destructive(inverseIndices.begin(), inverseIndices.end(), begin());
+        std::vector<size_type> oldToNew(nEntries, std::numeric_limits<size_type>::max());
+        const auto nActive = nEntries - getNDeactivated();
+        _reorderBuffer.clear();
+        _reorderBuffer.reserve(nActive);
+        for (size_type i = 0; i < nActive; ++i) {
+            const auto oldIndex = std::get<1>(keys[i]);
+            oldToNew[oldIndex] = i;
+            _reorderBuffer.push_back(std::move(_entries[oldIndex]));
         }
-    };*/
+        _entries.swap(_reorderBuffer);
+        _reorderBuffer.clear();
+        _blanks.clear();
+        _reorderSignal.fire_signal(oldToNew);
+    }
+
+    /**
+     * Signal that is fired after the particles were reordered, the argument is the mapping old index -> new index.
+     */
+    reorder_signal_type &reorderSignal() {
+        return _reorderSignal;
+    }
+
+private:
+    static constexpr std::uint64_t mortonMask = (static_cast<std::uint64_t>(1) << 21) - 1;
+
+    /**
+     * spreads the lower 21 bits of x so that there are two zero bits between each of them
+     */
+    static std::uint64_t spreadBits(std::uint64_t x) {
+        x &= mortonMask;
+        x = (x | x << 32) & 0x1f00000000ffffull;
+        x = (x | x << 16) & 0x1f0000ff0000ffull;
+        x = (x | x << 8) & 0x100f00f00f00f00full;
+        x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+        x = (x | x << 2) & 0x1249249249249249ull;
+        return x;
+    }
+
+    reorder_signal_type _reorderSignal;
+    Entries _reorderBuffer;
 
 };
 
@@ -55,8 +55,8 @@ struct ObservableData {
     readdy::model::reactions::ReactionCounts reactionCounts {};
     readdy::model::reactions::SpatialTopologyReactionCounts spatialReactionCounts {};
     readdy::model::reactions::StructuralTopologyReactionCounts structuralReactionCounts {};
-    scalar energy = 0;
-    scalar time = 0;
+    ScalarAccumulator energy = 0;
+    ScalarAccumulator time = 0;
     Matrix33 virial {};
 };
 
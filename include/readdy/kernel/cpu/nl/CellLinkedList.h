@@ -211,6 +211,22 @@ public:
     bool cellEmpty(std::size_t index) const {
         return (*_head.at(index)).load() == 0;
     };
+
+    /**
+     * Estimates how well the memory layout of the particles matches their spatial arrangement, as of the last update.
+     * @return the fraction of consecutive particles in memory that lie in different cells, 0 if nothing was binned
+     */
+    scalar cellChangeFraction() const {
+        const auto &[nCellChanges, nBinned] = _locality;
+        return nBinned > 1 ? static_cast<scalar>(nCellChanges) / static_cast<scalar>(nBinned - 1) : 0;
+    };
+
+    /**
+     * The width of the cells along each axis.
+     */
+    const Vec3 &cellSize() const {
+        return _cellSize;
+    };
 protected:
     void setUpBins() override;
 
@@ -223,6 +239,9 @@ protected:
 
     bool _serial{false};
 
+    // number of consecutive binned particles that lie in different cells and number of binned particles
+    std::tuple<std::size_t, std::size_t> _locality{0, 0};
+
 };
 
 class BoxIterator {
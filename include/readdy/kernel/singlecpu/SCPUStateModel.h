@@ -102,19 +102,19 @@ public:
         return getParticleData()->entry_at(index).type;
     }
 
-    scalar energy() const override {
+    ScalarAccumulator energy() const override {
         return _observableData.energy;
     }
 
-    scalar &energy() override {
+    ScalarAccumulator &energy() override {
         return _observableData.energy;
     }
 
-    scalar time() const override {
+    ScalarAccumulator time() const override {
         return _observableData.time;
     }
 
-    void setTime(scalar t) override {
+    void setTime(ScalarAccumulator t) override {
         _observableData.time = t;
     }
 
@@ -149,6 +149,10 @@ public:
 
     std::vector<readdy::model::Particle> getParticles() const override;
 
+    void forEachParticle(const ParticleVisitor &visitor) const override;
+
+    void updateParticlePositions(const ParticlePositionUpdate &update) override;
+
     std::vector<readdy::model::reactions::ReactionRecord>& reactionRecords() {
         return _observableData.reactionRecords;
     }
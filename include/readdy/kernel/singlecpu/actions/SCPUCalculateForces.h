@@ -68,18 +68,34 @@ public:
 
     void perform() override {
         const auto &context = kernel->context();
-        if(context.recordVirial()) {
-            performImpl<true>();
-        } else {
-            performImpl<false>();
+        switch (_mode) {
+            case Mode::forcesAndEnergy:
+                if (context.recordVirial()) {
+                    performImpl<Mode::forcesAndEnergy, true>();
+                } else {
+                    performImpl<Mode::forcesAndEnergy, false>();
+                }
+                break;
+            case Mode::forces:
+                if (context.recordVirial()) {
+                    performImpl<Mode::forces, true>();
+                } else {
+                    performImpl<Mode::forces, false>();
+                }
+                break;
+            case Mode::energy:
+                // the virial is made up of forces and therefore not available in the energy-only mode
+                performImpl<Mode::energy, false>();
+                break;
         }
-
     };
 
 private:
 
-    template<bool COMPUTE_VIRIAL>
+    template<Mode MODE, bool COMPUTE_VIRIAL>
     void performImpl() {
+        constexpr bool computeForces = MODE != Mode::energy;
+        constexpr bool computeEnergy = MODE != Mode::forces;
 
         const auto &context = kernel->context();
 
@@ -87,21 +103,35 @@ private:
         auto &data = *stateModel.getParticleData();
         auto &neighborList = *stateModel.getNeighborList();
 
-        stateModel.energy() = 0;
-        stateModel.virial() = Matrix33{{{0, 0, 0, 0, 0, 0, 0, 0, 0}}};
+        // in the forces-only mode, contributions are collected here and discarded
+        ScalarAccumulator discardedEnergy = 0;
+        auto &energy = computeEnergy ? stateModel.energy() : discardedEnergy;
+        energy = 0;
+        if constexpr (computeForces) {
+            stateModel.virial() = Matrix33{{{0, 0, 0, 0, 0, 0, 0, 0, 0}}};
+        }
 
         const auto &potentials = context.potentials();
         auto &topologies = stateModel.topologies();
-        if (!potentials.potentialsOrder1().empty() || !potentials.potentialsOrder2().empty() || !topologies.empty()) {
+        if (computeForces && (!potentials.potentialsOrder1().empty() || !potentials.potentialsOrder2().empty()
+                              || !topologies.empty())) {
             std::for_each(data.begin(), data.end(), [](auto &entry) {
                 entry.force = {0, 0, 0};
             });
         }
 
         auto order1eval = [&](auto &entry){
+            scalar myEnergy = 0;
             for (const auto &po1 : potentials.potentialsOf(entry.type)) {
-                po1->calculateForceAndEnergy(entry.force, stateModel.energy(), entry.position());
+                if constexpr (MODE == Mode::forcesAndEnergy) {
+                    po1->calculateForceAndEnergy(entry.force, myEnergy, entry.position());
+                } else if constexpr (MODE == Mode::forces) {
+                    po1->calculateForce(entry.force, entry.position());
+                } else {
+                    myEnergy += po1->calculateEnergy(entry.position());
+                }
             }
+            energy += myEnergy;
         };
 
         // order 2 eval
@@ -113,31 +143,49 @@ private:
             auto itPot = pots.find(neighborEntry.type);
             if (itPot != std::end(pots)) {
                 Vec3 forceVec{0, 0, 0};
+                scalar pairEnergy = 0;
                 auto x_ij = bcs::shortestDifference(entry.position(), neighborEntry.position(), box, pbc);
                 for (const auto &potential : itPot->second) {
-                    potential->calculateForceAndEnergy(forceVec, stateModel.energy(), x_ij);
+                    if constexpr (MODE == Mode::forcesAndEnergy) {
+                        potential->calculateForceAndEnergy(forceVec, pairEnergy, x_ij);
+                    } else if constexpr (MODE == Mode::forces) {
+                        potential->calculateForce(forceVec, x_ij);
+                    } else {
+                        pairEnergy += potential->calculateEnergy(x_ij);
+                    }
+                }
+                energy += pairEnergy;
+                if constexpr (computeForces) {
+                    entry.force += forceVec;
+                    neighborEntry.force -= forceVec;
+                    detail::computeVirial<COMPUTE_VIRIAL>(x_ij, forceVec, stateModel.virial());
                 }
-                entry.force += forceVec;
-                neighborEntry.force -= forceVec;
-                detail::computeVirial<COMPUTE_VIRIAL>(x_ij, forceVec, stateModel.virial());
             }
         };
 
 
         // topology eval
         auto taf = kernel->getTopologyActionFactory();
+        std::vector<Vec3> forceBackup;
         auto topologyEval = [&](auto &topology){
+            // the topology potential actions always update the forces, in the energy-only mode they are restored
+            const auto particles = computeForces ? decltype(topology->particleIndices()){}
+                                                 : topology->particleIndices();
+            forceBackup.clear();
+            for (auto particle : particles) {
+                forceBackup.push_back(data.entry_at(particle).force);
+            }
             for (const auto &bondedPot : topology->getBondedPotentials()) {
-                auto energy = bondedPot->createForceAndEnergyAction(taf)->perform(topology.get());
-                stateModel.energy() += energy;
+                energy += bondedPot->createForceAndEnergyAction(taf)->perform(topology.get());
             }
             for (const auto &anglePot : topology->getAnglePotentials()) {
-                auto energy = anglePot->createForceAndEnergyAction(taf)->perform(topology.get());
-                stateModel.energy() += energy;
+                energy += anglePot->createForceAndEnergyAction(taf)->perform(topology.get());
             }
             for (const auto &torsionPot : topology->getTorsionPotentials()) {
-                auto energy = torsionPot->createForceAndEnergyAction(taf)->perform(topology.get());
-                stateModel.energy() += energy;
+                energy += torsionPot->createForceAndEnergyAction(taf)->perform(topology.get());
+            }
+            for (std::size_t i = 0; i < particles.size(); ++i) {
+                data.entry_at(particles[i]).force = forceBackup[i];
             }
         };
 
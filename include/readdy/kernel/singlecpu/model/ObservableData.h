@@ -52,8 +52,8 @@ namespace readdy::kernel::scpu::model {
 
 struct ObservableData {
 
-    scalar energy = 0;
-    scalar time = 0;
+    ScalarAccumulator energy = 0;
+    ScalarAccumulator time = 0;
     std::vector<readdy::model::reactions::ReactionRecord> reactionRecords{};
     readdy::model::reactions::ReactionCounts reactionCounts {};
     readdy::model::reactions::SpatialTopologyReactionCounts spatialReactionCounts {};
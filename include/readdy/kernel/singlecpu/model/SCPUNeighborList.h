@@ -83,7 +83,7 @@ public:
             auto desiredWidth = static_cast<scalar>((_cutoff) / static_cast<scalar>(radius));
             std::array<std::size_t, 3> dims{};
             for (int i = 0; i < 3; ++i) {
-                dims[i] = static_cast<unsigned int>(std::max(1., std::floor(size[i] / desiredWidth)));
+                dims[i] = static_cast<unsigned int>(std::max(static_cast<scalar>(1.), std::floor(size[i] / desiredWidth)));
                 _cellSize[i] = size[i] / static_cast<scalar>(dims[i]);
             }
 
@@ -47,6 +47,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <list>
 #include <map>
 #include <iostream>
 #include <utility>
@@ -119,6 +121,14 @@ public:
      */
     virtual readdy::signals::scoped_connection connectObservable(observables::ObservableBase *observable) {
         observable->initialize(this);
+        if (observable->requiresEnergy()) {
+            // the observable is tracked as long as its slot exists, i.e., until the connection is released
+            auto it = _energyObservables.insert(_energyObservables.end(), observable);
+            std::shared_ptr<void> tracker(nullptr, [this, it](void *) { _energyObservables.erase(it); });
+            return _signal.connect_scoped([observable, tracker](const TimeStep t) {
+                observable->call(t);
+            });
+        }
         return _signal.connect_scoped([observable](const TimeStep t) {
             observable->call(t);
         });
@@ -131,6 +141,18 @@ public:
         _signal(t);
     }
 
+    /**
+     * Whether one of the connected observables that are due at time step t reads the energy of the state model.
+     * This includes registered observables, as they are connected as well.
+     * @param t the time step
+     * @return true if the energy has to be computed for time step t
+     */
+    bool energyRequired(TimeStep t) const {
+        return std::any_of(_energyObservables.begin(), _energyObservables.end(), [t](const auto *observable) {
+            return observable->shouldEvaluate(t);
+        });
+    }
+
     /**
      * Returns a vector containing all available action names for this specific kernel instance.
      *
@@ -229,6 +251,8 @@ public:
 protected:
     model::Context _context;
     std::string _name;
+    // declared before the signal, so that it outlives the slots that remove themselves from it
+    std::list<const observables::ObservableBase *> _energyObservables{};
     observables::signal_type _signal;
     ObservableContainer _observables{};
     ConnectionContainer _observableConnections{};
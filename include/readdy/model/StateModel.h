@@ -44,6 +44,7 @@
 
 #pragma once
 #include <vector>
+#include <functional>
 #include <readdy/model/topologies/GraphTopology.h>
 #include "Particle.h"
 #include "readdy/common/ReaDDyVec3.h"
@@ -52,6 +53,9 @@ namespace readdy::model {
 
 class StateModel {
 public:
+    using ParticleVisitor = std::function<void(ParticleTypeId type, ParticleId id, const Vec3 &pos,
+                                               const Vec3 &force)>;
+    using ParticlePositionUpdate = std::function<void(ParticleTypeId type, ParticleId id, Vec3 &pos)>;
 
     StateModel() = default;
 
@@ -74,6 +78,21 @@ public:
 
     [[nodiscard]] virtual ParticleTypeId getParticleType(std::size_t index) const = 0;
 
+    /**
+     * Visits all active particles in storage order, which is the order of getParticles(). Kernels override this to
+     * read their particle storage directly instead of copying it. The order is stable until particles are added,
+     * removed, or the neighbor list is updated.
+     * @param visitor called with type, id, position and force of each particle
+     */
+    virtual void forEachParticle(const ParticleVisitor &visitor) const;
+
+    /**
+     * Lets `update` modify the position of every active particle, in the order of forEachParticle(). Positions are
+     * wrapped back into the simulation box afterwards. The neighbor list is not updated.
+     * @param update called with type, id and a mutable reference to the position of each particle
+     */
+    virtual void updateParticlePositions(const ParticlePositionUpdate &update);
+
     /**
      * Initialize the neighbor list such that all particle-particle interactions
      * that are shorter than the given interactionDistance can be considered. Usually this distance is the largest cutoff distance
@@ -103,13 +122,13 @@ public:
 
     virtual void removeAllParticles() = 0;
 
-    [[nodiscard]] virtual scalar energy() const = 0;
+    [[nodiscard]] virtual ScalarAccumulator energy() const = 0;
 
-    virtual scalar &energy() = 0;
+    virtual ScalarAccumulator &energy() = 0;
 
-    [[nodiscard]] virtual scalar time() const = 0;
+    [[nodiscard]] virtual ScalarAccumulator time() const = 0;
 
-    virtual void setTime(scalar t) = 0;
+    virtual void setTime(ScalarAccumulator t) = 0;
 
     virtual void toDenseParticleIndices(std::vector<std::size_t>::iterator begin,
                                         std::vector<std::size_t>::iterator end) const = 0;
@@ -129,6 +129,18 @@ public:
     virtual std::unique_ptr<MakeCheckpoint> makeCheckpoint(std::string base, std::size_t maxNSaves) const = 0;
 
     virtual std::unique_ptr<InitializeKernel> initializeKernel() const = 0;
+
+    /**
+     * Fuses the given actions of this kernel into one compiled step. The context must be configured. Null actions are
+     * skipped, the mode of the force action is respected in every step.
+     * @return the compiled step or nullptr if the kernel cannot compile this combination of actions
+     */
+    virtual std::unique_ptr<CompiledStep>
+    compiledStep(TimeStepDependentAction * /*integrator*/, UpdateNeighborList * /*updateNeighborList*/,
+                 TimeStepDependentAction * /*reactions*/, top::EvaluateTopologyReactions * /*topologyReactions*/,
+                 CalculateForces * /*forces*/) const {
+        return nullptr;
+    }
 };
 
 }
@@ -109,12 +109,25 @@ public:
 /**
  * Calculates all forces and energies resulting from potentials (external, pair-potentials, bonded).
  * Optionally calculate the virial which is required if the pressure in the system shall be measured.
+ * Depending on the mode, only the forces (leaving the energy of the state model as it was) or only the energy
+ * (leaving the forces untouched) are evaluated.
  */
 class CalculateForces : public Action {
 public:
+    enum class Mode {
+        forcesAndEnergy, forces, energy
+    };
+
     CalculateForces();
 
     ~CalculateForces() override = default;
+
+    Mode &mode() { return _mode; }
+
+    [[nodiscard]] Mode mode() const { return _mode; }
+
+protected:
+    Mode _mode{Mode::forcesAndEnergy};
 };
 
 class CreateNeighborList : public Action {
@@ -137,6 +150,15 @@ class UpdateNeighborList : public Action {
 class ClearNeighborList : public Action {
 };
 
+/**
+ * One time step from the integrator up to and including the force evaluation, i.e., integrator, neighbor list update,
+ * reactions, topology reactions, neighbor list update and forces, with the configuration of the context fixed at
+ * creation. Kernels can specialize the whole step for that configuration at compile time, see
+ * ActionFactory::compiledStep(). It has to be recreated when the context or the actions change.
+ */
+class CompiledStep : public Action {
+};
+
 namespace reactions {
 
 class UncontrolledApproximation : public TimeStepDependentAction {
@@ -270,12 +292,16 @@ protected:
             ++topologyIdx;
         }
 
-        const auto &context = kernel->context();
+        insertResultingTopologies(model, kernel, resultingTopologies);
+    }
+
+    template<typename Kernel, typename Model>
+    void insertResultingTopologies(Model &model, Kernel *kernel,
+                                   std::vector<readdy::model::top::GraphTopology> &resultingTopologies) const {
         for (auto &&newTopology : resultingTopologies) {
             if (!newTopology.isNormalParticle(*kernel)) {
                 // we have a new topology here, update data accordingly.
-                newTopology.updateReactionRates(
-                        context.topologyRegistry().structuralReactionsOf(newTopology.type()));
+                newTopology.invalidateReactionRates();
                 newTopology.configure();
                 model.insert_topology(std::move(newTopology));
             } else {
@@ -400,12 +426,10 @@ protected:
             ++topologyIdx;
         }
 
-        const auto &context = kernel->context();
         for (auto &&newTopology : resultingTopologies) {
             if (!newTopology.isNormalParticle(*kernel)) {
                 // Update data for new topology
-                newTopology.updateReactionRates(
-                        context.topologyRegistry().structuralReactionsOf(newTopology.type()));
+                newTopology.invalidateReactionRates();
                 newTopology.configure();
                 model.insert_topology(std::move(newTopology));
             } else {
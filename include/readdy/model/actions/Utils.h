@@ -43,11 +43,45 @@
 
 #pragma once
 
+#include <map>
+
 #include <readdy/model/topologies/reactions/StructuralTopologyReaction.h>
+#include <readdy/model/topologies/GraphTopology.h>
 #include <readdy/common/index_persistent_vector.h>
 
 namespace readdy::model::actions::top {
 
+/**
+ * Re-evaluates the structural reaction rates of all active topologies whose rates were invalidated. The topologies
+ * are grouped by type so that each reaction's (batch) rate function is called once per type.
+ * @param topologies container of (smart) pointers to the topologies
+ * @param registry the topology registry
+ */
+template<typename Topologies>
+void updateStructuralReactionRates(Topologies &topologies, const readdy::model::top::TopologyRegistry &registry) {
+    using GraphTopology = readdy::model::top::GraphTopology;
+    std::map<TopologyTypeId, std::vector<GraphTopology *>> dirty;
+    for (auto &topology : topologies) {
+        if (!topology->isDeactivated() && topology->reactionRatesDirty()) {
+            dirty[topology->type()].push_back(topology.get());
+        }
+    }
+    for (const auto &[type, dirtyTopologies] : dirty) {
+        const auto &reactions = registry.structuralReactionsOf(type);
+        std::vector<const GraphTopology *> view(dirtyTopologies.begin(), dirtyTopologies.end());
+        std::vector<GraphTopology::ReactionRates> rates(view.size(), GraphTopology::ReactionRates(reactions.size()));
+        for (std::size_t r = 0; r < reactions.size(); ++r) {
+            auto reactionRates = reactions[r].rates(view);
+            for (std::size_t i = 0; i < view.size(); ++i) {
+                rates[i][r] = reactionRates[i];
+            }
+        }
+        for (std::size_t i = 0; i < view.size(); ++i) {
+            dirtyTopologies[i]->setReactionRates(std::move(rates[i]));
+        }
+    }
+}
+
 template<typename Kernel, typename Topology, typename TopologyRef, typename ParticleData>
 void executeStructuralReaction(readdy::util::index_persistent_vector<TopologyRef> &topologies,
                                std::vector<Topology> &newTopologies,
@@ -55,28 +89,27 @@ void executeStructuralReaction(readdy::util::index_persistent_vector<TopologyRef
                                const readdy::model::top::reactions::StructuralTopologyReaction &reaction,
                                std::size_t topologyIdx,
                                ParticleData &particleData,
-                               Kernel *kernel) {
-    auto result = reaction.execute(*topology, kernel);
-    if (!result.empty()) {
-        // we had a topology fission, so we need to actually remove the current topology from the
-        // data structure
-        topologies.erase(topologies.begin() + topologyIdx);
-        assert(topology->isDeactivated());
-        for (auto &it : result) {
-            if (!it.isNormalParticle(*kernel)) {
-                newTopologies.push_back(std::move(it));
-            }
+                               Kernel *kernel,
+                               const readdy::model::top::TopologyProvider &provider = {}) {
+    auto result = reaction.execute(*topology, kernel, provider);
+    // we had a topology fission, the split off components become new topologies while the current topology keeps
+    // the largest component
+    for (auto &it : result) {
+        if (!it.isNormalParticle(*kernel)) {
+            newTopologies.push_back(std::move(it));
+        } else {
+            auto vertex = it.graph().vertices().begin();
+            particleData.entry_at((*vertex)->particleIndex).topology_index = -1;
         }
-    } else {
-        if (topology->isNormalParticle(*kernel)) {
-            auto it = topology->graph().vertices().begin();
-            if(it == topology->graph().vertices().end()) {
-                throw std::runtime_error("Topology had size 1 but no active vertices!");
-            }
-            particleData.entry_at((*it)->particleIndex).topology_index = -1;
-            topologies.erase(topologies.begin() + topologyIdx);
-            assert(topology->isDeactivated());
+    }
+    if (topology->isNormalParticle(*kernel)) {
+        auto it = topology->graph().vertices().begin();
+        if(it == topology->graph().vertices().end()) {
+            throw std::runtime_error("Topology had size 1 but no active vertices!");
         }
+        particleData.entry_at((*it)->particleIndex).topology_index = -1;
+        topologies.erase(topologies.begin() + topologyIdx);
+        assert(topology->isDeactivated());
     }
 }
 
@@ -62,8 +62,26 @@ public:
             : typeName(std::move(typeName)), uniqueName(std::move(uniqueName)),
               conversions(std::move(conversions)), _id(counter++) {}
 
+    /**
+     * Result of classifying a region of space against a compartment.
+     */
+    enum class Containment {
+        inside, outside, boundary
+    };
+
     virtual bool isContained(const Vec3 &position) const = 0;
 
+    /**
+     * Classifies the ball with given center and radius: `inside` if isContained holds everywhere in it, `outside` if it
+     * holds nowhere, `boundary` otherwise. Implementations may always answer `boundary`, which is conservative.
+     * @param center the center of the ball
+     * @param radius the radius of the ball
+     * @return the classification
+     */
+    [[nodiscard]] virtual Containment classify(const Vec3 &/*center*/, scalar /*radius*/) const {
+        return Containment::boundary;
+    }
+
     const conversion_map &getConversions() const {
         return conversions;
     }
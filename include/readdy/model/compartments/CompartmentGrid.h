@@ -0,0 +1,139 @@
+/********************************************************************
+ * Copyright © 2018 Computational Molecular Biology Group,          *
+ *                  Freie Universität Berlin (GER)                  *
+ *                                                                  *
+ * Redistribution and use in source and binary forms, with or       *
+ * without modification, are permitted provided that the            *
+ * following conditions are met:                                    *
+ *  1. Redistributions of source code must retain the above         *
+ *     copyright notice, this list of conditions and the            *
+ *     following disclaimer.                                        *
+ *  2. Redistributions in binary form must reproduce the above      *
+ *     copyright notice, this list of conditions and the following  *
+ *     disclaimer in the documentation and/or other materials       *
+ *     provided with the distribution.                              *
+ *  3. Neither the name of the copyright holder nor the names of    *
+ *     its contributors may be used to endorse or promote products  *
+ *     derived from this software without specific                  *
+ *     prior written permission.                                    *
+ *                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND           *
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,      *
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF         *
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE         *
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR            *
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,         *
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER *
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,      *
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)    *
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF      *
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
+ ********************************************************************/
+
+
+
+/**
+ * The compartment grid voxelizes the simulation box. Each voxel is either fully inside exactly one compartment, fully
+ * outside of all compartments, or requires an exact test per particle. Conversions are stored in a dense
+ * (compartment, type) -> type table, so that particles in most voxels are converted with a single lookup.
+ *
+ * @file CompartmentGrid.h
+ * @brief Voxelized compartment membership and dense conversion table
+ * @author EricArkfeld
+ * @date 19.10.26
+ * @copyright BSD-3
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "CompartmentRegistry.h"
+
+namespace readdy::model::compartments {
+
+class CompartmentGrid {
+public:
+    using BoxSize = std::array<scalar, 3>;
+    using VoxelState = std::int32_t;
+
+    /**
+     * voxel state of voxels that are not contained in any compartment
+     */
+    static constexpr VoxelState outside = -1;
+    /**
+     * voxel state of voxels that require an exact test, non-negative states refer to exactly one compartment
+     */
+    static constexpr VoxelState boundary = -2;
+
+    CompartmentGrid() = default;
+
+    /**
+     * Creates the grid.
+     * @param compartments the compartments
+     * @param types the particle types
+     * @param boxSize the simulation box size, the box is centered around the origin
+     * @param maxVoxelsPerAxis the number of voxels along the longest box axis
+     */
+    CompartmentGrid(const CompartmentRegistry &compartments, const ParticleTypeRegistry &types,
+                    const BoxSize &boxSize, std::size_t maxVoxelsPerAxis = 64);
+
+    /**
+     * Checks whether this grid was built for the given setup and can be reused.
+     */
+    [[nodiscard]] bool upToDate(const CompartmentRegistry &compartments, const ParticleTypeRegistry &types,
+                                const BoxSize &boxSize) const;
+
+    /**
+     * Yields the state of the voxel containing the position, positions outside of the box yield `boundary`.
+     */
+    [[nodiscard]] VoxelState voxelState(const Vec3 &position) const;
+
+    /**
+     * Applies the conversions of all compartments containing the position to the type, in the order in which the
+     * compartments were registered.
+     * @param position the particle position
+     * @param type the particle type
+     * @return the converted type
+     */
+    [[nodiscard]] ParticleTypeId convert(const Vec3 &position, ParticleTypeId type) const {
+        const auto state = voxelState(position);
+        if (state == outside || type >= _nTypes) {
+            return type;
+        }
+        if (state >= 0) {
+            return _conversions[static_cast<std::size_t>(state) * _nTypes + type];
+        }
+        for (std::size_t i = 0; i < _compartments.size(); ++i) {
+            if (_compartments[i]->isContained(position)) {
+                type = _conversions[i * _nTypes + type];
+            }
+        }
+        return type;
+    }
+
+    [[nodiscard]] const std::array<std::size_t, 3> &nVoxels() const {
+        return _nVoxels;
+    }
+
+    [[nodiscard]] const std::vector<VoxelState> &voxels() const {
+        return _voxels;
+    }
+
+private:
+    CompartmentRegistry::CompartmentVector _compartments;
+    std::vector<Compartment::id_type> _compartmentIds;
+    std::size_t _nTypes{0};
+    BoxSize _boxSize{};
+    std::array<std::size_t, 3> _nVoxels{};
+    Vec3 _voxelSize{};
+    std::vector<VoxelState> _voxels;
+    // dense (compartment, type) -> converted type
+    std::vector<ParticleTypeId> _conversions;
+};
+
+}
@@ -66,6 +66,19 @@ public:
         }
     }
 
+    [[nodiscard]] Containment classify(const Vec3 &center, scalar radius) const override {
+        if constexpr(requires(const Geometry &g, Vec3 p) { g.signedDistance(p); }) {
+            const auto distance = geometry.signedDistance(center);
+            if (distance < -radius) {
+                return inside ? Containment::inside : Containment::outside;
+            }
+            if (distance > radius) {
+                return inside ? Containment::outside : Containment::inside;
+            }
+        }
+        return Containment::boundary;
+    }
+
 private:
     Geometry geometry;
     bool inside;
@@ -88,6 +101,18 @@ public:
         return distanceFromPlane < 0;
     }
 
+    [[nodiscard]] Containment classify(const Vec3 &center, scalar radius) const override {
+        const scalar distanceFromPlane = center * normalCoefficients - distanceFromOrigin;
+        const scalar bound = radius * normalCoefficients.norm();
+        if (distanceFromPlane - bound > 0) {
+            return largerOrLess ? Containment::inside : Containment::outside;
+        }
+        if (distanceFromPlane + bound < 0) {
+            return largerOrLess ? Containment::outside : Containment::inside;
+        }
+        return Containment::boundary;
+    }
+
 protected:
     const Vec3 normalCoefficients;
     const scalar distanceFromOrigin;
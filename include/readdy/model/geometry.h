@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <limits>
+
 #include "readdy/common/common.h"
 
 namespace readdy::model::geometry {
@@ -48,6 +50,13 @@ struct Sphere {
         }
     }
 
+    /**
+     * Signed distance to the surface, negative inside and positive outside.
+     */
+    [[nodiscard]] dtype signedDistance(Vec3 position) const {
+        return (position - center).norm() - radius;
+    }
+
     [[nodiscard]] std::string describe() const {
         return fmt::format("center={}, radius={}", center, radius);
     }
@@ -115,6 +124,21 @@ struct Box {
         }
     }
 
+    /**
+     * Signed distance to the surface, negative inside and positive outside.
+     */
+    [[nodiscard]] dtype signedDistance(Vec3 position) const {
+        dtype outside {0};
+        dtype inside {-std::numeric_limits<dtype>::infinity()};
+        #pragma unroll
+        for(std::uint8_t d = 0; d < 3; ++d) {
+            const auto q = std::max(v0[d] - position[d], position[d] - v1[d]);
+            outside += q > 0 ? q * q : 0;
+            inside = std::max(inside, q);
+        }
+        return std::sqrt(outside) + std::min(inside, static_cast<dtype>(0));
+    }
+
     [[nodiscard]] std::string describe() const {
         return fmt::format("minimum vertex v0=({},{},{}) and maximum vertex v1=({},{},{})",
                            v0.x, v0.y, v0.z, v1.x, v1.y, v1.z);
@@ -161,6 +185,13 @@ struct Capsule {
         return closestCircleCenter(position).template smallestDifference<inclusion>(position);
     }
 
+    /**
+     * Signed distance to the surface, negative inside and positive outside.
+     */
+    [[nodiscard]] dtype signedDistance(Vec3 position) const {
+        return (position - closestCircleCenter(position).center).norm() - radius;
+    }
+
     [[nodiscard]] std::string describe() const {
         return fmt::format("center={}, direction={}, radius={}, length={}", center, direction, radius, length);
     }
@@ -49,7 +49,7 @@
 
 namespace readdy::model::observables {
 
-class Energy : public Observable<scalar> {
+class Energy : public Observable<ScalarAccumulator> {
 public:
     Energy(Kernel *kernel, Stride stride);
 
@@ -67,6 +67,10 @@ public:
 
     void evaluate() override;
 
+    bool requiresEnergy() const override {
+        return true;
+    }
+
     std::string_view type() const override;
 
 protected:
@@ -154,6 +154,15 @@ public:
      */
     virtual void evaluate() = 0;
 
+    /**
+     * Whether evaluate() reads the energy of the state model, which is then computed by the simulation loop on the
+     * time steps where this observable is due.
+     * @return false by default
+     */
+    virtual bool requiresEnergy() const {
+        return false;
+    }
+
     /**
      * This should be called if the contents of the observable should be written into a file after evaluation.
      * @param file the file to write into
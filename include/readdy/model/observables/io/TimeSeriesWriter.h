@@ -64,7 +64,9 @@ public:
     TimeSeriesWriter(h5rd::Group &group, unsigned int chunkSize, const std::string &dsName = "time",
                      bool useBlosc = true)
             : dataSet(group.createDataSet<TimeStep>(dsName, {chunkSize}, {h5rd::UNLIMITED_DIMS},
-                                                          getFilterConfig(useBlosc))) {}
+                                                          getFilterConfig(useBlosc))) {
+        dataSet->setWriteCombining(chunkSize);
+    }
 
     ~TimeSeriesWriter() = default;
 
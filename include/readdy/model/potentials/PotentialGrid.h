@@ -0,0 +1,172 @@
+/********************************************************************
+ * Copyright © 2018 Computational Molecular Biology Group,          *
+ *                  Freie Universität Berlin (GER)                  *
+ *                                                                  *
+ * Redistribution and use in source and binary forms, with or       *
+ * without modification, are permitted provided that the            *
+ * following conditions are met:                                    *
+ *  1. Redistributions of source code must retain the above         *
+ *     copyright notice, this list of conditions and the            *
+ *     following disclaimer.                                        *
+ *  2. Redistributions in binary form must reproduce the above      *
+ *     copyright notice, this list of conditions and the following  *
+ *     disclaimer in the documentation and/or other materials       *
+ *     provided with the distribution.                              *
+ *  3. Neither the name of the copyright holder nor the names of    *
+ *     its contributors may be used to endorse or promote products  *
+ *     derived from this software without specific                  *
+ *     prior written permission.                                    *
+ *                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND           *
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,      *
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF         *
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE         *
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR            *
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,         *
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER *
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,      *
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)    *
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF      *
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
+ ********************************************************************/
+
+
+
+/**
+ * The potential grid tabulates the summed forces and energies of the built-in first order potentials acting on a
+ * particle type on the nodes of a regular grid spanning the simulation box. Inside of the box, forces and energies are
+ * obtained by trilinear interpolation, so that the cost per particle does not depend on how many potentials act on it.
+ * Other first order potentials, e.g., user defined ones, may depend on more than the position and are evaluated
+ * exactly.
+ *
+ * @file PotentialGrid.h
+ * @brief Grid-precomputed first order potentials
+ * @author EricArkfeld
+ * @date 19.10.26
+ * @copyright BSD-3
+ */
+
+#pragma once
+
+#include <array>
+#include <optional>
+#include <typeindex>
+#include <vector>
+
+#include "PotentialRegistry.h"
+
+namespace readdy::model::potentials {
+
+class PotentialGrid {
+public:
+    using BoxSize = std::array<scalar, 3>;
+    using Parameters = std::vector<scalar>;
+
+    /**
+     * The maximal number of grid nodes, each node takes four scalars per particle type with built-in potentials,
+     * i.e., 256 MiB per type in double precision.
+     */
+    static constexpr std::size_t maxNodes = 1u << 23u;
+
+    PotentialGrid() = default;
+
+    /**
+     * Creates the grid by evaluating the built-in first order potentials on its nodes.
+     * @param potentials the first order potentials per particle type
+     * @param boxSize the simulation box size, the box is centered around the origin
+     * @param spacing the desired distance between neighboring nodes, it is shrunk to fit the box
+     * @throws std::invalid_argument if the spacing is not positive or the grid would have more than maxNodes nodes
+     */
+    PotentialGrid(const PotentialRegistry::PotentialsO1Map &potentials, const BoxSize &boxSize, scalar spacing);
+
+    /**
+     * Checks whether this grid was built for the given setup and can be reused. Built-in potentials are compared by
+     * their parameters, so that potentials that were replaced or changed in place are detected.
+     */
+    [[nodiscard]] bool upToDate(const PotentialRegistry::PotentialsO1Map &potentials, const BoxSize &boxSize,
+                                scalar spacing) const;
+
+    /**
+     * The parameters of a built-in potential that depends on the position only.
+     * @param potential the potential
+     * @return the parameters, or nothing if the potential cannot be tabulated
+     */
+    static std::optional<Parameters> parametersOf(const PotentialOrder1 &potential);
+
+    /**
+     * The potentials acting on the particle type that are not tabulated and need to be evaluated exactly in addition
+     * to the interpolated values.
+     */
+    [[nodiscard]] const PotentialRegistry::PotentialsO1Collection &exactPotentials(ParticleTypeId type) const {
+        return type < _exactPotentials.size() ? _exactPotentials[type] : _noPotentials;
+    }
+
+    /**
+     * Adds the interpolated force and energy of the tabulated potentials acting on the particle type at the
+     * position.
+     * @return false if the position is outside of the grid and all potentials need to be evaluated exactly
+     */
+    bool calculateForceAndEnergy(ParticleTypeId type, const Vec3 &position, Vec3 &force, scalar &energy) const {
+        if (type >= _tables.size() || _tables[type].empty()) {
+            return true;
+        }
+        std::array<std::size_t, 3> cell{};
+        std::array<scalar, 3> frac{};
+        for (std::uint8_t d = 0; d < 3; ++d) {
+            const auto x = (position[d] + .5 * _boxSize[d]) * _inverseSpacing[d];
+            if (!(x >= 0) || x > static_cast<scalar>(_nCells[d])) {
+                return false;
+            }
+            cell[d] = std::min(static_cast<std::size_t>(x), _nCells[d] - 1);
+            frac[d] = x - static_cast<scalar>(cell[d]);
+        }
+        const auto &table = _tables[type];
+        std::array<scalar, 4> result{};
+        for (std::uint8_t corner = 0; corner < 8; ++corner) {
+            const std::size_t i = cell[0] + (corner & 1u), j = cell[1] + ((corner >> 1u) & 1u),
+                    k = cell[2] + ((corner >> 2u) & 1u);
+            const auto weight = ((corner & 1u) ? frac[0] : 1 - frac[0])
+                                * (((corner >> 1u) & 1u) ? frac[1] : 1 - frac[1])
+                                * (((corner >> 2u) & 1u) ? frac[2] : 1 - frac[2]);
+            const auto *node = &table[4 * ((i * (_nCells[1] + 1) + j) * (_nCells[2] + 1) + k)];
+            for (std::uint8_t c = 0; c < 4; ++c) {
+                result[c] += weight * node[c];
+            }
+        }
+        force += Vec3(result[0], result[1], result[2]);
+        energy += result[3];
+        return true;
+    }
+
+    [[nodiscard]] const std::array<std::size_t, 3> &nCells() const {
+        return _nCells;
+    }
+
+private:
+    // per particle type the tabulated potentials with their parameters and the exactly evaluated ones
+    struct Signature {
+        std::vector<std::pair<std::type_index, Parameters>> tabulated;
+        PotentialRegistry::PotentialsO1Collection exact;
+
+        bool operator==(const Signature &other) const {
+            return tabulated == other.tabulated && exact == other.exact;
+        }
+    };
+
+    static std::unordered_map<ParticleTypeId, Signature>
+    signatureOf(const PotentialRegistry::PotentialsO1Map &potentials);
+
+    std::unordered_map<ParticleTypeId, Signature> _signature;
+    std::vector<PotentialRegistry::PotentialsO1Collection> _exactPotentials;
+    PotentialRegistry::PotentialsO1Collection _noPotentials;
+    BoxSize _boxSize{};
+    scalar _spacing{0};
+    std::array<std::size_t, 3> _nCells{};
+    std::array<scalar, 3> _inverseSpacing{};
+    // per particle type (fx, fy, fz, energy) for each node, empty for types without tabulated potentials
+    std::vector<std::vector<scalar>> _tables;
+};
+
+}
@@ -64,7 +64,11 @@ public:
 
     virtual void calculateForce(Vec3 &force, const Vec3 &position) const = 0;
 
-    void calculateForceAndEnergy(Vec3 &force, scalar &energy, const Vec3 &position) const {
+    /**
+     * Adds the force to `force` and the energy to `energy`. The default evaluates both separately, built-in potentials
+     * override it to share the intermediate results.
+     */
+    virtual void calculateForceAndEnergy(Vec3 &force, scalar &energy, const Vec3 &position) const {
         energy += calculateEnergy(position);
         calculateForce(force, position);
     };
@@ -239,6 +239,34 @@ public:
         _registerO2(pots.back().get());
     }
 
+    /**
+     * Registers a pair potential that is given by tables of energies and forces, see TabulatedPotential.
+     *
+     * @param particleType1 particle type A
+     * @param particleType2 particle type B
+     * @param distances strictly increasing grid of distances, the last one is the cutoff
+     * @param energies the energies at the grid points
+     * @param forces the force magnitudes -dV/dr at the grid points
+     * @param interpolation linear or cubic spline interpolation in the squared distance
+     */
+    void addTabulated(const std::string &particleType1, const std::string &particleType2,
+                      const std::vector<scalar> &distances, const std::vector<scalar> &energies,
+                      const std::vector<scalar> &forces,
+                      TabulatedPotential::Interpolation interpolation = TabulatedPotential::Interpolation::CubicSpline) {
+        addTabulated(_types->idOf(particleType1), _types->idOf(particleType2), distances, energies, forces,
+                     interpolation);
+    }
+
+    void addTabulated(ParticleTypeId particleType1, ParticleTypeId particleType2,
+                      const std::vector<scalar> &distances, const std::vector<scalar> &energies,
+                      const std::vector<scalar> &forces,
+                      TabulatedPotential::Interpolation interpolation = TabulatedPotential::Interpolation::CubicSpline) {
+        auto &pots = _ownPotentialsP2[std::tie(particleType1, particleType2)];
+        pots.emplace_back(std::make_shared<TabulatedPotential>(particleType1, particleType2, distances, energies,
+                                                               forces, interpolation));
+        _registerO2(pots.back().get());
+    }
+
     /**
      * Register a sphere potential, which is used to confine particles inside or outside a spherical volume.
      * The energy function increases quadratically with respect to the distance from the sphere edge,
@@ -69,6 +69,12 @@ public:
         force += -1 * _forceConstant * _geometry.template smallestDifference<inclusion>(position);
     }
 
+    void calculateForceAndEnergy(Vec3 &force, scalar &energy, const Vec3 &position) const override {
+        const Vec3 shortestDiff = _geometry.template smallestDifference<inclusion>(position);
+        energy += 0.5 * _forceConstant * shortestDiff.normSquared();
+        force += -1 * _forceConstant * shortestDiff;
+    }
+
     [[nodiscard]] std::string type() const override { return std::string(Geometry::name); }
     [[nodiscard]] const Geometry &geometry() const { return _geometry; }
     [[nodiscard]] scalar forceConstant() const { return _forceConstant; }
@@ -140,10 +146,39 @@ public:
         }
     }
 
+    void calculateForceAndEnergy(Vec3 &force, scalar &energy, const Vec3 &position) const override {
+        const auto difference = position - origin;
+        const auto distance = difference.norm();
+        if (distance < r1 || r4 <= distance) {
+            return;
+        }
+        if (distance < r2) {
+            const auto offset = distance - radius + width;
+            energy += static_cast<scalar>(0.5) * effectiveForceConstant * offset * offset;
+            force += -effectiveForceConstant * offset * difference / distance;
+        } else if (distance < r3) {
+            const auto offset = distance - radius;
+            energy += height - static_cast<scalar>(0.5) * effectiveForceConstant * offset * offset;
+            force += effectiveForceConstant * offset * difference / distance;
+        } else {
+            const auto offset = distance - radius - width;
+            energy += static_cast<scalar>(0.5) * effectiveForceConstant * offset * offset;
+            force += -effectiveForceConstant * offset * difference / distance;
+        }
+    }
+
     std::string describe() const override;
 
     std::string type() const override;
 
+    const Vec3 &getOrigin() const { return origin; }
+
+    scalar getRadius() const { return radius; }
+
+    scalar getHeight() const { return height; }
+
+    scalar getWidth() const { return width; }
+
 protected:
     const Vec3 origin;
     const readdy::scalar radius, height, width, r1, r2, r3, r4, effectiveForceConstant;
@@ -190,6 +225,17 @@ public:
         }
     }
 
+    void calculateForceAndEnergy(Vec3 &force, scalar &energy, const Vec3 &position) const override {
+        Vec3 pos = position - origin;
+        Vec3 perpendicular = pos - (pos * normal) * normal;
+        scalar distanceFromAxis = perpendicular.norm();
+        if (inclusion ? distanceFromAxis > radius : distanceFromAxis < radius) {
+            const auto offset = distanceFromAxis - radius;
+            energy += static_cast<scalar>(0.5) * forceConstant * offset * offset;
+            force += -forceConstant * offset * perpendicular / distanceFromAxis;
+        }
+    }
+
     std::string describe() const override {
         std::string inOrOut = inclusion ? "inclusion" : "exclusion";
         return fmt::format("Cylindrical {} potential with Force constant={}, origin={}, normal={}, and radius={}",
@@ -198,6 +244,14 @@ public:
 
     std::string type() const override;
 
+    scalar getForceConstant() const { return forceConstant; }
+
+    const Vec3 &getOrigin() const { return origin; }
+
+    const Vec3 &getNormal() const { return normal; }
+
+    scalar getRadius() const { return radius; }
+
 protected:
     const Vec3 origin;
     const Vec3 normal;
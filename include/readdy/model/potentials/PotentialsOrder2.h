@@ -47,6 +47,7 @@
 #pragma once
 
 #include <ostream>
+#include <vector>
 #include "PotentialOrder2.h"
 
 namespace readdy::model::potentials {
@@ -90,6 +91,18 @@ public:
         }
     }
 
+    void calculateForceAndEnergy(Vec3 &force, scalar &energy, const Vec3 &x_ij) const override {
+        const auto distanceSquared = x_ij * x_ij;
+        if (distanceSquared < _interactionDistanceSquared) {
+            const auto distance = std::sqrt(distanceSquared);
+            const auto overlap = distance - _interactionDistance;
+            energy += static_cast<scalar>(0.5) * overlap * overlap * getForceConstant();
+            if (distanceSquared > 0) {
+                force += (getForceConstant() * overlap) / distance * x_ij;
+            }
+        }
+    }
+
     scalar getCutoffRadiusSquared() const override {
         return _interactionDistanceSquared;
     }
@@ -182,6 +195,32 @@ public:
         }
     }
 
+    void calculateForceAndEnergy(Vec3 &force, scalar &energy, const Vec3 &x_ij) const override {
+        const auto dist = std::sqrt(x_ij * x_ij);
+        const auto len_part2 = conf.noInteractionDistance - conf.desiredParticleDistance;
+        const auto attractiveConstant = conf.depthAtDesiredDistance * (1. / (.5 * len_part2)) * (1. / (.5 * len_part2));
+        scalar factor = 0;
+        if (dist < conf.desiredParticleDistance) {
+            // repulsive as we are closer than the desired distance
+            const auto offset = dist - conf.desiredParticleDistance;
+            energy += static_cast<scalar>(.5) * forceConstant * offset * offset - conf.depthAtDesiredDistance;
+            factor = forceConstant * offset;
+        } else if (dist < conf.desiredParticleDistance + .5 * len_part2) {
+            // attractive as we are further (but not too far) apart than the desired distance
+            const auto offset = dist - conf.desiredParticleDistance;
+            energy += .5 * attractiveConstant * offset * offset - conf.depthAtDesiredDistance;
+            factor = attractiveConstant * offset;
+        } else if (dist < conf.noInteractionDistance) {
+            // if we are not too far apart but still further than in the previous case, attractive
+            const auto offset = dist - conf.noInteractionDistance;
+            energy += -.5 * attractiveConstant * offset * offset;
+            factor = -attractiveConstant * offset;
+        }
+        if (dist > 0 && factor != 0) {
+            force += factor * x_ij / dist;
+        }
+    }
+
     scalar getCutoffRadiusSquared() const override {
         return conf.noInteractionDistanceSquared;
     }
@@ -252,6 +291,16 @@ public:
         }
     }
 
+    void calculateForceAndEnergy(Vec3 &force, scalar &energy, const Vec3 &x_ij) const override {
+        const auto r = x_ij.norm();
+        if (r > cutoffDistance) return;
+        const auto ratio = sigma / r;
+        const auto ratioM = std::pow(ratio, m);
+        const auto ratioN = std::pow(ratio, n);
+        energy += shift ? k * (ratioM - ratioN) - this->energy(cutoffDistance) : k * (ratioM - ratioN);
+        force += -1. * k * (1 / (r * r)) * (m * ratioM - n * ratioN) * x_ij;
+    }
+
     scalar getCutoffRadiusSquared() const override {
         return cutoffDistanceSquared;
     }
@@ -304,6 +353,15 @@ public:
         force += forceFactor * (-1. * x_ij / distance);
     }
 
+    void calculateForceAndEnergy(Vec3 &force, scalar &energy, const Vec3 &x_ij) const override {
+        const auto distance = x_ij.norm();
+        const auto screening = electrostaticStrength * std::exp(-inverseScreeningDepth * distance) / distance;
+        const auto repulsion = repulsionStrength * std::pow(repulsionDistance / distance, exponent);
+        energy += screening + repulsion;
+        const auto forceFactor = screening * (inverseScreeningDepth + 1. / distance) + repulsion * exponent / distance;
+        force += forceFactor * (-1. * x_ij / distance);
+    }
+
     std::string describe() const override;
 
     scalar getCutoffRadiusSquared() const override {
@@ -322,6 +380,104 @@ protected:
     scalar cutoffSquared;
 };
 
+/**
+ * Pair potential that is given by tables of energies and forces on a grid of distances. Both are interpolated in
+ * the squared distance, so that no square root is required during evaluation. Beyond the last grid point the
+ * potential vanishes, below the first grid point it is continued constantly.
+ */
+class TabulatedPotential : public PotentialOrder2 {
+    using super = PotentialOrder2;
+public:
+    enum class Interpolation {
+        Linear, CubicSpline
+    };
+
+    /**
+     * Constructs a tabulated potential between two particle types A and B (where possibly A = B).
+     *
+     * @param type1 particle type A
+     * @param type2 particle type B
+     * @param distances strictly increasing, non-negative grid of distances, the last one is the cutoff
+     * @param energies the energies at the grid points
+     * @param forces the force magnitudes -dV/dr at the grid points, positive values are repulsive
+     * @param interpolation how to interpolate between the grid points
+     */
+    TabulatedPotential(ParticleTypeId type1, ParticleTypeId type2, const std::vector<scalar> &distances,
+                       const std::vector<scalar> &energies, const std::vector<scalar> &forces,
+                       Interpolation interpolation = Interpolation::CubicSpline);
+
+    scalar calculateEnergy(const Vec3 &x_ij) const override {
+        const auto distanceSquared = x_ij * x_ij;
+        if (distanceSquared >= _cutoffSquared) return 0;
+        scalar t;
+        const auto k = interval(distanceSquared, t);
+        return evaluate(_energyCoefficients, k, t);
+    }
+
+    void calculateForce(Vec3 &force, const Vec3 &x_ij) const override {
+        const auto distanceSquared = x_ij * x_ij;
+        if (distanceSquared >= _cutoffSquared) return;
+        scalar t;
+        const auto k = interval(distanceSquared, t);
+        force += evaluate(_forceCoefficients, k, t) * x_ij;
+    }
+
+    void calculateForceAndEnergy(Vec3 &force, scalar &energy, const Vec3 &x_ij) const override {
+        const auto distanceSquared = x_ij * x_ij;
+        if (distanceSquared >= _cutoffSquared) return;
+        scalar t;
+        const auto k = interval(distanceSquared, t);
+        energy += evaluate(_energyCoefficients, k, t);
+        force += evaluate(_forceCoefficients, k, t) * x_ij;
+    }
+
+    scalar getCutoffRadiusSquared() const override {
+        return _cutoffSquared;
+    }
+
+    Interpolation interpolation() const {
+        return _interpolation;
+    }
+
+    std::string describe() const override;
+
+    std::string type() const override;
+
+private:
+    /**
+     * Finds the grid interval containing a squared distance below the cutoff.
+     * @param distanceSquared the squared distance
+     * @param t gets the offset of the squared distance from the start of the interval
+     * @return the interval index
+     */
+    std::size_t interval(scalar distanceSquared, scalar &t) const {
+        if (distanceSquared <= _nodes.front()) {
+            t = 0;
+            return 0;
+        }
+        auto k = _buckets[static_cast<std::size_t>((distanceSquared - _nodes.front()) * _inverseBucketWidth)];
+        while (distanceSquared >= _nodes[k + 1]) ++k;
+        t = distanceSquared - _nodes[k];
+        return k;
+    }
+
+    static scalar evaluate(const std::vector<scalar> &coefficients, std::size_t k, scalar t) {
+        const auto *c = &coefficients[4 * k];
+        return ((c[3] * t + c[2]) * t + c[1]) * t + c[0];
+    }
+
+    Interpolation _interpolation;
+    scalar _cutoff, _cutoffSquared;
+    // squared distances of the grid points
+    std::vector<scalar> _nodes;
+    // per interval polynomial coefficients in the offset from the interval start, for the energy and for the factor
+    // with which the separation vector is scaled to obtain the force
+    std::vector<scalar> _energyCoefficients, _forceCoefficients;
+    // maps equally sized bins of squared distances to the first interval intersecting them
+    std::vector<std::size_t> _buckets;
+    scalar _inverseBucketWidth;
+};
+
 template<typename T>
 const std::string getPotentialName(typename std::enable_if<std::is_base_of<HarmonicRepulsion, T>::value>::type * = 0) {
     return "HarmonicRepulsion";
@@ -345,4 +501,10 @@ getPotentialName(typename std::enable_if<std::is_base_of<ScreenedElectrostatics,
     return "ScreenedElectrostatics";
 }
 
+template<typename T>
+const std::string
+getPotentialName(typename std::enable_if<std::is_base_of<TabulatedPotential, T>::value>::type * = 0) {
+    return "TabulatedPotential";
+}
+
 }
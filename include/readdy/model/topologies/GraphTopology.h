@@ -45,6 +45,8 @@
 
 #pragma once
 
+#include <numeric>
+
 #include <graphs/graphs.h>
 
 #include "common.h"
@@ -80,8 +82,29 @@ public:
 
     GraphTopology &operator=(const GraphTopology &) = delete;
 
+    /**
+     * Empties this (typically deactivated) topology and turns it into an active, unconfigured topology of the given
+     * type. The vertex list, the particle to vertex index and the change tracking keep their allocated storage, so
+     * that a topology built into it with addVertex() and addEdge() does not reallocate them.
+     * @param type the new topology type
+     */
+    void reset(TopologyTypeId type);
+
+    /**
+     * Adds a vertex that is not yet connected to the rest of the graph.
+     * @param data the vertex data, containing the particle index
+     * @return the persistent index of the new vertex
+     */
+    Graph::PersistentVertexIndex addVertex(const VertexData &data) {
+        auto ix = _graph.addVertex(data);
+        _vertexForParticle[data.particleIndex] = ix;
+        return ix;
+    }
+
     void setGraph(Graph graph) {
         _graph = std::move(graph);
+        _configured = false;
+        rebuildVertexIndex();
     }
 
     [[nodiscard]] const Graph &graph() const {
@@ -97,31 +120,79 @@ public:
     }
 
     void addEdge(Graph::iterator it1, Graph::iterator it2) {
-        _graph.addEdge(it1, it2);
+        addEdge(it1.persistent_index(), it2.persistent_index());
     }
 
     void addEdge(Graph::Edge edge) {
-        _graph.addEdge(edge);
+        addEdge(std::get<0>(edge), std::get<1>(edge));
     }
 
     void addEdge(Graph::PersistentVertexIndex ix1, Graph::PersistentVertexIndex ix2) {
         _graph.addEdge(ix1, ix2);
+        markVertexChanged(ix1);
+        markVertexChanged(ix2);
     }
 
     void removeEdge(Graph::iterator it1, Graph::iterator it2) {
-        _graph.removeEdge(it1, it2);
+        removeEdge(it1.persistent_index(), it2.persistent_index());
     }
 
     void removeEdge(Graph::Edge edge) {
-        _graph.removeEdge(edge);
+        removeEdge(std::get<0>(edge), std::get<1>(edge));
     }
 
     void removeEdge(Graph::PersistentVertexIndex ix1, Graph::PersistentVertexIndex ix2) {
         _graph.removeEdge(ix1, ix2);
+        markVertexChanged(ix1);
+        markVertexChanged(ix2);
+        _removedEdges.emplace_back(ix1, ix2);
     }
 
+    /**
+     * Builds the bonded potentials (bonds, angles, dihedrals) of this topology from scratch by enumerating all n-tuples
+     * of the graph. Validates the whole topology beforehand.
+     */
     void configure();
 
+    /**
+     * Updates the bonded potentials after the graph was modified through this topology's edge modifiers or after
+     * vertices were marked as changed. Only terms that contain a changed vertex are removed and re-enumerated, the
+     * remaining terms are kept. Falls back to configure() if the topology was never configured.
+     * Assumes that the graph is still connected, see isConnectedAfterChanges().
+     */
+    void reconfigure();
+
+    /**
+     * Records that the vertex's particle type or connectivity was changed, so that reconfigure() re-enumerates the
+     * terms it takes part in.
+     * @param vertex the vertex
+     */
+    void markVertexChanged(Graph::PersistentVertexIndex vertex) {
+        _changedVertices.push_back(vertex);
+    }
+
+    /**
+     * Checks connectivity of the graph after edges have been removed since the last (re)configuration. Only searches
+     * for paths between the endpoints of removed edges, assuming that the graph was connected before. Falls back to a
+     * full connectivity check if the topology was never configured.
+     * @return true if the graph is connected
+     */
+    [[nodiscard]] bool isConnectedAfterChanges() const;
+
+    [[nodiscard]] const std::vector<Graph::PersistentVertexIndex> &changedVertices() const {
+        return _changedVertices;
+    }
+
+    /**
+     * Yields the vertex stored under a persistent index. Unlike graph().vertices().at(), this also yields vertices
+     * that were removed, e.g., the ones among changedVertices().
+     * @param vertex the persistent index
+     * @return the (possibly deactivated) vertex
+     */
+    [[nodiscard]] const Vertex &vertexAt(Graph::PersistentVertexIndex vertex) const {
+        return *(_graph.vertices().begin_persistent() + vertex.value);
+    }
+
     [[nodiscard]] ParticleTypeId typeOf(Graph::PersistentVertexIndex vertex) const;
 
     [[nodiscard]] ParticleTypeId typeOf(const Vertex &v) const;
@@ -135,6 +206,29 @@ public:
             _cumulativeRate += rate;
             return rate;
         });
+        _ratesDirty = false;
+    }
+
+    /**
+     * Sets the structural reaction rates, e.g., after they were evaluated in a batch over several topologies.
+     * @param rates the rates, one per structural reaction of this topology's type
+     */
+    void setReactionRates(ReactionRates rates) {
+        _reaction_rates = std::move(rates);
+        _cumulativeRate = std::accumulate(_reaction_rates.begin(), _reaction_rates.end(), ReactionRate{0});
+        _ratesDirty = false;
+    }
+
+    /**
+     * Flags the cached structural reaction rates as outdated, they are re-evaluated lazily before the next topology
+     * reaction step.
+     */
+    void invalidateReactionRates() {
+        _ratesDirty = true;
+    }
+
+    [[nodiscard]] bool reactionRatesDirty() const {
+        return _ratesDirty;
     }
 
     void updateSpatialReactionRates(const TopologyRegistry::SpatialReactionCollection &reactions,
@@ -167,6 +261,16 @@ public:
 
     std::vector<GraphTopology> connectedComponents();
 
+    /**
+     * Moves all connected components except for the largest one into new topologies of the same type, this topology
+     * keeps the remaining component. If the topology was configured, only the surroundings of edges removed since then
+     * are searched from all of their endpoints, always advancing the search that has visited the fewest vertices, so
+     * that the cost is bounded by the smaller components.
+     * @param provider provides the topologies that the split off components are built into, new ones if empty
+     * @return the split off components, empty if the graph is still connected
+     */
+    std::vector<GraphTopology> splitOffComponents(const TopologyProvider &provider = {});
+
     [[nodiscard]] bool isDeactivated() const {
         return deactivated;
     }
@@ -186,13 +290,26 @@ public:
     [[nodiscard]] typename Graph::VertexList::const_persistent_iterator vertexIteratorForParticle(VertexData::ParticleIndex index) const;
 
     [[nodiscard]] Graph::PersistentVertexIndex vertexIndexForParticle(VertexData::ParticleIndex index) const {
-        auto it = vertexIteratorForParticle(index);
-        if(it == _graph.vertices().end_persistent()) {
+        auto it = _vertexForParticle.find(index);
+        if(it == _vertexForParticle.end()) {
             throw std::invalid_argument(fmt::format("Particle {} not contained in graph", index));
         }
-        return {static_cast<std::size_t>(std::distance(_graph.vertices().begin_persistent(), it))};
+        return it->second;
     }
 
+    /**
+     * Removes the vertex and all its edges from the graph.
+     * @param vertex the vertex
+     */
+    void removeVertex(Graph::PersistentVertexIndex vertex);
+
+    /**
+     * Updates the particle indices of all vertices and bonded terms after the particles were moved within the data
+     * container.
+     * @param oldToNew mapping from the previous particle index to the current one
+     */
+    void remapParticleIndices(const std::vector<VertexData::ParticleIndex> &oldToNew);
+
     typename Graph::PersistentVertexIndex appendParticle(VertexData::ParticleIndex newParticle,
                                                          Graph::PersistentVertexIndex counterPart);
 
@@ -249,6 +366,19 @@ protected:
     ReactionRates _spatial_reaction_rates;
     TopologyTypeId _topology_type;
     bool deactivated{false};
+    bool _ratesDirty{true};
+    bool _configured{false};
+    std::vector<Graph::PersistentVertexIndex> _changedVertices;
+    std::vector<Graph::Edge> _removedEdges;
+    std::unordered_map<VertexData::ParticleIndex, Graph::PersistentVertexIndex> _vertexForParticle;
+
+private:
+    void rebuildVertexIndex();
+
+    void clearChanges() {
+        _changedVertices.clear();
+        _removedEdges.clear();
+    }
 };
 
 }
@@ -45,7 +45,7 @@
 
 #pragma once
 
-#include <unordered_set>
+#include <span>
 #include <unordered_map>
 
 #include <readdy/common/common.h>
@@ -79,15 +79,26 @@ class TopologyRegistry {
 public:
 
     using SpatialReaction = reactions::SpatialTopologyReaction;
-    using SpatialReactionMap = topology_particle_type_tuple_umap<std::vector<SpatialReaction>>;
-    using SpatialReactionCollection = SpatialReactionMap::mapped_type;
-    using SpatialReactionTypeIds = std::unordered_set<ParticleTypeId>;
+    using SpatialReactionCollection = std::span<const SpatialReaction>;
+    using SpatialReactionMap = topology_particle_type_tuple_umap<SpatialReactionCollection>;
 
     using StructuralReaction = TopologyType::StructuralReaction;
     using StructuralReactionCollection = TopologyType::StructuralReactionCollection;
 
     using TypeCollection = std::vector<TopologyType>;
 
+    TopologyRegistry() = default;
+
+    TopologyRegistry(const TopologyRegistry &rhs);
+
+    TopologyRegistry &operator=(const TopologyRegistry &rhs);
+
+    TopologyRegistry(TopologyRegistry &&) noexcept = default;
+
+    TopologyRegistry &operator=(TopologyRegistry &&) noexcept = default;
+
+    ~TopologyRegistry() = default;
+
     TopologyTypeId addType(const std::string &name, const StructuralReactionCollection &reactions = {});
 
     void addStructuralReaction(TopologyTypeId typeId, reactions::StructuralTopologyReaction reaction) {
@@ -266,7 +277,7 @@ public:
         return _spatialReactions;
     }
 
-    const SpatialReactionCollection &spatialReactionsByType(
+    SpatialReactionCollection spatialReactionsByType(
             const std::string &particleType1, const std::string &topologyType1,
             const std::string &particleType2, const std::string &topologyType2) const {
         return spatialReactionsByType(
@@ -274,29 +285,35 @@ public:
                 _types->idOf(particleType2), idOf(topologyType2));
     }
 
-    const SpatialReactionCollection &spatialReactionsByType(ParticleTypeId t1, TopologyTypeId tt1,
-                                                            ParticleTypeId t2, TopologyTypeId tt2) const {
-        auto it = _spatialReactions.find(std::make_tuple(t1, tt1, t2, tt2));
-        return it != _spatialReactions.end() ? it->second : _defaultTopologyReactions;
+    /**
+     * Yields the spatial reactions between a particle of type t1 in a topology of type tt1 and a particle of type t2
+     * in a topology of type tt2 (EmptyTopologyId for free particles). The lookup is symmetric in (t1, tt1) and
+     * (t2, tt2) and goes through a dense table, so that it is cheap enough to be performed for every neighbor pair.
+     * @return a view of the reactions, empty if there are none
+     */
+    SpatialReactionCollection spatialReactionsByType(ParticleTypeId t1, TopologyTypeId tt1,
+                                                     ParticleTypeId t2, TopologyTypeId tt2) const {
+        const auto key1 = spatialReactionKey(t1, tt1);
+        const auto key2 = spatialReactionKey(t2, tt2);
+        if (key1 == noSpatialReactionSlot || key2 == noSpatialReactionSlot) {
+            return {};
+        }
+        return _spatialReactionTable[key1 * _nSpatialReactionKeys + key2];
     }
 
     const SpatialReaction &spatialReactionByName(const std::string &name) const {
-        for (const auto &e : _spatialReactions) {
-            for (const auto &reaction : e.second) {
-                if (reaction.name() == name) {
-                    return reaction;
-                }
+        for (const auto &reaction : _spatialReactionStorage) {
+            if (reaction.name() == name) {
+                return reaction;
             }
         }
         throw std::invalid_argument("No reaction with name \"" + name + "\" registered.");
     }
 
     SpatialReaction &spatialReactionByName(const std::string &name) {
-        for (auto &e : _spatialReactions) {
-            for (auto &reaction : e.second) {
-                if (reaction.name() == name) {
-                    return reaction;
-                }
+        for (auto &reaction : _spatialReactionStorage) {
+            if (reaction.name() == name) {
+                return reaction;
             }
         }
         throw std::invalid_argument("No reaction with name \"" + name + "\" registered.");
@@ -307,7 +324,7 @@ public:
     }
 
     bool isSpatialReactionType(ParticleTypeId type) const {
-        return _spatialReactionTypes.find(type) != _spatialReactionTypes.end();
+        return type < _spatialParticleTypeSlots.size() && _spatialParticleTypeSlots[type] != noSpatialReactionSlot;
     }
 
     /**
@@ -367,11 +384,43 @@ public:
 private:
     static TopologyTypeId counter;
 
+    static constexpr std::uint32_t noSpatialReactionSlot = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * Rebuilds the key -> reactions map and the dense lookup table from the reaction storage.
+     */
+    void updateSpatialReactionTable();
+
+    std::uint32_t spatialReactionKey(ParticleTypeId type, TopologyTypeId topologyType) const {
+        if (type >= _spatialParticleTypeSlots.size()) {
+            return noSpatialReactionSlot;
+        }
+        const auto typeSlot = _spatialParticleTypeSlots[type];
+        // slot 0 is reserved for particles that are not part of a topology
+        std::uint32_t topologyTypeSlot = 0;
+        if (topologyType != EmptyTopologyId) {
+            const auto index = static_cast<std::size_t>(topologyType);
+            topologyTypeSlot = index < _spatialTopologyTypeSlots.size() ? _spatialTopologyTypeSlots[index]
+                                                                         : noSpatialReactionSlot;
+        }
+        if (typeSlot == noSpatialReactionSlot || topologyTypeSlot == noSpatialReactionSlot) {
+            return noSpatialReactionSlot;
+        }
+        return typeSlot * _nSpatialTopologyTypeSlots + topologyTypeSlot;
+    }
+
     TypeCollection _registry{};
 
+    // spatial reactions, reactions with the same (unordered) key are stored contiguously in order of registration
+    std::vector<SpatialReaction> _spatialReactionStorage{};
     SpatialReactionMap _spatialReactions{};
-    SpatialReactionCollection _defaultTopologyReactions{};
-    SpatialReactionTypeIds _spatialReactionTypes{};
+    // dense slots of the particle types and topology types that take part in spatial reactions
+    std::vector<std::uint32_t> _spatialParticleTypeSlots{};
+    std::vector<std::uint32_t> _spatialTopologyTypeSlots{};
+    std::uint32_t _nSpatialTopologyTypeSlots{0};
+    std::uint32_t _nSpatialReactionKeys{0};
+    // _nSpatialReactionKeys x _nSpatialReactionKeys table of views into the reaction storage
+    std::vector<SpatialReactionCollection> _spatialReactionTable{};
 
     const ParticleTypeRegistry *_types;
 
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <cstddef>
+#include <functional>
 
 #include <graphs/graphs.h>
 
@@ -22,4 +23,12 @@ struct VertexData {
 using Vertex = graphs::Vertex<VertexData>;
 using Graph = graphs::Graph<graphs::IndexPersistentVector, Vertex>;
 
+class GraphTopology;
+
+/**
+ * Yields an empty topology of the requested type that a new topology is built into, e.g., a deactivated one whose
+ * storage is recycled by the state model.
+ */
+using TopologyProvider = std::function<GraphTopology(TopologyTypeId)>;
+
 }
@@ -66,8 +66,8 @@ struct AngleConfiguration {
     AngleConfiguration(size_t idx1, size_t idx2, size_t idx3, scalar forceConstant, scalar theta_0)
             : idx1(idx1), idx2(idx2), idx3(idx3), equilibriumAngle(theta_0), forceConstant(forceConstant) {}
 
-    const std::size_t idx1, idx2, idx3;
-    const scalar equilibriumAngle, forceConstant;
+    std::size_t idx1, idx2, idx3;
+    scalar equilibriumAngle, forceConstant;
 };
 
 
@@ -95,6 +95,10 @@ public:
         return angles;
     }
 
+    angle_configurations &getAngles() {
+        return angles;
+    }
+
     scalar calculateEnergy(const Vec3 &x_ji, const Vec3 &x_jk, const angle &angle) const;
 
     void
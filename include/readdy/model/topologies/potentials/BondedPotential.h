@@ -82,6 +82,10 @@ public:
         return bonds;
     }
 
+    bond_configurations &getBonds() {
+        return bonds;
+    }
+
 protected:
     bond_configurations bonds;
 };
@@ -83,6 +83,10 @@ public:
         return dihedrals;
     }
 
+    dihedral_configurations &getDihedrals() {
+        return dihedrals;
+    }
+
     scalar calculateEnergy(const Vec3 &x_ji, const Vec3 &x_kj, const Vec3 &x_kl, const dihedral_configuration &) const;
 
     void
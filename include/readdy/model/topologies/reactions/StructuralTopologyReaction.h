@@ -108,6 +108,10 @@ public:
      * rate function type, yielding a rate
      */
     using rate_function = std::function<scalar(const GraphTopology &)>;
+    /**
+     * batch rate function type, yielding one rate per topology
+     */
+    using batch_rate_function = std::function<std::vector<scalar>(const std::vector<const GraphTopology *> &)>;
 
     /**
      * creates a new instance by supplying a reaction function and a rate function
@@ -124,15 +128,42 @@ public:
      */
     StructuralTopologyReaction(std::string name, reaction_function reaction_function, scalar rate);
 
+    /**
+     * creates a new instance by supplying a reaction function and a batch rate function, which evaluates the rates of
+     * all topologies (of the reaction's topology type) whose rates need updating in one call
+     * @param name name of the reaction
+     * @param reaction_function the reaction function
+     * @param batch_rate_function the batch rate function
+     */
+    StructuralTopologyReaction(std::string name, reaction_function reaction_function,
+                               batch_rate_function batch_rate_function);
+
     /**
      * Evaluates the rate of this reaction for a given topology.
      * @param topology the topology
      * @return the rate
      */
     [[nodiscard]] scalar rate(const GraphTopology &topology) const {
+        if (_batch_rate_function) {
+            return rates({&topology}).front();
+        }
         return _rate_function(topology);
     }
 
+    /**
+     * Evaluates the rates of this reaction for several topologies, using the batch rate function if there is one.
+     * @param topologies the topologies
+     * @return the rates, one per topology
+     */
+    [[nodiscard]] std::vector<scalar> rates(const std::vector<const GraphTopology *> &topologies) const;
+
+    /**
+     * @return whether the rates of this reaction are evaluated in batches
+     */
+    [[nodiscard]] bool hasBatchRateFunction() const {
+        return static_cast<bool>(_batch_rate_function);
+    }
+
     /**
      * Yields a reaction recipe for a given topology.
      * @param topology the topology
@@ -183,12 +214,15 @@ public:
     }
 
     /**
-     * Executes the topology reaction on a topology and a kernel, possibly returns child topologies.
+     * Executes the topology reaction on a topology and a kernel, possibly returns child topologies. If the graph fell
+     * apart, the topology keeps its largest component and the remaining components are returned.
      * @param topology the topology
      * @param kernel the kernel
+     * @param provider provides the topologies that child topologies are built into, new ones if empty
      * @return a vector of child topologies if they were created in the process
      */
-    std::vector<GraphTopology> execute(GraphTopology &topology, const Kernel *kernel) const;
+    std::vector<GraphTopology> execute(GraphTopology &topology, const Kernel *kernel,
+                                       const TopologyProvider &provider = {}) const;
 
 private:
 
@@ -203,6 +237,10 @@ private:
      * the rate function responsible of calculating a rate for a given topology
      */
     rate_function _rate_function;
+    /**
+     * optional function calculating the rates of several topologies at once, takes precedence over _rate_function
+     */
+    batch_rate_function _batch_rate_function;
     /**
      * the execution mode
      */
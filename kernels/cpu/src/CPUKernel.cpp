@@ -74,7 +74,7 @@ void CPUKernel::initialize() {
     }
     for (auto &top : _stateModel.topologies()) {
         top->configure();
-        top->updateReactionRates(context().topologyRegistry().structuralReactionsOf(top->type()));
+        top->invalidateReactionRates();
     }
     _stateModel.reactionRecords().clear();
     _stateModel.resetReactionCounts();
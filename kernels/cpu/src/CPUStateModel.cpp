@@ -45,6 +45,7 @@
 
 #include <future>
 #include <readdy/kernel/cpu/CPUStateModel.h>
+#include <readdy/common/boundary_condition_operations.h>
 
 namespace readdy::kernel::cpu {
 
@@ -77,29 +78,67 @@ std::vector<readdy::model::Particle> CPUStateModel::getParticles() const {
     return result;
 }
 
+void CPUStateModel::forEachParticle(const ParticleVisitor &visitor) const {
+    for (const auto &entry : *getParticleData()) {
+        if (!entry.deactivated) visitor(entry.type, entry.id, entry.pos, entry.force);
+    }
+}
+
+void CPUStateModel::updateParticlePositions(const ParticlePositionUpdate &update) {
+    const auto &box = _context.get().boxSize().data();
+    const auto &pbc = _context.get().periodicBoundaryConditions().data();
+    for (auto &entry : *getParticleData()) {
+        if (!entry.deactivated) {
+            update(entry.type, entry.id, entry.pos);
+            bcs::fixPosition(entry.pos, box, pbc);
+        }
+    }
+}
+
 CPUStateModel::CPUStateModel(data_type &data, const readdy::model::Context &context, thread_pool &pool,
                              readdy::model::top::TopologyActionFactory const *const taf)
-        : _pool(pool), _context(context), _topologyActionFactory(*taf), _data(data) {
+        : _pool(pool), _context(context), _topologyActionFactory(*taf), _data(data),
+          _reorderConnection(data.reorderSignal().connect_scoped([this](const auto &oldToNew) {
+              for (auto &top : _topologies) {
+                  if (!top->isDeactivated()) {
+                      top->remapParticleIndices(oldToNew);
+                  }
+              }
+          })) {
     _neighborList = std::make_unique<neighbor_list>(_data.get(), _context.get(), _pool.get());
 }
 
+bool CPUStateModel::reorderDue() {
+    ++_updatesSinceReorder;
+    if (_reorderInterval > 0 && _updatesSinceReorder >= _reorderInterval) {
+        return true;
+    }
+    if (_reorderThreshold > 0) {
+        if (_localityAfterReorder < 0) {
+            return true;
+        }
+        const auto degraded = _localityAfterReorder + _reorderThreshold * (1 - _localityAfterReorder);
+        return _neighborList->cellChangeFraction() > degraded;
+    }
+    return false;
+}
+
+void CPUStateModel::reorderParticles() {
+    _data.get().mortonSort(_neighborList->cellSize());
+    _neighborList->update();
+    _updatesSinceReorder = 0;
+    _localityAfterReorder = _neighborList->cellChangeFraction();
+}
+
 readdy::model::top::GraphTopology *const
 CPUStateModel::addTopology(TopologyTypeId type, const std::vector<readdy::model::Particle> &particles) {
     std::vector<std::size_t> indices = getParticleData()->addTopologyParticles(particles);
 
-    readdy::model::top::Graph graph;
-    std::for_each(std::begin(indices), std::end(indices), [&graph](auto ix) {
-        graph.addVertex(readdy::model::top::VertexData{ix});
-    });
-
-    auto it = _topologies.push_back(std::make_unique<topology>(type, std::move(graph), _context.get(), this));
-    const auto idx = std::distance(topologies().begin(), it);
-    for(auto v : (*it)->graph().vertices()) {
-        if(!v.deactivated()) {
-            getParticleData()->entry_at(v->particleIndex).topology_index = idx;
-        }
+    auto top = spareTopology(type);
+    for (auto ix : indices) {
+        top.addVertex(readdy::model::top::VertexData{ix});
     }
-    return it->get();
+    return insert_topology(std::move(top));
 }
 
 std::vector<readdy::model::top::GraphTopology*> CPUStateModel::getTopologies() {
@@ -113,14 +152,59 @@ std::vector<readdy::model::top::GraphTopology*> CPUStateModel::getTopologies() {
     return result;
 }
 
-void CPUStateModel::insert_topology(CPUStateModel::topology &&top) {
+CPUStateModel::topology *CPUStateModel::insert_topology(CPUStateModel::topology &&top) {
+    if (auto *blank = _topologies.next_blank(); blank != nullptr && *blank) {
+        recycleTopology(std::move(*blank));
+    }
     auto it = _topologies.push_back(std::make_unique<topology>(std::move(top)));
     auto idx = std::distance(_topologies.begin(), it);
-    const auto& particles = it->get()->particleIndices();
     auto& data = *getParticleData();
-    std::for_each(particles.begin(), particles.end(), [idx, &data](auto index) {
-        data.entry_at(index).topology_index = idx;
+    for (const auto &v : (*it)->graph().vertices()) {
+        data.entry_at(v->particleIndex).topology_index = idx;
+    }
+    return it->get();
+}
+
+CPUStateModel::topology CPUStateModel::spareTopology(TopologyTypeId type) {
+    if (_topologyPool.empty()) {
+        return topology(type, {}, _context.get(), this);
+    }
+    // moving out of the pooled object takes over its storage
+    topology spare = std::move(*_topologyPool.back());
+    _topologyPool.pop_back();
+    _topologyPoolVertices -= static_cast<std::size_t>(std::distance(spare.graph().vertices().begin_persistent(),
+                                                                    spare.graph().vertices().end_persistent()));
+    spare.reset(type);
+    return spare;
+}
+
+void CPUStateModel::recycleTopology(topology_ref &&dead) {
+    const auto nVertices = static_cast<std::size_t>(std::distance(dead->graph().vertices().begin_persistent(),
+                                                                  dead->graph().vertices().end_persistent()));
+    // do not pin the storage of arbitrarily many or large dead topologies
+    if (_topologyPool.size() < topologyPoolCapacity
+        && _topologyPoolVertices + nVertices <= topologyPoolVertexCapacity) {
+        _topologyPoolVertices += nVertices;
+        _topologyPool.push_back(std::move(dead));
+    }
+}
+
+void CPUStateModel::compactTopologies(bool force) {
+    const auto nDeactivated = _topologies.n_deactivated();
+    if (nDeactivated == 0 || (!force && (nDeactivated < minDeactivatedForCompaction
+                                         || 2 * nDeactivated < _topologies.size()))) {
+        return;
+    }
+    auto mapping = _topologies.compact([this](topology_ref &&dead) {
+        if (dead) {
+            recycleTopology(std::move(dead));
+        }
     });
+    for (auto &entry : *getParticleData()) {
+        if (entry.topology_index >= 0) {
+            entry.topology_index = mapping.at(static_cast<std::size_t>(entry.topology_index));
+        }
+    }
 }
 
 void CPUStateModel::resetReactionCounts() {
@@ -160,6 +244,8 @@ void CPUStateModel::toDenseParticleIndices(std::vector<std::size_t>::iterator be
 void CPUStateModel::clear() {
     getParticleData()->clear();
     topologies().clear();
+    _topologyPool.clear();
+    _topologyPoolVertices = 0;
     reactionRecords().clear();
     resetReactionCounts();
     virial() = {};
@@ -51,6 +51,7 @@
 #include <readdy/kernel/cpu/actions/CPUBreakBonds.h>
 #include <readdy/kernel/cpu/actions/CPUActionReaction.h>
 #include <readdy/kernel/cpu/actions/CPUMiscActions.h>
+#include <readdy/kernel/cpu/actions/CPUCompiledStep.h>
 
 namespace core_p = readdy::model::actions;
 
@@ -133,6 +134,29 @@ std::unique_ptr<model::actions::InitializeKernel> CPUActionFactory::initializeKe
     return {std::make_unique<CPUInitializeKernel>(kernel)};
 }
 
+std::unique_ptr<model::actions::CompiledStep>
+CPUActionFactory::compiledStep(model::actions::TimeStepDependentAction *integrator,
+                               model::actions::UpdateNeighborList *updateNeighborList,
+                               model::actions::TimeStepDependentAction *reactionScheduler,
+                               model::actions::top::EvaluateTopologyReactions *topologyReactions,
+                               model::actions::CalculateForces *forces) const {
+    // the compiled step only knows the actions of this kernel, e.g., not the detailed balance scheduler or actions
+    // implemented in python
+    auto cpuIntegrator = dynamic_cast<CPUEulerBDIntegrator *>(integrator);
+    auto cpuUpdateNeighborList = dynamic_cast<CPUUpdateNeighborList *>(updateNeighborList);
+    auto gillespie = dynamic_cast<reactions::CPUGillespie *>(reactionScheduler);
+    auto uncontrolledApproximation = dynamic_cast<reactions::CPUUncontrolledApproximation *>(reactionScheduler);
+    auto cpuTopologyReactions = dynamic_cast<top::CPUEvaluateTopologyReactions *>(topologyReactions);
+    auto cpuForces = dynamic_cast<CPUCalculateForces *>(forces);
+    if (!cpuIntegrator || (updateNeighborList && !cpuUpdateNeighborList)
+        || (reactionScheduler && !gillespie && !uncontrolledApproximation)
+        || (topologyReactions && !cpuTopologyReactions) || (forces && !cpuForces)) {
+        return nullptr;
+    }
+    return {std::make_unique<CPUCompiledStep>(kernel, cpuIntegrator, cpuUpdateNeighborList, gillespie,
+                                              uncontrolledApproximation, cpuTopologyReactions, cpuForces)};
+}
+
 }
 }
 }
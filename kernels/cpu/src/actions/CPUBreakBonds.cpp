@@ -0,0 +1,205 @@
+/********************************************************************
+ * Copyright © 2019 Computational Molecular Biology Group,          *
+ *                  Freie Universität Berlin (GER)                  *
+ *                                                                  *
+ * Redistribution and use in source and binary forms, with or       *
+ * without modification, are permitted provided that the            *
+ * following conditions are met:                                    *
+ *  1. Redistributions of source code must retain the above         *
+ *     copyright notice, this list of conditions and the            *
+ *     following disclaimer.                                        *
+ *  2. Redistributions in binary form must reproduce the above      *
+ *     copyright notice, this list of conditions and the following  *
+ *     disclaimer in the documentation and/or other materials       *
+ *     provided with the distribution.                              *
+ *  3. Neither the name of the copyright holder nor the names of    *
+ *     its contributors may be used to endorse or promote products  *
+ *     derived from this software without specific                  *
+ *     prior written permission.                                    *
+ *                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND           *
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,      *
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF         *
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE         *
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR            *
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,         *
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER *
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,      *
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)    *
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF      *
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
+ ********************************************************************/
+
+
+/**
+ * Breakable pairs of particle types are indexed once in a dense table. Each step only the configured harmonic bond
+ * terms of the topologies, i.e., the ones that CalculateForces evaluates, are scanned for bonds between breakable
+ * types, whose energies are then evaluated in parallel. The resulting edge removals are applied sequentially.
+ *
+ * @file CPUBreakBonds.cpp
+ * @brief CPU kernel implementation of the action BreakBonds
+ * @author EricArkfeld
+ * @date 19.10.26
+ */
+
+#include <readdy/kernel/cpu/actions/CPUBreakBonds.h>
+
+namespace readdy::kernel::cpu::actions::top {
+
+void CPUBreakBonds::indexBreakableTypes() {
+    const auto &typeMapping = kernel->context().particleTypes().typeMapping();
+    std::size_t nTypes = 0;
+    for (const auto &[name, id] : typeMapping) {
+        nTypes = std::max(nTypes, static_cast<std::size_t>(id) + 1);
+    }
+    _nTypes = nTypes;
+    _breakable.clear();
+    _breakableIndex.assign(nTypes * nTypes, -1);
+    for (const auto &[types, threshold] : thresholdEnergies()) {
+        const auto [t1, t2] = types;
+        if (t1 >= nTypes || t2 >= nTypes) {
+            continue;
+        }
+        const auto idx = static_cast<std::ptrdiff_t>(_breakable.size());
+        _breakable.push_back({threshold, breakRates().at(types)});
+        _breakableIndex.at(t1 * nTypes + t2) = idx;
+        _breakableIndex.at(t2 * nTypes + t1) = idx;
+    }
+}
+
+void CPUBreakBonds::gatherBrokenBonds(std::size_t topologyBegin, std::size_t topologyEnd,
+                                      std::vector<BrokenBond> &broken) const {
+    const auto &topologies = kernel->getCPUKernelStateModel().topologies();
+    const auto &data = *kernel->getCPUKernelStateModel().getParticleData();
+    const auto &context = kernel->context();
+    const auto &boxSize = context.boxSize();
+    const auto &pbc = context.periodicBoundaryConditions();
+
+    std::vector<BondCandidate> candidates;
+    for (auto topologyIdx = topologyBegin; topologyIdx < topologyEnd; ++topologyIdx) {
+        const auto &top = topologies.at(topologyIdx);
+        if (top->isDeactivated()) {
+            continue;
+        }
+        candidates.clear();
+        for (const auto &bondedPotential : top->getBondedPotentials()) {
+            const auto *harmonicBond = dynamic_cast<const readdy::model::top::Topology::HarmonicBond *>(
+                    bondedPotential.get());
+            if (harmonicBond == nullptr) {
+                continue;
+            }
+            for (const auto &bond : harmonicBond->getBonds()) {
+                const auto &e1 = data.entry_at(bond.idx1);
+                const auto &e2 = data.entry_at(bond.idx2);
+                const auto breakableIdx = _breakableIndex[e1.type * _nTypes + e2.type];
+                if (breakableIdx < 0) {
+                    continue;
+                }
+                const auto x_ij = bcs::shortestDifference(e1.pos, e2.pos, boxSize, pbc);
+                candidates.push_back({std::min(bond.idx1, bond.idx2), std::max(bond.idx1, bond.idx2),
+                                      static_cast<std::size_t>(breakableIdx),
+                                      harmonicBond->calculateEnergy(x_ij, bond)});
+            }
+        }
+        if (candidates.empty()) {
+            continue;
+        }
+        // an edge can carry several bond terms, its energy is the sum over these
+        std::sort(candidates.begin(), candidates.end(), [](const auto &c1, const auto &c2) {
+            return std::tie(c1.particle1, c1.particle2) < std::tie(c2.particle1, c2.particle2);
+        });
+        for (auto it = candidates.begin(); it != candidates.end();) {
+            auto energy = it->energy;
+            auto next = std::next(it);
+            for (; next != candidates.end() && next->particle1 == it->particle1
+                   && next->particle2 == it->particle2; ++next) {
+                energy += next->energy;
+            }
+            const auto &breakable = _breakable[it->breakableIdx];
+            if (energy > breakable.thresholdEnergy) {
+                if (readdy::model::rnd::uniform_real() < 1 - std::exp(-breakable.rate * _timeStep)) {
+                    broken.push_back({topologyIdx, it->particle1, it->particle2});
+                }
+            }
+            it = next;
+        }
+    }
+}
+
+void CPUBreakBonds::perform() {
+    auto &model = kernel->getCPUKernelStateModel();
+    auto &topologies = model.topologies();
+    auto &particleData = *model.getParticleData();
+    if (topologies.empty() || thresholdEnergies().empty()) {
+        return;
+    }
+    if (_breakableIndex.empty()) {
+        indexBreakableTypes();
+    }
+
+    // bond terms only exist for configured topologies
+    for (auto &top : topologies) {
+        if (!top->isDeactivated() && top->getBondedPotentials().empty() && !top->graph().edges().empty()) {
+            top->configure();
+        }
+    }
+
+    std::vector<BrokenBond> broken;
+    {
+        auto &pool = kernel->pool();
+        const auto nThreads = kernel->getNThreads();
+        const auto grainSize = std::max<std::size_t>(topologies.size() / nThreads, 1);
+
+        std::vector<std::vector<BrokenBond>> threadBroken(nThreads);
+        std::vector<std::function<void(std::size_t)>> tasks;
+        tasks.reserve(nThreads);
+        std::size_t topologyIdx = 0;
+        for (std::size_t i = 0; i < nThreads && topologyIdx < topologies.size(); ++i) {
+            const auto next = i == nThreads - 1 ? topologies.size()
+                                                : std::min(topologyIdx + grainSize, topologies.size());
+            tasks.push_back(pool.pack([this, &threadBroken, i](std::size_t, std::size_t begin, std::size_t end) {
+                gatherBrokenBonds(begin, end, threadBroken[i]);
+            }, topologyIdx, next));
+            topologyIdx = next;
+        }
+        {
+            auto futures = pool.pushAll(std::move(tasks));
+            for (auto &future : futures) {
+                future.get();
+            }
+        }
+        // the tasks cover contiguous, increasing topology ranges, so the bonds stay grouped by topology
+        for (auto &buffer : threadBroken) {
+            broken.insert(broken.end(), buffer.begin(), buffer.end());
+        }
+    }
+
+    std::vector<readdy::model::top::GraphTopology> resultingTopologies;
+    for (auto it = broken.begin(); it != broken.end();) {
+        const auto topologyIdx = it->topologyIdx;
+        auto next = std::find_if(it, broken.end(), [topologyIdx](const auto &bond) {
+            return bond.topologyIdx != topologyIdx;
+        });
+        auto reactionFunction = [it, next](readdy::model::top::GraphTopology &t) {
+            readdy::model::top::reactions::Recipe recipe(t);
+            for (auto bond = it; bond != next; ++bond) {
+                recipe.removeEdge(t.vertexIndexForParticle(bond->particle1),
+                                  t.vertexIndexForParticle(bond->particle2));
+            }
+            return recipe;
+        };
+        scalar rateDoesntMatter{1.};
+        readdy::model::top::reactions::StructuralTopologyReaction reaction("__internal_break_bonds",
+                                                                           reactionFunction, rateDoesntMatter);
+        readdy::model::actions::top::executeStructuralReaction(topologies, resultingTopologies,
+                                                               topologies.at(topologyIdx), reaction, topologyIdx,
+                                                               particleData, kernel, model.topologyProvider());
+        it = next;
+    }
+
+    insertResultingTopologies(model, kernel, resultingTopologies);
+}
+
+}
@@ -44,6 +44,24 @@
 namespace readdy::kernel::cpu::actions {
 
 void CPUCalculateForces::perform() {
+    const auto computeVirial = kernel->context().recordVirial();
+    switch (_mode) {
+        case Mode::forcesAndEnergy:
+            computeVirial ? performImpl<Mode::forcesAndEnergy, true>() : performImpl<Mode::forcesAndEnergy, false>();
+            break;
+        case Mode::forces:
+            computeVirial ? performImpl<Mode::forces, true>() : performImpl<Mode::forces, false>();
+            break;
+        case Mode::energy:
+            computeVirial ? performImpl<Mode::energy, true>() : performImpl<Mode::energy, false>();
+            break;
+    }
+}
+
+template<CPUCalculateForces::Mode MODE, bool COMPUTE_VIRIAL>
+void CPUCalculateForces::performImpl() {
+    constexpr bool computeForces = MODE != Mode::energy;
+    constexpr bool computeEnergy = MODE != Mode::forces;
 
     const auto &ctx = kernel->context();
 
@@ -53,21 +71,25 @@ void CPUCalculateForces::perform() {
     auto taf = kernel->getTopologyActionFactory();
     auto &topologies = stateModel.topologies();
 
-    stateModel.energy() = 0;
-    stateModel.virial() = Matrix33{{{0, 0, 0, 0, 0, 0, 0, 0, 0}}};
+    if constexpr (computeEnergy) {
+        stateModel.energy() = 0;
+    }
+    if constexpr (computeForces) {
+        stateModel.virial() = Matrix33{{{0, 0, 0, 0, 0, 0, 0, 0, 0}}};
+    }
 
     const auto &potOrder1 = ctx.potentials().potentialsOrder1();
     const auto &potOrder2 = ctx.potentials().potentialsOrder2();
     if (!potOrder1.empty() || !potOrder2.empty() || !stateModel.topologies().empty()) {
-        {
-            // todo maybe optimize this by transposing data structure
+        if (computeForces && potOrder1.empty()) {
+            // otherwise the forces are reset while evaluating the first order potentials
             std::for_each(data->begin(), data->end(), [](auto &entry) {
                 entry.force = {0, 0, 0};
             });
         }
         {
             auto &pool = data->pool();
-            std::vector<std::promise<scalar>> promises;
+            std::vector<std::promise<ScalarAccumulator>> promises;
             std::vector<std::promise<Matrix33>> virialPromises;
             // 1st order pot + topologies = 2*pool size
             // 2nd order pot <= nl.nCells
@@ -81,6 +103,15 @@ void CPUCalculateForces::perform() {
                 virialPromises.reserve(!potOrder2.empty() ? nThreads : 0);
                 if (!potOrder1.empty()) {
                     // 1st order pot
+                    const auto gridSpacing = ctx.kernelConfiguration().cpu.externalPotentials.grid_spacing;
+                    if (gridSpacing > 0) {
+                        if (!potentialGrid || !potentialGrid->upToDate(potOrder1, ctx.boxSize(), gridSpacing)) {
+                            potentialGrid = std::make_unique<model::potentials::PotentialGrid>(
+                                    potOrder1, ctx.boxSize(), gridSpacing);
+                        }
+                    } else {
+                        potentialGrid.reset();
+                    }
                     std::vector<std::function<void(std::size_t)>> tasks;
                     tasks.reserve(nThreads);
 
@@ -91,16 +122,16 @@ void CPUCalculateForces::perform() {
                         if (it != itNext) {
                             promises.emplace_back();
                             auto dataBounds = std::make_tuple(it, itNext);
-                            tasks.push_back(pool.pack(calculateOrder1, dataBounds, std::ref(promises.back()), data,
-                                                      ctx.potentials().potentialsOrder1()));
+                            tasks.push_back(pool.pack(calculateOrder1<MODE>, dataBounds, std::ref(promises.back()),
+                                                      data, std::cref(potOrder1), potentialGrid.get()));
                         }
                         it = itNext;
                     }
                     if (it != data->end()) {
                         promises.emplace_back();
                         auto dataBounds = std::make_tuple(it, data->end());
-                        tasks.push_back(pool.pack(calculateOrder1, dataBounds, std::ref(promises.back()), data,
-                                                  ctx.potentials().potentialsOrder1()));
+                        tasks.push_back(pool.pack(calculateOrder1<MODE>, dataBounds, std::ref(promises.back()), data,
+                                                  std::cref(potOrder1), potentialGrid.get()));
                     }
                     {
                         auto futures = pool.pushAll(std::move(tasks));
@@ -121,15 +152,16 @@ void CPUCalculateForces::perform() {
                         if (it != itNext) {
                             promises.emplace_back();
                             auto bounds = std::make_tuple(it, itNext);
-                            tasks.push_back(
-                                    pool.pack(calculateTopologies, bounds, taf, std::ref(promises.back())));
+                            tasks.push_back(pool.pack(calculateTopologies<MODE>, bounds, taf, data,
+                                                      std::ref(promises.back())));
                         }
                         it = itNext;
                     }
                     if (it != topologies.cend()) {
                         promises.emplace_back();
                         auto bounds = std::make_tuple(it, topologies.cend());
-                        tasks.push_back(pool.pack(calculateTopologies, bounds, taf, std::ref(promises.back())));
+                        tasks.push_back(pool.pack(calculateTopologies<MODE>, bounds, taf, data,
+                                                  std::ref(promises.back())));
                     }
                     {
                         auto futures = pool.pushAll(std::move(tasks));
@@ -141,6 +173,8 @@ void CPUCalculateForces::perform() {
                     }
                 }
                 if (!potOrder2.empty()) {
+                    // the virial is made up of forces and therefore not available in the energy-only mode
+                    auto order2 = calculateOrder2<MODE, computeForces && COMPUTE_VIRIAL>;
                     std::vector<std::function<void(std::size_t)>> tasks;
                     tasks.reserve(nThreads);
                     auto granularity = nThreads;
@@ -151,40 +185,22 @@ void CPUCalculateForces::perform() {
                         if (it != itNext) {
                             promises.emplace_back();
                             virialPromises.emplace_back();
-                            if(ctx.recordVirial()) {
-                                tasks.push_back(pool.pack(
-                                        calculateOrder2<true>, std::make_tuple(it, itNext), data,
-                                        std::cref(*neighborList), std::ref(promises.back()),
-                                        std::ref(virialPromises.back()), ctx.potentials().potentialsOrder2(),
-                                        ctx.boxSize(), ctx.periodicBoundaryConditions()
-                                ));
-                            } else {
-                                tasks.push_back(pool.pack(
-                                        calculateOrder2<false>, std::make_tuple(it, itNext), data,
-                                        std::cref(*neighborList), std::ref(promises.back()),
-                                        std::ref(virialPromises.back()), ctx.potentials().potentialsOrder2(),
-                                        ctx.boxSize(), ctx.periodicBoundaryConditions()
-                                ));
-                            }
+                            tasks.push_back(pool.pack(
+                                    order2, std::make_tuple(it, itNext), data, std::cref(*neighborList),
+                                    std::ref(promises.back()), std::ref(virialPromises.back()),
+                                    std::cref(potOrder2), ctx.boxSize(), ctx.periodicBoundaryConditions()
+                            ));
                         }
                         it = itNext;
                     }
                     if (it != nCells) {
                         promises.emplace_back();
                         virialPromises.emplace_back();
-                        if(ctx.recordVirial()) {
-                            tasks.push_back(pool.pack(
-                                    calculateOrder2<true>, std::make_tuple(it, nCells), data, std::cref(*neighborList),
-                                    std::ref(promises.back()), std::ref(virialPromises.back()),
-                                    ctx.potentials().potentialsOrder2(), ctx.boxSize(), ctx.periodicBoundaryConditions()
-                            ));
-                        } else {
-                            tasks.push_back(pool.pack(
-                                    calculateOrder2<false>, std::make_tuple(it, nCells), data, std::cref(*neighborList),
-                                    std::ref(promises.back()), std::ref(virialPromises.back()),
-                                    ctx.potentials().potentialsOrder2(), ctx.boxSize(), ctx.periodicBoundaryConditions()
-                            ));
-                        }
+                        tasks.push_back(pool.pack(
+                                order2, std::make_tuple(it, nCells), data, std::cref(*neighborList),
+                                std::ref(promises.back()), std::ref(virialPromises.back()),
+                                std::cref(potOrder2), ctx.boxSize(), ctx.periodicBoundaryConditions()
+                        ));
                     }
                     {
                         auto futures = pool.pushAll(std::move(tasks));
@@ -199,25 +215,31 @@ void CPUCalculateForces::perform() {
 
             {
                 for (auto &f : promises) {
-                    stateModel.energy() += f.get_future().get();
+                    const auto energy = f.get_future().get();
+                    if constexpr (computeEnergy) {
+                        stateModel.energy() += energy;
+                    }
                 }
             }
             {
                 for (auto &f : virialPromises) {
-                    stateModel.virial() += f.get_future().get();
+                    const auto virial = f.get_future().get();
+                    if constexpr (computeForces) {
+                        stateModel.virial() += virial;
+                    }
                 }
             }
         }
     }
 }
 
-template<bool COMPUTE_VIRIAL>
+template<CPUCalculateForces::Mode MODE, bool COMPUTE_VIRIAL>
 void CPUCalculateForces::calculateOrder2(std::size_t, nl_bounds nlBounds,
                                          CPUStateModel::data_type *data, const CPUStateModel::neighbor_list &nl,
-                                         std::promise<scalar> &energyPromise, std::promise<Matrix33> &virialPromise,
-                                         model::potentials::PotentialRegistry::PotentialsO2Map pot2,
+                                         std::promise<ScalarAccumulator> &energyPromise, std::promise<Matrix33> &virialPromise,
+                                         const model::potentials::PotentialRegistry::PotentialsO2Map &pot2,
                                          model::Context::BoxSize box, model::Context::PeriodicBoundaryConditions pbc) {
-    scalar energyUpdate = 0.0;
+    ScalarAccumulator energyUpdate = 0.0;
     Matrix33 virialUpdate{{{0, 0, 0, 0, 0, 0, 0, 0, 0}}};
 
     for (auto cell = std::get<0>(nlBounds); cell < std::get<1>(nlBounds); ++cell) {
@@ -241,11 +263,19 @@ void CPUCalculateForces::calculateOrder2(std::size_t, nl_bounds nlBounds,
                         auto distSquared = x_ij * x_ij;
                         for (const auto &potential : potit->second) {
                             if (distSquared < potential->getCutoffRadiusSquared()) {
-                                Vec3 forceUpdate{0, 0, 0};
-                                potential->calculateForceAndEnergy(forceUpdate, mySecondOrderEnergy, x_ij);
-                                force += forceUpdate;
-                                if(COMPUTE_VIRIAL && *particleIt < neighborIndex) {
-                                    virialUpdate += math::outerProduct<Matrix33>(-1.*x_ij, forceUpdate);
+                                if constexpr (MODE == Mode::energy) {
+                                    mySecondOrderEnergy += potential->calculateEnergy(x_ij);
+                                } else {
+                                    Vec3 forceUpdate{0, 0, 0};
+                                    if constexpr (MODE == Mode::forcesAndEnergy) {
+                                        potential->calculateForceAndEnergy(forceUpdate, mySecondOrderEnergy, x_ij);
+                                    } else {
+                                        potential->calculateForce(forceUpdate, x_ij);
+                                    }
+                                    force += forceUpdate;
+                                    if (COMPUTE_VIRIAL && *particleIt < neighborIndex) {
+                                        virialUpdate += math::outerProduct<Matrix33>(-1. * x_ij, forceUpdate);
+                                    }
                                 }
                             }
                         }
@@ -267,13 +297,22 @@ void CPUCalculateForces::calculateOrder2(std::size_t, nl_bounds nlBounds,
 
 }
 
+template<CPUCalculateForces::Mode MODE>
 void CPUCalculateForces::calculateTopologies(std::size_t, top_bounds topBounds,
-                                             model::top::TopologyActionFactory *taf,
-                                             std::promise<scalar> &energyPromise) {
-    scalar energyUpdate = 0.0;
+                                             model::top::TopologyActionFactory *taf, CPUStateModel::data_type *data,
+                                             std::promise<ScalarAccumulator> &energyPromise) {
+    ScalarAccumulator energyUpdate = 0.0;
+    std::vector<Vec3> forceBackup;
     for (auto it = std::get<0>(topBounds); it != std::get<1>(topBounds); ++it) {
         const auto &top = *it;
         if (!top->isDeactivated()) {
+            // the topology potential actions always update the forces, in the energy-only mode they are restored
+            const auto particles = MODE == Mode::energy ? top->particleIndices()
+                                                        : decltype(top->particleIndices()){};
+            forceBackup.clear();
+            for (auto particle : particles) {
+                forceBackup.push_back(data->entry_at(particle).force);
+            }
             for (const auto &bondedPot : top->getBondedPotentials()) {
                 auto energy = bondedPot->createForceAndEnergyAction(taf)->perform(top.get());
                 energyUpdate += energy;
@@ -286,31 +325,63 @@ void CPUCalculateForces::calculateTopologies(std::size_t, top_bounds topBounds,
                 auto energy = torsionPot->createForceAndEnergyAction(taf)->perform(top.get());
                 energyUpdate += energy;
             }
+            for (std::size_t i = 0; i < particles.size(); ++i) {
+                data->entry_at(particles[i]).force = forceBackup[i];
+            }
         }
     }
 
     energyPromise.set_value(energyUpdate);
 }
 
+template<CPUCalculateForces::Mode MODE>
 void CPUCalculateForces::calculateOrder1(std::size_t, data_bounds dataBounds,
-                                         std::promise<scalar> &energyPromise, CPUStateModel::data_type *data,
-                                         model::potentials::PotentialRegistry::PotentialsO1Map pot1) {
-    scalar energyUpdate = 0.0;
+                                         std::promise<ScalarAccumulator> &energyPromise, CPUStateModel::data_type *data,
+                                         const model::potentials::PotentialRegistry::PotentialsO1Map &pot1,
+                                         const model::potentials::PotentialGrid *grid) {
+    ScalarAccumulator energyUpdate = 0.0;
+
+    auto evaluate = [](const auto &potentials, const Vec3 &pos, Vec3 &force, scalar &energy) {
+        for (const auto &potential : potentials) {
+            if constexpr (MODE == Mode::forcesAndEnergy) {
+                potential->calculateForceAndEnergy(force, energy, pos);
+            } else if constexpr (MODE == Mode::forces) {
+                potential->calculateForce(force, pos);
+            } else {
+                energy += potential->calculateEnergy(pos);
+            }
+        }
+    };
 
     for (auto it = std::get<0>(dataBounds); it != std::get<1>(dataBounds); ++it) {
         auto &entry = *it;
+        Vec3 force{0., 0., 0.};
         if (!entry.deactivated) {
-            auto &force = entry.force;
-            force = {0., 0., 0.};
             const auto &myPos = entry.pos;
-            auto find_it = pot1.find(entry.type);
-            if (find_it != pot1.end()) {
-                for (const auto &potential : find_it->second) {
-                    potential->calculateForceAndEnergy(force, energyUpdate, myPos);
+            scalar myEnergy = 0.;
+            // the grid always interpolates both, force and energy
+            if (grid && grid->calculateForceAndEnergy(entry.type, myPos, force, myEnergy)) {
+                evaluate(grid->exactPotentials(entry.type), myPos, force, myEnergy);
+            } else {
+                auto find_it = pot1.find(entry.type);
+                if (find_it != pot1.end()) {
+                    evaluate(find_it->second, myPos, force, myEnergy);
                 }
             }
+            energyUpdate += myEnergy;
+        }
+        if constexpr (MODE != Mode::energy) {
+            entry.force = force;
         }
     }
     energyPromise.set_value(energyUpdate);
 }
+
+template void CPUCalculateForces::performImpl<CPUCalculateForces::Mode::forcesAndEnergy, true>();
+template void CPUCalculateForces::performImpl<CPUCalculateForces::Mode::forcesAndEnergy, false>();
+template void CPUCalculateForces::performImpl<CPUCalculateForces::Mode::forces, true>();
+template void CPUCalculateForces::performImpl<CPUCalculateForces::Mode::forces, false>();
+template void CPUCalculateForces::performImpl<CPUCalculateForces::Mode::energy, true>();
+template void CPUCalculateForces::performImpl<CPUCalculateForces::Mode::energy, false>();
+
 }
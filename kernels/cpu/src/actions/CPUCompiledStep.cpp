@@ -0,0 +1,127 @@
+/********************************************************************
+ * Copyright © 2018 Computational Molecular Biology Group,          *
+ *                  Freie Universität Berlin (GER)                  *
+ *                                                                  *
+ * Redistribution and use in source and binary forms, with or       *
+ * without modification, are permitted provided that the            *
+ * following conditions are met:                                    *
+ *  1. Redistributions of source code must retain the above         *
+ *     copyright notice, this list of conditions and the            *
+ *     following disclaimer.                                        *
+ *  2. Redistributions in binary form must reproduce the above      *
+ *     copyright notice, this list of conditions and the following  *
+ *     disclaimer in the documentation and/or other materials       *
+ *     provided with the distribution.                              *
+ *  3. Neither the name of the copyright holder nor the names of    *
+ *     its contributors may be used to endorse or promote products  *
+ *     derived from this software without specific                  *
+ *     prior written permission.                                    *
+ *                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND           *
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,      *
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF         *
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE         *
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR            *
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,         *
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER *
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,      *
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)    *
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF      *
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
+ ********************************************************************/
+
+
+/**
+ * @file CPUCompiledStep.cpp
+ * @brief CPU kernel implementation of the compiled simulation step
+ * @author EricArkfeld
+ * @date 19.10.26
+ * @copyright BSD-3
+ */
+
+#include <readdy/kernel/cpu/actions/CPUCompiledStep.h>
+
+namespace readdy::kernel::cpu::actions {
+
+CPUCompiledStep::CPUCompiledStep(CPUKernel *kernel, CPUEulerBDIntegrator *integrator,
+                                 CPUUpdateNeighborList *updateNeighborList, reactions::CPUGillespie *gillespie,
+                                 reactions::CPUUncontrolledApproximation *uncontrolledApproximation,
+                                 top::CPUEvaluateTopologyReactions *topologyReactions, CPUCalculateForces *forces)
+        : kernel(kernel), integrator(integrator), updateNeighborList(updateNeighborList), gillespie(gillespie),
+          uncontrolledApproximation(uncontrolledApproximation), topologyReactions(topologyReactions),
+          forces(forces) {
+    const auto &ctx = kernel->context();
+    const bool hasReactions = (gillespie || uncontrolledApproximation)
+                              && (ctx.reactions().nOrder1() > 0 || ctx.reactions().nOrder2() > 0);
+    const std::array<bool, nFlags> flags{
+            hasReactions && ctx.recordReactionCounts(),
+            hasReactions && ctx.recordReactionsWithPositions(),
+            ctx.recordVirial(),
+            updateNeighborList != nullptr,
+            topologyReactions != nullptr,
+            forces != nullptr
+    };
+    if (!hasReactions) {
+        selectStep<void>(flags);
+    } else if (gillespie) {
+        selectStep<reactions::CPUGillespie>(flags);
+    } else {
+        selectStep<reactions::CPUUncontrolledApproximation>(flags);
+    }
+}
+
+template<typename Reactions, bool... FLAGS>
+void CPUCompiledStep::selectStep(const std::array<bool, nFlags> &flags) {
+    if constexpr (sizeof...(FLAGS) == nFlags) {
+        _step = &CPUCompiledStep::step<Reactions, FLAGS...>;
+    } else if (flags[sizeof...(FLAGS)]) {
+        selectStep<Reactions, FLAGS..., true>(flags);
+    } else {
+        selectStep<Reactions, FLAGS..., false>(flags);
+    }
+}
+
+template<typename Reactions>
+Reactions *CPUCompiledStep::reactionScheduler() const {
+    if constexpr (std::is_same_v<Reactions, reactions::CPUGillespie>) {
+        return gillespie;
+    } else {
+        return uncontrolledApproximation;
+    }
+}
+
+template<typename Reactions, bool RECORD_COUNTS, bool RECORD_POSITIONS, bool COMPUTE_VIRIAL, bool NEIGHBOR_LIST,
+         bool TOPOLOGY_REACTIONS, bool FORCES>
+void CPUCompiledStep::step() {
+    // qualified calls, so that none of the phases is dispatched virtually
+    integrator->CPUEulerBDIntegrator::perform();
+    if constexpr (NEIGHBOR_LIST) {
+        updateNeighborList->CPUUpdateNeighborList::perform();
+    }
+    if constexpr (!std::is_void_v<Reactions>) {
+        reactionScheduler<Reactions>()->template performImpl<RECORD_COUNTS, RECORD_POSITIONS>();
+    }
+    if constexpr (TOPOLOGY_REACTIONS) {
+        topologyReactions->top::CPUEvaluateTopologyReactions::perform();
+    }
+    if constexpr (NEIGHBOR_LIST) {
+        updateNeighborList->CPUUpdateNeighborList::perform();
+    }
+    if constexpr (FORCES) {
+        switch (forces->mode()) {
+            case Mode::forcesAndEnergy:
+                forces->performImpl<Mode::forcesAndEnergy, COMPUTE_VIRIAL>();
+                break;
+            case Mode::forces:
+                forces->performImpl<Mode::forces, COMPUTE_VIRIAL>();
+                break;
+            case Mode::energy:
+                forces->performImpl<Mode::energy, COMPUTE_VIRIAL>();
+                break;
+        }
+    }
+}
+
+}
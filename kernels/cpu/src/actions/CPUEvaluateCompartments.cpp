@@ -52,23 +52,39 @@ CPUEvaluateCompartments::CPUEvaluateCompartments(CPUKernel *const kernel) : kern
 void CPUEvaluateCompartments::perform() {
     if (!kernel->context().compartments().empty()) {
         const auto &ctx = kernel->context();
-        const auto &compartments = ctx.compartments().get();
-        for (auto &e: *kernel->getCPUKernelStateModel().getParticleData()) {
-            if (!e.deactivated) {
-                for (const auto &compartment: compartments) {
-                    if (compartment->isContained(e.pos)) {
-                        const auto &conversions = compartment->getConversions();
-                        const auto convIt = conversions.find(e.type);
-                        if (convIt != conversions.end()) {
-                            e.type = (*convIt).second;
-                        }
-                    }
+        if (!grid || !grid->upToDate(ctx.compartments(), ctx.particleTypes(), ctx.boxSize())) {
+            grid = std::make_unique<readdy::model::compartments::CompartmentGrid>(
+                    ctx.compartments(), ctx.particleTypes(), ctx.boxSize());
+        }
+
+        auto &data = *kernel->getCPUKernelStateModel().getParticleData();
+        auto &pool = kernel->pool();
+        const auto nThreads = kernel->getNThreads();
+        const auto grainSize = std::max<std::size_t>(data.size() / nThreads, 1);
+
+        auto evaluate = [&data, &grid = *grid](std::size_t, std::size_t begin, std::size_t end) {
+            for (auto i = begin; i < end; ++i) {
+                auto &e = data.entry_at(i);
+                if (!e.deactivated) {
+                    e.type = grid.convert(e.pos, e.type);
                 }
             }
+        };
+
+        std::vector<std::function<void(std::size_t)>> tasks;
+        tasks.reserve(nThreads);
+        std::size_t index = 0;
+        for (std::size_t i = 0; i < nThreads && index < data.size(); ++i) {
+            const auto next = i == nThreads - 1 ? data.size() : std::min(index + grainSize, data.size());
+            tasks.push_back(pool.pack(evaluate, index, next));
+            index = next;
+        }
+        auto futures = pool.pushAll(std::move(tasks));
+        for (auto &future : futures) {
+            future.get();
         }
     }
 }
-
 }
 }
 }
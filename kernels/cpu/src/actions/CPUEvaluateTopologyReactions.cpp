@@ -160,7 +160,7 @@ void CPUEvaluateTopologyReactions::perform() {
                 for (auto &&top : new_topologies) {
                     if (!top.isNormalParticle(*kernel)) {
                         // we have a new topology here, update data accordingly.
-                        top.updateReactionRates(context.topologyRegistry().structuralReactionsOf(top.type()));
+                        top.invalidateReactionRates();
                         top.configure();
                         model.insert_topology(std::move(top));
                     } else {
@@ -177,6 +177,8 @@ void CPUEvaluateTopologyReactions::perform() {
                 }
             }
         }
+        // all events of this step are processed, so topology indices may be translated now
+        model.compactTopologies();
     }
 }
 
@@ -188,15 +190,18 @@ void CPUEvaluateTopologyReactions::handleStructuralReactionEvent(CPUStateModel::
     const auto &context = kernel->context();
     const auto &reactions = context.topologyRegistry().structuralReactionsOf(topology->type());
     const auto &reaction = reactions.at(static_cast<std::size_t>(event.reaction_idx));
+    auto &model = kernel->getCPUKernelStateModel();
     readdy::model::actions::top::executeStructuralReaction(topologies, new_topologies, topology, reaction,
-                                                           event.topology_idx,
-                                                           *(kernel->getCPUKernelStateModel().getParticleData()),
-                                                           kernel);
+                                                           event.topology_idx, *model.getParticleData(), kernel,
+                                                           model.topologyProvider());
 }
 
 CPUEvaluateTopologyReactions::topology_reaction_events CPUEvaluateTopologyReactions::gatherEvents() {
     topology_reaction_events events;
     const auto &topology_types = kernel->context().topologyRegistry();
+    // only topologies that changed since their rates were last evaluated need new rates
+    readdy::model::actions::top::updateStructuralReactionRates(kernel->getCPUKernelStateModel().topologies(),
+                                                               topology_types);
     {
         rate_t current_cumulative_rate = 0;
         std::size_t topology_idx = 0;
@@ -219,121 +224,153 @@ CPUEvaluateTopologyReactions::topology_reaction_events CPUEvaluateTopologyReacti
             ++topology_idx;
         }
 
-        const auto &context = kernel->context();
+        if (!kernel->context().topologyRegistry().spatialReactionRegistry().empty()) {
+            const auto &nl = *kernel->getCPUKernelStateModel().getNeighborList();
+            auto &pool = kernel->pool();
+            const auto nThreads = kernel->getNThreads();
+            const auto grainSize = std::max<std::size_t>(nl.nCells() / nThreads, 1);
+
+            // every task collects the events of a contiguous range of cells into its own buffer
+            std::vector<topology_reaction_events> threadEvents(nThreads);
+            std::vector<std::function<void(std::size_t)>> tasks;
+            tasks.reserve(nThreads);
+            std::size_t cell = 0;
+            for (std::size_t i = 0; i < nThreads && cell < nl.nCells(); ++i) {
+                const auto cellNext = i == nThreads - 1 ? nl.nCells() : std::min(cell + grainSize, nl.nCells());
+                tasks.push_back(pool.pack([this, &threadEvents, i](std::size_t, std::size_t begin, std::size_t end) {
+                    readdy::model::top::Graph::DistanceScratch scratch;
+                    gatherSpatialEvents(begin, end, threadEvents[i], scratch);
+                }, cell, cellNext));
+                cell = cellNext;
+            }
+            {
+                auto futures = pool.pushAll(std::move(tasks));
+                for (auto &future : futures) {
+                    future.get();
+                }
+            }
+
+            std::size_t nEvents = events.size();
+            for (const auto &buffer : threadEvents) {
+                nEvents += buffer.size();
+            }
+            events.reserve(nEvents);
+            for (auto &buffer : threadEvents) {
+                events.insert(events.end(), buffer.begin(), buffer.end());
+            }
+        }
+    }
+    return events;
+}
 
-        static const CPUStateModel::topology_ref EMPTY_TOP{};
+void CPUEvaluateTopologyReactions::gatherSpatialEvents(std::size_t cellBegin, std::size_t cellEnd,
+                                                       topology_reaction_events &events,
+                                                       readdy::model::top::Graph::DistanceScratch &scratch) const {
+    const auto &context = kernel->context();
+    const auto &model = kernel->getCPUKernelStateModel();
+    const auto &top_registry = context.topologyRegistry();
+    const auto &box = context.boxSize().data();
+    const auto &pbc = context.periodicBoundaryConditions().data();
+    const auto &data = *model.getParticleData();
+    const auto &nl = *model.getNeighborList();
+    const auto &topologies = model.topologies();
+
+    for (std::size_t cell = cellBegin; cell < cellEnd; ++cell) {
+        for (auto itParticle = nl.particlesBegin(cell); itParticle != nl.particlesEnd(cell); ++itParticle) {
+            const auto &entry = data.entry_at(*itParticle);
+            if (!entry.deactivated && top_registry.isSpatialReactionType(entry.type)) {
+                const auto entryTopologyDeactivated = topologyDeactivated(entry.topology_index);
+                const auto hasEntryTop = entry.topology_index >= 0 && !entryTopologyDeactivated;
+                TopologyTypeId tt1 = hasEntryTop ? topologies.at(static_cast<std::size_t>(entry.topology_index))->type()
+                                                 : static_cast<TopologyTypeId>(-1);
+
+                nl.forEachNeighbor(*itParticle, cell, [&](std::size_t neighborIndex) {
+                    const auto &neighbor = data.entry_at(neighborIndex);
+                    const auto neighborTopDeactivated = topologyDeactivated(neighbor.topology_index);
+                    const auto hasNeighborTop = neighbor.topology_index >= 0 && !neighborTopDeactivated;
+                    if ((!hasEntryTop && !hasNeighborTop) || (hasNeighborTop && *itParticle > neighborIndex)) {
+                        // use symmetry or skip entirely
+                        return;
+                    }
+                    TopologyTypeId tt2 = hasNeighborTop ? topologies.at(
+                            static_cast<std::size_t>(neighbor.topology_index))->type()
+                                                        : static_cast<TopologyTypeId>(-1);
 
-        if (!context.topologyRegistry().spatialReactionRegistry().empty()) {
-            const auto &model = kernel->getCPUKernelStateModel();
-            const auto &top_registry = context.topologyRegistry();
-            const auto &box = context.boxSize().data();
-            const auto &pbc = context.periodicBoundaryConditions().data();
-            const auto &data = *kernel->getCPUKernelStateModel().getParticleData();
-            const auto &nl = *kernel->getCPUKernelStateModel().getNeighborList();
-            const auto &topologies = kernel->getCPUKernelStateModel().topologies();
-
-            for (std::size_t cell = 0; cell < nl.nCells(); ++cell) {
-                for (auto itParticle = nl.particlesBegin(cell); itParticle != nl.particlesEnd(cell); ++itParticle) {
-                    const auto &entry = data.entry_at(*itParticle);
-                    if (!entry.deactivated && top_registry.isSpatialReactionType(entry.type)) {
-                        const auto entryTopologyDeactivated = topologyDeactivated(entry.topology_index);
-                        const auto hasEntryTop = entry.topology_index >= 0 && !entryTopologyDeactivated;
-
-                        nl.forEachNeighbor(*itParticle, cell, [&](std::size_t neighborIndex) {
-                            const auto &neighbor = data.entry_at(neighborIndex);
-                            const auto neighborTopDeactivated = topologyDeactivated(neighbor.topology_index);
-                            const auto hasNeighborTop = neighbor.topology_index >= 0 && !neighborTopDeactivated;
-                            if ((!hasEntryTop && !hasNeighborTop) || (hasNeighborTop && *itParticle > neighborIndex)) {
-                                // use symmetry or skip entirely
-                                return;
+                    const auto &reactions = top_registry.spatialReactionsByType(entry.type, tt1, neighbor.type, tt2);
+                    if (reactions.empty()) {
+                        return;
+                    }
+                    const auto distSquared = bcs::distSquared(entry.pos, neighbor.pos, box, pbc);
+                    std::size_t reaction_index = 0;
+                    for (const auto &reaction : reactions) {
+                        if (!reaction.allow_self_connection() &&
+                            entry.topology_index == neighbor.topology_index) {
+                            ++reaction_index;
+                            continue;
+                        }
+                        if (distSquared < reaction.radius() * reaction.radius()) {
+                            TREvent event{};
+                            event.reactionId = reaction.id();
+                            if (hasEntryTop && !hasNeighborTop) {
+                                // entry is a topology, neighbor an ordinary particle
+                                event.topology_idx = static_cast<std::size_t>(entry.topology_index);
+                                event.t1 = entry.type;
+                                event.t2 = neighbor.type;
+                                event.idx1 = *itParticle;
+                                event.idx2 = neighborIndex;
+                                event.rate = reaction.rate();
+                            } else if (!hasEntryTop && hasNeighborTop) {
+                                // neighbor is a topology, entry an ordinary particle
+                                event.topology_idx = static_cast<std::size_t>(neighbor.topology_index);
+                                event.t1 = neighbor.type;
+                                event.t2 = entry.type;
+                                event.idx1 = neighborIndex;
+                                event.idx2 = *itParticle;
+                                event.rate = reaction.rate();
+                            } else if (hasEntryTop && hasNeighborTop) {
+                                // this is a topology-topology fusion
+                                event.topology_idx = static_cast<std::size_t>(entry.topology_index);
+                                event.topology_idx2 = static_cast<std::size_t>(neighbor.topology_index);
+                                event.t1 = entry.type;
+                                event.t2 = neighbor.type;
+                                event.idx1 = *itParticle;
+                                event.idx2 = neighborIndex;
+                                event.rate = reaction.rate(
+                                        *topologies.at(event.topology_idx),
+                                        *topologies.at(event.topology_idx2)
+                                );
+                            } else {
+                                log::critical("got no topology for topology-fusion");
                             }
-                            TopologyTypeId tt1 = hasEntryTop ? topologies.at(
-                                    static_cast<std::size_t>(entry.topology_index))->type()
-                                                             : static_cast<TopologyTypeId>(-1);
-                            TopologyTypeId tt2 = hasNeighborTop ? topologies.at(
-                                    static_cast<std::size_t>(neighbor.topology_index))->type()
-                                                                : static_cast<TopologyTypeId>(-1);
-
-                            const auto distSquared = bcs::distSquared(entry.pos, neighbor.pos, box, pbc);
-                            std::size_t reaction_index = 0;
-                            const auto &otherTop = hasNeighborTop ? model.topologies().at(
-                                    static_cast<std::size_t>(neighbor.topology_index)
-                            ) : EMPTY_TOP;
-                            const auto &reactions = top_registry.spatialReactionsByType(entry.type, tt1,
-                                                                                        neighbor.type, tt2);
-                            for (const auto &reaction : reactions) {
-                                if (!reaction.allow_self_connection() &&
-                                    entry.topology_index == neighbor.topology_index) {
+                            event.cumulativeRate = event.rate;
+                            if (reaction.allow_self_connection() &&
+                                entry.topology_index == neighbor.topology_index) {
+                                const auto &topol = topologies.at(static_cast<std::size_t>(neighbor.topology_index));
+                                const readdy::model::top::Graph &gr = topol->graph();
+                                const auto &v1 = topol->vertexIteratorForParticle(event.idx1);
+                                const auto &v2 = topol->vertexIteratorForParticle(event.idx2);
+                                // only distances up to the largest forbidden one matter, bound the search accordingly
+                                const auto minDistance = static_cast<std::int32_t>(reaction.min_graph_distance());
+                                const auto maxDepth = context.legacyTopologySelfFusion() ? minDistance
+                                                                                         : std::max(minDistance, 1);
+                                auto d = gr.graphDistance(v1, v2, maxDepth, scratch);
+                                if ((d != -1 && d <= minDistance) ||
+                                    (!context.legacyTopologySelfFusion() && d == 1)) {
                                     ++reaction_index;
                                     continue;
                                 }
-                                if (distSquared < reaction.radius() * reaction.radius()) {
-                                    TREvent event{};
-                                    event.reactionId = reaction.id();
-                                    current_cumulative_rate = event.cumulativeRate;
-                                    if (hasEntryTop && !hasNeighborTop) {
-                                        // entry is a topology, neighbor an ordinary particle
-                                        event.topology_idx = static_cast<std::size_t>(entry.topology_index);
-                                        event.t1 = entry.type;
-                                        event.t2 = neighbor.type;
-                                        event.idx1 = *itParticle;
-                                        event.idx2 = neighborIndex;
-                                        event.rate = reaction.rate();
-                                        event.cumulativeRate = event.rate + current_cumulative_rate;
-                                    } else if (!hasEntryTop && hasNeighborTop) {
-                                        // neighbor is a topology, entry an ordinary particle
-                                        event.topology_idx = static_cast<std::size_t>(neighbor.topology_index);
-                                        event.t1 = neighbor.type;
-                                        event.t2 = entry.type;
-                                        event.idx1 = neighborIndex;
-                                        event.idx2 = *itParticle;
-                                        event.rate = reaction.rate();
-                                        event.cumulativeRate = event.rate + current_cumulative_rate;
-                                    } else if (hasEntryTop && hasNeighborTop) {
-                                        // this is a topology-topology fusion
-                                        event.topology_idx = static_cast<std::size_t>(entry.topology_index);
-                                        event.topology_idx2 = static_cast<std::size_t>(neighbor.topology_index);
-                                        event.t1 = entry.type;
-                                        event.t2 = neighbor.type;
-                                        event.idx1 = *itParticle;
-                                        event.idx2 = neighborIndex;
-                                        event.rate = reaction.rate(
-                                                *topologies.at(event.topology_idx),
-                                                *topologies.at(event.topology_idx2)
-                                        );
-                                        event.cumulativeRate = event.rate + current_cumulative_rate;
-                                    } else {
-                                        log::critical("got no topology for topology-fusion");
-                                    }
-                                    if (reaction.allow_self_connection() &&
-                                        entry.topology_index == neighbor.topology_index) {
-                                        const auto &topol = model.topologies().at(
-                                                static_cast<std::size_t>(neighbor.topology_index));
-                                        // auto topol = topologies.at(event.topology_idx);
-                                        const readdy::model::top::Graph &gr = topol->graph();
-                                        const auto &v1 = topol->vertexIteratorForParticle(event.idx1);
-                                        const auto &v2 = topol->vertexIteratorForParticle(event.idx2);
-                                        auto d = gr.graphDistance(v1, v2);
-                                        if ((d != -1 && d <= reaction.min_graph_distance()) ||
-                                            (!context.legacyTopologySelfFusion() && d == 1)) {
-                                            ++reaction_index;
-                                            continue;
-                                        }
-                                    }
-                                    event.reaction_idx = reaction_index;
-                                    event.spatial = true;
-
-                                    events.push_back(event);
-                                }
-                                ++reaction_index;
                             }
-                        });
+                            event.reaction_idx = reaction_index;
+                            event.spatial = true;
+
+                            events.push_back(event);
+                        }
+                        ++reaction_index;
                     }
-                }
+                });
             }
         }
     }
-    return events;
 }
 
 void CPUEvaluateTopologyReactions::handleTopologyParticleReaction(CPUStateModel::topology_ref &topology,
@@ -341,7 +378,7 @@ void CPUEvaluateTopologyReactions::handleTopologyParticleReaction(CPUStateModel:
     const auto &context = kernel->context();
     const auto &top_registry = context.topologyRegistry();
     const auto &reaction = top_registry.spatialReactionsByType(event.t1, topology->type(), event.t2,
-                                                               EmptyTopologyId).at(event.reaction_idx);
+                                                               EmptyTopologyId)[event.reaction_idx];
 
     auto &model = kernel->getCPUKernelStateModel();
     auto &data = *model.getParticleData();
@@ -373,7 +410,7 @@ void CPUEvaluateTopologyReactions::handleTopologyParticleReaction(CPUStateModel:
     } else {
         topology->type() = reaction.top_type_to2();
     }
-    topology->updateReactionRates(context.topologyRegistry().structuralReactionsOf(topology->type()));
+    topology->invalidateReactionRates();
     topology->configure();
 }
 
@@ -382,8 +419,8 @@ void CPUEvaluateTopologyReactions::handleTopologyTopologyReaction(CPUStateModel:
                                                                   const TREvent &event) {
     const auto &context = kernel->context();
     const auto &top_registry = context.topologyRegistry();
-    const auto &reaction = top_registry.spatialReactionsByType(event.t1, t1->type(), event.t2, t2->type()).at(
-            event.reaction_idx);
+    const auto &reaction = top_registry.spatialReactionsByType(event.t1, t1->type(), event.t2,
+                                                               t2->type())[event.reaction_idx];
 
     auto &model = kernel->getCPUKernelStateModel();
     auto &data = *model.getParticleData();
@@ -438,7 +475,7 @@ void CPUEvaluateTopologyReactions::handleTopologyTopologyReaction(CPUStateModel:
             t1->type() = top_type_to1;
             t2->type() = top_type_to2;
 
-            t2->updateReactionRates(context.topologyRegistry().structuralReactionsOf(t2->type()));
+            t2->invalidateReactionRates();
             t2->updateSpatialReactionRates(
                     context.topologyRegistry().spatialReactionsByType(event.t2, t2->type(),
                                                                       event.t1, t1->type()),
@@ -447,7 +484,7 @@ void CPUEvaluateTopologyReactions::handleTopologyTopologyReaction(CPUStateModel:
             t2->configure();
         }
     }
-    t1->updateReactionRates(context.topologyRegistry().structuralReactionsOf(t1->type()));
+    t1->invalidateReactionRates();
     t1->updateSpatialReactionRates(
             context.topologyRegistry().spatialReactionsByType(event.t1, t1->type(),
                                                               event.t2, t2->type()),
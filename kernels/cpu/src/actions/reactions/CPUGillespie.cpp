@@ -51,6 +51,16 @@ namespace reactions {
 CPUGillespie::CPUGillespie(CPUKernel *kernel, readdy::scalar timeStep) : super(timeStep), kernel(kernel) {}
 
 void CPUGillespie::perform() {
+    const auto &ctx = kernel->context();
+    if (ctx.recordReactionsWithPositions()) {
+        ctx.recordReactionCounts() ? performImpl<true, true>() : performImpl<false, true>();
+    } else {
+        ctx.recordReactionCounts() ? performImpl<true, false>() : performImpl<false, false>();
+    }
+}
+
+template<bool RECORD_COUNTS, bool RECORD_POSITIONS>
+void CPUGillespie::performImpl() {
     const auto &ctx = kernel->context();
     if(ctx.reactions().nOrder1() == 0 && ctx.reactions().nOrder2() == 0) {
         return;
@@ -59,39 +69,27 @@ void CPUGillespie::perform() {
     auto data = stateModel.getParticleData();
     const auto nl = stateModel.getNeighborList();
 
-    if(ctx.recordReactionCounts()) {
+    if constexpr (RECORD_COUNTS) {
         stateModel.resetReactionCounts();
     }
+    if constexpr (RECORD_POSITIONS) {
+        stateModel.reactionRecords().clear();
+    }
 
     scalar alpha = 0.0;
     std::vector<event_t> events;
     gatherEvents(kernel, readdy::util::range<event_t::index_type>(0, data->size()), nl, data, alpha, events);
-    if(ctx.recordReactionsWithPositions()) {
-        stateModel.reactionRecords().clear();
-        if(ctx.recordReactionCounts()) {
-            auto &counts = stateModel.reactionCounts();
-            auto particlesUpdate = handleEventsGillespie(kernel, timeStep(), false, false, std::move(events),
-                                                         &stateModel.reactionRecords(), &counts);
-            data->update(std::move(particlesUpdate));
-        } else {
-            auto particlesUpdate = handleEventsGillespie(kernel, timeStep(), false, false, std::move(events),
-                                                         &stateModel.reactionRecords(), nullptr);
-            data->update(std::move(particlesUpdate));
-        }
-    } else {
-        if(ctx.recordReactionCounts()) {
-            auto &counts = stateModel.reactionCounts();
-            auto particlesUpdate = handleEventsGillespie(kernel, timeStep(), false, false, std::move(events),
-                                                         nullptr, &counts);
-            data->update(std::move(particlesUpdate));
-        } else {
-            auto particlesUpdate = handleEventsGillespie(kernel, timeStep(), false, false, std::move(events),
-                                                         nullptr, nullptr);
-            data->update(std::move(particlesUpdate));
-        }
-    }
+    auto particlesUpdate = handleEventsGillespie(kernel, timeStep(), false, false, std::move(events),
+                                                 RECORD_POSITIONS ? &stateModel.reactionRecords() : nullptr,
+                                                 RECORD_COUNTS ? &stateModel.reactionCounts() : nullptr);
+    data->update(std::move(particlesUpdate));
 }
 
+template void CPUGillespie::performImpl<true, true>();
+template void CPUGillespie::performImpl<true, false>();
+template void CPUGillespie::performImpl<false, true>();
+template void CPUGillespie::performImpl<false, false>();
+
 }
 }
 }
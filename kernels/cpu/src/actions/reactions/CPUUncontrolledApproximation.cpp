@@ -133,6 +133,16 @@ void findEvents(std::size_t /*tid*/, data_iter_t begin, data_iter_t end, nl_boun
 }
 
 void CPUUncontrolledApproximation::perform() {
+    const auto &ctx = kernel->context();
+    if (ctx.recordReactionsWithPositions()) {
+        ctx.recordReactionCounts() ? performImpl<true, true>() : performImpl<false, true>();
+    } else {
+        ctx.recordReactionCounts() ? performImpl<true, false>() : performImpl<false, false>();
+    }
+}
+
+template<bool RECORD_COUNTS, bool RECORD_POSITIONS>
+void CPUUncontrolledApproximation::performImpl() {
     const auto &ctx = kernel->context();
     auto &stateModel = kernel->getCPUKernelStateModel();
     auto nl = stateModel.getNeighborList();
@@ -140,10 +150,10 @@ void CPUUncontrolledApproximation::perform() {
     const auto &box = ctx.boxSize().data();
     const auto &pbc = ctx.periodicBoundaryConditions().data();
 
-    if (ctx.recordReactionsWithPositions()) {
-        kernel->getCPUKernelStateModel().reactionRecords().clear();
+    if constexpr (RECORD_POSITIONS) {
+        stateModel.reactionRecords().clear();
     }
-    if (ctx.recordReactionCounts()) {
+    if constexpr (RECORD_COUNTS) {
         stateModel.resetReactionCounts();
     }
 
@@ -209,7 +219,7 @@ void CPUUncontrolledApproximation::perform() {
                 auto entry1 = event.idx1;
                 if (event.nEducts == 1) {
                     auto reaction = ctx.reactions().order1ByType(event.t1)[event.reactionIndex];
-                    if (ctx.recordReactionsWithPositions()) {
+                    if constexpr (RECORD_POSITIONS) {
                         record_t record;
                         record.id = reaction->id();
                         performReaction(&data, ctx, entry1, entry1, newParticles, decayedEntries, reaction, &record);
@@ -218,7 +228,7 @@ void CPUUncontrolledApproximation::perform() {
                     } else {
                         performReaction(&data, ctx, entry1, entry1, newParticles, decayedEntries, reaction, nullptr);
                     }
-                    if (ctx.recordReactionCounts()) {
+                    if constexpr (RECORD_COUNTS) {
                         auto &counts = stateModel.reactionCounts();
                         counts.at(reaction->id())++;
                     }
@@ -229,7 +239,7 @@ void CPUUncontrolledApproximation::perform() {
                     }
                 } else {
                     auto reaction = ctx.reactions().order2ByType(event.t1, event.t2)[event.reactionIndex];
-                    if (ctx.recordReactionsWithPositions()) {
+                    if constexpr (RECORD_POSITIONS) {
                         record_t record;
                         record.id = reaction->id();
                         performReaction(&data, ctx, entry1, event.idx2, newParticles, decayedEntries, reaction, &record);
@@ -238,7 +248,7 @@ void CPUUncontrolledApproximation::perform() {
                     } else {
                         performReaction(&data, ctx, entry1, event.idx2, newParticles, decayedEntries, reaction, nullptr);
                     }
-                    if (ctx.recordReactionCounts()) {
+                    if constexpr (RECORD_COUNTS) {
                         auto &counts = stateModel.reactionCounts();
                         counts.at(reaction->id())++;
                     }
@@ -254,6 +264,12 @@ void CPUUncontrolledApproximation::perform() {
         data.update(std::make_pair(std::move(newParticles), std::move(decayedEntries)));
     }
 }
+
+template void CPUUncontrolledApproximation::performImpl<true, true>();
+template void CPUUncontrolledApproximation::performImpl<true, false>();
+template void CPUUncontrolledApproximation::performImpl<false, true>();
+template void CPUUncontrolledApproximation::performImpl<false, false>();
+
 }
 }
 }
@@ -65,7 +65,7 @@ void CellLinkedList::setUp(scalar cutoff, cell_radius_type radius) {
         auto desiredWidth = static_cast<scalar>((_cutoff) / static_cast<scalar>(radius));
         std::array<std::size_t, 3> dims{};
         for (int i = 0; i < 3; ++i) {
-            dims[i] = static_cast<unsigned int>(std::max(1., std::floor(size[i] / desiredWidth)));
+            dims[i] = static_cast<unsigned int>(std::max(static_cast<scalar>(1.), std::floor(size[i] / desiredWidth)));
             _cellSize[i] = size[i] / static_cast<scalar>(dims[i]);
         }
 
@@ -155,6 +155,7 @@ void CompactCellLinkedList::fillBins<true>() {
     };
 
     std::size_t pidx = 1;
+    std::size_t nBinned = 0, nCellChanges = 0, previousCell = 0;
     for (const auto &entry : _data.get()) {
         if (!entry.deactivated && particleInBox(entry.pos)) {
             const auto i = static_cast<std::size_t>(std::floor((entry.pos.x + .5 * boxSize[0]) / _cellSize.x));
@@ -163,22 +164,19 @@ void CompactCellLinkedList::fillBins<true>() {
             const auto cellIndex = _cellIndex(i, j, k);
             _list[pidx] = *_head.at(cellIndex);
             *_head[cellIndex] = pidx;
+            if (nBinned > 0 && cellIndex != previousCell) {
+                ++nCellChanges;
+            }
+            previousCell = cellIndex;
+            ++nBinned;
         }
         ++pidx;
     }
+    _locality = {nCellChanges, nBinned};
 }
 
 template<>
 void CompactCellLinkedList::fillBins<false>() {
-    {/*
-        static int i = 0;
-        if(i % 100 == 0) {
-            _data.get().hilbertSort(_max_cutoff + _skin);
-            i = 0;
-        }
-        ++i;
-    */}
-
     const auto &boxSize = _context.get().boxSize();
     const auto &data = _data.get();
     const auto grainSize = data.size() / _pool.get().size();
@@ -194,10 +192,14 @@ void CompactCellLinkedList::fillBins<false>() {
     auto &list = _list;
     auto &head = _head;
 
-    auto worker = [&data, &cellIndex, cellSize, &list, &head, boxSize, particleInBox]
-            (std::size_t tid, std::size_t begin_pidx, std::size_t end_pidx) {
+    // per task: number of binned particles and number of consecutive binned particles in different cells
+    std::vector<std::tuple<std::size_t, std::size_t>> locality(_pool.get().size());
+
+    auto worker = [&data, &cellIndex, cellSize, &list, &head, boxSize, particleInBox, &locality]
+            (std::size_t tid, std::size_t task, std::size_t begin_pidx, std::size_t end_pidx) {
         auto it = data.begin() + begin_pidx - 1;
         auto pidx = begin_pidx;
+        std::size_t nBinned = 0, nCellChanges = 0, previousCell = 0;
         while (it != data.begin() + end_pidx - 1) {
             const auto &entry = *it;
             if (!entry.deactivated && particleInBox(entry.pos)) {
@@ -210,21 +212,35 @@ void CompactCellLinkedList::fillBins<false>() {
                 auto currentHead = atomic.load();
                 while (!atomic.compare_exchange_weak(currentHead, pidx)) {}
                 list[pidx] = currentHead;
+                if (nBinned > 0 && cix != previousCell) {
+                    ++nCellChanges;
+                }
+                previousCell = cix;
+                ++nBinned;
             }
             ++pidx;
             ++it;
         }
+        locality[task] = std::make_tuple(nCellChanges, nBinned);
     };
 
-    std::vector<util::thread::joining_future<void>> futures;
-    futures.reserve(_pool.get().size());
-    auto it = 1_z;
-    for (auto i = 0_z; i < _pool.get().size() - 1; ++i) {
-        auto itNext = it + grainSize;
-        if(it != itNext) futures.emplace_back(_pool.get().push(worker, it, itNext));
-        it = itNext;
+    {
+        std::vector<util::thread::joining_future<void>> futures;
+        futures.reserve(_pool.get().size());
+        auto it = 1_z;
+        for (auto i = 0_z; i < _pool.get().size() - 1; ++i) {
+            auto itNext = it + grainSize;
+            if (it != itNext) futures.emplace_back(_pool.get().push(worker, i, it, itNext));
+            it = itNext;
+        }
+        futures.emplace_back(_pool.get().push(worker, _pool.get().size() - 1, it, _data.get().size() + 1));
+    }
+    // chunk borders are not counted, which is negligible for the locality estimate
+    _locality = {0, 0};
+    for (const auto &[nCellChanges, nBinned] : locality) {
+        std::get<0>(_locality) += nCellChanges;
+        std::get<1>(_locality) += nBinned;
     }
-    futures.emplace_back(_pool.get().push(worker, it, _data.get().size()+1));
 }
 
 void CompactCellLinkedList::setUpBins() {
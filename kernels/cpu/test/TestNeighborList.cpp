@@ -362,3 +362,78 @@ TEST_CASE("Test cpu neighbor list", "[cpu]") {
         }
     }
 }
+
+TEST_CASE("Test cpu particle reordering", "[cpu]") {
+    using namespace readdy;
+
+    auto kernel = std::make_unique<cpu::CPUKernel>();
+    auto &context = kernel->context();
+    context.boxSize() = {{20, 20, 20}};
+    context.particleTypes().add("A", 1.);
+    context.particleTypes().addTopologyType("T", 1.);
+    context.topologyRegistry().addType("chain");
+    context.topologyRegistry().configureBondPotential("T", "T", {10., 1.});
+    context.potentials().addHarmonicRepulsion("A", "A", 1., 4.);
+    context.kernelConfiguration().cpu.neighborList.reorder_interval = 1;
+
+    auto &stateModel = kernel->getCPUKernelStateModel();
+    auto &data = *stateModel.getParticleData();
+    const auto idA = context.particleTypes().idOf("A");
+    for (auto i = 0; i < 2000; ++i) {
+        stateModel.addParticle({model::rnd::uniform_real<scalar>(-10, 10), model::rnd::uniform_real<scalar>(-10, 10),
+                                model::rnd::uniform_real<scalar>(-10, 10), idA});
+    }
+    std::vector<model::Particle> chain;
+    for (auto i = 0; i < 5; ++i) {
+        chain.emplace_back(-8. + 4. * i, 8. - 4. * i, 0., context.particleTypes().idOf("T"));
+    }
+    auto topology = stateModel.addTopology(context.topologyRegistry().idOf("chain"), chain);
+    for (std::size_t i = 0; i < 4; ++i) {
+        topology->addEdge({i}, {i + 1});
+    }
+    // create some blanks
+    for (std::size_t i = 0; i < 2000; i += 10) {
+        data.removeParticle(i);
+    }
+
+    std::unordered_map<ParticleId, Vec3> positions;
+    for (const auto &p : stateModel.getParticles()) {
+        positions.emplace(p.id(), p.pos());
+    }
+    std::vector<ParticleId> chainIds;
+    for (const auto &p : topology->fetchParticles()) {
+        chainIds.push_back(p.id());
+    }
+
+    kernel->initialize();
+    stateModel.initializeNeighborList(context.calculateMaxCutoff());
+
+    REQUIRE(data.getNDeactivated() == 0);
+    REQUIRE(data.size() == positions.size());
+    for (const auto &entry : data) {
+        auto it = positions.find(entry.id);
+        REQUIRE(it != positions.end());
+        REQUIRE(it->second == entry.pos);
+    }
+    REQUIRE(stateModel.getNeighborList()->cellChangeFraction() < .2);
+
+    // the topology follows its particles
+    const auto fetched = topology->fetchParticles();
+    REQUIRE(fetched.size() == chainIds.size());
+    for (std::size_t i = 0; i < fetched.size(); ++i) {
+        REQUIRE(fetched[i].id() == chainIds[i]);
+    }
+    for (auto index : topology->particleIndices()) {
+        REQUIRE(data.entry_at(index).topology_index == 0);
+    }
+    const auto &bonds = dynamic_cast<const model::top::Topology::HarmonicBond *>(
+            topology->getBondedPotentials().at(0).get())->getBonds();
+    REQUIRE(bonds.size() == 4);
+    for (const auto &bond : bonds) {
+        const auto id1 = data.entry_at(bond.idx1).id;
+        const auto id2 = data.entry_at(bond.idx2).id;
+        auto pos1 = std::distance(chainIds.begin(), std::find(chainIds.begin(), chainIds.end(), id1));
+        auto pos2 = std::distance(chainIds.begin(), std::find(chainIds.begin(), chainIds.end(), id2));
+        REQUIRE(std::abs(pos1 - pos2) == 1);
+    }
+}
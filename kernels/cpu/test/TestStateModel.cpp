@@ -0,0 +1,94 @@
+/********************************************************************
+ * Copyright © 2018 Computational Molecular Biology Group,          *
+ *                  Freie Universität Berlin (GER)                  *
+ *                                                                  *
+ * Redistribution and use in source and binary forms, with or       *
+ * without modification, are permitted provided that the            *
+ * following conditions are met:                                    *
+ *  1. Redistributions of source code must retain the above         *
+ *     copyright notice, this list of conditions and the            *
+ *     following disclaimer.                                        *
+ *  2. Redistributions in binary form must reproduce the above      *
+ *     copyright notice, this list of conditions and the following  *
+ *     disclaimer in the documentation and/or other materials       *
+ *     provided with the distribution.                              *
+ *  3. Neither the name of the copyright holder nor the names of    *
+ *     its contributors may be used to endorse or promote products  *
+ *     derived from this software without specific                  *
+ *     prior written permission.                                    *
+ *                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND           *
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,      *
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF         *
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE         *
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR            *
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,         *
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER *
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,      *
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)    *
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF      *
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
+ ********************************************************************/
+
+
+/**
+ * Tests for the topology bookkeeping of the CPU state model.
+ *
+ * @file TestStateModel.cpp
+ * @brief Tests for the CPU state model
+ * @author EricArkfeld
+ * @date 19.10.26
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <readdy/kernel/cpu/CPUKernel.h>
+
+TEST_CASE("Test cpu kernel topology recycling", "[cpu]") {
+    auto kernel = std::make_unique<readdy::kernel::cpu::CPUKernel>();
+    auto &ctx = kernel->context();
+    ctx.particleTypes().add("T", 1.0, readdy::model::particleflavor::TOPOLOGY);
+    ctx.topologyRegistry().configureBondPotential("T", "T", {1.0, 1.0});
+    ctx.boxSize() = {{10, 10, 10}};
+    auto t = ctx.particleTypes().idOf("T");
+    auto &model = kernel->getCPUKernelStateModel();
+
+    std::vector<readdy::model::Particle> particles;
+    for (int i = 0; i < 100; ++i) {
+        particles.emplace_back(0, 0, 0, t);
+    }
+    auto *chain = model.addTopology(0, {particles.begin(), particles.begin() + 4});
+    chain->addEdge({0}, {1});
+    chain->addEdge({1}, {2});
+    chain->addEdge({2}, {3});
+    chain->configure();
+
+    auto *dead = model.addTopology(0, particles);
+    const auto *storage = &*dead->graph().vertices().begin_persistent();
+    model.topologies().erase(model.topologies().begin() + 1);
+    model.compactTopologies(true);
+    REQUIRE(model.topologies().size() == 1);
+
+    SECTION("Added topologies are built into the storage of a dead one") {
+        auto *recycled = model.addTopology(0, {particles.begin(), particles.begin() + 50});
+        REQUIRE(&*recycled->graph().vertices().begin_persistent() == storage);
+        REQUIRE(recycled->graph().nVertices() == 50);
+        REQUIRE_FALSE(recycled->isDeactivated());
+        REQUIRE(recycled->getBondedPotentials().empty());
+        for (const auto &v : recycled->graph().vertices()) {
+            REQUIRE(recycled->vertexIteratorForParticle(v->particleIndex) != recycled->graph().end_persistent());
+        }
+    }
+
+    SECTION("Split off components are built into the storage of a dead one") {
+        chain->removeEdge({1}, {2});
+        auto components = chain->splitOffComponents(model.topologyProvider());
+        REQUIRE(components.size() == 1);
+        REQUIRE(&*components.front().graph().vertices().begin_persistent() == storage);
+        REQUIRE(components.front().graph().nVertices() == 2);
+        REQUIRE(components.front().graph().isConnected());
+        REQUIRE(chain->graph().nVertices() == 2);
+    }
+}
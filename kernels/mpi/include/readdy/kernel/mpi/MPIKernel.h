@@ -47,7 +47,9 @@
 #include <readdy/kernel/mpi/MPIStateModel.h>
 #include <readdy/kernel/mpi/actions/MPIActionFactory.h>
 #include <readdy/kernel/mpi/observables/MPIObservableFactory.h>
+#include <readdy/kernel/mpi/observables/ObservableReducer.h>
 #include <readdy/kernel/mpi/model/MPIDomain.h>
+#include <readdy/kernel/mpi/model/topologies/MPITopologyActionFactory.h>
 #include <readdy/common/Timer.h>
 
 #include <utility>
@@ -114,11 +116,11 @@ public:
     }
 
     const readdy::model::top::TopologyActionFactory *const getTopologyActionFactory() const override {
-        return nullptr;
+        return &_topologyActionFactory;
     }
 
     readdy::model::top::TopologyActionFactory *const getTopologyActionFactory() override {
-        return nullptr;
+        return &_topologyActionFactory;
     }
 
     bool supportsGillespie() const override {
@@ -133,9 +135,18 @@ public:
         return _commUsedRanks;
     }
 
+    observables::ObservableReducer &observableReducer() {
+        return _reducer;
+    }
+
+    /**
+     * Evaluates all observables, the ones that are reduced over all ranks are reduced together afterwards.
+     */
     virtual void evaluateObservables(TimeStep t) override {
         if (not _domain.isIdleRank()) {
+            _reducer.beginBatch();
             _signal(t);
+            _reducer.endBatch(_commUsedRanks);
         }
     }
 
@@ -150,6 +161,8 @@ protected:
     MPIStateModel _stateModel;
     actions::MPIActionFactory _actions;
     observables::MPIObservableFactory _observables;
+    observables::ObservableReducer _reducer;
+    model::top::MPITopologyActionFactory _topologyActionFactory;
 
 
     // The communicator for the subgroup of actually used workers
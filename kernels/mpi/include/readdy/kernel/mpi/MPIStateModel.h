@@ -43,6 +43,8 @@
 
 #pragma once
 
+#include <optional>
+
 #include <readdy/model/StateModel.h>
 #include <readdy/kernel/mpi/model/MPINeighborList.h>
 #include <readdy/kernel/singlecpu/model/ObservableData.h>
@@ -50,6 +52,7 @@
 #include <readdy/common/signals.h>
 #include <readdy/kernel/mpi/model/MPIParticleData.h>
 #include <readdy/kernel/mpi/model/MPIUtils.h>
+#include <readdy/kernel/mpi/model/MPITopology.h>
 
 namespace readdy::kernel::mpi {
 
@@ -97,6 +100,7 @@ public:
 
     void removeAllParticles() override {
         getParticleData()->clear();
+        _topologyEntries.clear();
     }
 
     readdy::kernel::scpu::model::ObservableData &observableData() {
@@ -115,19 +119,19 @@ public:
         return _observableData.virial;
     }
 
-    scalar energy() const override {
+    ScalarAccumulator energy() const override {
         return _observableData.energy;
     }
 
-    scalar &energy() override {
+    ScalarAccumulator &energy() override {
         return _observableData.energy;
     }
 
-    scalar time() const override {
+    ScalarAccumulator time() const override {
         return _observableData.time;
     }
 
-    void setTime(scalar value) override {
+    void setTime(ScalarAccumulator value) override {
         _observableData.time = value;
     }
 
@@ -194,11 +198,75 @@ public:
 
     readdy::model::top::GraphTopology *const
     addTopology(TopologyTypeId type, const std::vector<readdy::model::Particle> &particles) override {
-        throw std::logic_error("no topologies on MPI kernel");
+        throw std::logic_error("graph topologies are not available on the MPI kernel, use addMPITopology()");
     }
 
     std::vector<readdy::model::top::GraphTopology *> getTopologies() override {
-        throw std::logic_error("no topologies on MPI kernel");
+        throw std::logic_error("graph topologies are not available on the MPI kernel, use mpiTopologies()");
+    }
+
+    /**
+     * @return the topologies whose anchor particle this worker is responsible for
+     */
+    const std::vector<model::MPITopology> &mpiTopologies() const {
+        return _topologies;
+    }
+
+    std::vector<model::MPITopology> &mpiTopologies() {
+        return _topologies;
+    }
+
+    /**
+     * @return a topology id that is unique over all ranks, for topologies created on this rank
+     */
+    std::size_t createTopologyId() {
+        return util::rankPrefixedId(_domain->rank(), _nCreatedTopologies++);
+    }
+
+    /**
+     * @return true if topologies were added on any rank, i.e. workers have to exchange topologies and their forces
+     */
+    bool hasTopologies() const {
+        return _hasTopologies;
+    }
+
+    /**
+     * Looks up a topology particle in the domain core or halo. The index of topology particles is kept up to date
+     * whenever particles are added or synchronized, it is not rebuilt when forces are evaluated.
+     * @param id the global id of the particle
+     * @return the entry, preferably the one this worker is responsible for, nullptr if the particle is not present
+     */
+    MPIEntry *topologyEntry(ParticleId id) {
+        const auto index = topologyEntryIndex(id);
+        return index ? &_data.get().entry_at(*index) : nullptr;
+    }
+
+    /**
+     * Looks up a topology particle like topologyEntry().
+     * @param id the global id of the particle
+     * @return the index of the entry in the particle data, empty if the particle is not present
+     */
+    std::optional<Data::EntryIndex> topologyEntryIndex(ParticleId id) const {
+        auto it = _topologyEntries.find(id);
+        if (it != _topologyEntries.end()) {
+            const auto &entry = _data.get().entry_at(it->second);
+            if (!entry.deactivated and entry.id == id) {
+                return it->second;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Adds a topology particle that was created on this worker, e.g., appended to a topology by a reaction. The
+     * worker is responsible for it regardless of its position, the next synchronization hands it over if necessary.
+     * @param particle the particle
+     * @return the index of the new entry
+     */
+    Data::EntryIndex addCreatedTopologyParticle(const Particle &particle) {
+        const auto index = _data.get().addEntry(MPIEntry(particle, true, _domain->rank()));
+        indexTopologyEntries({index});
+        return index;
     }
 
     const model::MPIDomain *domain() const {
@@ -220,10 +288,70 @@ public:
      */
     void distributeParticle(const Particle &p);
 
+    /**
+     * The master rank sorts the particles `ps` by responsible rank and scatters them, the argument is ignored on
+     * all other ranks.
+     */
     void distributeParticles(const std::vector<Particle> &ps);
 
+    /**
+     * Every used rank contributes particles `ps` (e.g. a slice it generated or read from file), which are sent to
+     * the workers responsible for them in a single all-to-all exchange. This avoids funneling the whole initial
+     * configuration through the master rank.
+     */
+    void redistributeParticles(const std::vector<Particle> &ps);
+
+    /**
+     * Each used rank reads a contiguous slice of the last frame of a flat trajectory (e.g. the one written by
+     * checkpointing) and redistributes the particles, see redistributeParticles().
+     * @param fileName the hdf5 file
+     * @param trajectoryGroup the group that contains the "records" and "limits" data sets
+     */
+    void distributeParticlesFromFile(const std::string &fileName,
+                                     const std::string &trajectoryGroup = "/readdy/trajectory/trajectory_ckpt");
+
+    /**
+     * Adds a topology. The particles are distributed like in distributeParticles(), their global ids are the ones
+     * assigned on the master rank. The topology is only sent to the worker that is responsible for its first
+     * particle. All used ranks have to call this, the arguments are only read on the master rank.
+     * @param type the topology type
+     * @param particles the topology particles
+     * @param edges the edges of the topology graph as pairs of indices into `particles`
+     */
+    void addMPITopology(TopologyTypeId type, const std::vector<Particle> &particles,
+                        const std::vector<std::tuple<std::size_t, std::size_t>> &edges);
+
     std::vector<MPIStateModel::Particle> gatherParticles() const;
 
+    /**
+     * Distributed checkpoint. Each worker writes the particles it is responsible for into its own file
+     * `<base>/checkpoint_<t>_domain_<rank>.h5`, which has the layout of a flat trajectory with one frame. After all
+     * domain files are written, the master writes the manifest `<base>/checkpoint_<t>.h5` containing the simulation
+     * setup and the decomposition (domain ranks, cores and particle numbers). No particles are sent around.
+     * @param basePath directory of the checkpoint files
+     * @param t the current time step
+     * @return the path of the manifest on the master rank, the path of the own domain file on workers
+     */
+    std::string writeCheckpoint(const std::string &basePath, TimeStep t) const;
+
+    /**
+     * Restart from a distributed checkpoint. The domain files listed in the manifest are assigned round robin to
+     * the used ranks, which read them in parallel and redistribute the particles spatially. The decomposition of
+     * the checkpoint need not match the current one.
+     * @param manifestPath path of the checkpoint manifest
+     * @return the time step at which the checkpoint was written
+     */
+    TimeStep readCheckpoint(const std::string &manifestPath);
+
+    /**
+     * @param manifestPath path of a checkpoint manifest
+     * @param rank the rank which wrote the domain file
+     * @return path of the domain file that belongs to the manifest
+     */
+    static std::string checkpointDomainFile(const std::string &manifestPath, int rank);
+
+    static constexpr const char *CHECKPOINT_GROUP_PATH = "/readdy/checkpoint";
+
     /**
      * 1. fill list `own` of own-responsible particles [to be sent around]
      * 2. prepare list `other` of other-responsible particles [to be applied to self and send to other directions]
@@ -248,13 +376,41 @@ public:
      **/
     void synchronizeWithNeighbors();
 
+    /**
+     * Forces that a worker evaluated for topology particles in its halo are sent to the workers responsible for
+     * these particles and added to their entries. All workers have to call this.
+     * @param haloForces the forces per global particle id, only halo particles of this worker
+     */
+    void returnHaloForces(const std::unordered_map<ParticleId, Vec3> &haloForces);
+
+    /**
+     * Types and positions that a worker changed for topology particles in its halo, e.g., in a structural topology
+     * reaction, are sent to the workers responsible for these particles and applied to their entries. All workers have
+     * to call this.
+     * @param changes the changed particles per responsible rank
+     */
+    void returnHaloParticleChanges(const std::unordered_map<int, std::vector<util::ParticlePOD>> &changes);
+
 private:
+    // appends particles this worker is responsible for, assumes that they are located in the domain core
+    void addResponsibleParticles(const std::vector<util::ParticlePOD> &particles);
+
+    // topology particles among the entries at `indices` are added to the index of topology particles
+    void indexTopologyEntries(const std::vector<Data::EntryIndex> &indices);
+
+    // topologies whose anchor particle is now in the core of another worker are moved there
+    void migrateTopologies();
+
     readdy::kernel::scpu::model::ObservableData _observableData;
     std::reference_wrapper<const readdy::model::Context> _context;
     std::reference_wrapper<Data> _data;
     NeighborList _neighborList;
     const model::MPIDomain* _domain;
     MPI_Comm _commUsedRanks = MPI_COMM_WORLD;
+    std::vector<model::MPITopology> _topologies;
+    std::unordered_map<ParticleId, Data::EntryIndex> _topologyEntries;
+    std::size_t _nCreatedTopologies {0};
+    bool _hasTopologies {false};
 };
 
 }
@@ -91,7 +91,7 @@ public:
     [[nodiscard]] std::unique_ptr<readdy::model::actions::EvaluateObservables> evaluateObservables() const override;
 
     [[nodiscard]] std::unique_ptr<readdy::model::actions::MakeCheckpoint>
-    makeCheckpoint(std::string base, std::size_t maxNSaves, std::string checkpointFormat) const override;
+    makeCheckpoint(std::string base, std::size_t maxNSaves) const override;
 
     [[nodiscard]] std::unique_ptr<readdy::model::actions::InitializeKernel> initializeKernel() const override;
 };
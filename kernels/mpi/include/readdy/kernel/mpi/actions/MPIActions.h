@@ -187,6 +187,41 @@ protected:
 };
 }
 
+namespace top {
+
+/**
+ * Structural topology reactions. Each worker evaluates the rates of the topologies it holds, whose particles are all
+ * in its domain core or halo, and performs the reactions. Changed halo particles are sent to the workers responsible
+ * for them, topologies split off by a reaction stay with this worker until the next synchronization migrates them.
+ * Spatial topology reactions are not available.
+ */
+class MPIEvaluateTopologyReactions : public readdy::model::actions::top::EvaluateTopologyReactions {
+public:
+    MPIEvaluateTopologyReactions(MPIKernel *kernel, readdy::scalar timeStep)
+            : EvaluateTopologyReactions(timeStep), kernel(kernel) {}
+
+    void perform() override;
+
+private:
+    MPIKernel *const kernel;
+};
+
+/**
+ * Breaks bonds whose energy exceeds the threshold like BreakBonds, evaluated by the worker that holds the topology.
+ */
+class MPIBreakBonds : public readdy::model::actions::top::BreakBonds {
+public:
+    MPIBreakBonds(MPIKernel *kernel, readdy::scalar timeStep, readdy::model::actions::top::BreakConfig config)
+            : BreakBonds(timeStep, std::move(config)), kernel(kernel) {}
+
+    void perform() override;
+
+private:
+    MPIKernel *const kernel;
+};
+
+}
+
 class MPIEvaluateObservables : public readdy::model::actions::EvaluateObservables {
 public:
     explicit MPIEvaluateObservables(MPIKernel *kernel) : kernel(kernel) {}
@@ -199,33 +234,40 @@ private:
     MPIKernel *kernel;
 };
 
+/**
+ * Writes distributed checkpoints, see MPIStateModel::writeCheckpoint(). Every rank only touches its own files,
+ * which is also true for removing old checkpoints.
+ */
 class MPIMakeCheckpoint : public readdy::model::actions::MakeCheckpoint {
 public:
-    MPIMakeCheckpoint(MPIKernel *kernel, const std::string& base, std::size_t maxNSaves,
-                      const std::string &checkpointFormat)
-            : kernel(kernel), saver(base, maxNSaves, checkpointFormat) {}
+    MPIMakeCheckpoint(MPIKernel *kernel, const std::string& base, std::size_t maxNSaves)
+            : kernel(kernel), saver(base, maxNSaves) {}
 
     void perform(TimeStep t) override {
-        // todo sync (MPIGather) the state to master's stateModel, then makeCheckpoint as usual and clear stateModel
-        if (kernel->domain().isMasterRank()) {
-            // todo gather
-            // make checkpoint on master
-            //saver.makeCheckpoint(kernel, t);
-            // clear state model
-            //kernel->getMPIKernelStateModel().clear();
-        } else if (kernel->domain().isWorkerRank()) {
-            // todo gather, send responsible particles
-        } else {
-            // no op for idlers
+        auto path = kernel->getMPIKernelStateModel().writeCheckpoint(saver.basePath(), t);
+        if (saver.maxNSaves() > 0 && !path.empty()) {
+            previousCheckpoints.push(path);
+        }
+        while (saver.maxNSaves() > 0 && previousCheckpoints.size() > saver.maxNSaves()) {
+            const auto &oldestCheckpoint = previousCheckpoints.front();
+            if (fs::exists(oldestCheckpoint)) {
+                if (!fs::remove(oldestCheckpoint)) {
+                    throw std::runtime_error(fmt::format("Could not remove checkpoint {}", oldestCheckpoint));
+                }
+            } else {
+                log::warn("Tried removing checkpoint {} but it didn't exist (anymore).", oldestCheckpoint);
+            }
+            previousCheckpoints.pop();
         }
     }
 
     std::string describe() const override {
-        return saver.describe();
+        return saver.describe() + "   * format: distributed, one file per domain and a manifest\n";
     }
 private:
     MPIKernel *kernel;
     readdy::api::Saver saver;
+    std::queue<std::string> previousCheckpoints {};
 };
 
 class MPIInitializeKernel : public readdy::model::actions::InitializeKernel {
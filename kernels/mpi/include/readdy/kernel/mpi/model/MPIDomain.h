@@ -129,6 +129,27 @@ public:
         return _domainIndex(ijk[0], ijk[1], ijk[2]) + 1; // + 1 because master rank = 0
     }
 
+    /**
+     * The rank among this domain and its neighbors which is responsible for a position in this domain's core or halo.
+     * In contrast to rankOfPosition this evaluates the same comparison as the other rank's isInDomainCore, such that
+     * both agree also for positions on a domain face.
+     */
+    [[nodiscard]] int responsibleRankOfPosition(const Vec3 &pos) const {
+        validateRankNotMaster();
+        for (std::size_t i = 0; i < _neighborRanks.size(); ++i) {
+            if (_neighborTypes[i] == NeighborType::nan) {
+                continue;
+            }
+            const auto [origin, extent] = coreOfDomain(_neighborRanks[i]);
+            if (origin.x <= pos.x and pos.x < origin.x + extent.x and
+                origin.y <= pos.y and pos.y < origin.y + extent.y and
+                origin.z <= pos.z and pos.z < origin.z + extent.z) {
+                return _neighborRanks[i];
+            }
+        }
+        return rankOfPosition(pos);
+    }
+
     [[nodiscard]] bool isInDomainCore(const Vec3 &pos) const {
         validateRankNotMaster();
         return (_origin.x <= pos.x and pos.x < _origin.x + _extent.x and
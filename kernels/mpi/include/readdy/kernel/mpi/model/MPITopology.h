@@ -0,0 +1,245 @@
+/********************************************************************
+ * Copyright © 2026 Computational Molecular Biology Group,          *
+ *                  Freie Universität Berlin (GER)                  *
+ *                                                                  *
+ * Redistribution and use in source and binary forms, with or       *
+ * without modification, are permitted provided that the            *
+ * following conditions are met:                                    *
+ *  1. Redistributions of source code must retain the above         *
+ *     copyright notice, this list of conditions and the            *
+ *     following disclaimer.                                        *
+ *  2. Redistributions in binary form must reproduce the above      *
+ *     copyright notice, this list of conditions and the following  *
+ *     disclaimer in the documentation and/or other materials       *
+ *     provided with the distribution.                              *
+ *  3. Neither the name of the copyright holder nor the names of    *
+ *     its contributors may be used to endorse or promote products  *
+ *     derived from this software without specific                  *
+ *     prior written permission.                                    *
+ *                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND           *
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,      *
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF         *
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE         *
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR            *
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,         *
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER *
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,      *
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)    *
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF      *
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
+ ********************************************************************/
+
+/**
+ * Topologies of the MPI kernel. A topology only knows the global ids of its particles, not where they are stored.
+ * Its bonded potentials refer to particles by global id, too. A topology only lives on the worker that is responsible
+ * for its first particle, the anchor. This worker resolves the ids against the particles in its core and halo, evaluates
+ * all bonded terms and sends the forces on halo particles back. Once the anchor has moved into the core of another
+ * worker, the topology moves along. Structural topology reactions and bond breaking are also performed by this worker,
+ * which then sends the changed halo particles to the workers responsible for them.
+ *
+ * @file MPITopology.h
+ * @brief Distributed topologies with particles referenced by global id
+ * @author EricArkfeld
+ * @date 19.10.26
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+
+#include <readdy/model/Context.h>
+#include <readdy/model/topologies/Topology.h>
+#include <readdy/model/topologies/common.h>
+
+namespace readdy::kernel::mpi::model {
+
+class MPITopology : public readdy::model::top::Topology {
+public:
+    /**
+     * Creates the topology and its bonded potentials, bonds, angles and torsions are found in the graph that is
+     * spanned by `edges` just like for GraphTopology::configure().
+     * @param id the id of the topology, unique over all ranks, see util::rankPrefixedId()
+     * @param type the topology type
+     * @param particleIds global ids of the particles
+     * @param particleTypes types of the particles
+     * @param edges pairs of indices into `particleIds`
+     * @param context the context
+     */
+    MPITopology(std::size_t id, TopologyTypeId type, std::vector<ParticleId> particleIds,
+                std::vector<ParticleTypeId> particleTypes, std::vector<std::tuple<std::size_t, std::size_t>> edges,
+                const readdy::model::Context &context)
+            : Topology(), _id(id), _type(type), _particleIds(std::move(particleIds)),
+              _particleTypes(std::move(particleTypes)), _edges(std::move(edges)) {
+        if (_particleIds.empty()) {
+            throw std::invalid_argument("A topology needs at least one particle");
+        }
+        if (_particleIds.size() != _particleTypes.size()) {
+            throw std::invalid_argument(fmt::format("Got {} particle ids but {} particle types",
+                                                    _particleIds.size(), _particleTypes.size()));
+        }
+        for (auto t : _particleTypes) {
+            if (context.particleTypes().infoOf(t).flavor != readdy::model::particleflavor::TOPOLOGY) {
+                throw std::invalid_argument(fmt::format("Particle type {} is not a topology particle type",
+                                                        context.particleTypes().nameOf(t)));
+            }
+        }
+
+        readdy::model::top::Graph graph;
+        for (auto particleId : _particleIds) {
+            graph.addVertex(readdy::model::top::VertexData{static_cast<readdy::model::top::VertexData::ParticleIndex>(particleId)});
+        }
+        for (const auto &[i1, i2] : _edges) {
+            if (i1 >= _particleIds.size() || i2 >= _particleIds.size()) {
+                throw std::invalid_argument(fmt::format("Edge ({}, {}) out of range, topology has {} particles",
+                                                        i1, i2, _particleIds.size()));
+            }
+            graph.addEdge(readdy::model::top::Graph::PersistentVertexIndex{i1},
+                          readdy::model::top::Graph::PersistentVertexIndex{i2});
+        }
+        if (!graph.isConnected()) {
+            throw std::invalid_argument("The graph of the topology is not connected");
+        }
+
+        configure(graph, _particleTypes, context);
+    }
+
+    [[nodiscard]] std::size_t id() const {
+        return _id;
+    }
+
+    [[nodiscard]] TopologyTypeId type() const {
+        return _type;
+    }
+
+    [[nodiscard]] const std::vector<ParticleId> &particleIds() const {
+        return _particleIds;
+    }
+
+    [[nodiscard]] const std::vector<ParticleTypeId> &particleTypes() const {
+        return _particleTypes;
+    }
+
+    /**
+     * @return the edges of the topology graph as pairs of indices into particleIds()
+     */
+    [[nodiscard]] const std::vector<std::tuple<std::size_t, std::size_t>> &edges() const {
+        return _edges;
+    }
+
+    /**
+     * The rank that is responsible for this particle holds the topology.
+     * @return the global id of the first particle
+     */
+    [[nodiscard]] ParticleId anchor() const {
+        return _particleIds.front();
+    }
+
+    /**
+     * Appends the description of this topology to a buffer, such that it can be sent to another rank.
+     * @param buffer the buffer
+     */
+    void serialize(std::vector<std::size_t> &buffer) const {
+        buffer.push_back(_id);
+        buffer.push_back(static_cast<std::size_t>(_type));
+        buffer.push_back(_particleIds.size());
+        buffer.insert(buffer.end(), _particleIds.begin(), _particleIds.end());
+        buffer.insert(buffer.end(), _particleTypes.begin(), _particleTypes.end());
+        buffer.push_back(_edges.size());
+        for (const auto &[i1, i2] : _edges) {
+            buffer.push_back(i1);
+            buffer.push_back(i2);
+        }
+    }
+
+    /**
+     * Reads one topology that was written by serialize().
+     * @param it position in the buffer, is advanced past the topology
+     * @param context the context
+     * @return the topology
+     */
+    static MPITopology deserialize(std::vector<std::size_t>::const_iterator &it, const readdy::model::Context &context) {
+        const auto id = *it++;
+        const auto type = static_cast<TopologyTypeId>(*it++);
+        const auto nParticles = *it++;
+        std::vector<ParticleId> particleIds(it, it + nParticles);
+        it += nParticles;
+        std::vector<ParticleTypeId> particleTypes;
+        particleTypes.reserve(nParticles);
+        std::transform(it, it + nParticles, std::back_inserter(particleTypes),
+                       [](auto t) { return static_cast<ParticleTypeId>(t); });
+        it += nParticles;
+        const auto nEdges = *it++;
+        std::vector<std::tuple<std::size_t, std::size_t>> edges;
+        edges.reserve(nEdges);
+        for (std::size_t i = 0; i < nEdges; ++i, it += 2) {
+            edges.emplace_back(*it, *(it + 1));
+        }
+        return {id, type, std::move(particleIds), std::move(particleTypes), std::move(edges), context};
+    }
+
+private:
+    void configure(readdy::model::top::Graph &graph, const std::vector<ParticleTypeId> &particleTypes,
+                   const readdy::model::Context &context) {
+        namespace pot = readdy::model::top::pot;
+        const auto &config = context.topologyRegistry().potentialConfiguration();
+        auto typeOf = [&](auto vertexIndex) { return particleTypes.at(vertexIndex.value); };
+        auto idOf = [&](auto vertexIndex) { return graph.vertices().at(vertexIndex)->particleIndex; };
+
+        std::vector<pot::BondConfiguration> bonds;
+        std::vector<pot::AngleConfiguration> angles;
+        std::vector<pot::DihedralConfiguration> dihedrals;
+
+        graph.findNTuples([&](const readdy::model::top::Graph::Edge &tuple) {
+            auto [i1, i2] = tuple;
+            auto it = config.pairPotentials.find(std::make_tuple(typeOf(i1), typeOf(i2)));
+            if (it == config.pairPotentials.end()) {
+                throw std::invalid_argument(fmt::format("The edge between particles {} ({}) and {} ({}) has no bond "
+                                                        "configured!", idOf(i1),
+                                                        context.particleTypes().nameOf(typeOf(i1)), idOf(i2),
+                                                        context.particleTypes().nameOf(typeOf(i2))));
+            }
+            for (const auto &cfg : it->second) {
+                bonds.emplace_back(idOf(i1), idOf(i2), cfg.forceConstant, cfg.length);
+            }
+        }, [&](const readdy::model::top::Graph::Path3 &triple) {
+            auto [i1, i2, i3] = triple;
+            auto it = config.anglePotentials.find(std::make_tuple(typeOf(i1), typeOf(i2), typeOf(i3)));
+            if (it != config.anglePotentials.end()) {
+                for (const auto &cfg : it->second) {
+                    angles.emplace_back(idOf(i1), idOf(i2), idOf(i3), cfg.forceConstant, cfg.equilibriumAngle);
+                }
+            }
+        }, [&](const readdy::model::top::Graph::Path4 &quadruple) {
+            auto [i1, i2, i3, i4] = quadruple;
+            auto it = config.torsionPotentials.find(std::make_tuple(typeOf(i1), typeOf(i2), typeOf(i3), typeOf(i4)));
+            if (it != config.torsionPotentials.end()) {
+                for (const auto &cfg : it->second) {
+                    dihedrals.emplace_back(idOf(i1), idOf(i2), idOf(i3), idOf(i4), cfg.forceConstant,
+                                           cfg.multiplicity, cfg.phi_0);
+                }
+            }
+        });
+        // harmonic bonds, harmonic angles and cosine dihedrals are the only available types
+        if (!bonds.empty()) {
+            addBondedPotential(std::make_unique<HarmonicBond>(bonds));
+        }
+        if (!angles.empty()) {
+            addAnglePotential(std::make_unique<HarmonicAngle>(angles));
+        }
+        if (!dihedrals.empty()) {
+            addTorsionPotential(std::make_unique<CosineDihedral>(dihedrals));
+        }
+    }
+
+    std::size_t _id;
+    TopologyTypeId _type;
+    std::vector<ParticleId> _particleIds;
+    std::vector<ParticleTypeId> _particleTypes;
+    std::vector<std::tuple<std::size_t, std::size_t>> _edges;
+};
+
+}
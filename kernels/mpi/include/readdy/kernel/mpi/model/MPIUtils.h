@@ -46,26 +46,61 @@
 #include <string>
 #include <mpi.h>
 #include <vector>
+#include <numeric>
+#include <unordered_map>
+#include <algorithm>
 #include <readdy/common/Timer.h>
 
 namespace readdy::kernel::mpi::util {
 
+/**
+ * Particle data that is sent around between ranks. The id is global, i.e. it is kept when a particle moves to another
+ * domain or is copied into a halo, such that topologies can refer to their particles.
+ */
 struct ParticlePOD {
     Vec3 position;
     ParticleTypeId typeId;
+    ParticleId id;
 
-    ParticlePOD() : position(Vec3()), typeId(0) {}
+    ParticlePOD() : position(Vec3()), typeId(0), id(0) {}
 
-    ParticlePOD(Vec3 position, ParticleTypeId typeId) : position(position), typeId(typeId) {}
+    ParticlePOD(Vec3 position, ParticleTypeId typeId) : position(position), typeId(typeId), id(0) {}
 
-    explicit ParticlePOD(const MPIEntry &mpiEntry) : position(mpiEntry.pos), typeId(mpiEntry.type) {}
-    explicit ParticlePOD(const readdy::model::Particle &particle) : position(particle.pos()), typeId(particle.type()) {}
+    ParticlePOD(Vec3 position, ParticleTypeId typeId, ParticleId id) : position(position), typeId(typeId), id(id) {}
+
+    explicit ParticlePOD(const MPIEntry &mpiEntry) : position(mpiEntry.pos), typeId(mpiEntry.type), id(mpiEntry.id) {}
+    explicit ParticlePOD(const readdy::model::Particle &particle)
+            : position(particle.pos()), typeId(particle.type()), id(particle.id()) {}
 
     bool operator==(const ParticlePOD& other) const {
         return (this->position == other.position) and (this->typeId == other.typeId);
     }
 };
 
+/**
+ * Force on a particle, identified by its global id, that was evaluated on another rank.
+ */
+struct ForcePOD {
+    ParticleId id;
+    Vec3 force;
+};
+
+/**
+ * Number of bits of a rank local id, the remaining upper bits hold the rank.
+ */
+inline constexpr unsigned int rankIdShift = 48;
+
+/**
+ * Ids that are created on a rank (particles, topologies) are prefixed with the rank, such that ids stay unique
+ * when particles or topologies move between ranks.
+ * @param rank the rank that creates the id
+ * @param localId the id that is unique on this rank, must be smaller than 2^rankIdShift
+ * @return the global id
+ */
+inline std::size_t rankPrefixedId(int rank, std::size_t localId) {
+    return (static_cast<std::size_t>(rank) << rankIdShift) | localId;
+}
+
 struct HashPOD {
     std::size_t operator()(const readdy::kernel::mpi::util::ParticlePOD &pod) const {
         std::size_t seed{0};
@@ -78,7 +113,8 @@ struct HashPOD {
 };
 
 enum tags {
-    transmitObjects
+    transmitObjects,
+    neighborObjects
 };
 
 template<typename T>
@@ -96,15 +132,16 @@ inline std::vector<T> receiveObjects(int senderRank, const MPI_Comm &comm) {
 
 // todo here flatbuffers could be useful
 template<typename T>
-inline void receiveAppendObjects(int senderRank, std::vector<T> &result, const MPI_Comm &comm) {
+inline void receiveAppendObjects(int senderRank, std::vector<T> &result, const MPI_Comm &comm,
+                                 int tag = tags::transmitObjects) {
     MPI_Status status;
-    MPI_Probe(senderRank, tags::transmitObjects, comm, &status);
+    MPI_Probe(senderRank, tag, comm, &status);
     int byteCount;
     MPI_Get_count(&status, MPI_BYTE, &byteCount);
     const int number = byteCount / sizeof(T);
     const std::size_t sizeBefore = result.size();
     result.resize(sizeBefore + number);
-    MPI_Recv((void *) (result.data() + sizeBefore), byteCount, MPI_BYTE, senderRank, tags::transmitObjects, comm,
+    MPI_Recv((void *) (result.data() + sizeBefore), byteCount, MPI_BYTE, senderRank, tag, comm,
              MPI_STATUS_IGNORE);
 }
 
@@ -177,6 +214,50 @@ receiveThenSend(std::array<std::size_t, 3> otherDirection, std::vector<util::Par
     }
 }
 
+/**
+ * Every worker sends one (possibly empty) message to each of its adjacent domains and receives one from each of them.
+ * All workers have to call this.
+ *
+ * @tparam T, the type of sent objects
+ * @param objects, the objects to send per target rank, targets have to be adjacent domains
+ * @param domain, the domain of this worker
+ * @param comm, communicator for the set of workers
+ * @return the objects this rank received
+ */
+template<typename T>
+inline std::vector<T> exchangeWithNeighbors(const std::unordered_map<int, std::vector<T>> &objects,
+                                            const model::MPIDomain &domain, const MPI_Comm &comm) {
+    std::vector<int> neighbors;
+    for (std::size_t i = 0; i < domain.neighborRanks().size(); ++i) {
+        const auto rank = domain.neighborRanks()[i];
+        if (domain.neighborTypes()[i] == model::MPIDomain::NeighborType::regular and rank != domain.rank()) {
+            neighbors.push_back(rank);
+        }
+    }
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+    for (const auto &[target, _] : objects) {
+        if (!std::binary_search(neighbors.begin(), neighbors.end(), target)) {
+            throw std::logic_error(fmt::format("rank={}, rank {} is not adjacent", domain.rank(), target));
+        }
+    }
+
+    const std::vector<T> none;
+    std::vector<MPI_Request> requests(neighbors.size());
+    for (std::size_t i = 0; i < neighbors.size(); ++i) {
+        auto it = objects.find(neighbors[i]);
+        const auto &send = it != objects.end() ? it->second : none;
+        MPI_Isend((void *) send.data(), static_cast<int>(send.size() * sizeof(T)), MPI_BYTE, neighbors[i],
+                  tags::neighborObjects, comm, &requests[i]);
+    }
+    std::vector<T> result;
+    for (const auto neighbor : neighbors) {
+        receiveAppendObjects(neighbor, result, comm, tags::neighborObjects);
+    }
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    return result;
+}
+
 // specialized version for MPI, todo remove topology?
 template<typename ParticleContainer, typename EvaluateOnParticle, typename InteractionContainer,
         typename EvaluateOnInteraction, typename TopologyContainer, typename EvaluateOnTopology>
@@ -258,4 +339,108 @@ inline std::vector<T> gatherObjects(const std::vector<T> &objects, int root, con
     return results;
 }
 
+/**
+ * Create an MPI data type that transfers one object of type T as an opaque block of bytes. Counts and
+ * displacements can then be given in number of objects instead of bytes, which would overflow int much earlier.
+ * The type has to be released with MPI_Type_free.
+ */
+template<typename T>
+inline MPI_Datatype contiguousType() {
+    MPI_Datatype type;
+    MPI_Type_contiguous(static_cast<int>(sizeof(T)), MPI_BYTE, &type);
+    MPI_Type_commit(&type);
+    return type;
+}
+
+/**
+ * Wrapper around Scatter and Scatterv, the counterpart of gatherObjects. The root sends `counts[i]` objects
+ * starting at `displacements[i]` to rank i. Counts and displacements only need to be valid on the root.
+ *
+ * @tparam T, the type of sent objects
+ * @param objects, the objects to send, only read on root
+ * @param counts, the number of objects per rank, only read on root
+ * @param displacements, the offset of each rank's objects in `objects`, only read on root
+ * @param root, the rank that sends
+ * @param comm, communicator for the set of workers
+ * @return the objects this rank received
+ */
+template<typename T>
+inline std::vector<T> scatterObjects(const std::vector<T> &objects, const std::vector<int> &counts,
+                                     const std::vector<int> &displacements, int root, const MPI_Comm &comm) {
+    int number {0};
+    MPI_Scatter(counts.data(), 1, MPI_INT, &number, 1, MPI_INT, root, comm);
+    std::vector<T> result(number);
+    auto type = contiguousType<T>();
+    MPI_Scatterv(objects.data(), counts.data(), displacements.data(), type,
+                 result.data(), number, type, root, comm);
+    MPI_Type_free(&type);
+    return result;
+}
+
+/**
+ * Wrapper around Alltoall and Alltoallv. Every rank sends `counts[i]` objects to rank i, where `objects` has to be
+ * ordered by target rank.
+ *
+ * @tparam T, the type of sent objects
+ * @param objects, the objects to send, ordered by target rank
+ * @param counts, number of objects for each rank in the communicator
+ * @param comm, communicator for the set of workers
+ * @return the objects this rank received, ordered by source rank
+ */
+template<typename T>
+inline std::vector<T> exchangeObjects(const std::vector<T> &objects, const std::vector<int> &counts,
+                                      const MPI_Comm &comm) {
+    int size;
+    MPI_Comm_size(comm, &size);
+    std::vector<int> receiveCounts(size, 0);
+    MPI_Alltoall(counts.data(), 1, MPI_INT, receiveCounts.data(), 1, MPI_INT, comm);
+
+    std::vector<int> sendDisplacements(size, 0);
+    std::vector<int> receiveDisplacements(size, 0);
+    std::exclusive_scan(counts.begin(), counts.end(), sendDisplacements.begin(), 0);
+    std::exclusive_scan(receiveCounts.begin(), receiveCounts.end(), receiveDisplacements.begin(), 0);
+
+    std::vector<T> result(receiveDisplacements.back() + receiveCounts.back());
+    auto type = contiguousType<T>();
+    MPI_Alltoallv(objects.data(), counts.data(), sendDisplacements.data(), type,
+                  result.data(), receiveCounts.data(), receiveDisplacements.data(), type, comm);
+    MPI_Type_free(&type);
+    return result;
+}
+
+/**
+ * The part of a distributed block of objects that one rank holds.
+ */
+struct BlockPartition {
+    /** offset of the rank's part in the whole block */
+    std::size_t offset {0};
+    /** number of objects the rank holds */
+    std::size_t count {0};
+    /** number of objects in the whole block, same on all ranks */
+    std::size_t total {0};
+};
+
+/**
+ * Determines where the objects of each rank go in a contiguous block over all ranks of the communicator,
+ * the offsets are the exclusive prefix sum of the per-rank counts. Collective operation.
+ *
+ * @param count the number of objects on this rank
+ * @param comm communicator for the set of workers
+ * @return offset, count and total for this rank
+ */
+inline BlockPartition partitionBlock(std::size_t count, const MPI_Comm &comm) {
+    unsigned long long local = count;
+    unsigned long long offset = 0;
+    unsigned long long total = 0;
+    MPI_Exscan(&local, &offset, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
+    // the receive buffer of rank 0 is undefined after an exclusive scan
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    if (rank == 0) {
+        offset = 0;
+    }
+    MPI_Allreduce(&local, &total, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, comm);
+    return {static_cast<std::size_t>(offset), count, static_cast<std::size_t>(total)};
+}
+
 }
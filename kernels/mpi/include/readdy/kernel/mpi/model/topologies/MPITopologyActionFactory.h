@@ -0,0 +1,85 @@
+/********************************************************************
+ * Copyright © 2026 Computational Molecular Biology Group,          *
+ *                  Freie Universität Berlin (GER)                  *
+ *                                                                  *
+ * Redistribution and use in source and binary forms, with or       *
+ * without modification, are permitted provided that the            *
+ * following conditions are met:                                    *
+ *  1. Redistributions of source code must retain the above         *
+ *     copyright notice, this list of conditions and the            *
+ *     following disclaimer.                                        *
+ *  2. Redistributions in binary form must reproduce the above      *
+ *     copyright notice, this list of conditions and the following  *
+ *     disclaimer in the documentation and/or other materials       *
+ *     provided with the distribution.                              *
+ *  3. Neither the name of the copyright holder nor the names of    *
+ *     its contributors may be used to endorse or promote products  *
+ *     derived from this software without specific                  *
+ *     prior written permission.                                    *
+ *                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND           *
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,      *
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF         *
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE         *
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR            *
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,         *
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER *
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,      *
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)    *
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF      *
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
+ ********************************************************************/
+
+/**
+ * Creates the actions that structural topology reactions are composed of. Bonded potentials of MPI topologies are
+ * evaluated by MPICalculateForces, so there are no potential actions.
+ *
+ * @file MPITopologyActionFactory.h
+ * @brief Topology action factory of the MPI kernel
+ * @author EricArkfeld
+ * @date 19.10.26
+ */
+
+#pragma once
+
+#include <readdy/model/topologies/TopologyActionFactory.h>
+#include <readdy/model/topologies/reactions/TopologyReactionActionFactory.h>
+
+namespace readdy::kernel::mpi {
+class MPIKernel;
+namespace model::top {
+
+class MPITopologyActionFactory : public readdy::model::top::TopologyActionFactory {
+    MPIKernel *const kernel;
+public:
+    explicit MPITopologyActionFactory(MPIKernel *kernel);
+
+    std::unique_ptr<readdy::model::top::pot::CalculateHarmonicBondPotential>
+    createCalculateHarmonicBondPotential(const harmonic_bond *potential) const override;
+
+    std::unique_ptr<readdy::model::top::pot::CalculateHarmonicAnglePotential>
+    createCalculateHarmonicAnglePotential(const harmonic_angle *potential) const override;
+
+    std::unique_ptr<readdy::model::top::pot::CalculateCosineDihedralPotential>
+    createCalculateCosineDihedralPotential(const cos_dihedral *potential) const override;
+
+    ActionPtr createChangeParticleType(readdy::model::top::GraphTopology *topology,
+                                       const readdy::model::top::Graph::PersistentVertexIndex &v,
+                                       const ParticleTypeId &type_to) const override;
+
+    ActionPtr createChangeTopologyType(readdy::model::top::GraphTopology *topology,
+                                       const std::string &type_to) const override;
+
+    ActionPtr createChangeParticlePosition(readdy::model::top::GraphTopology *topology,
+                                           const readdy::model::top::Graph::PersistentVertexIndex &v,
+                                           Vec3 position) const override;
+
+    ActionPtr createAppendParticle(readdy::model::top::GraphTopology *topology,
+                                   const std::vector<readdy::model::top::Graph::PersistentVertexIndex> &neighbors,
+                                   ParticleTypeId type, const Vec3 &position) const override;
+};
+
+}
+}
@@ -0,0 +1,103 @@
+/********************************************************************
+ * Copyright © 2026 Computational Molecular Biology Group,          *
+ *                  Freie Universität Berlin (GER)                  *
+ *                                                                  *
+ * Redistribution and use in source and binary forms, with or       *
+ * without modification, are permitted provided that the            *
+ * following conditions are met:                                    *
+ *  1. Redistributions of source code must retain the above         *
+ *     copyright notice, this list of conditions and the            *
+ *     following disclaimer.                                        *
+ *  2. Redistributions in binary form must reproduce the above      *
+ *     copyright notice, this list of conditions and the following  *
+ *     disclaimer in the documentation and/or other materials       *
+ *     provided with the distribution.                              *
+ *  3. Neither the name of the copyright holder nor the names of    *
+ *     its contributors may be used to endorse or promote products  *
+ *     derived from this software without specific                  *
+ *     prior written permission.                                    *
+ *                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND           *
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,      *
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF         *
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE         *
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR            *
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,         *
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER *
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,      *
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)    *
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF      *
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
+ ********************************************************************/
+
+/**
+ * Actions that apply topology reaction recipes to the particle data of an MPI worker. The vertices of the topology
+ * point to entries in the domain core or halo of the worker that holds the topology. Changes to halo entries are only
+ * local, the caller sends them to the responsible workers afterwards, see MPIStateModel::returnHaloParticleChanges().
+ *
+ * @file MPITopologyActions.h
+ * @brief Topology reaction actions of the MPI kernel
+ * @author EricArkfeld
+ * @date 19.10.26
+ */
+
+#pragma once
+
+#include <readdy/model/topologies/GraphTopology.h>
+#include <readdy/model/topologies/reactions/TopologyReactionAction.h>
+#include <readdy/kernel/mpi/MPIStateModel.h>
+
+namespace readdy::kernel::mpi::model::top::reactions::op {
+
+class MPIChangeParticleType : public readdy::model::top::reactions::actions::ChangeParticleType {
+    MPIDataContainer *const data;
+public:
+    MPIChangeParticleType(MPIDataContainer *const data, readdy::model::top::GraphTopology *const topology,
+                          const readdy::model::top::Graph::PersistentVertexIndex &v, const ParticleTypeId &type_to)
+            : ChangeParticleType(topology, v, type_to), data(data) {}
+
+    void execute() override {
+        const auto idx = topology->graph().vertices().at(_vertex)->particleIndex;
+        std::swap(data->entry_at(idx).type, previous_type);
+    }
+};
+
+class MPIChangeParticlePosition : public readdy::model::top::reactions::actions::ChangeParticlePosition {
+    MPIDataContainer *const data;
+public:
+    MPIChangeParticlePosition(MPIDataContainer *const data, readdy::model::top::GraphTopology *const topology,
+                              const readdy::model::top::Graph::PersistentVertexIndex &v, Vec3 posTo)
+            : ChangeParticlePosition(topology, v, posTo), data(data) {}
+
+    void execute() override {
+        const auto idx = topology->graph().vertices().at(_vertex)->particleIndex;
+        std::swap(data->entry_at(idx).pos, _posTo);
+    }
+};
+
+/**
+ * The appended particle gets an id that is unique over all ranks, the worker is responsible for it until the next
+ * synchronization.
+ */
+class MPIAppendParticle : public readdy::model::top::reactions::actions::AppendParticle {
+    MPIStateModel *const stateModel;
+public:
+    MPIAppendParticle(MPIStateModel *const stateModel, readdy::model::top::GraphTopology *topology,
+                      std::vector<readdy::model::top::Graph::PersistentVertexIndex> neighbors, ParticleTypeId type,
+                      Vec3 pos)
+            : AppendParticle(topology, std::move(neighbors), type, pos), stateModel(stateModel) {}
+
+    void execute() override {
+        const auto insertIndex = stateModel->addCreatedTopologyParticle(readdy::model::Particle(pos, type));
+        // append particle forming edge to the first neighbor
+        auto ix = topology->appendParticle(insertIndex, neighbors[0]);
+        // add remaining edges
+        for (std::size_t i = 1; i < neighbors.size(); ++i) {
+            topology->addEdge(ix, neighbors[i]);
+        }
+    }
+};
+
+}
@@ -0,0 +1,141 @@
+/********************************************************************
+ * Copyright © 2026 Computational Molecular Biology Group,          *
+ *                  Freie Universität Berlin (GER)                  *
+ *                                                                  *
+ * Redistribution and use in source and binary forms, with or       *
+ * without modification, are permitted provided that the            *
+ * following conditions are met:                                    *
+ *  1. Redistributions of source code must retain the above         *
+ *     copyright notice, this list of conditions and the            *
+ *     following disclaimer.                                        *
+ *  2. Redistributions in binary form must reproduce the above      *
+ *     copyright notice, this list of conditions and the following  *
+ *     disclaimer in the documentation and/or other materials       *
+ *     provided with the distribution.                              *
+ *  3. Neither the name of the copyright holder nor the names of    *
+ *     its contributors may be used to endorse or promote products  *
+ *     derived from this software without specific                  *
+ *     prior written permission.                                    *
+ *                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND           *
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,      *
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF         *
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE         *
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR            *
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,         *
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER *
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,      *
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)    *
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF      *
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
+ ********************************************************************/
+
+/**
+ * Writer for observables of the MPI kernel that write their results collectively into a file that was opened through
+ * MPI-IO. Instead of gathering everything on the master rank, each worker writes its part of a frame as a hyperslab of
+ * a flat data set. The frames are delimited by a "limits" data set with [begin, end) per frame, i.e., the same layout
+ * that is used by the FlatTrajectory. Variable length data sets cannot be written in parallel, hence this layout.
+ *
+ * @file CollectiveWriter.h
+ * @brief Flat, collectively written data sets for MPI observables
+ * @author EricArkfeld
+ * @date 19.10.26
+ */
+
+#pragma once
+
+#include <h5rd/h5rd.h>
+#include <readdy/common/common.h>
+#include <readdy/kernel/mpi/MPIStateModel.h>
+#include <readdy/model/observables/io/Types.h>
+
+namespace readdy::kernel::mpi::observables {
+
+class CollectiveWriter {
+public:
+    /**
+     * Creates the group `/readdy/observables/<dataSetName>` with the "limits" and "time" data sets. Collective
+     * operation over `comm`, which has to be the communicator the file was opened with.
+     */
+    CollectiveWriter(h5rd::File &file, const std::string &dataSetName, Stride flushStride, const MPI_Comm &comm)
+            : _comm(comm), _flushStride(flushStride),
+              _group(file.createGroup(std::string(readdy::model::observables::util::OBSERVABLES_GROUP_PATH) + "/" +
+                                      dataSetName)) {
+        if (!file.collective()) {
+            throw std::invalid_argument("The collective writer requires a file that was opened through MPI-IO");
+        }
+#ifdef H5_HAVE_PARALLEL
+        int cmp;
+        MPI_Comm_compare(file.comm(), comm, &cmp);
+        if (cmp != MPI_IDENT and cmp != MPI_CONGRUENT) {
+            throw std::invalid_argument("The file has to be opened collectively by exactly the used ranks");
+        }
+#endif
+        MPI_Comm_rank(comm, &_rank);
+        _limits = _group.createDataSet<std::size_t>("limits", {flushStride, 2}, {h5rd::UNLIMITED_DIMS, 2});
+        _time = _group.createDataSet<TimeStep>("time", {flushStride}, {h5rd::UNLIMITED_DIMS});
+    }
+
+    /**
+     * Adds a flat data set, which receives one contiguous range of elements per frame. Collective operation.
+     */
+    void addColumn(const std::string &name, const h5rd::DataSetType &memoryType, const h5rd::DataSetType &fileType) {
+        _columns.push_back(_group.createDataSet(name, {_flushStride}, {h5rd::UNLIMITED_DIMS}, memoryType, fileType));
+    }
+
+    template<typename T>
+    void addColumn(const std::string &name) {
+        _columns.push_back(_group.createDataSet<T>(name, {_flushStride}, {h5rd::UNLIMITED_DIMS}));
+    }
+
+    /**
+     * Appends one frame. Each rank contributes `count` elements per column, which are placed according to an
+     * exclusive scan over all ranks' counts. Time and limits are written by rank 0 of the communicator.
+     * Collective operation.
+     *
+     * @param t the current time step
+     * @param count the number of elements this rank contributes
+     * @param columns pointers to this rank's data, one per column in the order they were added
+     */
+    void append(TimeStep t, std::size_t count, const std::vector<const void *> &columns) {
+        if (columns.size() != _columns.size()) {
+            throw std::invalid_argument(fmt::format("Expected data for {} columns but got {}",
+                                                    _columns.size(), columns.size()));
+        }
+        const auto partition = mpi::util::partitionBlock(count, _comm);
+        for (std::size_t i = 0; i < _columns.size(); ++i) {
+            _columns[i]->appendCollective({partition.count}, columns[i], partition.offset, partition.total);
+        }
+        _currentLimits[0] = _currentLimits[1];
+        _currentLimits[1] += partition.total;
+        const h5rd::dimension nRoot = _rank == 0 ? 1 : 0;
+        _limits->appendCollective({nRoot, 2}, _currentLimits, 0, 1);
+        _time->appendCollective({nRoot}, &t, 0, 1);
+    }
+
+    void flush() {
+        for (auto &column : _columns) {
+            column->flush();
+        }
+        _limits->flush();
+        _time->flush();
+    }
+
+    h5rd::Group &group() {
+        return _group;
+    }
+
+private:
+    MPI_Comm _comm;
+    int _rank {0};
+    Stride _flushStride;
+    h5rd::Group _group;
+    std::vector<std::unique_ptr<h5rd::DataSet>> _columns;
+    std::unique_ptr<h5rd::DataSet> _limits;
+    std::unique_ptr<h5rd::DataSet> _time;
+    std::size_t _currentLimits[2] {0, 0};
+};
+
+}
@@ -38,7 +38,14 @@
  * @author chrisfroe
  * @date 03.06.19
  *
- * todo: https://support.hdfgroup.org/HDF5/PHDF5/ ?
+ * Observables that produce per-particle results (positions, particles, forces, reactions) support two output modes.
+ * If the file passed to enableWriteToFile() was opened collectively via MPI-IO, each worker writes its own part of
+ * a frame into flat data sets (see CollectiveWriter), and the result on each rank only contains the rank's own data.
+ * Otherwise the results are gathered on the master rank, which writes them alone.
+ *
+ * Observables that are sums over all workers (energy, virial, histogram, particle and reaction counts) are
+ * ReducibleObservables. When evaluated as part of the kernel's evaluateObservables(), all of them that are due in
+ * a time step are reduced together, see ObservableReducer. The reduced result is only available on the master rank.
  */
 
 #pragma once
@@ -46,6 +53,8 @@
 
 #include <readdy/model/observables/Observables.h>
 #include <readdy/model/observables/io/TimeSeriesWriter.h>
+#include <readdy/kernel/mpi/observables/CollectiveWriter.h>
+#include <readdy/kernel/mpi/observables/ObservableReducer.h>
 
 namespace rmou = readdy::model::observables::util;
 
@@ -55,36 +64,59 @@ class MPIKernel;
 
 namespace observables {
 
-class MPIEnergy : public readdy::model::observables::Energy {
+/**
+ * Base of the observables whose result is a sum over the contributions of all workers. The observable only evaluates
+ * the contribution of its rank in evaluateLocal(), everything else (reduction, writing on the master, callback) is
+ * handled here. Results that are scalars, matrices or vectors of numbers are packed into the reduction buffer as they
+ * are, other results need to override the packing.
+ * @tparam Observable the observable of the default model
+ */
+template<typename Observable>
+class MPISummedObservable : public Observable, public ReducibleObservable {
 public:
-    MPIEnergy(MPIKernel *kernel, Stride stride);
+    template<typename... Args>
+    explicit MPISummedObservable(MPIKernel *kernel, Args &&... args)
+            : Observable(kernel, std::forward<Args>(args)...), kernel(kernel) {}
 
     void evaluate() override;
 
+    void call(TimeStep t) override;
+
+    [[nodiscard]] std::size_t reductionSize() const override;
+
+    void pack(double *buffer) const override;
+
+    void unpack(const double *buffer) override;
+
+    void finishReduction() override;
+
 protected:
     MPIKernel *kernel;
 
+    /**
+     * Evaluates the contribution of this rank to the result, ranks without particles contribute zeros.
+     */
+    virtual void evaluateLocal() = 0;
+
     void append() override;
 
     void initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) override;
-
-    std::unique_ptr<h5rd::DataSet> ds{nullptr};
-    std::unique_ptr<rmou::TimeSeriesWriter> time{nullptr};
-    io::BloscFilter bloscFilter{};
 };
 
-class MPIVirial : public readdy::model::observables::Virial {
+class MPIEnergy : public MPISummedObservable<readdy::model::observables::Energy> {
 public:
-    MPIVirial(MPIKernel *kernel, Stride stride);
-
-    void evaluate() override;
+    MPIEnergy(MPIKernel *kernel, Stride stride);
 
 protected:
-    MPIKernel *kernel;
+    void evaluateLocal() override;
+};
 
-    void append() override;
+class MPIVirial : public MPISummedObservable<readdy::model::observables::Virial> {
+public:
+    MPIVirial(MPIKernel *kernel, Stride stride);
 
-    void initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) override;
+protected:
+    void evaluateLocal() override;
 };
 
 class MPIPositions : public readdy::model::observables::Positions {
@@ -93,12 +125,16 @@ public:
 
     void evaluate() override;
 
+    void flush() override;
+
 protected:
     MPIKernel *kernel;
 
     void append() override;
 
     void initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) override;
+
+    std::unique_ptr<CollectiveWriter> collectiveWriter {nullptr};
 };
 
 class MPIParticles : public readdy::model::observables::Particles {
@@ -108,15 +144,19 @@ public:
     // fixme note that returned particle ids are meaningless, they do not reflect the ids present on the workers' states
     void evaluate() override;
 
+    void flush() override;
+
 protected:
     MPIKernel *kernel;
 
     void append() override;
 
     void initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) override;
+
+    std::unique_ptr<CollectiveWriter> collectiveWriter {nullptr};
 };
 
-class MPIHistogramAlongAxis : public readdy::model::observables::HistogramAlongAxis {
+class MPIHistogramAlongAxis : public MPISummedObservable<readdy::model::observables::HistogramAlongAxis> {
 
 public:
     MPIHistogramAlongAxis(MPIKernel *kernel, unsigned int stride,
@@ -124,30 +164,17 @@ public:
                           const std::vector<std::string> &typesToCount,
                           unsigned int axis);
 
-    void evaluate() override;
-
 protected:
-    MPIKernel *kernel;
-
-    void append() override;
-
-    void initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) override;
+    void evaluateLocal() override;
 };
 
-class MPINParticles : public readdy::model::observables::NParticles {
+class MPINParticles : public MPISummedObservable<readdy::model::observables::NParticles> {
 public:
 
     MPINParticles(MPIKernel *kernel, unsigned int stride, std::vector<std::string> typesToCount = {});
 
-
-    void evaluate() override;
-
 protected:
-    MPIKernel *kernel;
-
-    void append() override;
-
-    void initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) override;
+    void evaluateLocal() override;
 };
 
 class MPIForces : public readdy::model::observables::Forces {
@@ -158,6 +185,8 @@ public:
 
     void evaluate() override;
 
+    void flush() override;
+
 
 protected:
     MPIKernel *kernel;
@@ -165,6 +194,8 @@ protected:
     void append() override;
 
     void initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) override;
+
+    std::unique_ptr<CollectiveWriter> collectiveWriter {nullptr};
 };
 
 class MPIReactions : public readdy::model::observables::Reactions {
@@ -173,26 +204,34 @@ public:
 
     void evaluate() override;
 
+    void flush() override;
+
 protected:
     MPIKernel *kernel;
 
     void append() override;
 
     void initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) override;
+
+    std::unique_ptr<CollectiveWriter> collectiveWriter {nullptr};
 };
 
-class MPIReactionCounts : public readdy::model::observables::ReactionCounts {
+class MPIReactionCounts : public MPISummedObservable<readdy::model::observables::ReactionCounts> {
 public:
     MPIReactionCounts(MPIKernel *kernel, unsigned int stride);
 
-    void evaluate() override;
+    // the counts are reduced in the order of reactionIds instead of the generic packing
+    [[nodiscard]] std::size_t reductionSize() const override;
 
-protected:
-    MPIKernel *kernel;
+    void pack(double *buffer) const override;
 
-    void append() override;
+    void unpack(const double *buffer) override;
 
-    void initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) override;
+protected:
+    void evaluateLocal() override;
+
+    // order of the reaction counts in the reduction buffer
+    std::vector<ReactionId> reactionIds;
 };
 
 }
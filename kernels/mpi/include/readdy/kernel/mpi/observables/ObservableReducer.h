@@ -0,0 +1,160 @@
+/********************************************************************
+ * Copyright © 2026 Computational Molecular Biology Group,          *
+ *                  Freie Universität Berlin (GER)                  *
+ *                                                                  *
+ * Redistribution and use in source and binary forms, with or       *
+ * without modification, are permitted provided that the            *
+ * following conditions are met:                                    *
+ *  1. Redistributions of source code must retain the above         *
+ *     copyright notice, this list of conditions and the            *
+ *     following disclaimer.                                        *
+ *  2. Redistributions in binary form must reproduce the above      *
+ *     copyright notice, this list of conditions and the following  *
+ *     disclaimer in the documentation and/or other materials       *
+ *     provided with the distribution.                              *
+ *  3. Neither the name of the copyright holder nor the names of    *
+ *     its contributors may be used to endorse or promote products  *
+ *     derived from this software without specific                  *
+ *     prior written permission.                                    *
+ *                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND           *
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,      *
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF         *
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE         *
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR            *
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,         *
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER *
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,      *
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)    *
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF      *
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
+ ********************************************************************/
+
+/**
+ * Batched reduction of observables of the MPI kernel. Observables whose result is a sum over all workers (energy,
+ * virial, histograms, particle and reaction counts) pack their local contribution into one common buffer. All
+ * observables that are due in the same time step are then reduced onto the master rank with a single MPI_Reduce,
+ * i.e. each additional observable costs no extra round trip. The workers do not wait for the master writing the
+ * reduced results into a file.
+ *
+ * @file ObservableReducer.h
+ * @brief Pack observables due in one time step into a single reduction
+ * @author EricArkfeld
+ * @date 19.10.26
+ */
+
+#pragma once
+
+#include <vector>
+#include <mpi.h>
+
+namespace readdy::kernel::mpi::observables {
+
+/**
+ * Interface of observables that can be summed up over all ranks. The buffer consists of doubles, which represent
+ * the counting observables exactly.
+ */
+class ReducibleObservable {
+public:
+    virtual ~ReducibleObservable() = default;
+
+    /**
+     * @return the number of values this observable contributes to the reduction buffer
+     */
+    [[nodiscard]] virtual std::size_t reductionSize() const = 0;
+
+    /**
+     * Write the local contribution into `buffer`, which has space for reductionSize() values.
+     */
+    virtual void pack(double *buffer) const = 0;
+
+    /**
+     * Only called on the master rank, takes the reduced values from `buffer`.
+     */
+    virtual void unpack(const double *buffer) = 0;
+
+    /**
+     * Called on all ranks after the reduction, e.g. to write the result and invoke the callback.
+     */
+    virtual void finishReduction() = 0;
+};
+
+class ObservableReducer {
+public:
+    /**
+     * Observables enqueued after this are only reduced in endBatch().
+     */
+    void beginBatch() {
+        _batching = true;
+    }
+
+    /**
+     * Reduces all enqueued observables with one collective call and finishes them in order of enqueueing.
+     * All used ranks have to enqueue the same observables in the same order.
+     */
+    void endBatch(const MPI_Comm &comm) {
+        _batching = false;
+        if (!_queue.empty()) {
+            reduce(_queue, comm);
+            for (auto *observable : _queue) {
+                observable->finishReduction();
+            }
+            _queue.clear();
+        }
+    }
+
+    /**
+     * Enqueues the observable for the current batch, if there is none it is reduced and finished right away.
+     */
+    void enqueue(ReducibleObservable *observable, const MPI_Comm &comm) {
+        if (_batching) {
+            _queue.push_back(observable);
+        } else {
+            reduce({observable}, comm);
+            observable->finishReduction();
+        }
+    }
+
+    /**
+     * Reduces the given observables onto the master rank, without finishing them.
+     */
+    void reduce(const std::vector<ReducibleObservable *> &observables, const MPI_Comm &comm) {
+        std::size_t size{0};
+        for (const auto *observable : observables) {
+            size += observable->reductionSize();
+        }
+        _send.resize(size);
+        _receive.resize(size);
+        std::size_t offset{0};
+        for (const auto *observable : observables) {
+            observable->pack(_send.data() + offset);
+            offset += observable->reductionSize();
+        }
+
+        int rank;
+        MPI_Comm_rank(comm, &rank);
+        MPI_Reduce(_send.data(), _receive.data(), static_cast<int>(size), MPI_DOUBLE, MPI_SUM, 0, comm);
+
+        if (rank == 0) {
+            offset = 0;
+            for (auto *observable : observables) {
+                observable->unpack(_receive.data() + offset);
+                offset += observable->reductionSize();
+            }
+        }
+    }
+
+    [[nodiscard]] bool batching() const {
+        return _batching;
+    }
+
+private:
+    bool _batching{false};
+    std::vector<ReducibleObservable *> _queue;
+    std::vector<double> _send;
+    std::vector<double> _receive;
+};
+
+}
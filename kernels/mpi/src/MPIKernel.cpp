@@ -51,7 +51,7 @@ MPIKernel::MPIKernel() : MPIKernel(readdy::model::Context{}) {}
 // pay attention to order of initialization, which is defined by class hierarchy, then by order of declaration
 MPIKernel::MPIKernel(const readdy::model::Context &ctx)
         : Kernel(name, ctx), _domain(_context), _data(&_domain), _actions(this), _observables(this),
-          _stateModel(_data, _context, &_domain) {
+          _stateModel(_data, _context, &_domain), _topologyActionFactory(this) {
     // Description of decomposition
     if (_domain.isMasterRank()) {
         readdy::log::info(_domain.describe());
@@ -85,6 +85,14 @@ MPIKernel::MPIKernel(const readdy::model::Context &ctx)
     // propagate to other classes that need communicator and don't know the kernel
     _stateModel.commUsedRanks() = _commUsedRanks;
 
+    // particles created on this rank get ids that are unique over all ranks
+    {
+        auto *counter = readdy::model::detail::particleIdCounter();
+        const ParticleId first = util::rankPrefixedId(_domain.rank(), 0);
+        auto current = counter->load();
+        while (current < first and !counter->compare_exchange_weak(current, first)) {}
+    }
+
     _stateModel.reactionRecords().clear();
     _stateModel.resetReactionCounts();
     _stateModel.virial() = Matrix33{{{0, 0, 0, 0, 0, 0, 0, 0, 0}}};
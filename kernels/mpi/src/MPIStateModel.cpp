@@ -43,6 +43,10 @@
 
 #include <readdy/kernel/mpi/MPIStateModel.h>
 #include <readdy/common/Timer.h>
+#include <readdy/model/observables/io/Types.h>
+#include <readdy/model/observables/io/TrajectoryEntry.h>
+#include <readdy/model/observables/io/Trajectory.h>
+#include <readdy/model/IOUtils.h>
 
 namespace readdy::kernel::mpi {
 
@@ -82,7 +86,7 @@ MPIStateModel::gatherParticles() const {
     std::vector<Particle> particles;
     std::for_each(thinParticles.begin(), thinParticles.end(),
                   [&particles](const util::ParticlePOD &tp) {
-                      particles.emplace_back(tp.position, tp.typeId);
+                      particles.emplace_back(tp.position, tp.typeId, tp.id);
                   });
     return particles;
 }
@@ -124,7 +128,9 @@ void MPIStateModel::toDenseParticleIndices(
 
 void MPIStateModel::clear() {
     getParticleData()->clear();
-    //topologies().clear();
+    _topologies.clear();
+    _topologyEntries.clear();
+    _hasTopologies = false;
     reactionRecords().clear();
     resetReactionCounts();
     virial() = {};
@@ -139,58 +145,355 @@ void MPIStateModel::addParticles(const std::vector<Particle> &particles) {
     getParticleData()->addParticles(particles);
 }
 
-// todo use MPI_Scatter
+namespace {
+/**
+ * Counting sort of particles by their responsible rank, so that the particles for each rank are contiguous.
+ * @return the sorted particles and the number of particles per rank
+ */
+std::pair<std::vector<util::ParticlePOD>, std::vector<int>>
+sortByRank(const std::vector<readdy::model::Particle> &ps, const model::MPIDomain &domain) {
+    std::vector<int> counts(domain.nUsedRanks(), 0);
+    std::vector<int> targets;
+    targets.reserve(ps.size());
+    for (const auto &particle : ps) {
+        const auto target = domain.rankOfPosition(particle.pos());
+        assert(target < domain.nUsedRanks());
+        assert(target != 0);
+        targets.push_back(target);
+        ++counts[target];
+    }
+    std::vector<int> next(counts.size(), 0);
+    std::exclusive_scan(counts.begin(), counts.end(), next.begin(), 0);
+    std::vector<util::ParticlePOD> sorted(ps.size());
+    for (std::size_t i = 0; i < ps.size(); ++i) {
+        sorted[next[targets[i]]++] = util::ParticlePOD(ps[i]);
+    }
+    return std::make_pair(std::move(sorted), std::move(counts));
+}
+}
+
+void MPIStateModel::addResponsibleParticles(const std::vector<util::ParticlePOD> &particles) {
+    std::vector<MPIEntry> entries;
+    entries.reserve(particles.size());
+    for (const auto &pod : particles) {
+        entries.emplace_back(Particle(pod.position, pod.typeId, pod.id), true, _domain->rank());
+    }
+    auto &data = _data.get();
+    data.reserve(data.size() + entries.size());
+    indexTopologyEntries(data.update(std::make_pair(std::move(entries), std::vector<Data::EntryIndex>{})));
+}
+
 void MPIStateModel::distributeParticles(const std::vector<Particle> &ps) {
     if (_domain->isIdleRank()) {
         return;
     }
     readdy::util::Timer timer("MPIStateModel::distributeParticles");
+    std::vector<util::ParticlePOD> sorted;
+    std::vector<int> counts;
+    std::vector<int> displacements;
     if (_domain->isMasterRank()) {
-        std::unordered_map<int, std::vector<util::ParticlePOD>> targetParticleMap;
-        for (const auto &particle : ps) {
-            int target = _domain->rankOfPosition(particle.pos());
-            assert(target < domain()->nUsedRanks());
-            assert(target != 0);
-            const auto &find = targetParticleMap.find(target);
-            if (find != targetParticleMap.end()) {
-                find->second.emplace_back(particle.pos(), particle.type());
-            } else {
-                targetParticleMap.emplace(std::make_pair(
-                        target, std::vector<util::ParticlePOD>{{particle.pos(), particle.type()}}
-                ));
+        std::tie(sorted, counts) = sortByRank(ps, *_domain);
+        displacements.resize(counts.size());
+        std::exclusive_scan(counts.begin(), counts.end(), displacements.begin(), 0);
+    }
+    const auto received = util::scatterObjects(sorted, counts, displacements, 0, _commUsedRanks);
+    if (_domain->isWorkerRank()) {
+        addResponsibleParticles(received);
+    }
+}
+
+void MPIStateModel::redistributeParticles(const std::vector<Particle> &ps) {
+    if (_domain->isIdleRank()) {
+        return;
+    }
+    readdy::util::Timer timer("MPIStateModel::redistributeParticles");
+    const auto [sorted, counts] = sortByRank(ps, *_domain);
+    const auto received = util::exchangeObjects(sorted, counts, _commUsedRanks);
+    if (_domain->isWorkerRank()) {
+        addResponsibleParticles(received);
+    } else if (!received.empty()) {
+        throw std::logic_error("The master rank must not receive particles");
+    }
+}
+
+void MPIStateModel::distributeParticlesFromFile(const std::string &fileName, const std::string &trajectoryGroup) {
+    if (_domain->isIdleRank()) {
+        return;
+    }
+    readdy::util::Timer timer("MPIStateModel::distributeParticlesFromFile");
+    std::vector<Particle> slice;
+    {
+        auto file = File::open(fileName, File::Flag::READ_ONLY);
+        auto group = file->getSubgroup(trajectoryGroup);
+        std::vector<std::size_t> limits;
+        group.read("limits", limits);
+        if (limits.size() < 2) {
+            throw std::invalid_argument(fmt::format("No frames in trajectory {} of file {}", trajectoryGroup, fileName));
+        }
+        // last frame is [begin, end)
+        const auto begin = limits[limits.size() - 2];
+        const auto end = limits[limits.size() - 1];
+        // contiguous slice of the frame for this rank
+        const auto n = end - begin;
+        const auto nRanks = static_cast<std::size_t>(_domain->nUsedRanks());
+        const auto rank = static_cast<std::size_t>(_domain->rank());
+        const auto sliceBegin = begin + (n * rank) / nRanks;
+        const auto sliceEnd = begin + (n * (rank + 1)) / nRanks;
+        if (sliceEnd > sliceBegin) {
+            auto types = readdy::model::observables::util::getTrajectoryEntryTypes(file->ref());
+            std::vector<readdy::model::observables::TrajectoryEntry> entries;
+            group.readSelection("records", entries, &std::get<0>(types), &std::get<1>(types),
+                                {sliceBegin}, {1}, {sliceEnd - sliceBegin});
+            slice.reserve(entries.size());
+            for (const auto &entry : entries) {
+                slice.emplace_back(entry.pos, entry.typeId);
             }
         }
-        std::vector<char> isTarget(_domain->nUsedRanks(), false);
-        for (auto&&[target, vec] : targetParticleMap) {
-            isTarget[target] = true;
+    }
+    redistributeParticles(slice);
+}
+
+void MPIStateModel::addMPITopology(TopologyTypeId type, const std::vector<Particle> &particles,
+                                   const std::vector<std::tuple<std::size_t, std::size_t>> &edges) {
+    if (_domain->isIdleRank()) {
+        return;
+    }
+    // the master sends the topology to the worker that is responsible for its anchor
+    std::vector<std::size_t> description;
+    std::vector<int> counts;
+    std::vector<int> displacements;
+    if (_domain->isMasterRank()) {
+        std::vector<ParticleId> ids;
+        std::vector<ParticleTypeId> types;
+        ids.reserve(particles.size());
+        types.reserve(particles.size());
+        std::transform(particles.begin(), particles.end(), std::back_inserter(ids), [](const auto &p) { return p.id(); });
+        std::transform(particles.begin(), particles.end(), std::back_inserter(types), [](const auto &p) { return p.type(); });
+        const model::MPITopology topology(util::rankPrefixedId(_domain->rank(), _nCreatedTopologies++), type,
+                                          std::move(ids), std::move(types), edges, _context.get());
+        topology.serialize(description);
+        counts.resize(_domain->nUsedRanks(), 0);
+        counts.at(_domain->rankOfPosition(particles.front().pos())) = static_cast<int>(description.size());
+        displacements.resize(counts.size());
+        std::exclusive_scan(counts.begin(), counts.end(), displacements.begin(), 0);
+    }
+    const auto received = util::scatterObjects(description, counts, displacements, 0, _commUsedRanks);
+    for (auto it = received.cbegin(); it != received.cend();) {
+        _topologies.push_back(model::MPITopology::deserialize(it, _context.get()));
+    }
+    _hasTopologies = true;
+    distributeParticles(particles);
+}
+
+void MPIStateModel::indexTopologyEntries(const std::vector<Data::EntryIndex> &indices) {
+    const auto &types = _context.get().particleTypes();
+    const auto &data = _data.get();
+    for (const auto index : indices) {
+        const auto &entry = data.entry_at(index);
+        if (!entry.deactivated and types.infoOf(entry.type).flavor == readdy::model::particleflavor::TOPOLOGY) {
+            auto [it, inserted] = _topologyEntries.emplace(entry.id, index);
+            if (!inserted) {
+                const auto &indexed = data.entry_at(it->second);
+                if (entry.responsible or indexed.deactivated or indexed.id != entry.id) {
+                    it->second = index;
+                }
+            }
         }
-        // broadcast target
-        MPI_Bcast(isTarget.data(), isTarget.size(), MPI_CHAR, 0, _commUsedRanks);
-        // send
-        for (auto&&[target, thinParticles] : targetParticleMap) {
-            MPI_Request req;
-            MPI_Isend((void *) thinParticles.data(),
-                      static_cast<int>(thinParticles.size() * sizeof(util::ParticlePOD)), MPI_BYTE,
-                      target, util::tags::transmitObjects, _commUsedRanks, &req);
-            MPI_Request_free(&req);
+    }
+}
+
+void MPIStateModel::migrateTopologies() {
+    std::unordered_map<int, std::vector<std::size_t>> outgoing;
+    std::vector<model::MPITopology> staying;
+    for (auto &topology : _topologies) {
+        const auto *anchor = topologyEntry(topology.anchor());
+        if (anchor == nullptr) {
+            throw std::runtime_error(fmt::format("rank={}, anchor particle {} of topology {} is neither in the domain "
+                                                 "core nor in the halo", _domain->rank(), topology.anchor(),
+                                                 topology.id()));
         }
-        MPI_Barrier(_commUsedRanks);
-    } else {
-        std::vector<char> isTarget(_domain->nUsedRanks(), false);
-        // am i one of the targets?
-        MPI_Bcast(isTarget.data(), isTarget.size(), MPI_CHAR, 0, _commUsedRanks);
-        if (isTarget[_domain->rank()]) {
-            // receive, ignore argument p here
-            const auto thinParticles = util::receiveObjects<util::ParticlePOD>(0, _commUsedRanks);
-            std::vector<Particle> particles;
-            std::for_each(thinParticles.begin(), thinParticles.end(),
-                          [&particles](const util::ParticlePOD &tp) {
-                              particles.emplace_back(tp.position, tp.typeId);
-                          });
-            addParticles(particles);
+        if (anchor->responsible) {
+            staying.push_back(std::move(topology));
+        } else {
+            topology.serialize(outgoing[anchor->rank]);
+        }
+    }
+    _topologies = std::move(staying);
+
+    const auto received = util::exchangeWithNeighbors(outgoing, *_domain, _commUsedRanks);
+    for (auto it = received.cbegin(); it != received.cend();) {
+        _topologies.push_back(model::MPITopology::deserialize(it, _context.get()));
+    }
+}
+
+void MPIStateModel::returnHaloForces(const std::unordered_map<ParticleId, Vec3> &haloForces) {
+    std::unordered_map<int, std::vector<util::ForcePOD>> outgoing;
+    for (const auto &[id, force] : haloForces) {
+        const auto *entry = topologyEntry(id);
+        if (entry == nullptr or entry->responsible) {
+            throw std::logic_error(fmt::format("rank={}, particle {} with a halo force is not a halo particle of "
+                                               "this worker", _domain->rank(), id));
         }
-        MPI_Barrier(_commUsedRanks);
+        outgoing[entry->rank].push_back({id, force});
     }
+    for (const auto &received : util::exchangeWithNeighbors(outgoing, *_domain, _commUsedRanks)) {
+        auto *entry = topologyEntry(received.id);
+        if (entry == nullptr or !entry->responsible) {
+            throw std::logic_error(fmt::format("rank={}, received a force for particle {} which this worker is not "
+                                               "responsible for", _domain->rank(), received.id));
+        }
+        entry->force += received.force;
+    }
+}
+
+void MPIStateModel::returnHaloParticleChanges(const std::unordered_map<int, std::vector<util::ParticlePOD>> &changes) {
+    for (const auto &received : util::exchangeWithNeighbors(changes, *_domain, _commUsedRanks)) {
+        auto *entry = topologyEntry(received.id);
+        if (entry == nullptr or !entry->responsible) {
+            throw std::logic_error(fmt::format("rank={}, received a change of particle {} which this worker is not "
+                                               "responsible for", _domain->rank(), received.id));
+        }
+        entry->type = received.typeId;
+        entry->pos = received.position;
+    }
+}
+
+std::string MPIStateModel::checkpointDomainFile(const std::string &manifestPath, int rank) {
+    const std::string extension = ".h5";
+    auto stem = manifestPath;
+    if (stem.size() >= extension.size() && stem.compare(stem.size() - extension.size(), extension.size(), extension) == 0) {
+        stem.erase(stem.size() - extension.size());
+    }
+    return fmt::format("{}_domain_{}{}", stem, rank, extension);
+}
+
+std::string MPIStateModel::writeCheckpoint(const std::string &basePath, TimeStep t) const {
+    if (_domain->isIdleRank()) {
+        return "";
+    }
+    readdy::util::Timer timer("MPIStateModel::writeCheckpoint");
+    const auto manifestPath = fmt::format("{}/checkpoint_{}.h5", basePath, t);
+    const auto &types = _context.get().particleTypes();
+
+    std::vector<readdy::model::observables::TrajectoryEntry> entries;
+    if (_domain->isWorkerRank()) {
+        const auto &data = _data.get();
+        for (const auto &entry : data) {
+            if (!entry.deactivated and entry.responsible) {
+                entries.emplace_back(data.toParticle(entry), types);
+            }
+        }
+    }
+
+    // the master only needs the number of particles per domain
+    std::vector<std::uint64_t> nParticles;
+    {
+        std::uint64_t n = entries.size();
+        if (_domain->isMasterRank()) {
+            nParticles.resize(_domain->nUsedRanks());
+        }
+        MPI_Gather(&n, 1, MPI_UINT64_T, nParticles.data(), 1, MPI_UINT64_T, 0, _commUsedRanks);
+    }
+
+    std::string result;
+    if (_domain->isWorkerRank()) {
+        result = checkpointDomainFile(manifestPath, _domain->rank());
+        auto file = File::create(result, File::Flag::OVERWRITE);
+        auto group = file->createGroup(
+                std::string(readdy::model::observables::Trajectory::TRAJECTORY_GROUP_PATH) + "/trajectory_ckpt");
+        auto h5types = readdy::model::observables::util::getTrajectoryEntryTypes(file->parentFile());
+        {
+            auto records = group.createDataSet("records", {std::max<std::size_t>(entries.size(), 1)},
+                                               {h5rd::UNLIMITED_DIMS}, std::get<0>(h5types), std::get<1>(h5types));
+            if (!entries.empty()) {
+                records->append({entries.size()}, entries.data());
+            }
+        }
+        {
+            std::array<std::size_t, 2> limits{0, entries.size()};
+            auto limitsDataSet = group.createDataSet<std::size_t>("limits", {1, 2}, {h5rd::UNLIMITED_DIMS, 2});
+            limitsDataSet->append({1, 2}, limits.data());
+        }
+        {
+            auto timeDataSet = group.createDataSet<TimeStep>("time", {1}, {h5rd::UNLIMITED_DIMS});
+            timeDataSet->append({1}, &t);
+        }
+    }
+
+    // the manifest is written last, its existence indicates a complete checkpoint
+    MPI_Barrier(_commUsedRanks);
+
+    if (_domain->isMasterRank()) {
+        result = manifestPath;
+        auto file = File::create(manifestPath, File::Flag::OVERWRITE);
+        {
+            auto cfgGroup = file->createGroup("readdy/config");
+            readdy::model::ioutils::writeSimulationSetup(cfgGroup, _context.get());
+        }
+        auto group = file->createGroup(CHECKPOINT_GROUP_PATH);
+        std::vector<int> ranks;
+        std::vector<std::size_t> domainParticles;
+        std::vector<scalar> origins;
+        std::vector<scalar> extents;
+        for (const auto rank : _domain->workerRanks()) {
+            ranks.push_back(rank);
+            domainParticles.push_back(nParticles.at(rank));
+            const auto [origin, extent] = _domain->coreOfDomain(rank);
+            origins.insert(origins.end(), origin.data.begin(), origin.data.end());
+            extents.insert(extents.end(), extent.data.begin(), extent.data.end());
+        }
+        const auto &nDomainsPerAxis = _domain->nDomainsPerAxis();
+        group.write("time", std::vector<TimeStep>{t});
+        group.write("nDomainsPerAxis", std::vector<std::size_t>(nDomainsPerAxis.begin(), nDomainsPerAxis.end()));
+        group.write("ranks", ranks);
+        group.write("nParticles", domainParticles);
+        group.write("origins", {ranks.size(), 3}, origins.data());
+        group.write("extents", {ranks.size(), 3}, extents.data());
+    }
+    return result;
+}
+
+TimeStep MPIStateModel::readCheckpoint(const std::string &manifestPath) {
+    if (_domain->isIdleRank()) {
+        return 0;
+    }
+    readdy::util::Timer timer("MPIStateModel::readCheckpoint");
+    std::vector<int> ranks;
+    std::vector<TimeStep> time;
+    {
+        auto manifest = File::open(manifestPath, File::Flag::READ_ONLY);
+        auto group = manifest->getSubgroup(CHECKPOINT_GROUP_PATH);
+        group.read("ranks", ranks);
+        group.read("time", time);
+    }
+    if (time.size() != 1) {
+        throw std::invalid_argument(fmt::format("Checkpoint manifest {} is malformed", manifestPath));
+    }
+
+    // domain files of the checkpoint are assigned round robin to the currently used ranks
+    std::vector<Particle> particles;
+    const auto nUsedRanks = static_cast<std::size_t>(_domain->nUsedRanks());
+    const auto &particleTypes = _context.get().particleTypes();
+    for (std::size_t i = static_cast<std::size_t>(_domain->rank()); i < ranks.size(); i += nUsedRanks) {
+        auto file = File::open(checkpointDomainFile(manifestPath, ranks[i]), File::Flag::READ_ONLY);
+        auto group = file->getSubgroup(
+                std::string(readdy::model::observables::Trajectory::TRAJECTORY_GROUP_PATH) + "/trajectory_ckpt");
+        std::vector<std::size_t> limits;
+        group.read("limits", limits);
+        if (limits.size() == 2 and limits[1] > limits[0]) {
+            auto types = readdy::model::observables::util::getTrajectoryEntryTypes(file->ref());
+            std::vector<readdy::model::observables::TrajectoryEntry> entries;
+            group.readSelection("records", entries, &std::get<0>(types), &std::get<1>(types),
+                                {limits[0]}, {1}, {limits[1] - limits[0]});
+            particles.reserve(particles.size() + entries.size());
+            for (const auto &entry : entries) {
+                particleTypes.infoOf(entry.typeId); // throws if the type is unknown to the current context
+                particles.emplace_back(entry.pos, entry.typeId);
+            }
+        }
+    }
+    redistributeParticles(particles);
+    return time.front();
 }
 
 std::vector<readdy::model::Particle> MPIStateModel::getParticles() const {
@@ -231,6 +534,7 @@ void MPIStateModel::synchronizeWithNeighbors() {
             own.emplace_back(entry);
             if (domain()->isInDomainHalo(entry.pos)) {
                 entry.responsible = false;
+                entry.rank = domain()->responsibleRankOfPosition(entry.pos);
             }
         } else if (not entry.deactivated and not entry.responsible) {
             removedEntries.push_back(i);
@@ -289,20 +593,30 @@ void MPIStateModel::synchronizeWithNeighbors() {
     for (const auto &p : other) {
         if (domain()->isInDomainCore(p.position)) {
             // gets added and worker is responsible
-            Particle particle(p.position, p.typeId);
+            Particle particle(p.position, p.typeId, p.id);
             MPIEntry entry(particle, true, domain()->rank());
             newEntries.emplace_back(entry);
         } else if (domain()->isInDomainCoreOrHalo(p.position)) {
             // gets added but worker is not responsible
-            Particle particle(p.position, p.typeId);
-            MPIEntry entry(particle, false, domain()->rankOfPosition(p.position));
+            Particle particle(p.position, p.typeId, p.id);
+            MPIEntry entry(particle, false, domain()->responsibleRankOfPosition(p.position));
             newEntries.emplace_back(entry);
         } else {
             // does not get added
         }
     }
+    for (const auto index : removedEntries) {
+        auto it = _topologyEntries.find(data.entry_at(index).id);
+        if (it != _topologyEntries.end() and it->second == index) {
+            _topologyEntries.erase(it);
+        }
+    }
     auto update = std::make_pair(std::move(newEntries), std::move(removedEntries));
-    data.update(std::move(update));
+    indexTopologyEntries(data.update(std::move(update)));
+
+    if (_hasTopologies) {
+        migrateTopologies();
+    }
 }
 
 }
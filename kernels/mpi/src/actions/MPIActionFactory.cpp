@@ -100,12 +100,15 @@ MPIActionFactory::detailedBalance(scalar timeStep) const {
 
 std::unique_ptr<readdy::model::actions::top::EvaluateTopologyReactions>
 MPIActionFactory::evaluateTopologyReactions(scalar timeStep) const {
-    throw std::invalid_argument("EvaluateTopologyReactions not implemented for MPI");
+    if (!kernel->context().topologyRegistry().spatialReactionRegistry().empty()) {
+        throw std::invalid_argument("Spatial topology reactions not implemented for MPI");
+    }
+    return {std::make_unique<top::MPIEvaluateTopologyReactions>(kernel, timeStep)};
 }
 
 std::unique_ptr<readdy::model::actions::top::BreakBonds>
 MPIActionFactory::breakBonds(scalar timeStep, readdy::model::actions::top::BreakConfig config) const {
-    throw std::invalid_argument("BreakBonds not implemented for MPI");
+    return {std::make_unique<top::MPIBreakBonds>(kernel, timeStep, std::move(config))};
 }
 
 std::unique_ptr<readdy::model::actions::EvaluateObservables> MPIActionFactory::evaluateObservables() const {
@@ -113,8 +116,8 @@ std::unique_ptr<readdy::model::actions::EvaluateObservables> MPIActionFactory::e
 }
 
 std::unique_ptr<readdy::model::actions::MakeCheckpoint>
-MPIActionFactory::makeCheckpoint(std::string base, std::size_t maxNSaves, std::string checkpointFormat) const {
-    return {std::make_unique<MPIMakeCheckpoint>(kernel, base, maxNSaves, checkpointFormat)};
+MPIActionFactory::makeCheckpoint(std::string base, std::size_t maxNSaves) const {
+    return {std::make_unique<MPIMakeCheckpoint>(kernel, base, maxNSaves)};
 }
 
 std::unique_ptr<readdy::model::actions::InitializeKernel> MPIActionFactory::initializeKernel() const {
@@ -57,6 +57,91 @@ void computeVirial<true>(const Vec3& r_ij, const Vec3 &force, Matrix33 &virial)
 
 template<>
 void computeVirial<false>(const Vec3& /*r_ij*/, const Vec3 &/*force*/, Matrix33 &/*virial*/) {}
+
+/**
+ * Looks up the local entries of the particles that take part in a bonded interaction. The worker that holds the
+ * topology evaluates the interaction as a whole, so all particles have to be in its domain core or halo.
+ */
+template<std::size_t N>
+std::array<MPIEntry *, N> resolveBondedParticles(const std::array<std::size_t, N> &ids, MPIStateModel &stateModel) {
+    std::array<MPIEntry *, N> entries{};
+    for (std::size_t i = 0; i < N; ++i) {
+        entries[i] = stateModel.topologyEntry(static_cast<ParticleId>(ids[i]));
+        if (entries[i] == nullptr) {
+            throw std::runtime_error(fmt::format("rank={}, bonded partner {} of a topology particle is neither in the "
+                                                 "domain core nor in the halo, increase the halo thickness",
+                                                 stateModel.domain()->rank(), ids[i]));
+        }
+    }
+    return entries;
+}
+
+/**
+ * Forces on particles this worker is responsible for are applied directly, forces on halo particles are collected
+ * and sent to the responsible worker afterwards.
+ */
+template<std::size_t N>
+void applyBondedForces(const std::array<MPIEntry *, N> &entries, const std::array<Vec3, N> &forces,
+                       std::unordered_map<ParticleId, Vec3> &haloForces) {
+    for (std::size_t i = 0; i < N; ++i) {
+        if (entries[i]->responsible) {
+            entries[i]->force += forces[i];
+        } else {
+            haloForces[entries[i]->id] += forces[i];
+        }
+    }
+}
+
+scalar calculateTopologies(MPIStateModel &stateModel, const readdy::model::Context &context,
+                           std::unordered_map<ParticleId, Vec3> &haloForces) {
+    const auto &box = context.boxSize().data();
+    const auto &pbc = context.periodicBoundaryConditions().data();
+
+    scalar energy{0};
+    for (const auto &topology : stateModel.mpiTopologies()) {
+        for (const auto &bondedPotential : topology.getBondedPotentials()) {
+            const auto *potential = static_cast<const readdy::model::top::Topology::HarmonicBond *>(bondedPotential.get());
+            for (const auto &bond : potential->getBonds()) {
+                if (bond.forceConstant == 0) {
+                    continue;
+                }
+                const auto e = resolveBondedParticles<2>({bond.idx1, bond.idx2}, stateModel);
+                std::array<Vec3, 2> forces{};
+                const auto x_ij = bcs::shortestDifference(e[0]->pos, e[1]->pos, box, pbc);
+                potential->calculateForce(forces[0], x_ij, bond);
+                forces[1] = -1. * forces[0];
+                energy += potential->calculateEnergy(x_ij, bond);
+                applyBondedForces(e, forces, haloForces);
+            }
+        }
+        for (const auto &anglePotential : topology.getAnglePotentials()) {
+            const auto *potential = static_cast<const readdy::model::top::Topology::HarmonicAngle *>(anglePotential.get());
+            for (const auto &angle : potential->getAngles()) {
+                const auto e = resolveBondedParticles<3>({angle.idx1, angle.idx2, angle.idx3}, stateModel);
+                std::array<Vec3, 3> forces{};
+                const auto x_ji = bcs::shortestDifference(e[1]->pos, e[0]->pos, box, pbc);
+                const auto x_jk = bcs::shortestDifference(e[1]->pos, e[2]->pos, box, pbc);
+                energy += potential->calculateEnergy(x_ji, x_jk, angle);
+                potential->calculateForce(forces[0], forces[1], forces[2], x_ji, x_jk, angle);
+                applyBondedForces(e, forces, haloForces);
+            }
+        }
+        for (const auto &torsionPotential : topology.getTorsionPotentials()) {
+            const auto *potential = static_cast<const readdy::model::top::Topology::CosineDihedral *>(torsionPotential.get());
+            for (const auto &dih : potential->getDihedrals()) {
+                const auto e = resolveBondedParticles<4>({dih.idx1, dih.idx2, dih.idx3, dih.idx4}, stateModel);
+                std::array<Vec3, 4> forces{};
+                const auto x_ji = bcs::shortestDifference(e[1]->pos, e[0]->pos, box, pbc);
+                const auto x_kj = bcs::shortestDifference(e[2]->pos, e[1]->pos, box, pbc);
+                const auto x_kl = bcs::shortestDifference(e[2]->pos, e[3]->pos, box, pbc);
+                energy += potential->calculateEnergy(x_ji, x_kj, x_kl, dih);
+                potential->calculateForce(forces[0], forces[1], forces[2], forces[3], x_ji, x_kj, x_kl, dih);
+                applyBondedForces(e, forces, haloForces);
+            }
+        }
+    }
+    return energy;
+}
 }
 
 template<bool COMPUTE_VIRIAL>
@@ -71,7 +156,8 @@ void MPICalculateForces::performImpl() {
 
     const auto &potentials = context.potentials();
 
-    if (!potentials.potentialsOrder1().empty() || !potentials.potentialsOrder2().empty()) {
+    if (!potentials.potentialsOrder1().empty() || !potentials.potentialsOrder2().empty() ||
+        stateModel.hasTopologies()) {
         std::for_each(data.begin(), data.end(), [](auto &entry) {
             entry.force = {0, 0, 0};
         });
@@ -138,6 +224,12 @@ void MPICalculateForces::performImpl() {
     std::vector<readdy::model::top::GraphTopology*> empty;
 
     readdy::kernel::mpi::util::evaluateOnContainers(data, order1eval, neighborList, order2eval, empty, noop);
+
+    if (stateModel.hasTopologies() and kernel->domain().isWorkerRank()) {
+        std::unordered_map<ParticleId, Vec3> haloForces;
+        stateModel.energy() += detail::calculateTopologies(stateModel, context, haloForces);
+        stateModel.returnHaloForces(haloForces);
+    }
 }
 
 template void MPICalculateForces::performImpl<true>();
@@ -0,0 +1,279 @@
+/********************************************************************
+ * Copyright © 2026 Computational Molecular Biology Group,          *
+ *                  Freie Universität Berlin (GER)                  *
+ *                                                                  *
+ * Redistribution and use in source and binary forms, with or       *
+ * without modification, are permitted provided that the            *
+ * following conditions are met:                                    *
+ *  1. Redistributions of source code must retain the above         *
+ *     copyright notice, this list of conditions and the            *
+ *     following disclaimer.                                        *
+ *  2. Redistributions in binary form must reproduce the above      *
+ *     copyright notice, this list of conditions and the following  *
+ *     disclaimer in the documentation and/or other materials       *
+ *     provided with the distribution.                              *
+ *  3. Neither the name of the copyright holder nor the names of    *
+ *     its contributors may be used to endorse or promote products  *
+ *     derived from this software without specific                  *
+ *     prior written permission.                                    *
+ *                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND           *
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,      *
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF         *
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE         *
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR            *
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,         *
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER *
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,      *
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)    *
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF      *
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
+ ********************************************************************/
+
+/**
+ * Structural topology reactions and bond breaking on the MPI kernel. The worker that holds a topology builds a graph
+ * topology whose vertices point to the entries of the topology particles in its domain core and halo, performs the
+ * reaction on it like the other kernels do and converts the resulting components back to MPI topologies.
+ *
+ * @file MPITopologyReactions.cpp
+ * @brief Topology reactions coordinated by the worker that holds the topology
+ * @author EricArkfeld
+ * @date 19.10.26
+ */
+
+#include <map>
+
+#include <readdy/kernel/mpi/actions/MPIActions.h>
+#include <readdy/model/actions/Utils.h>
+#include <readdy/model/RandomProvider.h>
+#include <readdy/common/boundary_condition_operations.h>
+
+namespace readdy::kernel::mpi::actions::top {
+
+namespace detail {
+
+using GraphTopology = readdy::model::top::GraphTopology;
+using HaloChanges = std::unordered_map<int, std::vector<util::ParticlePOD>>;
+
+/**
+ * A halo particle as it was before a reaction, to find out which halo particles were changed.
+ */
+struct HaloParticle {
+    MPIStateModel::Data::EntryIndex index;
+    int rank;
+    Vec3 pos;
+    ParticleTypeId type;
+};
+
+std::unique_ptr<GraphTopology> toGraphTopology(const model::MPITopology &topology, MPIStateModel &stateModel,
+                                               const readdy::model::Context &context) {
+    readdy::model::top::Graph graph;
+    for (auto id : topology.particleIds()) {
+        const auto index = stateModel.topologyEntryIndex(id);
+        if (!index) {
+            throw std::runtime_error(fmt::format("rank={}, particle {} of topology {} is neither in the domain core "
+                                                 "nor in the halo, increase the halo thickness",
+                                                 stateModel.domain()->rank(), id, topology.id()));
+        }
+        graph.addVertex(readdy::model::top::VertexData{
+                static_cast<readdy::model::top::VertexData::ParticleIndex>(*index)});
+    }
+    // the vertices were added in order, so their persistent indices are the indices into the particle ids
+    for (const auto &[i1, i2] : topology.edges()) {
+        graph.addEdge(readdy::model::top::Graph::PersistentVertexIndex{i1},
+                      readdy::model::top::Graph::PersistentVertexIndex{i2});
+    }
+    return std::make_unique<GraphTopology>(topology.type(), std::move(graph), context, &stateModel);
+}
+
+model::MPITopology toMPITopology(const GraphTopology &graphTopology, std::size_t id, const MPIStateModel &stateModel,
+                                 const readdy::model::Context &context) {
+    const auto &data = *stateModel.getParticleData();
+    const auto &graph = graphTopology.graph();
+    std::vector<ParticleId> ids;
+    std::vector<ParticleTypeId> types;
+    std::unordered_map<std::size_t, std::size_t> denseIndices;
+    for (auto it = graph.begin(); it != graph.end(); ++it) {
+        const auto &entry = data.entry_at((*it)->particleIndex);
+        denseIndices.emplace(it.persistent_index().value, ids.size());
+        ids.push_back(entry.id);
+        types.push_back(entry.type);
+    }
+    std::vector<std::tuple<std::size_t, std::size_t>> edges;
+    edges.reserve(graph.edges().size());
+    for (const auto &[v1, v2] : graph.edges()) {
+        edges.emplace_back(denseIndices.at(v1.value), denseIndices.at(v2.value));
+    }
+    return {id, graphTopology.type(), std::move(ids), std::move(types), std::move(edges), context};
+}
+
+std::vector<HaloParticle> haloParticles(const GraphTopology &graphTopology, const MPIStateModel &stateModel) {
+    const auto &data = *stateModel.getParticleData();
+    std::vector<HaloParticle> result;
+    for (const auto &vertex : graphTopology.graph().vertices()) {
+        if (!vertex.deactivated()) {
+            const auto &entry = data.entry_at(vertex->particleIndex);
+            if (!entry.responsible and entry.rank != stateModel.domain()->rank()) {
+                result.push_back({vertex->particleIndex, entry.rank, entry.pos, entry.type});
+            }
+        }
+    }
+    return result;
+}
+
+/**
+ * Collects the halo particles whose type or position differs from before the reaction, per responsible rank.
+ */
+void collectHaloChanges(const std::vector<HaloParticle> &before, const MPIStateModel &stateModel,
+                        HaloChanges &changes) {
+    const auto &data = *stateModel.getParticleData();
+    for (const auto &particle : before) {
+        const auto &entry = data.entry_at(particle.index);
+        if (entry.type != particle.type or entry.pos != particle.pos) {
+            changes[particle.rank].emplace_back(entry);
+        }
+    }
+}
+
+/**
+ * Performs a structural reaction on a topology that this worker holds and appends the resulting topologies to
+ * `results`. The component that stays in the reacting topology keeps its id, split off components get new ones.
+ * Components that are a single particle which is not a topology particle are no topologies anymore.
+ */
+void performReaction(const model::MPITopology &topology, GraphTopology &graphTopology,
+                     const readdy::model::top::reactions::StructuralTopologyReaction &reaction, MPIKernel *kernel,
+                     std::vector<model::MPITopology> &results) {
+    auto &stateModel = kernel->getMPIKernelStateModel();
+    auto children = reaction.execute(graphTopology, kernel);
+    if (!graphTopology.isNormalParticle(*kernel)) {
+        results.push_back(toMPITopology(graphTopology, topology.id(), stateModel, kernel->context()));
+    }
+    for (const auto &child : children) {
+        if (!child.isNormalParticle(*kernel)) {
+            results.push_back(toMPITopology(child, stateModel.createTopologyId(), stateModel, kernel->context()));
+        }
+    }
+}
+
+}
+
+void MPIEvaluateTopologyReactions::perform() {
+    auto &stateModel = kernel->getMPIKernelStateModel();
+    if (!kernel->domain().isWorkerRank() or !stateModel.hasTopologies()) {
+        return;
+    }
+    const auto &registry = kernel->context().topologyRegistry();
+    auto &topologies = stateModel.mpiTopologies();
+
+    // graph views of the topologies that have structural reactions
+    std::vector<std::size_t> reactive;
+    std::vector<std::unique_ptr<detail::GraphTopology>> graphs;
+    for (std::size_t i = 0; i < topologies.size(); ++i) {
+        if (!registry.structuralReactionsOf(topologies[i].type()).empty()) {
+            reactive.push_back(i);
+            graphs.push_back(detail::toGraphTopology(topologies[i], stateModel, kernel->context()));
+        }
+    }
+    readdy::model::actions::top::updateStructuralReactionRates(graphs, registry);
+
+    std::vector<model::MPITopology> results;
+    results.reserve(topologies.size());
+    detail::HaloChanges changes;
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < topologies.size(); ++i) {
+        if (next < reactive.size() and reactive[next] == i) {
+            auto &graphTopology = *graphs[next++];
+            const auto totalRate = graphTopology.cumulativeRate();
+            if (totalRate > 0 and readdy::model::rnd::uniform_real() < 1 - std::exp(-totalRate * _timeStep)) {
+                // one reaction per topology and time step, selected proportional to its rate
+                const auto &rates = graphTopology.rates();
+                const auto u = readdy::model::rnd::uniform_real() * totalRate;
+                std::size_t r = 0;
+                auto cumulativeRate = rates.front();
+                while (cumulativeRate < u and r + 1 < rates.size()) {
+                    cumulativeRate += rates[++r];
+                }
+                const auto halo = detail::haloParticles(graphTopology, stateModel);
+                detail::performReaction(topologies[i], graphTopology,
+                                        registry.structuralReactionsOf(graphTopology.type()).at(r), kernel, results);
+                detail::collectHaloChanges(halo, stateModel, changes);
+                continue;
+            }
+        }
+        results.push_back(std::move(topologies[i]));
+    }
+    topologies = std::move(results);
+    stateModel.returnHaloParticleChanges(changes);
+}
+
+void MPIBreakBonds::perform() {
+    auto &stateModel = kernel->getMPIKernelStateModel();
+    if (!kernel->domain().isWorkerRank() or !stateModel.hasTopologies()) {
+        return;
+    }
+    const auto &context = kernel->context();
+    const auto &box = context.boxSize().data();
+    const auto &pbc = context.periodicBoundaryConditions().data();
+    auto &topologies = stateModel.mpiTopologies();
+
+    std::vector<model::MPITopology> results;
+    results.reserve(topologies.size());
+    for (auto &topology : topologies) {
+        // bond energies per pair of particle ids
+        std::map<std::pair<ParticleId, ParticleId>, scalar> energies;
+        for (const auto &bondedPotential : topology.getBondedPotentials()) {
+            const auto *potential = static_cast<const readdy::model::top::Topology::HarmonicBond *>(bondedPotential.get());
+            for (const auto &bond : potential->getBonds()) {
+                const auto *e1 = stateModel.topologyEntry(bond.idx1);
+                const auto *e2 = stateModel.topologyEntry(bond.idx2);
+                if (e1 == nullptr or e2 == nullptr) {
+                    throw std::runtime_error(fmt::format("rank={}, bonded partner of topology {} is neither in the "
+                                                         "domain core nor in the halo, increase the halo thickness",
+                                                         kernel->domain().rank(), topology.id()));
+                }
+                const auto x_ij = bcs::shortestDifference(e1->pos, e2->pos, box, pbc);
+                energies[std::minmax<ParticleId>(bond.idx1, bond.idx2)] += potential->calculateEnergy(x_ij, bond);
+            }
+        }
+
+        std::vector<std::tuple<std::size_t, std::size_t>> broken;
+        const auto &ids = topology.particleIds();
+        for (const auto &[i1, i2] : topology.edges()) {
+            const auto type1 = stateModel.topologyEntry(ids[i1])->type;
+            const auto type2 = stateModel.topologyEntry(ids[i2])->type;
+            const auto thresholdEnergyIt = thresholdEnergies().find(std::tie(type1, type2));
+            if (thresholdEnergyIt != thresholdEnergies().end()) {
+                const auto energy = energies[std::minmax<ParticleId>(ids[i1], ids[i2])];
+                if (energy > thresholdEnergyIt->second) {
+                    const auto &rate = breakRates().at(std::tie(type1, type2));
+                    if (readdy::model::rnd::uniform_real() < 1 - std::exp(-rate * _timeStep)) {
+                        broken.emplace_back(i1, i2);
+                    }
+                }
+            }
+        }
+
+        if (broken.empty()) {
+            results.push_back(std::move(topology));
+        } else {
+            auto graphTopology = detail::toGraphTopology(topology, stateModel, context);
+            auto reactionFunction = [&broken](readdy::model::top::GraphTopology &t) {
+                readdy::model::top::reactions::Recipe recipe(t);
+                for (const auto &[i1, i2] : broken) {
+                    recipe.removeEdge(readdy::model::top::Graph::PersistentVertexIndex{i1},
+                                      readdy::model::top::Graph::PersistentVertexIndex{i2});
+                }
+                return recipe;
+            };
+            scalar rateDoesntMatter{1.};
+            readdy::model::top::reactions::StructuralTopologyReaction reaction("__internal_break_bonds",
+                                                                               reactionFunction, rateDoesntMatter);
+            detail::performReaction(topology, *graphTopology, reaction, kernel, results);
+        }
+    }
+    topologies = std::move(results);
+}
+
+}
@@ -34,7 +34,8 @@
 
 /**
  * Implementation of observables for the MPI kernel. In most cases during the evaluate(),
- * the workers collect the results which are then gathered on the master worker.
+ * the workers collect the results which are then gathered on the master worker. Observables with per-particle
+ * results skip the gathering if they write to a collectively opened file, then every worker writes its own part.
  *
  * @file MPIObservables.cpp
  * @brief Implementation of observables for the MPI kernel
@@ -48,33 +49,149 @@
 
 namespace readdy::kernel::mpi::observables {
 
-MPIVirial::MPIVirial(MPIKernel *kernel, Stride stride) : Virial(kernel, stride), kernel(kernel) {}
+namespace summation {
 
-void MPIVirial::evaluate() {
-    // todo use MPI reduce with the standard '+' op, MPI_SUM
-    //MPI_Reduce(send_data, recv_data, count, datatype, op, root, communicator);
-    std::vector<readdy::model::observables::Virial::result_type> results(1);
-    if (kernel->domain().isWorkerRank()) {
-        results[0] = kernel->getMPIKernelStateModel().virial();
+std::size_t size(scalar) {
+    return 1;
+}
+
+void pack(scalar value, double *buffer) {
+    buffer[0] = value;
+}
+
+void unpack(scalar &value, const double *buffer) {
+    value = static_cast<scalar>(buffer[0]);
+}
+
+std::size_t size(const Matrix33 &matrix) {
+    return matrix.data().size();
+}
+
+void pack(const Matrix33 &matrix, double *buffer) {
+    std::copy(matrix.data().begin(), matrix.data().end(), buffer);
+}
+
+void unpack(Matrix33 &matrix, const double *buffer) {
+    std::copy(buffer, buffer + matrix.data().size(), matrix.data().begin());
+}
+
+template<typename T>
+std::size_t size(const std::vector<T> &values) {
+    return values.size();
+}
+
+template<typename T>
+void pack(const std::vector<T> &values, double *buffer) {
+    std::transform(values.begin(), values.end(), buffer, [](auto value) { return static_cast<double>(value); });
+}
+
+template<typename T>
+void unpack(std::vector<T> &values, const double *buffer) {
+    std::transform(buffer, buffer + values.size(), values.begin(), [](auto value) {
+        // counts are summed exactly in double precision
+        if constexpr (std::is_integral_v<T>) {
+            return static_cast<T>(std::llround(value));
+        } else {
+            return static_cast<T>(value);
+        }
+    });
+}
+
+/**
+ * Results that can be packed into the reduction buffer as they are
+ */
+template<typename T>
+concept Packable = requires(const T &value, T &target, double *buffer) {
+    size(value);
+    pack(value, buffer);
+    unpack(target, buffer);
+};
+
+}
+
+template<typename Observable>
+void MPISummedObservable<Observable>::evaluate() {
+    evaluateLocal();
+    kernel->observableReducer().reduce({this}, kernel->commUsedRanks());
+}
+
+template<typename Observable>
+void MPISummedObservable<Observable>::call(TimeStep t) {
+    if (this->shouldEvaluate(t)) {
+        this->firstCall = false;
+        this->t_current = t;
+        evaluateLocal();
+        kernel->observableReducer().enqueue(this, kernel->commUsedRanks());
     }
-    results = util::gatherObjects(results, 0, kernel->domain(), kernel->commUsedRanks());
+}
 
-    if (kernel->domain().isMasterRank()) {
-        // add up virial tensors assuming that there was no double counting
-        // which has to be ensured in calculateForces
-        result = std::accumulate(results.begin(), results.end(), _internal::ReaDDyMatrix33<scalar>());
+template<typename Observable>
+void MPISummedObservable<Observable>::finishReduction() {
+    if (this->writeToFile) append();
+    this->_callback(this->result);
+}
+
+template<typename Observable>
+std::size_t MPISummedObservable<Observable>::reductionSize() const {
+    if constexpr (summation::Packable<typename Observable::result_type>) {
+        return summation::size(this->result);
+    } else {
+        throw std::logic_error(fmt::format("{} has to override the packing of its result", this->type()));
     }
 }
 
-void MPIVirial::append() {
+template<typename Observable>
+void MPISummedObservable<Observable>::pack(double *buffer) const {
+    if constexpr (summation::Packable<typename Observable::result_type>) {
+        summation::pack(this->result, buffer);
+    } else {
+        throw std::logic_error(fmt::format("{} has to override the packing of its result", this->type()));
+    }
+}
+
+template<typename Observable>
+void MPISummedObservable<Observable>::unpack(const double *buffer) {
+    if constexpr (summation::Packable<typename Observable::result_type>) {
+        summation::unpack(this->result, buffer);
+    } else {
+        throw std::logic_error(fmt::format("{} has to override the packing of its result", this->type()));
+    }
+}
+
+template<typename Observable>
+void MPISummedObservable<Observable>::append() {
     if (kernel->domain().isMasterRank()) {
-        Virial::append();
+        Observable::append();
     }
 }
 
-void MPIVirial::initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) {
+template<typename Observable>
+void MPISummedObservable<Observable>::initializeDataSet(File &file, const std::string &dataSetName,
+                                                        Stride flushStride) {
+    if (file.collective()) {
+        throw std::invalid_argument(fmt::format("{} does not support collective output, write it into a file "
+                                                "that is only opened on the master rank", this->type()));
+    }
     if (kernel->domain().isMasterRank()) {
-        Virial::initializeDataSet(file, dataSetName, flushStride);
+        Observable::initializeDataSet(file, dataSetName, flushStride);
+    }
+}
+
+template class MPISummedObservable<readdy::model::observables::Energy>;
+template class MPISummedObservable<readdy::model::observables::Virial>;
+template class MPISummedObservable<readdy::model::observables::HistogramAlongAxis>;
+template class MPISummedObservable<readdy::model::observables::NParticles>;
+template class MPISummedObservable<readdy::model::observables::ReactionCounts>;
+
+MPIVirial::MPIVirial(MPIKernel *kernel, Stride stride) : MPISummedObservable(kernel, stride) {}
+
+void MPIVirial::evaluateLocal() {
+    // virial tensors are added up assuming that there was no double counting, which has to be ensured in
+    // calculateForces
+    if (kernel->domain().isWorkerRank()) {
+        result = kernel->getMPIKernelStateModel().virial();
+    } else {
+        result = Matrix33{};
     }
 }
 
@@ -102,21 +219,37 @@ void MPIPositions::evaluate() {
             }
         }
     }
-    result = util::gatherObjects(result, 0, kernel->domain(), kernel->commUsedRanks());
+    if (!collectiveWriter) {
+        result = util::gatherObjects(result, 0, kernel->domain(), kernel->commUsedRanks());
+    }
 }
 
 void MPIPositions::append() {
-    if (kernel->domain().isMasterRank()) {
+    if (collectiveWriter) {
+        collectiveWriter->append(t_current, result.size(), {result.data()});
+    } else if (kernel->domain().isMasterRank()) {
         Positions::append();
     }
 }
 
 void MPIPositions::initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) {
-    if (kernel->domain().isMasterRank()) {
+    if (file.collective()) {
+        collectiveWriter = std::make_unique<CollectiveWriter>(file, dataSetName, flushStride, kernel->commUsedRanks());
+        auto types = rmou::getVec3Types(file.ref());
+        collectiveWriter->addColumn("data", std::get<0>(types), std::get<1>(types));
+    } else if (kernel->domain().isMasterRank()) {
         Positions::initializeDataSet(file, dataSetName, flushStride);
     }
 }
 
+void MPIPositions::flush() {
+    if (collectiveWriter) {
+        collectiveWriter->flush();
+    } else {
+        Positions::flush();
+    }
+}
+
 MPIParticles::MPIParticles(MPIKernel *kernel, unsigned int stride) : Particles(kernel, stride), kernel(kernel) {}
 
 void MPIParticles::evaluate() {
@@ -126,6 +259,18 @@ void MPIParticles::evaluate() {
     resultTypes.clear();
     resultIds.clear();
     resultPositions.clear();
+    if (collectiveWriter) {
+        if (kernel->domain().isWorkerRank()) {
+            for (const auto &p : *kernel->getMPIKernelStateModel().getParticleData()) {
+                if (!p.deactivated and p.responsible) {
+                    resultTypes.push_back(p.type);
+                    resultIds.push_back(p.id);
+                    resultPositions.push_back(p.pos);
+                }
+            }
+        }
+        return;
+    }
     auto particles = kernel->getMPIKernelStateModel().gatherParticles();
     if (kernel->domain().isMasterRank()) {
         for (const auto &p : particles) {
@@ -137,23 +282,40 @@ void MPIParticles::evaluate() {
 }
 
 void MPIParticles::append() {
-    if (kernel->domain().isMasterRank()) {
+    if (collectiveWriter) {
+        const auto &[types, ids, positions] = result;
+        collectiveWriter->append(t_current, types.size(), {types.data(), ids.data(), positions.data()});
+    } else if (kernel->domain().isMasterRank()) {
         Particles::append();
     }
 }
 
 void MPIParticles::initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) {
-    if (kernel->domain().isMasterRank()) {
+    if (file.collective()) {
+        collectiveWriter = std::make_unique<CollectiveWriter>(file, dataSetName, flushStride, kernel->commUsedRanks());
+        collectiveWriter->addColumn<ParticleTypeId>("types");
+        collectiveWriter->addColumn<ParticleId>("ids");
+        collectiveWriter->addColumn("positions", h5rd::NativeArrayDataSetType<scalar, 3>(file.ref()),
+                                    h5rd::STDArrayDataSetType<scalar, 3>(file.ref()));
+    } else if (kernel->domain().isMasterRank()) {
         Particles::initializeDataSet(file, dataSetName, flushStride);
     }
 }
 
+void MPIParticles::flush() {
+    if (collectiveWriter) {
+        collectiveWriter->flush();
+    } else {
+        Particles::flush();
+    }
+}
+
 MPIHistogramAlongAxis::MPIHistogramAlongAxis(MPIKernel *kernel, unsigned int stride,
                                              const std::vector<scalar> &binBorders,
                                              const std::vector<std::string> &typesToCount, unsigned int axis)
-        : HistogramAlongAxis(kernel, stride, binBorders, typesToCount, axis), kernel(kernel) {}
+        : MPISummedObservable(kernel, stride, binBorders, typesToCount, axis) {}
 
-void MPIHistogramAlongAxis::evaluate() {
+void MPIHistogramAlongAxis::evaluateLocal() {
     std::fill(result.begin(), result.end(), 0);
     if (kernel->domain().isWorkerRank()) {
         const auto data = kernel->getMPIKernelStateModel().getParticleData();
@@ -169,29 +331,12 @@ void MPIHistogramAlongAxis::evaluate() {
             }
         }
     }
-    // todo variable float type
-    HistogramAlongAxis::result_type tmp;
-    tmp.resize(result.size());
-    MPI_Reduce(result.data(), tmp.data(), static_cast<int>(result.size()), MPI_DOUBLE, MPI_SUM, 0, kernel->commUsedRanks());
-    result = tmp;
-}
-
-void MPIHistogramAlongAxis::append() {
-    if (kernel->domain().isMasterRank()) {
-        HistogramAlongAxis::append();
-    }
-}
-
-void MPIHistogramAlongAxis::initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) {
-    if (kernel->domain().isMasterRank()) {
-        HistogramAlongAxis::initializeDataSet(file, dataSetName, flushStride);
-    }
 }
 
 MPINParticles::MPINParticles(MPIKernel *kernel, unsigned int stride, std::vector<std::string> typesToCount)
-        : NParticles(kernel, stride, std::move(typesToCount)), kernel(kernel) {}
+        : MPISummedObservable(kernel, stride, std::move(typesToCount)) {}
 
-void MPINParticles::evaluate() {
+void MPINParticles::evaluateLocal() {
     result.clear();
     if (kernel->domain().isWorkerRank()) {
         const auto &pd = kernel->getMPIKernelStateModel().getParticleData();
@@ -225,22 +370,6 @@ void MPINParticles::evaluate() {
         throw std::runtime_error("impossible");
     }
 
-    NParticles::result_type tmp;
-    tmp.resize(result.size());
-    MPI_Reduce(result.data(), tmp.data(), static_cast<int>(result.size()), MPI_UNSIGNED_LONG, MPI_SUM, 0, kernel->commUsedRanks());
-    result = tmp;
-}
-
-void MPINParticles::append() {
-    if (kernel->domain().isMasterRank()) {
-        NParticles::append();
-    }
-}
-
-void MPINParticles::initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) {
-    if (kernel->domain().isMasterRank()) {
-        NParticles::initializeDataSet(file, dataSetName, flushStride);
-    }
 }
 
 MPIForces::MPIForces(MPIKernel *kernel, unsigned int stride, std::vector<std::string> typesToCount)
@@ -268,21 +397,37 @@ void MPIForces::evaluate() {
             }
         }
     }
-    result = util::gatherObjects(result, 0, kernel->domain(), kernel->commUsedRanks());
+    if (!collectiveWriter) {
+        result = util::gatherObjects(result, 0, kernel->domain(), kernel->commUsedRanks());
+    }
 }
 
 void MPIForces::append() {
-    if (kernel->domain().isMasterRank()) {
+    if (collectiveWriter) {
+        collectiveWriter->append(t_current, result.size(), {result.data()});
+    } else if (kernel->domain().isMasterRank()) {
         Forces::append();
     }
 }
 
 void MPIForces::initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) {
-    if (kernel->domain().isMasterRank()) {
+    if (file.collective()) {
+        collectiveWriter = std::make_unique<CollectiveWriter>(file, dataSetName, flushStride, kernel->commUsedRanks());
+        auto types = rmou::getVec3Types(file.ref());
+        collectiveWriter->addColumn("data", std::get<0>(types), std::get<1>(types));
+    } else if (kernel->domain().isMasterRank()) {
         Forces::initializeDataSet(file, dataSetName, flushStride);
     }
 }
 
+void MPIForces::flush() {
+    if (collectiveWriter) {
+        collectiveWriter->flush();
+    } else {
+        Forces::flush();
+    }
+}
+
 MPIReactions::MPIReactions(MPIKernel *kernel, unsigned int stride) : Reactions(kernel, stride), kernel(kernel) {}
 
 void MPIReactions::evaluate() {
@@ -290,49 +435,61 @@ void MPIReactions::evaluate() {
     if (kernel->domain().isWorkerRank()) {
         result = kernel->getMPIKernelStateModel().reactionRecords();
     }
-    result = util::gatherObjects(result, 0, kernel->domain(), kernel->commUsedRanks());
+    if (!collectiveWriter) {
+        result = util::gatherObjects(result, 0, kernel->domain(), kernel->commUsedRanks());
+    }
 }
 
 void MPIReactions::append() {
-    if (kernel->domain().isMasterRank()) {
+    if (collectiveWriter) {
+        collectiveWriter->append(t_current, result.size(), {result.data()});
+    } else if (kernel->domain().isMasterRank()) {
         Reactions::append();
     }
 }
 
 void MPIReactions::initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) {
-    if (kernel->domain().isMasterRank()) {
+    if (file.collective()) {
+        collectiveWriter = std::make_unique<CollectiveWriter>(file, dataSetName, flushStride, kernel->commUsedRanks());
+        auto types = rmou::getReactionRecordTypes(file.ref());
+        collectiveWriter->addColumn("records", std::get<0>(types), std::get<1>(types));
+    } else if (kernel->domain().isMasterRank()) {
         Reactions::initializeDataSet(file, dataSetName, flushStride);
     }
 }
 
-MPIReactionCounts::MPIReactionCounts(MPIKernel *kernel, unsigned int stride) : ReactionCounts(kernel, stride), kernel(kernel) {}
+void MPIReactions::flush() {
+    if (collectiveWriter) {
+        collectiveWriter->flush();
+    } else {
+        Reactions::flush();
+    }
+}
 
-void MPIReactionCounts::evaluate() {
-    // todo this could be nicer with MPI_Reduce: flatten into vec, mpi_reduce, copy into result map
-    auto &counts = std::get<0>(result);
+MPIReactionCounts::MPIReactionCounts(MPIKernel *kernel, unsigned int stride) : MPISummedObservable(kernel, stride) {}
 
-    // prepare a vector that mirrors the counts map
-    std::vector<std::pair<readdy::ReactionId, unsigned long>> countsVec;
-    if (kernel->domain().isWorkerRank()) {
-        counts = kernel->getMPIKernelStateModel().reactionCounts();
-        for (const auto &pair : counts) {
-            countsVec.push_back(pair);
+void MPIReactionCounts::evaluateLocal() {
+    auto &counts = std::get<0>(result);
+    // all ranks know all reactions, which fixes the layout of the reduction buffer
+    reactionIds.clear();
+    const auto &reactions = kernel->context().reactions();
+    for (const auto &entry : reactions.order1()) {
+        for (auto reaction : entry.second) {
+            reactionIds.push_back(reaction->id());
         }
     }
+    for (const auto &entry : reactions.order2()) {
+        for (auto reaction : entry.second) {
+            reactionIds.push_back(reaction->id());
+        }
+    }
+    std::sort(reactionIds.begin(), reactionIds.end());
+    reactionIds.erase(std::unique(reactionIds.begin(), reactionIds.end()), reactionIds.end());
 
-    // gather all vectors
-    countsVec = util::gatherObjects(countsVec, 0, kernel->domain(), kernel->commUsedRanks());
-
-    // reduce the countsVec on master rank, i.e. aggregate pairs with the same id into the usual map format
-    if (kernel->domain().isMasterRank()) {
+    if (kernel->domain().isWorkerRank()) {
+        counts = kernel->getMPIKernelStateModel().reactionCounts();
+    } else {
         counts.clear();
-        for (const auto &[id, n] : countsVec) {
-            if (counts.find(id) != counts.end()) {
-                counts[id] += n;
-            } else {
-                counts[id] = n;
-            }
-        }
     }
 
     // no topologies currently on MPI
@@ -340,40 +497,33 @@ void MPIReactionCounts::evaluate() {
     //std::get<2>(result) = kernel->getMPIKernelStateModel().structuralReactionCounts();
 }
 
-void MPIReactionCounts::append() {
-    if (kernel->domain().isMasterRank()) {
-        ReactionCounts::append();
-    }
+std::size_t MPIReactionCounts::reductionSize() const {
+    return reactionIds.size();
 }
 
-void MPIReactionCounts::initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) {
-    if (kernel->domain().isMasterRank()) {
-        ReactionCounts::initializeDataSet(file, dataSetName, flushStride);
+void MPIReactionCounts::pack(double *buffer) const {
+    const auto &counts = std::get<0>(result);
+    std::transform(reactionIds.begin(), reactionIds.end(), buffer, [&counts](const auto id) {
+        auto it = counts.find(id);
+        return it != counts.end() ? static_cast<double>(it->second) : 0.;
+    });
+}
+
+void MPIReactionCounts::unpack(const double *buffer) {
+    auto &counts = std::get<0>(result);
+    counts.clear();
+    for (std::size_t i = 0; i < reactionIds.size(); ++i) {
+        counts[reactionIds[i]] = static_cast<std::size_t>(std::llround(buffer[i]));
     }
 }
 
-MPIEnergy::MPIEnergy(MPIKernel *kernel, Stride stride) : Energy(kernel, stride), kernel(kernel) {}
+MPIEnergy::MPIEnergy(MPIKernel *kernel, Stride stride) : MPISummedObservable(kernel, stride) {}
 
-void MPIEnergy::evaluate() {
+void MPIEnergy::evaluateLocal() {
     result = 0.;
     if (kernel->domain().isWorkerRank()) {
         result = kernel->stateModel().energy();
     }
-    readdy::scalar tmp;
-    MPI_Reduce(&result, &tmp, static_cast<int>(1), MPI_DOUBLE, MPI_SUM, 0, kernel->commUsedRanks());
-    result = tmp;
-}
-
-void MPIEnergy::append() {
-    if (kernel->domain().isMasterRank()) {
-        Energy::append();
-    }
-}
-
-void MPIEnergy::initializeDataSet(File &file, const std::string &dataSetName, Stride flushStride) {
-    if (kernel->domain().isMasterRank()) {
-        Energy::initializeDataSet(file, dataSetName, flushStride);
-    }
 }
 
 }
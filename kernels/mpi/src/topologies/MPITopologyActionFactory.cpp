@@ -0,0 +1,100 @@
+/********************************************************************
+ * Copyright © 2026 Computational Molecular Biology Group,          *
+ *                  Freie Universität Berlin (GER)                  *
+ *                                                                  *
+ * Redistribution and use in source and binary forms, with or       *
+ * without modification, are permitted provided that the            *
+ * following conditions are met:                                    *
+ *  1. Redistributions of source code must retain the above         *
+ *     copyright notice, this list of conditions and the            *
+ *     following disclaimer.                                        *
+ *  2. Redistributions in binary form must reproduce the above      *
+ *     copyright notice, this list of conditions and the following  *
+ *     disclaimer in the documentation and/or other materials       *
+ *     provided with the distribution.                              *
+ *  3. Neither the name of the copyright holder nor the names of    *
+ *     its contributors may be used to endorse or promote products  *
+ *     derived from this software without specific                  *
+ *     prior written permission.                                    *
+ *                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND           *
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,      *
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF         *
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE         *
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR            *
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,         *
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER *
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,      *
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)    *
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF      *
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
+ ********************************************************************/
+
+/**
+ * @file MPITopologyActionFactory.cpp
+ * @brief Topology action factory of the MPI kernel
+ * @author EricArkfeld
+ * @date 19.10.26
+ */
+
+#include <readdy/kernel/mpi/MPIKernel.h>
+#include <readdy/kernel/mpi/model/topologies/MPITopologyActions.h>
+
+namespace c_top = readdy::model::top;
+
+namespace readdy::kernel::mpi::model::top {
+
+MPITopologyActionFactory::MPITopologyActionFactory(MPIKernel *const kernel) : kernel(kernel) {}
+
+std::unique_ptr<c_top::pot::CalculateHarmonicBondPotential>
+MPITopologyActionFactory::createCalculateHarmonicBondPotential(const harmonic_bond *const potential) const {
+    throw std::logic_error("Bonded potentials of MPI topologies are evaluated by the force action");
+}
+
+std::unique_ptr<c_top::pot::CalculateHarmonicAnglePotential>
+MPITopologyActionFactory::createCalculateHarmonicAnglePotential(const harmonic_angle *const potential) const {
+    throw std::logic_error("Angle potentials of MPI topologies are evaluated by the force action");
+}
+
+std::unique_ptr<c_top::pot::CalculateCosineDihedralPotential>
+MPITopologyActionFactory::createCalculateCosineDihedralPotential(const cos_dihedral *const potential) const {
+    throw std::logic_error("Torsion potentials of MPI topologies are evaluated by the force action");
+}
+
+MPITopologyActionFactory::ActionPtr
+MPITopologyActionFactory::createChangeParticleType(c_top::GraphTopology *const topology,
+                                                   const c_top::Graph::PersistentVertexIndex &v,
+                                                   const ParticleTypeId &type_to) const {
+    return std::make_unique<reactions::op::MPIChangeParticleType>(
+            kernel->getMPIKernelStateModel().getParticleData(), topology, v, type_to
+    );
+}
+
+MPITopologyActionFactory::ActionPtr
+MPITopologyActionFactory::createChangeTopologyType(c_top::GraphTopology *const topology,
+                                                   const std::string &type_to) const {
+    return std::make_unique<c_top::reactions::actions::ChangeTopologyType>(
+            topology, kernel->context().topologyRegistry().idOf(type_to)
+    );
+}
+
+MPITopologyActionFactory::ActionPtr
+MPITopologyActionFactory::createChangeParticlePosition(c_top::GraphTopology *const topology,
+                                                       const c_top::Graph::PersistentVertexIndex &v,
+                                                       Vec3 position) const {
+    return std::make_unique<reactions::op::MPIChangeParticlePosition>(
+            kernel->getMPIKernelStateModel().getParticleData(), topology, v, position
+    );
+}
+
+MPITopologyActionFactory::ActionPtr
+MPITopologyActionFactory::createAppendParticle(c_top::GraphTopology *const topology,
+                                               const std::vector<c_top::Graph::PersistentVertexIndex> &neighbors,
+                                               ParticleTypeId type, const Vec3 &position) const {
+    return std::make_unique<reactions::op::MPIAppendParticle>(&kernel->getMPIKernelStateModel(), topology,
+                                                              neighbors, type, position);
+}
+
+}
@@ -81,4 +81,113 @@ TEST_CASE("Test particles observable", "[mpi]") {
     simulation.run(3, 0.01);
 }
 
+TEST_CASE("Test batched reduction of observables", "[mpi]") {
+    readdy::model::Context ctx;
+    ctx.boxSize() = {10., 10., 10.};
+    ctx.particleTypes().add("A", 1.);
+    ctx.particleTypes().add("B", 1.);
+    ctx.reactions().add("conversion: A -> B", 1e-10);
+    Json conf = {{"MPI", {{"dx", 4.9}, {"dy", 4.9}, {"dz", 4.9}}}};
+    ctx.kernelConfiguration() = conf.get<readdy::conf::Configuration>();
+
+    readdy::plugin::KernelProvider::kernel_ptr kernelPtr(readdy::kernel::mpi::MPIKernel::create(ctx));
+    auto *mpiKernel = dynamic_cast<readdy::kernel::mpi::MPIKernel *>(kernelPtr.get());
+    const bool isMaster = mpiKernel->domain().isMasterRank();
+    readdy::Simulation simulation(std::move(kernelPtr));
+
+    const std::size_t nA = 20;
+    const std::size_t nB = 10;
+    for (std::size_t i = 0; i < nA + nB; ++i) {
+        auto x = readdy::model::rnd::uniform_real() * 10. - 5.;
+        auto y = readdy::model::rnd::uniform_real() * 10. - 5.;
+        auto z = readdy::model::rnd::uniform_real() * 10. - 5.;
+        simulation.addParticle(i < nA ? "A" : "B", x, y, z);
+    }
+
+    std::size_t nCallbacks{0};
+    simulation.registerObservable(simulation.observe().nParticles(1, {"A", "B"}, [&](const auto &result) {
+        ++nCallbacks;
+        if (isMaster) {
+            REQUIRE(result.size() == 2);
+            CHECK(result[0] + result[1] == nA + nB);
+        }
+    }));
+    simulation.registerObservable(simulation.observe().histogramAlongAxis(1, {-5., 0., 5.}, {"A", "B"}, 0,
+                                                                           [&](const auto &result) {
+        ++nCallbacks;
+        if (isMaster) {
+            CHECK(result.size() == 2);
+        }
+    }));
+    simulation.registerObservable(simulation.observe().reactionCounts(1, [&](const auto &result) {
+        ++nCallbacks;
+        if (isMaster) {
+            CHECK(std::get<0>(result).size() == 1);
+        }
+    }));
+    simulation.run(3, 0.01);
+    if (!mpiKernel->domain().isIdleRank()) {
+        // three observables in four time steps
+        CHECK(nCallbacks == 12);
+    }
+}
+
+TEST_CASE("Test block partition for collective output", "[mpi]") {
+    int rank, worldSize;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &worldSize);
+    // rank r contributes r+1 objects
+    const auto partition = readdy::kernel::mpi::util::partitionBlock(rank + 1, MPI_COMM_WORLD);
+    CHECK(partition.count == rank + 1);
+    CHECK(partition.offset == rank * (rank + 1) / 2);
+    CHECK(partition.total == worldSize * (worldSize + 1) / 2);
+}
+
+#ifdef H5_HAVE_PARALLEL
+TEST_CASE("Test collective output of positions", "[mpi]") {
+    readdy::model::Context ctx;
+    ctx.boxSize() = {10., 10., 10.};
+    ctx.particleTypes().add("A", 1.);
+    Json conf = {{"MPI", {{"dx", 4.9}, {"dy", 4.9}, {"dz", 4.9}}}};
+    ctx.kernelConfiguration() = conf.get<readdy::conf::Configuration>();
+
+    readdy::plugin::KernelProvider::kernel_ptr kernelPtr(readdy::kernel::mpi::MPIKernel::create(ctx));
+    auto *mpiKernel = dynamic_cast<readdy::kernel::mpi::MPIKernel *>(kernelPtr.get());
+    if (mpiKernel->domain().isIdleRank()) {
+        return;
+    }
+    const auto comm = mpiKernel->commUsedRanks();
+    readdy::Simulation simulation(std::move(kernelPtr));
+
+    const std::size_t nParticles = 50;
+    for (std::size_t i = 0; i < nParticles; ++i) {
+        auto x = readdy::model::rnd::uniform_real() * 10. - 5.;
+        auto y = readdy::model::rnd::uniform_real() * 10. - 5.;
+        auto z = readdy::model::rnd::uniform_real() * 10. - 5.;
+        simulation.addParticle("A", x, y, z);
+    }
+    const std::string fileName = "test_collective_positions.h5";
+    {
+        auto file = readdy::File::create(fileName, readdy::File::Flag::OVERWRITE, comm);
+        auto obs = simulation.observe().positions(1);
+        obs->enableWriteToFile(*file, "positions", 3);
+        simulation.registerObservable(std::move(obs));
+        simulation.run(4, 0.01);
+    }
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    if (rank == 0) {
+        auto file = readdy::File::open(fileName, readdy::File::Flag::READ_ONLY);
+        auto group = file->getSubgroup("readdy/observables/positions");
+        std::vector<std::size_t> limits;
+        group.read("limits", limits);
+        // 5 frames, begin and end each
+        REQUIRE(limits.size() == 10);
+        for (std::size_t frame = 0; frame < 5; ++frame) {
+            CHECK(limits[2 * frame + 1] - limits[2 * frame] == nParticles);
+        }
+    }
+}
+#endif
+
 // todo more tests!
@@ -148,3 +148,313 @@ TEST_CASE("Test distribute particles and gather them again", "[mpi]") {
         }
     }
 }
+
+TEST_CASE("Test redistribute particles from every rank", "[mpi]") {
+    MPI_Barrier(MPI_COMM_WORLD);
+    readdy::model::Context ctx;
+
+    ctx.boxSize() = {10., 10., 10.};
+    ctx.particleTypes().add("A", 1.);
+    Json conf = {{"MPI", {{"dx", 4.9}, {"dy", 4.9}, {"dz", 4.9}}}};
+    ctx.kernelConfiguration() = conf.get<readdy::conf::Configuration>();
+
+    readdy::kernel::mpi::MPIKernel kernel(ctx);
+    const auto &domain = kernel.domain();
+    auto idA = kernel.context().particleTypes().idOf("A");
+
+    // every used rank (including master) contributes one particle to the center of each worker's domain
+    std::vector<readdy::model::Particle> particles;
+    if (!domain.isIdleRank()) {
+        for (const auto &rank : domain.workerRanks()) {
+            auto [origin, extent] = domain.coreOfDomain(rank);
+            particles.emplace_back(origin + 0.5 * extent, idA);
+        }
+    }
+    kernel.getMPIKernelStateModel().redistributeParticles(particles);
+
+    if (domain.isWorkerRank()) {
+        // one particle from each used rank
+        CHECK(kernel.getMPIKernelStateModel().getParticleData()->size() == domain.nUsedRanks());
+    } else {
+        CHECK(kernel.getMPIKernelStateModel().getParticleData()->size() == 0);
+    }
+
+    const auto gathered = kernel.getMPIKernelStateModel().gatherParticles();
+    if (domain.isMasterRank()) {
+        CHECK(gathered.size() == domain.nUsedRanks() * domain.nDomains());
+    }
+}
+
+TEST_CASE("Test distributed checkpoint and restart", "[mpi]") {
+    MPI_Barrier(MPI_COMM_WORLD);
+    readdy::model::Context ctx;
+
+    ctx.boxSize() = {10., 10., 10.};
+    ctx.particleTypes().add("A", 1.);
+    ctx.particleTypes().add("B", 1.);
+    Json conf = {{"MPI", {{"dx", 4.9}, {"dy", 4.9}, {"dz", 4.9}}}};
+    ctx.kernelConfiguration() = conf.get<readdy::conf::Configuration>();
+
+    std::vector<readdy::model::Particle> particles;
+    const std::size_t nParticles = 100;
+    for (std::size_t i = 0; i < nParticles; ++i) {
+        readdy::Vec3 pos{readdy::model::rnd::uniform_real() * 10. - 5.,
+                         readdy::model::rnd::uniform_real() * 10. - 5.,
+                         readdy::model::rnd::uniform_real() * 10. - 5.};
+        particles.emplace_back(pos, ctx.particleTypes().idOf(i % 2 == 0 ? "A" : "B"));
+    }
+
+    const std::string manifest = "./checkpoint_42.h5";
+    {
+        readdy::kernel::mpi::MPIKernel kernel(ctx);
+        kernel.getMPIKernelStateModel().distributeParticles(particles);
+        const auto path = kernel.getMPIKernelStateModel().writeCheckpoint(".", 42);
+        if (kernel.domain().isMasterRank()) {
+            CHECK(path == manifest);
+        }
+    }
+
+    {
+        readdy::kernel::mpi::MPIKernel kernel(ctx);
+        if (kernel.domain().isIdleRank()) {
+            return;
+        }
+        auto t = kernel.getMPIKernelStateModel().readCheckpoint(manifest);
+        CHECK(t == 42);
+        for (const auto &entry : *kernel.getMPIKernelStateModel().getParticleData()) {
+            CHECK(kernel.domain().isInDomainCore(entry.pos));
+        }
+        const auto restored = kernel.getMPIKernelStateModel().gatherParticles();
+        if (kernel.domain().isMasterRank()) {
+            CHECK(restored.size() == nParticles);
+            auto nA = std::count_if(restored.begin(), restored.end(), [&](const auto &p) {
+                return p.type() == ctx.particleTypes().idOf("A");
+            });
+            CHECK(nA == nParticles / 2);
+        }
+        MPI_Barrier(kernel.commUsedRanks());
+        if (kernel.domain().isWorkerRank()) {
+            std::remove(readdy::kernel::mpi::MPIStateModel::checkpointDomainFile(manifest, kernel.domain().rank()).c_str());
+        } else {
+            std::remove(manifest.c_str());
+        }
+    }
+}
+
+TEST_CASE("Test bonded forces of a topology across domains", "[mpi]") {
+    MPI_Barrier(MPI_COMM_WORLD);
+    readdy::model::Context ctx;
+
+    ctx.boxSize() = {10., 10., 10.};
+    ctx.particleTypes().add("T", 1., readdy::model::particleflavor::TOPOLOGY);
+    ctx.potentials().addHarmonicRepulsion("T", "T", 1., 0.1);
+    ctx.topologyRegistry().addType("chain");
+    ctx.topologyRegistry().configureBondPotential("T", "T", {10., 1.});
+    Json conf = {{"MPI", {{"dx", 4.9}, {"dy", 4.9}, {"dz", 4.9}, {"haloThickness", 1.5}}}};
+    ctx.kernelConfiguration() = conf.get<readdy::conf::Configuration>();
+
+    readdy::kernel::mpi::MPIKernel kernel(ctx);
+    if (kernel.domain().isIdleRank()) {
+        return;
+    }
+    auto &stateModel = kernel.getMPIKernelStateModel();
+    const auto idT = ctx.particleTypes().idOf("T");
+    // the bond crosses the boundary at x=0 of two domains
+    std::vector<readdy::model::Particle> particles{{-0.3, -2.5, -2.5, idT}, {0.3, -2.5, -2.5, idT}};
+    stateModel.addMPITopology(ctx.topologyRegistry().idOf("chain"), particles, {{0, 1}});
+    // only the worker responsible for the first particle holds the topology
+    int nLocal = static_cast<int>(stateModel.mpiTopologies().size());
+    int nTotal{0};
+    MPI_Allreduce(&nLocal, &nTotal, 1, MPI_INT, MPI_SUM, kernel.commUsedRanks());
+    REQUIRE(nTotal == 1);
+    for (const auto &topology : stateModel.mpiTopologies()) {
+        REQUIRE(topology.getBondedPotentials().size() == 1);
+        REQUIRE(kernel.domain().rankOfPosition(particles.front().pos()) == kernel.domain().rank());
+    }
+
+    kernel.actions().initializeKernel()->perform();
+    kernel.actions().createNeighborList(kernel.context().calculateMaxCutoff())->perform();
+    kernel.actions().calculateForces()->perform();
+
+    if (kernel.domain().isWorkerRank()) {
+        for (const auto &entry : *stateModel.getParticleData()) {
+            if (!entry.deactivated and entry.responsible) {
+                // bond is compressed, particles are pushed apart
+                if (entry.pos.x < 0) {
+                    CHECK(entry.force.x < 0.);
+                } else {
+                    CHECK(entry.force.x > 0.);
+                }
+            }
+        }
+    }
+
+    // the bond energy is evaluated once, by the worker that holds the topology
+    readdy::scalar localEnergy = stateModel.energy();
+    readdy::scalar totalEnergy{0};
+    MPI_Reduce(&localEnergy, &totalEnergy, 1, MPI_DOUBLE, MPI_SUM, 0, kernel.commUsedRanks());
+    if (kernel.domain().isMasterRank()) {
+        CHECK(totalEnergy == Approx(10. * 0.4 * 0.4));
+    }
+}
+
+TEST_CASE("Test returned halo forces of bonds on a domain face and across the periodic boundary", "[mpi]") {
+    MPI_Barrier(MPI_COMM_WORLD);
+    readdy::model::Context ctx;
+
+    ctx.boxSize() = {10., 10., 10.};
+    ctx.periodicBoundaryConditions() = {true, true, true};
+    ctx.particleTypes().add("T", 1., readdy::model::particleflavor::TOPOLOGY);
+    ctx.topologyRegistry().addType("chain");
+    ctx.topologyRegistry().configureBondPotential("T", "T", {10., 1.});
+    Json conf = {{"MPI", {{"dx", 4.9}, {"dy", 4.9}, {"dz", 4.9}, {"haloThickness", 1.5}}}};
+    ctx.kernelConfiguration() = conf.get<readdy::conf::Configuration>();
+
+    readdy::kernel::mpi::MPIKernel kernel(ctx);
+    if (kernel.domain().isIdleRank()) {
+        return;
+    }
+    auto &stateModel = kernel.getMPIKernelStateModel();
+    const auto idT = ctx.particleTypes().idOf("T");
+    const auto chain = ctx.topologyRegistry().idOf("chain");
+    // the second particle sits exactly on the face x=0 between two domains, the bond has length 0.5
+    stateModel.addMPITopology(chain, {{-0.5, -2.5, -2.5, idT}, {0., -2.5, -2.5, idT}}, {{0, 1}});
+    // the bond crosses the periodic boundary in x, the minimum image distance is 0.3
+    stateModel.addMPITopology(chain, {{-4.8, 2.5, 2.5, idT}, {4.9, 2.5, 2.5, idT}}, {{0, 1}});
+
+    kernel.actions().initializeKernel()->perform();
+    kernel.actions().createNeighborList(kernel.context().calculateMaxCutoff())->perform();
+    kernel.actions().calculateForces()->perform();
+
+    // every particle receives the full force of its compressed bond, F = 2k(l - r), exactly once
+    int nLocal{0};
+    if (kernel.domain().isWorkerRank()) {
+        for (const auto &entry : *stateModel.getParticleData()) {
+            if (!entry.deactivated and entry.responsible) {
+                ++nLocal;
+                readdy::scalar expected;
+                if (entry.pos.y < 0) {
+                    expected = entry.pos.x < 0 ? -2. * 10. * 0.5 : 2. * 10. * 0.5;
+                } else {
+                    expected = entry.pos.x < 0 ? 2. * 10. * 0.7 : -2. * 10. * 0.7;
+                }
+                CHECK(entry.force.x == Approx(expected));
+                CHECK(entry.force.y == Approx(0.).margin(1e-12));
+                CHECK(entry.force.z == Approx(0.).margin(1e-12));
+            }
+        }
+    }
+    int nTotal{0};
+    MPI_Allreduce(&nLocal, &nTotal, 1, MPI_INT, MPI_SUM, kernel.commUsedRanks());
+    REQUIRE(nTotal == 4);
+}
+
+TEST_CASE("Test structural topology reaction across domains", "[mpi]") {
+    MPI_Barrier(MPI_COMM_WORLD);
+    readdy::model::Context ctx;
+
+    ctx.boxSize() = {10., 10., 10.};
+    ctx.particleTypes().add("T", 0., readdy::model::particleflavor::TOPOLOGY);
+    ctx.particleTypes().add("B", 0.);
+    ctx.potentials().addHarmonicRepulsion("T", "T", 1., 0.1);
+    ctx.topologyRegistry().addType("chain");
+    ctx.topologyRegistry().configureBondPotential("T", "T", {10., 1.});
+    // the particle at positive x is released as a normal particle
+    const auto idB = ctx.particleTypes().idOf("B");
+    auto reactionFunction = [idB](readdy::model::top::GraphTopology &topology) {
+        readdy::model::top::reactions::Recipe recipe(topology);
+        const auto &graph = topology.graph();
+        for (auto it = graph.begin(); it != graph.end(); ++it) {
+            if (topology.particleForVertex(it.persistent_index()).pos().x > 0) {
+                recipe.changeParticleType(it.persistent_index(), idB);
+                for (auto neighbor : it->neighbors()) {
+                    recipe.removeEdge(it.persistent_index(), neighbor);
+                }
+            }
+        }
+        return recipe;
+    };
+    ctx.topologyRegistry().addStructuralReaction(
+            "chain", readdy::model::top::reactions::StructuralTopologyReaction("release", reactionFunction, 1e10));
+    Json conf = {{"MPI", {{"dx", 4.9}, {"dy", 4.9}, {"dz", 4.9}, {"haloThickness", 1.5}}}};
+    ctx.kernelConfiguration() = conf.get<readdy::conf::Configuration>();
+
+    readdy::kernel::mpi::MPIKernel kernel(ctx);
+    if (kernel.domain().isIdleRank()) {
+        return;
+    }
+    auto &stateModel = kernel.getMPIKernelStateModel();
+    const auto idT = ctx.particleTypes().idOf("T");
+    // the topology is held by the worker at negative x, the released particle is in its halo
+    std::vector<readdy::model::Particle> particles{{-0.3, -2.5, -2.5, idT}, {0.3, -2.5, -2.5, idT}};
+    stateModel.addMPITopology(ctx.topologyRegistry().idOf("chain"), particles, {{0, 1}});
+
+    kernel.actions().initializeKernel()->perform();
+    kernel.actions().createNeighborList(kernel.context().calculateMaxCutoff())->perform();
+    kernel.actions().evaluateTopologyReactions(1.)->perform();
+    kernel.actions().updateNeighborList()->perform();
+
+    // the type change was applied by the worker responsible for the released particle
+    const auto gathered = stateModel.gatherParticles();
+    if (kernel.domain().isMasterRank()) {
+        REQUIRE(gathered.size() == 2);
+        for (const auto &p : gathered) {
+            CHECK(p.type() == (p.pos().x > 0 ? idB : idT));
+        }
+    }
+
+    int nLocal = static_cast<int>(stateModel.mpiTopologies().size());
+    int nTotal{0};
+    MPI_Allreduce(&nLocal, &nTotal, 1, MPI_INT, MPI_SUM, kernel.commUsedRanks());
+    REQUIRE(nTotal == 1);
+    for (const auto &topology : stateModel.mpiTopologies()) {
+        REQUIRE(topology.particleIds().size() == 1);
+        const auto *anchor = stateModel.topologyEntry(topology.anchor());
+        REQUIRE(anchor != nullptr);
+        CHECK(anchor->pos.x < 0);
+        CHECK(topology.getBondedPotentials().empty());
+    }
+}
+
+TEST_CASE("Test breaking a bond across domains", "[mpi]") {
+    MPI_Barrier(MPI_COMM_WORLD);
+    readdy::model::Context ctx;
+
+    ctx.boxSize() = {10., 10., 10.};
+    ctx.particleTypes().add("T", 0., readdy::model::particleflavor::TOPOLOGY);
+    ctx.potentials().addHarmonicRepulsion("T", "T", 1., 0.1);
+    ctx.topologyRegistry().addType("chain");
+    ctx.topologyRegistry().configureBondPotential("T", "T", {10., 1.});
+    Json conf = {{"MPI", {{"dx", 4.9}, {"dy", 4.9}, {"dz", 4.9}, {"haloThickness", 1.5}}}};
+    ctx.kernelConfiguration() = conf.get<readdy::conf::Configuration>();
+
+    readdy::kernel::mpi::MPIKernel kernel(ctx);
+    if (kernel.domain().isIdleRank()) {
+        return;
+    }
+    auto &stateModel = kernel.getMPIKernelStateModel();
+    const auto idT = ctx.particleTypes().idOf("T");
+    // the bond is stretched across the boundary at x=0, its energy is 10
+    std::vector<readdy::model::Particle> particles{{-1., -2.5, -2.5, idT}, {1., -2.5, -2.5, idT}};
+    stateModel.addMPITopology(ctx.topologyRegistry().idOf("chain"), particles, {{0, 1}});
+
+    kernel.actions().initializeKernel()->perform();
+    kernel.actions().createNeighborList(kernel.context().calculateMaxCutoff())->perform();
+    readdy::model::actions::top::BreakConfig breakConfig;
+    breakConfig.addBreakablePair(idT, idT, 1., 1e10);
+    kernel.actions().breakBonds(1., breakConfig)->perform();
+    kernel.actions().updateNeighborList()->perform();
+
+    // each particle forms a topology of its own, which moved to the worker responsible for it
+    int nLocal = static_cast<int>(stateModel.mpiTopologies().size());
+    int nTotal{0};
+    MPI_Allreduce(&nLocal, &nTotal, 1, MPI_INT, MPI_SUM, kernel.commUsedRanks());
+    REQUIRE(nTotal == 2);
+    for (const auto &topology : stateModel.mpiTopologies()) {
+        REQUIRE(topology.particleIds().size() == 1);
+        const auto *anchor = stateModel.topologyEntry(topology.anchor());
+        REQUIRE(anchor != nullptr);
+        CHECK(anchor->responsible);
+        CHECK(topology.getBondedPotentials().empty());
+    }
+}
@@ -61,7 +61,7 @@ void SCPUKernel::initialize() {
     readdy::model::Kernel::initialize();
     for(auto& top : getSCPUKernelStateModel().topologies()) {
         top->configure();
-        top->updateReactionRates(context().topologyRegistry().structuralReactionsOf(top->type()));
+        top->invalidateReactionRates();
     }
     getSCPUKernelStateModel().reactionRecords().clear();
     getSCPUKernelStateModel().resetReactionCounts();
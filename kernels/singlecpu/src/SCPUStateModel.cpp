@@ -44,6 +44,7 @@
 
 #include <algorithm>
 #include <readdy/kernel/singlecpu/SCPUStateModel.h>
+#include <readdy/common/boundary_condition_operations.h>
 
 namespace readdy::kernel::scpu {
 
@@ -76,6 +77,23 @@ std::vector<readdy::model::Particle> SCPUStateModel::getParticles() const {
 }
 
 
+void SCPUStateModel::forEachParticle(const ParticleVisitor &visitor) const {
+    for (const auto &entry : particleData) {
+        if (!entry.is_deactivated()) visitor(entry.type, entry.id, entry.pos, entry.force);
+    }
+}
+
+void SCPUStateModel::updateParticlePositions(const ParticlePositionUpdate &update) {
+    const auto &box = _context.get().boxSize().data();
+    const auto &pbc = _context.get().periodicBoundaryConditions().data();
+    for (auto &entry : particleData) {
+        if (!entry.is_deactivated()) {
+            update(entry.type, entry.id, entry.pos);
+            bcs::fixPosition(entry.pos, box, pbc);
+        }
+    }
+}
+
 readdy::model::top::GraphTopology *const SCPUStateModel::addTopology(TopologyTypeId type, const std::vector<readdy::model::Particle> &particles) {
     std::vector<std::size_t> indices = particleData.addTopologyParticles(particles);
     readdy::model::top::Graph graph;
@@ -144,7 +144,7 @@ void SCPUEvaluateTopologyReactions::perform() {
                 for (auto &&top : new_topologies) {
                     if (!top.isNormalParticle(*kernel)) {
                         // we have a new topology here, update data accordingly.
-                        top.updateReactionRates(context.topologyRegistry().structuralReactionsOf(top.type()));
+                        top.invalidateReactionRates();
                         top.configure();
                         model.insert_topology(std::move(top));
                     } else {
@@ -169,6 +169,9 @@ SCPUEvaluateTopologyReactions::topology_reaction_events SCPUEvaluateTopologyReac
     const auto &context = kernel->context();
     const auto &topology_registry = context.topologyRegistry();
     topology_reaction_events events;
+    // only topologies that changed since their rates were last evaluated need new rates
+    readdy::model::actions::top::updateStructuralReactionRates(kernel->getSCPUKernelStateModel().topologies(),
+                                                               topology_registry);
     {
         rate_t current_cumulative_rate = 0;
         std::size_t topology_idx = 0;
@@ -363,8 +366,8 @@ void SCPUEvaluateTopologyReactions::handleTopologyTopologyReaction(SCPUStateMode
                                                                    const SCPUEvaluateTopologyReactions::TREvent &event) {
     const auto &context = kernel->context();
     const auto &top_registry = context.topologyRegistry();
-    const auto &reaction = top_registry.spatialReactionsByType(event.t1, t1->type(), event.t2, t2->type()).at(
-            event.reaction_idx);
+    const auto &reaction = top_registry.spatialReactionsByType(event.t1, t1->type(), event.t2,
+                                                               t2->type())[event.reaction_idx];
 
     auto &model = kernel->getSCPUKernelStateModel();
     auto &data = *model.getParticleData();
@@ -418,7 +421,7 @@ void SCPUEvaluateTopologyReactions::handleTopologyTopologyReaction(SCPUStateMode
             t1->type() = top_type_to1;
             t2->type() = top_type_to2;
 
-            t2->updateReactionRates(context.topologyRegistry().structuralReactionsOf(t2->type()));
+            t2->invalidateReactionRates();
             t2->updateSpatialReactionRates(
                     context.topologyRegistry().spatialReactionsByType(event.t2, t2->type(),
                                                                       event.t1, t1->type()),
@@ -427,7 +430,7 @@ void SCPUEvaluateTopologyReactions::handleTopologyTopologyReaction(SCPUStateMode
             t2->configure();
         }
     }
-    t1->updateReactionRates(context.topologyRegistry().structuralReactionsOf(t1->type()));
+    t1->invalidateReactionRates();
     t1->updateSpatialReactionRates(
             context.topologyRegistry().spatialReactionsByType(event.t1, t1->type(),
                                                               event.t2, t2->type()),
@@ -441,7 +444,7 @@ void SCPUEvaluateTopologyReactions::handleTopologyParticleReaction(SCPUStateMode
     const auto &context = kernel->context();
     const auto &top_registry = context.topologyRegistry();
     const auto &reaction = top_registry.spatialReactionsByType(event.t1, topology->type(), event.t2,
-                                                               EmptyTopologyId).at(event.reaction_idx);
+                                                               EmptyTopologyId)[event.reaction_idx];
 
     auto &model = kernel->getSCPUKernelStateModel();
     auto &data = *model.getParticleData();
@@ -473,7 +476,7 @@ void SCPUEvaluateTopologyReactions::handleTopologyParticleReaction(SCPUStateMode
     } else {
         topology->type() = reaction.top_type_to2();
     }
-    topology->updateReactionRates(context.topologyRegistry().structuralReactionsOf(topology->type()));
+    topology->invalidateReactionRates();
     topology->configure();
 }
 
@@ -495,7 +495,7 @@ void SCPUDetailedBalance::perform() {
                                                              "SCPUDetailedBalance::perform::eval",
                                                              "SCPUReactionImpls.cpp"));
                 }
-                const scalar acceptance = std::min(1., prefactor * boltzmannFactor);
+                const scalar acceptance = std::min(static_cast<scalar>(1.), prefactor * boltzmannFactor);
                 log::trace("Acceptance for current event is {}", acceptance);
 
                 if (readdy::model::rnd::uniform_real() < acceptance) {
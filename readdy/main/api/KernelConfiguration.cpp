@@ -46,11 +46,14 @@ namespace readdy::conf {
 
 namespace cpu {
 void to_json(json &j, const NeighborList &nl) {
-    j = json{{"cll_radius", nl.cll_radius}};
+    j = json{{"cll_radius", nl.cll_radius}, {"reorder_interval", nl.reorder_interval},
+             {"reorder_threshold", nl.reorder_threshold}};
 }
 
 void from_json(const json &j, NeighborList &nl) {
     nl.cll_radius = j.at("cll_radius").get<std::uint8_t>();
+    nl.reorder_interval = j.value("reorder_interval", nl.reorder_interval);
+    nl.reorder_threshold = j.value("reorder_threshold", nl.reorder_threshold);
 }
 
 void to_json(json &j, const ThreadConfig &nl) {
@@ -65,9 +68,18 @@ void from_json(const json &j, ThreadConfig &nl) {
     }
 }
 
+void to_json(json &j, const ExternalPotentials &conf) {
+    j = json{{"grid_spacing", conf.grid_spacing}};
+}
+
+void from_json(const json &j, ExternalPotentials &conf) {
+    conf.grid_spacing = j.value("grid_spacing", conf.grid_spacing);
+}
+
 void to_json(json &j, const Configuration &conf) {
     j = json {{"neighbor_list", conf.neighborList},
-              {"thread_config", conf.threadConfig}};
+              {"thread_config", conf.threadConfig},
+              {"external_potentials", conf.externalPotentials}};
 }
 
 void from_json(const json &j, Configuration &conf) {
@@ -81,6 +93,11 @@ void from_json(const json &j, Configuration &conf) {
     } else {
         conf.threadConfig = {};
     }
+    if (j.find("external_potentials") != j.end()) {
+        conf.externalPotentials = j.at("external_potentials").get<ExternalPotentials>();
+    } else {
+        conf.externalPotentials = {};
+    }
 }
 }
 
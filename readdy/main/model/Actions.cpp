@@ -244,7 +244,7 @@ namespace readdy::model::actions {
 
         // effective lhs interaction volume
         {
-            const auto result = util::integration::integrateAdaptive(lhsIntegrand, 0., lhsInteractionRadius,
+            const auto result = util::integration::integrateAdaptive(lhsIntegrand, scalar{0}, lhsInteractionRadius,
                                                                      desiredRelativeError, maxiter);
             const auto achievedRelativeError = result.second / result.first;
             if (achievedRelativeError > desiredRelativeError) {
@@ -256,7 +256,7 @@ namespace readdy::model::actions {
 
         // effective rhs interaction volume
         {
-            const auto result = util::integration::integrateAdaptive(rhsIntegrand, 0., rhsInteractionRadius,
+            const auto result = util::integration::integrateAdaptive(rhsIntegrand, scalar{0}, rhsInteractionRadius,
                                                                      desiredRelativeError, maxiter);
             const auto achievedRelativeError = result.second / result.first;
             if (achievedRelativeError > desiredRelativeError) {
@@ -268,7 +268,7 @@ namespace readdy::model::actions {
 
         // effective lhs reaction volume
         {
-            const auto result = util::integration::integrateAdaptive(lhsIntegrand, 0., reactionRadius,
+            const auto result = util::integration::integrateAdaptive(lhsIntegrand, scalar{0}, reactionRadius,
                                                                      desiredRelativeError,
                                                                      maxiter);
             const auto achievedRelativeError = result.second / result.first;
@@ -281,7 +281,7 @@ namespace readdy::model::actions {
 
         // effective rhs reaction volume
         {
-            const auto result = util::integration::integrateAdaptive(rhsIntegrand, 0., reactionRadius,
+            const auto result = util::integration::integrateAdaptive(rhsIntegrand, scalar{0}, reactionRadius,
                                                                      desiredRelativeError,
                                                                      maxiter);
             const auto achievedRelativeError = result.second / result.first;
@@ -55,4 +55,14 @@ std::vector<Particle> StateModel::getParticlesForTopology(const top::GraphTopolo
     return result;
 }
 
+void StateModel::forEachParticle(const ParticleVisitor &visitor) const {
+    for (const auto &p : getParticles()) {
+        visitor(p.type(), p.id(), p.pos(), {});
+    }
+}
+
+void StateModel::updateParticlePositions(const ParticlePositionUpdate &/*update*/) {
+    throw std::logic_error("This kernel does not support updating particle positions in place.");
+}
+
 }
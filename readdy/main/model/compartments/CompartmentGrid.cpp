@@ -0,0 +1,143 @@
+/********************************************************************
+ * Copyright © 2018 Computational Molecular Biology Group,          *
+ *                  Freie Universität Berlin (GER)                  *
+ *                                                                  *
+ * Redistribution and use in source and binary forms, with or       *
+ * without modification, are permitted provided that the            *
+ * following conditions are met:                                    *
+ *  1. Redistributions of source code must retain the above         *
+ *     copyright notice, this list of conditions and the            *
+ *     following disclaimer.                                        *
+ *  2. Redistributions in binary form must reproduce the above      *
+ *     copyright notice, this list of conditions and the following  *
+ *     disclaimer in the documentation and/or other materials       *
+ *     provided with the distribution.                              *
+ *  3. Neither the name of the copyright holder nor the names of    *
+ *     its contributors may be used to endorse or promote products  *
+ *     derived from this software without specific                  *
+ *     prior written permission.                                    *
+ *                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND           *
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,      *
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF         *
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE         *
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR            *
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,         *
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER *
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,      *
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)    *
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF      *
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
+ ********************************************************************/
+
+
+
+/**
+ * @file CompartmentGrid.cpp
+ * @brief Implementation of the voxelized compartment grid
+ * @author EricArkfeld
+ * @date 19.10.26
+ * @copyright BSD-3
+ */
+
+#include <readdy/model/compartments/CompartmentGrid.h>
+
+namespace readdy::model::compartments {
+
+namespace {
+std::size_t nTypesOf(const ParticleTypeRegistry &types) {
+    std::size_t nTypes = 0;
+    for (const auto &[name, id] : types.typeMapping()) {
+        nTypes = std::max(nTypes, static_cast<std::size_t>(id) + 1);
+    }
+    return nTypes;
+}
+}
+
+CompartmentGrid::CompartmentGrid(const CompartmentRegistry &compartments, const ParticleTypeRegistry &types,
+                                 const BoxSize &boxSize, std::size_t maxVoxelsPerAxis)
+        : _compartments(compartments.get()), _nTypes(nTypesOf(types)), _boxSize(boxSize) {
+    if (maxVoxelsPerAxis == 0) {
+        throw std::invalid_argument("The compartment grid requires at least one voxel per axis");
+    }
+    _compartmentIds.reserve(_compartments.size());
+    for (const auto &compartment : _compartments) {
+        _compartmentIds.push_back(compartment->getId());
+    }
+
+    _conversions.resize(_compartments.size() * _nTypes);
+    for (std::size_t i = 0; i < _compartments.size(); ++i) {
+        for (std::size_t t = 0; t < _nTypes; ++t) {
+            _conversions[i * _nTypes + t] = static_cast<ParticleTypeId>(t);
+        }
+        for (const auto &[from, to] : _compartments[i]->getConversions()) {
+            if (from < _nTypes) {
+                _conversions[i * _nTypes + from] = to;
+            }
+        }
+    }
+
+    const auto longestAxis = *std::max_element(boxSize.begin(), boxSize.end());
+    const auto width = longestAxis / static_cast<scalar>(maxVoxelsPerAxis);
+    for (std::uint8_t d = 0; d < 3; ++d) {
+        _nVoxels[d] = std::clamp(static_cast<std::size_t>(std::ceil(boxSize[d] / width)),
+                                 static_cast<std::size_t>(1), maxVoxelsPerAxis);
+        _voxelSize[d] = boxSize[d] / static_cast<scalar>(_nVoxels[d]);
+    }
+    // slightly enlarged half diagonal so that rounding in the classification stays conservative
+    const auto radius = static_cast<scalar>(.5 * (1. + 1e-6)) * _voxelSize.norm();
+
+    _voxels.resize(_nVoxels[0] * _nVoxels[1] * _nVoxels[2]);
+    std::size_t ix = 0;
+    for (std::size_t i = 0; i < _nVoxels[0]; ++i) {
+        for (std::size_t j = 0; j < _nVoxels[1]; ++j) {
+            for (std::size_t k = 0; k < _nVoxels[2]; ++k, ++ix) {
+                const Vec3 center{-.5 * boxSize[0] + (static_cast<scalar>(i) + .5) * _voxelSize[0],
+                                  -.5 * boxSize[1] + (static_cast<scalar>(j) + .5) * _voxelSize[1],
+                                  -.5 * boxSize[2] + (static_cast<scalar>(k) + .5) * _voxelSize[2]};
+                VoxelState state = outside;
+                for (std::size_t c = 0; c < _compartments.size(); ++c) {
+                    const auto containment = _compartments[c]->classify(center, radius);
+                    if (containment == Compartment::Containment::boundary
+                        || (containment == Compartment::Containment::inside && state != outside)) {
+                        state = boundary;
+                        break;
+                    }
+                    if (containment == Compartment::Containment::inside) {
+                        state = static_cast<VoxelState>(c);
+                    }
+                }
+                _voxels[ix] = state;
+            }
+        }
+    }
+}
+
+bool CompartmentGrid::upToDate(const CompartmentRegistry &compartments, const ParticleTypeRegistry &types,
+                               const BoxSize &boxSize) const {
+    if (boxSize != _boxSize || compartments.get().size() != _compartments.size() || nTypesOf(types) != _nTypes) {
+        return false;
+    }
+    for (std::size_t i = 0; i < _compartments.size(); ++i) {
+        if (compartments.get()[i]->getId() != _compartmentIds[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+CompartmentGrid::VoxelState CompartmentGrid::voxelState(const Vec3 &position) const {
+    std::array<std::size_t, 3> cell{};
+    for (std::uint8_t d = 0; d < 3; ++d) {
+        const auto x = (position[d] + .5 * _boxSize[d]) / _voxelSize[d];
+        if (!(x >= 0) || x >= static_cast<scalar>(_nVoxels[d])) {
+            return boundary;
+        }
+        cell[d] = static_cast<std::size_t>(x);
+    }
+    return _voxels[(cell[0] * _nVoxels[1] + cell[1]) * _nVoxels[2] + cell[2]];
+}
+
+}
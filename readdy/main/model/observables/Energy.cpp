@@ -68,7 +68,8 @@ void Energy::initializeDataSet(File &file, const std::string &dataSetName, Strid
     h5rd::dimensions fs = {flushStride};
     h5rd::dimensions dims = {h5rd::UNLIMITED_DIMS};
     auto group = file.createGroup(std::string(util::OBSERVABLES_GROUP_PATH) + "/" + dataSetName);
-    pimpl->ds = group.createDataSet<scalar>("data", fs, dims, {&pimpl->bloscFilter});
+    pimpl->ds = group.createDataSet<ScalarAccumulator>("data", fs, dims, {&pimpl->bloscFilter});
+    pimpl->ds->setWriteCombining(flushStride);
     pimpl->time = std::make_unique<util::TimeSeriesWriter>(group, flushStride);
 }
 
@@ -82,6 +82,7 @@ void Forces::initializeDataSet(File &file, const std::string &dataSetName, unsig
     auto dataSet = group.createVLENDataSet("data", fs, dims,
                                            std::get<0>(*pimpl->h5types), std::get<1>(*pimpl->h5types));
     pimpl->dataSet = std::move(dataSet);
+    pimpl->dataSet->setWriteCombining(flushStride);
     pimpl->timeSeries = std::make_unique<util::TimeSeriesWriter>(group, flushStride);
 }
 
@@ -86,6 +86,7 @@ void HistogramAlongAxis::initializeDataSet(File &file, const std::string &dataSe
     const auto path = std::string(util::OBSERVABLES_GROUP_PATH) + "/" + dataSetName;
     auto group = file.createGroup(path);
     pimpl->dataSet = group.createDataSet<scalar>("data", fs, dims, {&bloscFilter});
+    pimpl->dataSet->setWriteCombining(flushStride);
     pimpl->time = std::make_unique<util::TimeSeriesWriter>(group, flushStride);
 }
 
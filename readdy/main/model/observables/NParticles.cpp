@@ -81,6 +81,7 @@ void NParticles::initializeDataSet(File &file, const std::string &dataSetName, S
     h5rd::dimensions dims = {h5rd::UNLIMITED_DIMS, size};
     auto group = file.createGroup(std::string(util::OBSERVABLES_GROUP_PATH) + "/" + dataSetName);
     pimpl->ds = group.createDataSet<std::size_t>("data", fs, dims, {&pimpl->bloscFilter});
+    pimpl->ds->setWriteCombining(flushStride);
     pimpl->time = std::make_unique<util::TimeSeriesWriter>(group, flushStride);
 }
 
@@ -69,6 +69,9 @@ void Particles::initializeDataSet(File &file, const std::string &dataSetName, St
     pimpl->dataSetPositions = group.createVLENDataSet("positions", fs, dims,
                                                       h5rd::NativeArrayDataSetType<scalar, 3>(group.parentFile()),
                                                       h5rd::STDArrayDataSetType<scalar, 3>(group.parentFile()));
+    pimpl->dataSetTypes->setWriteCombining(flushStride);
+    pimpl->dataSetIds->setWriteCombining(flushStride);
+    pimpl->dataSetPositions->setWriteCombining(flushStride);
     pimpl->time = std::make_unique<util::TimeSeriesWriter>(group, flushStride);
 }
 
@@ -83,6 +83,7 @@ void Positions::initializeDataSet(File &file, const std::string &dataSetName, St
     auto group = file.createGroup(std::string(util::OBSERVABLES_GROUP_PATH) + "/" + dataSetName);
     pimpl->writer = group.createVLENDataSet("data", fs, dims, std::get<0>(*pimpl->h5types),
                                             std::get<1>(*pimpl->h5types));
+    pimpl->writer->setWriteCombining(flushStride);
     pimpl->time = std::make_unique<util::TimeSeriesWriter>(group, flushStride);
 }
 
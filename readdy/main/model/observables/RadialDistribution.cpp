@@ -166,6 +166,7 @@ void RadialDistribution::initializeDataSet(File &file, const std::string &dataSe
     log::debug("created group with path {}", path);
     group.write("bin_centers", centers);
     pimpl->writerRadialDistribution = group.createDataSet<scalar>("distribution", fs, dims, {&bloscFilter});
+    pimpl->writerRadialDistribution->setWriteCombining(flushStride);
     pimpl->time = std::make_unique<util::TimeSeriesWriter>(group, flushStride);
 }
 
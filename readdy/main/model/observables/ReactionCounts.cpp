@@ -104,6 +104,7 @@ void ReactionCounts::append() {
                 h5rd::dimensions dims = {h5rd::UNLIMITED_DIMS};
                 auto dset = subgroup.createDataSet<std::size_t>(std::to_string(reaction->id()), chunkSize, dims,
                                                                 {&pimpl->bloscFilter});
+                dset->setWriteCombining(pimpl->flushStride);
                 pimpl->dataSets[reaction->id()] = std::move(dset);
             }
             for (const auto &reaction : reactionRegistry.order2Flat()) {
@@ -111,6 +112,7 @@ void ReactionCounts::append() {
                 h5rd::dimensions dims = {h5rd::UNLIMITED_DIMS};
                 auto dset = subgroup.createDataSet<std::size_t>(std::to_string(reaction->id()), chunkSize, dims,
                                                                 {&pimpl->bloscFilter});
+                dset->setWriteCombining(pimpl->flushStride);
                 pimpl->dataSets[reaction->id()] = std::move(dset);
             }
         }
@@ -123,6 +125,7 @@ void ReactionCounts::append() {
                     h5rd::dimensions dims = {h5rd::UNLIMITED_DIMS};
                     auto dset = spatialSubgroup.createDataSet<std::size_t>(std::to_string(spatialReaction.id()),
                             chunkSize, dims, {&pimpl->bloscFilter});
+                    dset->setWriteCombining(pimpl->flushStride);
                     pimpl->spatialReactionsDataSets[spatialReaction.id()] = std::move(dset);
                 }
             }
@@ -136,6 +139,7 @@ void ReactionCounts::append() {
                     h5rd::dimensions dims = {h5rd::UNLIMITED_DIMS};
                     auto dset = structuralSubgroup.createDataSet<std::size_t>(std::to_string(structuralReaction.id()),
                                                                            chunkSize, dims, {&pimpl->bloscFilter});
+                    dset->setWriteCombining(pimpl->flushStride);
                     pimpl->structuralReactionsDataSets[structuralReaction.id()] = std::move(dset);
                 }
             }
@@ -77,6 +77,7 @@ void Reactions::initializeDataSet(File &file, const std::string &dataSetName, St
             file.createGroup(std::string(util::OBSERVABLES_GROUP_PATH) + "/" + dataSetName));
     pimpl->writer = pimpl->group->createVLENDataSet("records", fs, dims, std::get<0>(*pimpl->h5types),
                                                     std::get<1>(*pimpl->h5types));
+    pimpl->writer->setWriteCombining(flushStride);
     pimpl->time = std::make_unique<util::TimeSeriesWriter>(*pimpl->group, flushStride);
 }
 
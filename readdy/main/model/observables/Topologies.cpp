@@ -109,6 +109,8 @@ void Topologies::initializeDataSet(File &file, const std::string &dataSetName, S
         fs = {flushStride, 2};
         dims = {h5rd::UNLIMITED_DIMS, 2};
         pimpl->dataSetEdges = group.createDataSet<std::size_t>("edges", fs, dims, filters);
+        pimpl->dataSetParticles->setWriteCombining(flushStride);
+        pimpl->dataSetEdges->setWriteCombining(flushStride);
     }
     {
         // limits
@@ -116,12 +118,15 @@ void Topologies::initializeDataSet(File &file, const std::string &dataSetName, S
         h5rd::dimensions dims = {h5rd::UNLIMITED_DIMS, 2};
         pimpl->limitsParticles = group.createDataSet<std::size_t>("limitsParticles", fs, dims);
         pimpl->limitsEdges = group.createDataSet<std::size_t>("limitsEdges", fs, dims);
+        pimpl->limitsParticles->setWriteCombining(flushStride);
+        pimpl->limitsEdges->setWriteCombining(flushStride);
     }
     {
         // types
         h5rd::dimensions fs = {flushStride};
         h5rd::dimensions dims = {h5rd::UNLIMITED_DIMS};
         pimpl->types = group.createVLENDataSet<TopologyTypeId>("types", fs, dims);
+        pimpl->types->setWriteCombining(flushStride);
     }
 
     pimpl->time = std::make_unique<util::TimeSeriesWriter>(group, flushStride, "time", useBlosc);
@@ -84,6 +84,7 @@ void Trajectory::initializeDataSet(File &file, const std::string &dataSetName, u
             std::string(TRAJECTORY_GROUP_PATH + (dataSetName.length() > 0 ? "/" + dataSetName : "")));
     pimpl->dataSet = group.createVLENDataSet("records", fs, dims,
                                              std::get<0>(*pimpl->h5types), std::get<1>(*pimpl->h5types));
+    pimpl->dataSet->setWriteCombining(flushStride);
     pimpl->time = std::make_unique<util::TimeSeriesWriter>(group, flushStride);
 }
 
@@ -122,11 +123,13 @@ void FlatTrajectory::initializeDataSet(File &file, const std::string &dataSetNam
             if(useBlosc) filters.push_back(&filter);
             pimpl->dataSet = group.createDataSet("records", fs, dims, std::get<0>(*pimpl->h5types),
                                                  std::get<1>(*pimpl->h5types), filters);
+            pimpl->dataSet->setWriteCombining(flushStride);
         }
         {
             h5rd::dimensions fs = {flushStride, 2};
             h5rd::dimensions dims = {h5rd::UNLIMITED_DIMS, 2};
             pimpl->limits = group.createDataSet<std::size_t>("limits", fs, dims);
+            pimpl->limits->setWriteCombining(flushStride);
         }
         pimpl->time = std::make_unique<util::TimeSeriesWriter>(group, flushStride, "time", useBlosc);
 
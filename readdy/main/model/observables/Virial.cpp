@@ -75,7 +75,8 @@ void Virial::initializeDataSet(File &file, const std::string &dataSetName, Strid
     h5rd::dimensions fs = {flushStride, Matrix33::n(), Matrix33::m()};
     h5rd::dimensions dims = {h5rd::UNLIMITED_DIMS, Matrix33::n(), Matrix33::m()};
     auto group = file.createGroup(std::string(util::OBSERVABLES_GROUP_PATH) + "/" + dataSetName);
-    pimpl->ds = group.createDataSet<readdy::scalar>("data", fs, dims, {&pimpl->bloscFilter});
+    pimpl->ds = group.createDataSet<ScalarAccumulator>("data", fs, dims, {&pimpl->bloscFilter});
+    pimpl->ds->setWriteCombining(flushStride);
     pimpl->time = std::make_unique<util::TimeSeriesWriter>(group, flushStride);
 }
 
@@ -0,0 +1,180 @@
+/********************************************************************
+ * Copyright © 2018 Computational Molecular Biology Group,          *
+ *                  Freie Universität Berlin (GER)                  *
+ *                                                                  *
+ * Redistribution and use in source and binary forms, with or       *
+ * without modification, are permitted provided that the            *
+ * following conditions are met:                                    *
+ *  1. Redistributions of source code must retain the above         *
+ *     copyright notice, this list of conditions and the            *
+ *     following disclaimer.                                        *
+ *  2. Redistributions in binary form must reproduce the above      *
+ *     copyright notice, this list of conditions and the following  *
+ *     disclaimer in the documentation and/or other materials       *
+ *     provided with the distribution.                              *
+ *  3. Neither the name of the copyright holder nor the names of    *
+ *     its contributors may be used to endorse or promote products  *
+ *     derived from this software without specific                  *
+ *     prior written permission.                                    *
+ *                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND           *
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,      *
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF         *
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE         *
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR            *
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,     *
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,         *
+ * BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER *
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,      *
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)    *
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF      *
+ * ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                       *
+ ********************************************************************/
+
+
+
+/**
+ * @file PotentialGrid.cpp
+ * @brief Implementation of grid-precomputed first order potentials
+ * @author EricArkfeld
+ * @date 19.10.26
+ * @copyright BSD-3
+ */
+
+#include <algorithm>
+#include <iterator>
+
+#include <readdy/model/potentials/PotentialGrid.h>
+#include <readdy/model/potentials/PotentialsOrder1.h>
+
+namespace readdy::model::potentials {
+
+namespace {
+
+template<typename T>
+const T *exactly(const PotentialOrder1 &potential) {
+    // subclasses of the built-in potentials may override their evaluation, hence the exact type is required
+    return typeid(potential) == typeid(T) ? static_cast<const T *>(&potential) : nullptr;
+}
+
+template<bool inclusion>
+std::optional<PotentialGrid::Parameters> harmonicGeometryParameters(const PotentialOrder1 &potential) {
+    if (const auto *box = exactly<Box<inclusion>>(potential)) {
+        const auto &g = box->geometry();
+        return PotentialGrid::Parameters{box->forceConstant(), g.v0.x, g.v0.y, g.v0.z, g.v1.x, g.v1.y, g.v1.z};
+    }
+    if (const auto *sphere = exactly<Sphere<inclusion>>(potential)) {
+        const auto &g = sphere->geometry();
+        return PotentialGrid::Parameters{sphere->forceConstant(), g.center.x, g.center.y, g.center.z, g.radius};
+    }
+    if (const auto *capsule = exactly<Capsule<inclusion>>(potential)) {
+        const auto &g = capsule->geometry();
+        return PotentialGrid::Parameters{capsule->forceConstant(), g.center.x, g.center.y, g.center.z,
+                                         g.direction.x, g.direction.y, g.direction.z, g.radius, g.length};
+    }
+    if (const auto *cylinder = exactly<Cylinder<inclusion>>(potential)) {
+        const auto &origin = cylinder->getOrigin();
+        const auto &normal = cylinder->getNormal();
+        return PotentialGrid::Parameters{cylinder->getForceConstant(), origin.x, origin.y, origin.z,
+                                         normal.x, normal.y, normal.z, cylinder->getRadius()};
+    }
+    return std::nullopt;
+}
+
+}
+
+std::optional<PotentialGrid::Parameters> PotentialGrid::parametersOf(const PotentialOrder1 &potential) {
+    if (const auto *barrier = exactly<SphericalBarrier>(potential)) {
+        const auto &origin = barrier->getOrigin();
+        return Parameters{origin.x, origin.y, origin.z, barrier->getRadius(), barrier->getHeight(),
+                          barrier->getWidth()};
+    }
+    if (auto parameters = harmonicGeometryParameters<true>(potential)) {
+        return parameters;
+    }
+    return harmonicGeometryParameters<false>(potential);
+}
+
+std::unordered_map<ParticleTypeId, PotentialGrid::Signature>
+PotentialGrid::signatureOf(const PotentialRegistry::PotentialsO1Map &potentials) {
+    std::unordered_map<ParticleTypeId, Signature> signature;
+    for (const auto &[type, collection] : potentials) {
+        if (collection.empty()) {
+            continue;
+        }
+        auto &entry = signature[type];
+        for (auto *potential : collection) {
+            if (auto parameters = parametersOf(*potential)) {
+                entry.tabulated.emplace_back(typeid(*potential), std::move(*parameters));
+            } else {
+                entry.exact.push_back(potential);
+            }
+        }
+    }
+    return signature;
+}
+
+PotentialGrid::PotentialGrid(const PotentialRegistry::PotentialsO1Map &potentials, const BoxSize &boxSize,
+                             scalar spacing) : _signature(signatureOf(potentials)), _boxSize(boxSize),
+                                               _spacing(spacing) {
+    if (!(spacing > 0)) {
+        throw std::invalid_argument(fmt::format("The potential grid spacing must be positive but was {}", spacing));
+    }
+    std::size_t nNodes = 1;
+    for (std::uint8_t d = 0; d < 3; ++d) {
+        const auto nCells = std::ceil(boxSize[d] / spacing);
+        if (!(nCells + 1 <= static_cast<scalar>(maxNodes / nNodes))) {
+            throw std::invalid_argument(fmt::format(
+                    "The potential grid spacing {} is too small for the box ({}, {}, {}), the grid would exceed {} "
+                    "nodes", spacing, boxSize[0], boxSize[1], boxSize[2], maxNodes));
+        }
+        _nCells[d] = std::max(static_cast<std::size_t>(nCells), static_cast<std::size_t>(1));
+        _inverseSpacing[d] = static_cast<scalar>(_nCells[d]) / boxSize[d];
+        nNodes *= _nCells[d] + 1;
+    }
+
+    std::size_t nTypes = 0;
+    for (const auto &[type, entry] : _signature) {
+        nTypes = std::max(nTypes, static_cast<std::size_t>(type) + 1);
+    }
+    _tables.resize(nTypes);
+    _exactPotentials.resize(nTypes);
+    for (const auto &[type, entry] : _signature) {
+        _exactPotentials[type] = entry.exact;
+        if (entry.tabulated.empty()) {
+            continue;
+        }
+        PotentialRegistry::PotentialsO1Collection tabulated;
+        std::copy_if(potentials.at(type).begin(), potentials.at(type).end(), std::back_inserter(tabulated),
+                     [](const auto *potential) { return parametersOf(*potential).has_value(); });
+        auto &table = _tables[type];
+        table.resize(4 * nNodes);
+        std::size_t ix = 0;
+        for (std::size_t i = 0; i <= _nCells[0]; ++i) {
+            for (std::size_t j = 0; j <= _nCells[1]; ++j) {
+                for (std::size_t k = 0; k <= _nCells[2]; ++k, ++ix) {
+                    const Vec3 node{-.5 * boxSize[0] + static_cast<scalar>(i) / _inverseSpacing[0],
+                                    -.5 * boxSize[1] + static_cast<scalar>(j) / _inverseSpacing[1],
+                                    -.5 * boxSize[2] + static_cast<scalar>(k) / _inverseSpacing[2]};
+                    Vec3 force{0, 0, 0};
+                    scalar energy{0};
+                    for (const auto *potential : tabulated) {
+                        potential->calculateForceAndEnergy(force, energy, node);
+                    }
+                    table[4 * ix] = force[0];
+                    table[4 * ix + 1] = force[1];
+                    table[4 * ix + 2] = force[2];
+                    table[4 * ix + 3] = energy;
+                }
+            }
+        }
+    }
+}
+
+bool PotentialGrid::upToDate(const PotentialRegistry::PotentialsO1Map &potentials, const BoxSize &boxSize,
+                             scalar spacing) const {
+    return spacing == _spacing && boxSize == _boxSize && signatureOf(potentials) == _signature;
+}
+
+}
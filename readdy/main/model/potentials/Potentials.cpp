@@ -41,6 +41,8 @@
  * @date 20.06.16
  */
 
+#include <algorithm>
+
 #include <readdy/model/Kernel.h>
 #include <readdy/model/potentials/PotentialsOrder1.h>
 
@@ -212,4 +214,110 @@ std::string ScreenedElectrostatics::type() const {
     return getPotentialName<ScreenedElectrostatics>();
 }
 
+namespace {
+/**
+ * Per interval coefficients (a, b, c, d) of a + b t + c t^2 + d t^3 interpolating the values y on the nodes x,
+ * where t is the offset from the interval start. The cubic variant is a natural spline.
+ */
+std::vector<scalar> interpolationCoefficients(const std::vector<double> &x, const std::vector<double> &y, bool cubic) {
+    const auto n = x.size();
+    std::vector<double> secondDerivatives(n, 0.);
+    if (cubic && n > 2) {
+        // tridiagonal system for the second derivatives in the inner nodes, solved by forward elimination and
+        // back substitution
+        std::vector<double> diag(n, 0.), rhs(n, 0.);
+        for (std::size_t i = 1; i < n - 1; ++i) {
+            const auto hPrev = x[i] - x[i - 1];
+            const auto h = x[i + 1] - x[i];
+            diag[i] = 2. * (hPrev + h);
+            rhs[i] = 6. * ((y[i + 1] - y[i]) / h - (y[i] - y[i - 1]) / hPrev);
+            if (i > 1) {
+                const auto factor = hPrev / diag[i - 1];
+                diag[i] -= factor * hPrev;
+                rhs[i] -= factor * rhs[i - 1];
+            }
+        }
+        for (std::size_t i = n - 2; i >= 1; --i) {
+            const auto h = x[i + 1] - x[i];
+            secondDerivatives[i] = (rhs[i] - h * secondDerivatives[i + 1]) / diag[i];
+        }
+    }
+    std::vector<scalar> coefficients;
+    coefficients.reserve(4 * (n - 1));
+    for (std::size_t i = 0; i < n - 1; ++i) {
+        const auto h = x[i + 1] - x[i];
+        const auto mi = secondDerivatives[i];
+        const auto mNext = secondDerivatives[i + 1];
+        coefficients.push_back(static_cast<scalar>(y[i]));
+        coefficients.push_back(static_cast<scalar>((y[i + 1] - y[i]) / h - h * (2. * mi + mNext) / 6.));
+        coefficients.push_back(static_cast<scalar>(mi / 2.));
+        coefficients.push_back(static_cast<scalar>((mNext - mi) / (6. * h)));
+    }
+    return coefficients;
+}
+}
+
+TabulatedPotential::TabulatedPotential(ParticleTypeId type1, ParticleTypeId type2,
+                                       const std::vector<scalar> &distances, const std::vector<scalar> &energies,
+                                       const std::vector<scalar> &forces, Interpolation interpolation)
+        : super(type1, type2), _interpolation(interpolation) {
+    const auto n = distances.size();
+    if (n < 2) {
+        throw std::invalid_argument("A tabulated potential requires at least two grid points!");
+    }
+    if (energies.size() != n || forces.size() != n) {
+        throw std::invalid_argument(fmt::format("The number of energies ({}) and forces ({}) must match the number "
+                                                "of grid points ({})!", energies.size(), forces.size(), n));
+    }
+    if (distances.front() < 0) {
+        throw std::invalid_argument("The grid of a tabulated potential must not contain negative distances!");
+    }
+    std::vector<double> nodes(n), energyValues(energies.begin(), energies.end()), forceFactors(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i > 0 && !(distances[i] > distances[i - 1])) {
+            throw std::invalid_argument("The grid of a tabulated potential must be strictly increasing!");
+        }
+        const auto r = static_cast<double>(distances[i]);
+        nodes[i] = r * r;
+        // the force on the first particle is f(r^2) x_ij with x_ij pointing to the second particle
+        forceFactors[i] = r > 0 ? -static_cast<double>(forces[i]) / r : 0.;
+    }
+    if (distances.front() == 0) {
+        // the force vanishes at zero separation anyway, continue the factor smoothly
+        forceFactors[0] = forceFactors[1];
+    }
+    const bool cubic = interpolation == Interpolation::CubicSpline;
+    _energyCoefficients = interpolationCoefficients(nodes, energyValues, cubic);
+    _forceCoefficients = interpolationCoefficients(nodes, forceFactors, cubic);
+    _nodes.assign(nodes.begin(), nodes.end());
+    _cutoff = distances.back();
+    _cutoffSquared = _nodes.back();
+
+    // the bins are roughly as wide as the narrowest interval so that the lookup rarely walks more than one interval
+    double narrowest = nodes.back() - nodes.front();
+    for (std::size_t i = 0; i < n - 1; ++i) {
+        narrowest = std::min(narrowest, nodes[i + 1] - nodes[i]);
+    }
+    const auto range = nodes.back() - nodes.front();
+    const auto nBuckets = std::clamp(static_cast<std::size_t>(std::ceil(range / narrowest)), n - 1, 8 * (n - 1));
+    _inverseBucketWidth = static_cast<scalar>(static_cast<double>(nBuckets) / range);
+    // one extra bucket for squared distances that round up to the end of the range
+    _buckets.resize(nBuckets + 1);
+    std::size_t k = 0;
+    for (std::size_t b = 0; b <= nBuckets; ++b) {
+        const auto bucketStart = nodes.front() + static_cast<double>(b) * range / static_cast<double>(nBuckets);
+        while (k < n - 2 && nodes[k + 1] <= bucketStart) ++k;
+        _buckets[b] = k;
+    }
+}
+
+std::string TabulatedPotential::describe() const {
+    return fmt::format("Tabulated potential with {} grid points, {} interpolation and cutoff={}", _nodes.size(),
+                       _interpolation == Interpolation::CubicSpline ? "cubic spline" : "linear", _cutoff);
+}
+
+std::string TabulatedPotential::type() const {
+    return getPotentialName<TabulatedPotential>();
+}
+
 }
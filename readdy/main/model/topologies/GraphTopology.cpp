@@ -43,7 +43,12 @@
  * @copyright BSD-3
  */
 
+#include <array>
+#include <optional>
+#include <queue>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <readdy/model/Kernel.h>
 #include <readdy/model/topologies/GraphTopology.h>
@@ -54,60 +59,97 @@ namespace readdy::model::top {
 GraphTopology::GraphTopology(TopologyTypeId type, Graph graph,
                              const model::Context& context, const model::StateModel *stateModel)
         : Topology(), _context(context), _topology_type(type), _stateModel(stateModel), _cumulativeRate(0),
-        _graph(std::move(graph)) {}
-
-void GraphTopology::configure() {
-    validate();
+        _graph(std::move(graph)) {
+    rebuildVertexIndex();
+}
 
+void GraphTopology::reset(TopologyTypeId type) {
+    _graph.clear();
+    _vertexForParticle.clear();
+    _reaction_rates.clear();
+    _cumulativeRate = 0;
+    _spatial_reaction_rates.clear();
+    _topology_type = type;
+    deactivated = false;
+    _ratesDirty = true;
+    _configured = false;
+    clearChanges();
     bondedPotentials.clear();
     anglePotentials.clear();
     torsionPotentials.clear();
+}
+
+void GraphTopology::rebuildVertexIndex() {
+    _vertexForParticle.clear();
+    _vertexForParticle.reserve(_graph.nVertices());
+    std::size_t ix {0};
+    for (auto it = _graph.vertices().begin_persistent(); it != _graph.vertices().end_persistent(); ++it, ++ix) {
+        if (!it->deactivated()) {
+            _vertexForParticle.emplace((*it)->particleIndex, Graph::PersistentVertexIndex{ix});
+        }
+    }
+}
+
+namespace {
+
+/**
+ * Collects the bonded terms of n-tuples of a graph topology, grouped by potential type.
+ */
+struct TermCollector {
+    TermCollector(const GraphTopology &topology, const api::PotentialConfiguration &config)
+            : topology(topology), config(config) {}
+
+    const GraphTopology &topology;
+    const api::PotentialConfiguration &config;
 
     std::unordered_map<api::BondType, std::vector<pot::BondConfiguration>, readdy::util::hash::EnumClassHash> bonds;
     std::unordered_map<api::AngleType, std::vector<pot::AngleConfiguration>, readdy::util::hash::EnumClassHash> angles;
     std::unordered_map<api::TorsionType, std::vector<pot::DihedralConfiguration>, readdy::util::hash::EnumClassHash> dihedrals;
 
-    const auto &config = context().topologyRegistry().potentialConfiguration();
-
-    _graph.findNTuples([&](const Graph::Edge &tuple) {
+    void pair(const Graph::Edge &tuple) {
         auto [i1, i2] = tuple;
-        const auto& v1 = _graph.vertices().at(i1);
-        const auto& v2 = _graph.vertices().at(i2);
-        auto it = config.pairPotentials.find(std::make_tuple(typeOf(v1), typeOf(v2)));
+        const auto &v1 = topology.graph().vertices().at(i1);
+        const auto &v2 = topology.graph().vertices().at(i2);
+        auto it = config.pairPotentials.find(std::make_tuple(topology.typeOf(v1), topology.typeOf(v2)));
         if (it != config.pairPotentials.end()) {
             for (const auto &cfg : it->second) {
                 bonds[cfg.type].emplace_back(v1->particleIndex, v2->particleIndex, cfg.forceConstant, cfg.length);
             }
         } else {
             std::ostringstream ss;
-            auto p1 = particleForVertex(v1);
-            auto p2 = particleForVertex(v2);
+            const auto &types = topology.context().particleTypes();
 
-            ss << "The edge " << v1->particleIndex << " (" << context().particleTypes().nameOf(p1.type()) << ")";
-            ss << " -- " << v2->particleIndex << " (" << context().particleTypes().nameOf(p2.type()) << ")";
+            ss << "The edge " << v1->particleIndex << " (" << types.nameOf(topology.typeOf(v1)) << ")";
+            ss << " -- " << v2->particleIndex << " (" << types.nameOf(topology.typeOf(v2)) << ")";
             ss << " has no bond configured!";
 
             throw std::invalid_argument(ss.str());
         }
-    }, [&](const Graph::Path3 &triple) {
+    }
+
+    void triple(const Graph::Path3 &triple) {
         auto [i1, i2, i3] = triple;
-        const auto& v1 = _graph.vertices().at(i1);
-        const auto& v2 = _graph.vertices().at(i2);
-        const auto& v3 = _graph.vertices().at(i3);
-        auto it = config.anglePotentials.find(std::make_tuple(typeOf(v1), typeOf(v2), typeOf(v3)));
+        const auto &v1 = topology.graph().vertices().at(i1);
+        const auto &v2 = topology.graph().vertices().at(i2);
+        const auto &v3 = topology.graph().vertices().at(i3);
+        auto it = config.anglePotentials.find(std::make_tuple(topology.typeOf(v1), topology.typeOf(v2),
+                                                              topology.typeOf(v3)));
         if (it != config.anglePotentials.end()) {
             for (const auto &cfg : it->second) {
                 angles[cfg.type].emplace_back(v1->particleIndex, v2->particleIndex, v3->particleIndex,
                                               cfg.forceConstant, cfg.equilibriumAngle);
             }
         }
-    }, [&](const Graph::Path4 &quadruple) {
+    }
+
+    void quadruple(const Graph::Path4 &quadruple) {
         auto [i1, i2, i3, i4] = quadruple;
-        const auto& v1 = _graph.vertices().at(i1);
-        const auto& v2 = _graph.vertices().at(i2);
-        const auto& v3 = _graph.vertices().at(i3);
-        const auto& v4 = _graph.vertices().at(i4);
-        auto it = config.torsionPotentials.find(std::make_tuple(typeOf(v1), typeOf(v2), typeOf(v3), typeOf(v4)));
+        const auto &v1 = topology.graph().vertices().at(i1);
+        const auto &v2 = topology.graph().vertices().at(i2);
+        const auto &v3 = topology.graph().vertices().at(i3);
+        const auto &v4 = topology.graph().vertices().at(i4);
+        auto it = config.torsionPotentials.find(std::make_tuple(topology.typeOf(v1), topology.typeOf(v2),
+                                                                topology.typeOf(v3), topology.typeOf(v4)));
         if (it != config.torsionPotentials.end()) {
             for (const auto &cfg : it->second) {
                 dihedrals[cfg.type].emplace_back(v1->particleIndex, v2->particleIndex, v3->particleIndex,
@@ -115,8 +157,50 @@ void GraphTopology::configure() {
                                                  cfg.phi_0);
             }
         }
-    });
-    for (const auto &bond : bonds) {
+    }
+};
+
+template<typename Concrete, typename Potential, typename Configurations, typename Predicate>
+void removeTerms(std::vector<std::unique_ptr<Potential>> &potentials, Configurations &&getter, const Predicate &pred) {
+    for (auto &potential : potentials) {
+        if (auto concrete = dynamic_cast<Concrete *>(potential.get())) {
+            auto &terms = getter(*concrete);
+            terms.erase(std::remove_if(terms.begin(), terms.end(), pred), terms.end());
+            if (terms.empty()) {
+                potential.reset();
+            }
+        }
+    }
+    potentials.erase(std::remove(potentials.begin(), potentials.end(), nullptr), potentials.end());
+}
+
+template<typename Concrete, typename Potential, typename Configurations, typename Terms>
+void appendTerms(std::vector<std::unique_ptr<Potential>> &potentials, Configurations &&getter, Terms &&terms) {
+    for (auto &potential : potentials) {
+        if (auto concrete = dynamic_cast<Concrete *>(potential.get())) {
+            auto &existing = getter(*concrete);
+            existing.insert(existing.end(), terms.begin(), terms.end());
+            return;
+        }
+    }
+    potentials.push_back(std::make_unique<Concrete>(std::forward<Terms>(terms)));
+}
+
+}
+
+void GraphTopology::configure() {
+    validate();
+
+    bondedPotentials.clear();
+    anglePotentials.clear();
+    torsionPotentials.clear();
+
+    TermCollector collector {*this, context().topologyRegistry().potentialConfiguration()};
+
+    _graph.findNTuples([&](const Graph::Edge &tuple) { collector.pair(tuple); },
+                       [&](const Graph::Path3 &triple) { collector.triple(triple); },
+                       [&](const Graph::Path4 &quadruple) { collector.quadruple(quadruple); });
+    for (const auto &bond : collector.bonds) {
         switch (bond.first) {
             case api::BondType::HARMONIC: {
                 addBondedPotential(std::make_unique<HarmonicBond>(bond.second));
@@ -124,7 +208,7 @@ void GraphTopology::configure() {
             }
         }
     }
-    for (const auto &angle : angles) {
+    for (const auto &angle : collector.angles) {
         switch (angle.first) {
             case api::AngleType::HARMONIC: {
                 addAnglePotential(std::make_unique<HarmonicAngle>(angle.second));
@@ -132,7 +216,7 @@ void GraphTopology::configure() {
             }
         }
     }
-    for (const auto &dih : dihedrals) {
+    for (const auto &dih : collector.dihedrals) {
         switch (dih.first) {
             case api::TorsionType::COS_DIHEDRAL: {
                 addTorsionPotential(std::make_unique<CosineDihedral>(dih.second));
@@ -140,6 +224,194 @@ void GraphTopology::configure() {
             }
         }
     }
+    _configured = true;
+    clearChanges();
+}
+
+void GraphTopology::reconfigure() {
+    if (!_configured) {
+        configure();
+        return;
+    }
+    if (_changedVertices.empty()) {
+        return;
+    }
+
+    const auto &vertices = _graph.vertices();
+    const auto &types = context().particleTypes();
+
+    std::sort(_changedVertices.begin(), _changedVertices.end());
+    _changedVertices.erase(std::unique(_changedVertices.begin(), _changedVertices.end()), _changedVertices.end());
+
+    // validate the changed vertices only, the remainder of the graph is untouched since the last configuration
+    for (auto ix : _changedVertices) {
+        const auto &v = vertexAt(ix);
+        if (v.deactivated()) {
+            // removed vertices keep their stale neighbor lists, edges pointing to them are caught below
+            continue;
+        }
+        for (auto neighbor : v.neighbors()) {
+            if (vertexAt(neighbor).deactivated()) {
+                throw std::logic_error(fmt::format("Edge ({} -- {}) points to deactivated vertex {}!",
+                                                   ix, neighbor, neighbor));
+            }
+        }
+        if (types.infoOf(typeOf(v)).flavor != particleflavor::TOPOLOGY) {
+            throw std::runtime_error(fmt::format("Topology contains particle {} which is not a topology particle!",
+                                                 particleForVertex(v)));
+        }
+    }
+
+    // drop all terms that involve a changed vertex
+    std::unordered_set<VertexData::ParticleIndex> changedParticles;
+    changedParticles.reserve(_changedVertices.size());
+    for (auto ix : _changedVertices) {
+        changedParticles.insert(vertexAt(ix)->particleIndex);
+    }
+    auto touched = [&changedParticles](auto... indices) {
+        return (changedParticles.count(indices) || ...);
+    };
+    removeTerms<HarmonicBond>(bondedPotentials, [](auto &p) -> auto& { return p.getBonds(); }, [&](const auto &b) {
+        return touched(b.idx1, b.idx2);
+    });
+    removeTerms<HarmonicAngle>(anglePotentials, [](auto &p) -> auto& { return p.getAngles(); }, [&](const auto &a) {
+        return touched(a.idx1, a.idx2, a.idx3);
+    });
+    removeTerms<CosineDihedral>(torsionPotentials, [](auto &p) -> auto& { return p.getDihedrals(); }, [&](const auto &d) {
+        return touched(d.idx1, d.idx2, d.idx3, d.idx4);
+    });
+
+    // re-enumerate the tuples containing a changed vertex in the same orientation as Graph::findNTuples
+    std::vector<char> changed(vertices.size_persistent(), false);
+    for (auto ix : _changedVertices) {
+        if (!vertexAt(ix).deactivated()) changed.at(ix.value) = true;
+    }
+    auto isChanged = [&changed](auto... ix) {
+        return (changed[ix.value] || ...);
+    };
+    // centers of triples and middle edges of quadruples are in the closed neighborhood of changed vertices
+    std::vector<Graph::PersistentVertexIndex> centers;
+    {
+        std::vector<char> isCenter(vertices.size_persistent(), false);
+        for (auto ix : _changedVertices) {
+            if (!changed.at(ix.value)) continue;
+            if (!isCenter[ix.value]) {
+                isCenter[ix.value] = true;
+                centers.push_back(ix);
+            }
+            for (auto neighbor : vertices.at(ix).neighbors()) {
+                if (!isCenter[neighbor.value]) {
+                    isCenter[neighbor.value] = true;
+                    centers.push_back(neighbor);
+                }
+            }
+        }
+    }
+
+    TermCollector collector {*this, context().topologyRegistry().potentialConfiguration()};
+    for (auto ix : _changedVertices) {
+        if (!changed.at(ix.value)) continue;
+        for (auto neighbor : vertices.at(ix).neighbors()) {
+            if (!changed[neighbor.value] || ix < neighbor) {
+                collector.pair(ix < neighbor ? Graph::Edge{ix, neighbor} : Graph::Edge{neighbor, ix});
+            }
+        }
+    }
+    std::vector<Graph::Edge> middleEdges;
+    for (auto center : centers) {
+        const auto &neighbors = vertices.at(center).neighbors();
+        for (auto n1 : neighbors) {
+            for (auto n2 : neighbors) {
+                if (n2 < n1 && isChanged(n2, center, n1)) {
+                    collector.triple({n2, center, n1});
+                }
+            }
+            middleEdges.push_back(center < n1 ? Graph::Edge{center, n1} : Graph::Edge{n1, center});
+        }
+    }
+    std::sort(middleEdges.begin(), middleEdges.end());
+    middleEdges.erase(std::unique(middleEdges.begin(), middleEdges.end()), middleEdges.end());
+    for (const auto &[p, q] : middleEdges) {
+        for (auto x : vertices.at(p).neighbors()) {
+            if (x == q) continue;
+            for (auto y : vertices.at(q).neighbors()) {
+                if (y != p && y != x && isChanged(x, p, q, y)) {
+                    collector.quadruple({x, p, q, y});
+                }
+            }
+        }
+    }
+
+    for (auto &bond : collector.bonds) {
+        switch (bond.first) {
+            case api::BondType::HARMONIC: {
+                appendTerms<HarmonicBond>(bondedPotentials, [](auto &p) -> auto& { return p.getBonds(); },
+                                          std::move(bond.second));
+                break;
+            }
+        }
+    }
+    for (auto &angle : collector.angles) {
+        switch (angle.first) {
+            case api::AngleType::HARMONIC: {
+                appendTerms<HarmonicAngle>(anglePotentials, [](auto &p) -> auto& { return p.getAngles(); },
+                                           std::move(angle.second));
+                break;
+            }
+        }
+    }
+    for (auto &dih : collector.dihedrals) {
+        switch (dih.first) {
+            case api::TorsionType::COS_DIHEDRAL: {
+                appendTerms<CosineDihedral>(torsionPotentials, [](auto &p) -> auto& { return p.getDihedrals(); },
+                                            std::move(dih.second));
+                break;
+            }
+        }
+    }
+    clearChanges();
+}
+
+bool GraphTopology::isConnectedAfterChanges() const {
+    if (!_configured) {
+        return _graph.isConnected();
+    }
+    const auto &vertices = _graph.vertices();
+    for (const auto &[u, w] : _removedEdges) {
+        if (vertexAt(u).deactivated() || vertexAt(w).deactivated()) {
+            continue;
+        }
+        const auto &uNeighbors = vertices.at(u).neighbors();
+        if (std::find(uNeighbors.begin(), uNeighbors.end(), w) != uNeighbors.end()) {
+            continue;
+        }
+        // bidirectional breadth first search from both endpoints of the removed edge, stops as soon as the frontiers
+        // meet or one of the two sides is exhausted
+        std::unordered_map<std::size_t, char> side {{u.value, 0}, {w.value, 1}};
+        std::array<std::vector<Graph::PersistentVertexIndex>, 2> frontiers {{{u}, {w}}};
+        bool connected = false;
+        while (!connected && !frontiers[0].empty() && !frontiers[1].empty()) {
+            const char s = frontiers[0].size() <= frontiers[1].size() ? 0 : 1;
+            std::vector<Graph::PersistentVertexIndex> next;
+            for (auto ix : frontiers[s]) {
+                for (auto neighbor : vertices.at(ix).neighbors()) {
+                    auto [it, inserted] = side.emplace(neighbor.value, s);
+                    if (inserted) {
+                        next.push_back(neighbor);
+                    } else if (it->second != s) {
+                        connected = true;
+                        break;
+                    }
+                }
+                if (connected) break;
+            }
+            frontiers[s] = std::move(next);
+        }
+        if (!connected) {
+            return false;
+        }
+    }
+    return true;
 }
 
 std::vector<GraphTopology> GraphTopology::connectedComponents() {
@@ -158,6 +430,172 @@ std::vector<GraphTopology> GraphTopology::connectedComponents() {
     return std::move(components);
 }
 
+std::vector<GraphTopology> GraphTopology::splitOffComponents(const TopologyProvider &provider) {
+    using Index = Graph::PersistentVertexIndex;
+    const auto &vertices = _graph.vertices();
+
+    // every component that was split off contains an endpoint of a removed edge, as long as the graph was connected
+    std::vector<Index> seeds;
+    if (_configured) {
+        for (const auto &[u, w] : _removedEdges) {
+            if (!vertexAt(u).deactivated()) seeds.push_back(u);
+            if (!vertexAt(w).deactivated()) seeds.push_back(w);
+        }
+        std::sort(seeds.begin(), seeds.end());
+        seeds.erase(std::unique(seeds.begin(), seeds.end()), seeds.end());
+    } else {
+        for (auto it = vertices.begin(); it != vertices.end(); ++it) {
+            seeds.push_back(it.persistent_index());
+        }
+    }
+    if (seeds.size() < 2) {
+        return {};
+    }
+
+    // breadth first searches from all seeds, searches that meet are merged (union-find over seeds). One edge at a
+    // time is explored by the live search that has visited the fewest vertices, so a search is only exhausted when it
+    // is the smallest one and the work is bounded by the smaller components, also if they are deep.
+    std::vector<std::size_t> parent(seeds.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](std::size_t i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    struct Search {
+        // queued vertices together with the position of the next neighbor to explore
+        std::vector<std::pair<Index, std::size_t>> queue;
+        std::size_t head {0};
+        std::size_t nVisited {1};
+
+        [[nodiscard]] bool exhausted() const { return head == queue.size(); }
+    };
+    std::unordered_map<std::size_t, std::size_t> label;
+    std::vector<Search> searches(seeds.size());
+    using Entry = std::pair<std::size_t, std::size_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> smallest;
+    for (std::size_t i = 0; i < seeds.size(); ++i) {
+        label.emplace(seeds[i].value, i);
+        searches[i].queue.emplace_back(seeds[i], 0);
+        smallest.emplace(1, i);
+    }
+
+    auto nRoots = seeds.size();
+    auto nLive = seeds.size();
+    while (nRoots > 1 && nLive > 1) {
+        auto [nVisited, i] = smallest.top();
+        smallest.pop();
+        if (find(i) != i || searches[i].nVisited != nVisited || searches[i].exhausted()) {
+            // outdated entry, the search was merged or has grown since
+            continue;
+        }
+        std::optional<Index> neighbor;
+        {
+            auto &search = searches[i];
+            auto &[vertex, position] = search.queue[search.head];
+            const auto &neighbors = vertices.at(vertex).neighbors();
+            if (position < neighbors.size()) {
+                neighbor = neighbors[position++];
+            }
+            if (position >= neighbors.size()) {
+                ++search.head;
+            }
+        }
+        auto root = i;
+        if (neighbor) {
+            auto [it, inserted] = label.emplace(neighbor->value, i);
+            if (inserted) {
+                searches[i].queue.emplace_back(*neighbor, 0);
+                ++searches[i].nVisited;
+            } else if (auto other = find(it->second); other != i) {
+                // the other search is live as well, otherwise it would have reached this vertex already
+                auto *kept = &searches[other];
+                auto *merged = &searches[i];
+                root = other;
+                if (kept->queue.size() - kept->head < merged->queue.size() - merged->head) {
+                    std::swap(kept, merged);
+                    root = i;
+                }
+                kept->queue.insert(kept->queue.end(), merged->queue.begin() + merged->head, merged->queue.end());
+                kept->nVisited += merged->nVisited;
+                merged->queue.clear();
+                merged->head = 0;
+                parent[root == i ? other : i] = root;
+                --nRoots;
+                --nLive;
+            }
+        }
+        if (searches[root].exhausted()) {
+            --nLive;
+        } else {
+            smallest.emplace(searches[root].nVisited, root);
+        }
+    }
+    if (nRoots == 1) {
+        // all searches met, still connected
+        return {};
+    }
+    const bool searchLeft = nLive == 1;
+    std::vector<std::size_t> finished;
+    for (std::size_t i = 0; i < seeds.size(); ++i) {
+        if (find(i) == i && searches[i].exhausted()) {
+            finished.push_back(i);
+        }
+    }
+
+    // collect the vertices of the exhausted searches, if no search is left, the largest component stays
+    std::unordered_map<std::size_t, std::vector<Index>> components;
+    for (auto root : finished) {
+        components[root];
+    }
+    for (const auto &[vertex, seed] : label) {
+        auto it = components.find(find(seed));
+        if (it != components.end()) {
+            it->second.push_back(Index{vertex});
+        }
+    }
+    if (!searchLeft) {
+        auto largest = std::max_element(components.begin(), components.end(), [](const auto &c1, const auto &c2) {
+            return c1.second.size() < c2.second.size();
+        });
+        components.erase(largest);
+    }
+
+    std::vector<std::vector<Index>> sorted;
+    sorted.reserve(components.size());
+    for (auto &[root, component] : components) {
+        std::sort(component.begin(), component.end());
+        sorted.push_back(std::move(component));
+    }
+    // deterministic order of the new topologies
+    std::sort(sorted.begin(), sorted.end());
+
+    std::vector<GraphTopology> result;
+    result.reserve(sorted.size());
+    for (const auto &component : sorted) {
+        auto top = provider ? provider(_topology_type) : GraphTopology(_topology_type, {}, _context, _stateModel);
+        std::unordered_map<std::size_t, Index> mapping;
+        mapping.reserve(component.size());
+        for (auto ix : component) {
+            mapping.emplace(ix.value, top.addVertex(vertices.at(ix).data()));
+        }
+        for (auto ix : component) {
+            for (auto neighbor : vertices.at(ix).neighbors()) {
+                if (ix < neighbor) {
+                    top._graph.addEdge(mapping.at(ix.value), mapping.at(neighbor.value));
+                }
+            }
+        }
+        for (auto ix : component) {
+            removeVertex(ix);
+        }
+        result.push_back(std::move(top));
+    }
+    return result;
+}
+
 bool GraphTopology::isNormalParticle(const Kernel &k) const {
     if(_graph.nVertices() == 1){
         for(const auto &v : _graph.vertices()) {
@@ -177,7 +615,8 @@ typename Graph::PersistentVertexIndex GraphTopology::appendParticle(VertexData::
     auto itNew = _graph.addVertex(VertexData{
             newParticle,
     });
-    _graph.addEdge(counterPart, itNew);
+    _vertexForParticle[newParticle] = itNew;
+    addEdge(counterPart, itNew);
     return itNew;
 }
 
@@ -207,7 +646,14 @@ typename Graph::PersistentVertexIndex GraphTopology::appendTopology(const GraphT
         auto otherIx = otherGraph.vertices().persistentIndex(itOther);
 
         auto mapping = _graph.append(otherGraph, ix, otherIx);
+        for (std::size_t i = 0; i < mapping.size(); ++i) {
+            const auto &v = otherGraph.vertices().at(Graph::PersistentVertexIndex{i});
+            if (!v.deactivated()) {
+                _vertexForParticle[v->particleIndex] = mapping[i];
+            }
+        }
         _topology_type = newType;
+        _configured = false;
         return mapping.at(otherIx.value);
     } else {
         log::warn("encountered empty topology which was deactivated={}", other.isDeactivated());
@@ -223,15 +669,74 @@ std::vector<Particle> GraphTopology::fetchParticles() const {
 }
 
 typename Graph::VertexList::persistent_iterator GraphTopology::vertexIteratorForParticle(VertexData::ParticleIndex index) {
-    return std::find_if(_graph.vertices().begin_persistent(), _graph.vertices().end_persistent(), [index](const auto& v) {
-        return !v.deactivated() && v->particleIndex == index;
-    });
+    auto it = _vertexForParticle.find(index);
+    if (it == _vertexForParticle.end()) {
+        return _graph.vertices().end_persistent();
+    }
+    return _graph.vertices().begin_persistent() + it->second.value;
 }
 
 typename Graph::VertexList::const_persistent_iterator GraphTopology::vertexIteratorForParticle(VertexData::ParticleIndex index) const {
-    return std::find_if(_graph.vertices().begin_persistent(), _graph.vertices().end_persistent(), [index](const auto& v) {
-        return !v.deactivated() && v->particleIndex == index;
-    });
+    auto it = _vertexForParticle.find(index);
+    if (it == _vertexForParticle.end()) {
+        return _graph.vertices().end_persistent();
+    }
+    return _graph.vertices().begin_persistent() + it->second.value;
+}
+
+void GraphTopology::removeVertex(Graph::PersistentVertexIndex vertex) {
+    const auto &v = _graph.vertices().at(vertex);
+    if (v.deactivated()) {
+        throw std::invalid_argument(fmt::format("Vertex {} was already removed", vertex));
+    }
+    const auto &neighbors = v.neighbors();
+    for (auto neighbor : neighbors) {
+        markVertexChanged(neighbor);
+        // the former neighbors have to stay connected among each other
+        if (neighbor != neighbors.front()) {
+            _removedEdges.emplace_back(neighbors.front(), neighbor);
+        }
+    }
+    markVertexChanged(vertex);
+    _vertexForParticle.erase(v->particleIndex);
+    _graph.removeVertex(vertex);
+}
+
+void GraphTopology::remapParticleIndices(const std::vector<VertexData::ParticleIndex> &oldToNew) {
+    for (auto &v : _graph.vertices()) {
+        if (!v.deactivated()) {
+            v->particleIndex = oldToNew.at(v->particleIndex);
+        }
+    }
+    rebuildVertexIndex();
+    // the bonded terms refer to particle indices as well
+    for (auto &pot : bondedPotentials) {
+        if (auto harmonic = dynamic_cast<HarmonicBond *>(pot.get())) {
+            for (auto &bond : harmonic->getBonds()) {
+                bond.idx1 = oldToNew.at(bond.idx1);
+                bond.idx2 = oldToNew.at(bond.idx2);
+            }
+        }
+    }
+    for (auto &pot : anglePotentials) {
+        if (auto harmonic = dynamic_cast<HarmonicAngle *>(pot.get())) {
+            for (auto &angle : harmonic->getAngles()) {
+                angle.idx1 = oldToNew.at(angle.idx1);
+                angle.idx2 = oldToNew.at(angle.idx2);
+                angle.idx3 = oldToNew.at(angle.idx3);
+            }
+        }
+    }
+    for (auto &pot : torsionPotentials) {
+        if (auto cosine = dynamic_cast<CosineDihedral *>(pot.get())) {
+            for (auto &dih : cosine->getDihedrals()) {
+                dih.idx1 = oldToNew.at(dih.idx1);
+                dih.idx2 = oldToNew.at(dih.idx2);
+                dih.idx3 = oldToNew.at(dih.idx3);
+                dih.idx4 = oldToNew.at(dih.idx4);
+            }
+        }
+    }
 }
 
 Particle GraphTopology::particleForVertex(const Vertex &vertex) const {
@@ -246,7 +751,10 @@ ParticleTypeId GraphTopology::typeOf(Graph::PersistentVertexIndex vertex) const
 }
 
 ParticleTypeId GraphTopology::typeOf(const Vertex &v) const {
-    return particleForVertex(v).type();
+    if(!_stateModel) {
+        throw std::logic_error("Cannot fetch particle type if state model was not provided!");
+    }
+    return _stateModel->getParticleType(v->particleIndex);
 }
 
 std::vector<VertexData::ParticleIndex> GraphTopology::particleIndices() const {
@@ -51,6 +51,23 @@
 namespace readdy::model::top {
 TopologyTypeId TopologyRegistry::counter = 0;
 
+TopologyRegistry::TopologyRegistry(const TopologyRegistry &rhs)
+        : _registry(rhs._registry), _spatialReactionStorage(rhs._spatialReactionStorage), _types(rhs._types),
+          _potentialConfiguration(rhs._potentialConfiguration) {
+    updateSpatialReactionTable();
+}
+
+TopologyRegistry &TopologyRegistry::operator=(const TopologyRegistry &rhs) {
+    if (this != &rhs) {
+        _registry = rhs._registry;
+        _spatialReactionStorage = rhs._spatialReactionStorage;
+        _types = rhs._types;
+        _potentialConfiguration = rhs._potentialConfiguration;
+        updateSpatialReactionTable();
+    }
+    return *this;
+}
+
 std::string TopologyRegistry::describe() const {
     namespace rus = readdy::util::str;
     std::string description;
@@ -217,9 +234,63 @@ void TopologyRegistry::addSpatialReaction(const std::string &descriptor,
 void TopologyRegistry::addSpatialReaction(reactions::SpatialTopologyReaction &&reaction) {
     validateSpatialReaction(reaction);
     auto key = std::make_tuple(reaction.type1(), reaction.top_type1(), reaction.type2(), reaction.top_type2());
-    _spatialReactionTypes.emplace(reaction.type1());
-    _spatialReactionTypes.emplace(reaction.type2());
-    _spatialReactions[key].push_back(std::move(reaction));
+    auto it = _spatialReactions.find(key);
+    if (it != _spatialReactions.end()) {
+        // append to the reactions of the same key so that these stay contiguous
+        auto offset = (it->second.data() + it->second.size()) - std::as_const(_spatialReactionStorage).data();
+        _spatialReactionStorage.insert(_spatialReactionStorage.begin() + offset, std::move(reaction));
+    } else {
+        _spatialReactionStorage.push_back(std::move(reaction));
+    }
+    updateSpatialReactionTable();
+}
+
+void TopologyRegistry::updateSpatialReactionTable() {
+    _spatialReactions.clear();
+    _spatialParticleTypeSlots.clear();
+    _spatialTopologyTypeSlots.clear();
+
+    auto assignSlot = [](std::vector<std::uint32_t> &slots, std::size_t index, std::uint32_t &nSlots) {
+        if (index >= slots.size()) {
+            slots.resize(index + 1, noSpatialReactionSlot);
+        }
+        if (slots[index] == noSpatialReactionSlot) {
+            slots[index] = nSlots++;
+        }
+    };
+
+    std::uint32_t nParticleTypeSlots = 0;
+    // slot 0 belongs to particles without topology
+    _nSpatialTopologyTypeSlots = 1;
+    for (auto begin = _spatialReactionStorage.begin(); begin != _spatialReactionStorage.end();) {
+        const auto &reaction = *begin;
+        auto key = std::make_tuple(reaction.type1(), reaction.top_type1(), reaction.type2(), reaction.top_type2());
+        auto end = std::find_if(begin, _spatialReactionStorage.end(), [&key](const auto &other) {
+            return !detail::TopologyParticleTypeEq{}(key, std::make_tuple(other.type1(), other.top_type1(),
+                                                                          other.type2(), other.top_type2()));
+        });
+        _spatialReactions.emplace(key, SpatialReactionCollection(&*begin, static_cast<std::size_t>(end - begin)));
+
+        assignSlot(_spatialParticleTypeSlots, reaction.type1(), nParticleTypeSlots);
+        assignSlot(_spatialParticleTypeSlots, reaction.type2(), nParticleTypeSlots);
+        for (auto topologyType : {reaction.top_type1(), reaction.top_type2()}) {
+            if (topologyType != EmptyTopologyId) {
+                assignSlot(_spatialTopologyTypeSlots, static_cast<std::size_t>(topologyType),
+                           _nSpatialTopologyTypeSlots);
+            }
+        }
+        begin = end;
+    }
+
+    _nSpatialReactionKeys = nParticleTypeSlots * _nSpatialTopologyTypeSlots;
+    _spatialReactionTable.assign(static_cast<std::size_t>(_nSpatialReactionKeys) * _nSpatialReactionKeys, {});
+    for (const auto &[key, reactions] : _spatialReactions) {
+        const auto &[t1, tt1, t2, tt2] = key;
+        const auto key1 = spatialReactionKey(t1, tt1);
+        const auto key2 = spatialReactionKey(t2, tt2);
+        _spatialReactionTable[key1 * _nSpatialReactionKeys + key2] = reactions;
+        _spatialReactionTable[key2 * _nSpatialReactionKeys + key1] = reactions;
+    }
 }
 
 void TopologyRegistry::addSpatialReaction(const std::string &name, const std::string &typeFrom1,
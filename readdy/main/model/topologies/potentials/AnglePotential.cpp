@@ -84,7 +84,7 @@ void HarmonicAnglePotential::calculateForce(Vec3 &f_i, Vec3 &f_j, Vec3 &f_k, con
     const scalar inv_norm_product = 1. / norm_product;
 
     scalar cos_theta = inv_norm_product * scalarProduct;
-    cos_theta = readdy::util::numeric::clamp(cos_theta, -1., 1.);
+    cos_theta = readdy::util::numeric::clamp(cos_theta, static_cast<scalar>(-1.), static_cast<scalar>(1.));
 
     scalar sin_theta_inv = std::sqrt(1. - cos_theta * cos_theta);
     // avoid too small values of sin_theta
@@ -67,9 +67,31 @@ StructuralTopologyReaction::StructuralTopologyReaction(std::string name,  reacti
         : StructuralTopologyReaction(std::move(name), std::move(reaction_function),
                 [rate](const GraphTopology&) -> scalar { return rate; }) {}
 
-std::vector<GraphTopology> StructuralTopologyReaction::execute(GraphTopology &topology, const Kernel* const kernel) const {
+StructuralTopologyReaction::StructuralTopologyReaction(std::string name, reaction_function reaction_function,
+                                                       batch_rate_function batch_rate_function)
+        : _reaction_function(std::move(reaction_function)), _batch_rate_function(std::move(batch_rate_function)),
+          _name(std::move(name)), _id(counter++) {}
+
+std::vector<scalar> StructuralTopologyReaction::rates(const std::vector<const GraphTopology *> &topologies) const {
+    if (_batch_rate_function) {
+        auto result = _batch_rate_function(topologies);
+        if (result.size() != topologies.size()) {
+            throw std::runtime_error(fmt::format("The batch rate function of reaction {} returned {} rates for {} "
+                                                 "topologies.", _name, result.size(), topologies.size()));
+        }
+        return result;
+    }
+    std::vector<scalar> result;
+    result.reserve(topologies.size());
+    for (const auto *topology : topologies) {
+        result.push_back(_rate_function(*topology));
+    }
+    return result;
+}
+
+std::vector<GraphTopology> StructuralTopologyReaction::execute(GraphTopology &topology, const Kernel* const kernel,
+                                                               const TopologyProvider &provider) const {
     const auto &types = kernel->context().particleTypes();
-    const auto &topology_types = kernel->context().topologyRegistry();
     auto recipe = operations(topology);
     auto& steps = recipe.steps();
     if(!steps.empty()) {
@@ -88,15 +110,16 @@ std::vector<GraphTopology> StructuralTopologyReaction::execute(GraphTopology &to
         // post reaction
         if (expects_connected_after_reaction()) {
             bool valid = true;
-            if (!topology.graph().isConnected()) {
+            if (!topology.isConnectedAfterChanges()) {
                 // we expected it to be connected after the reaction.. but it is not, raise or rollback.
                 log::warn("The topology was expected to still be connected after the reaction, but it was not.");
                 valid = false;
             }
             {
-                // check if all particle types are topology flavored
-                for (const auto &v : topology.graph().vertices()) {
-                    if (types.infoOf(topology.particleForVertex(v).type()).flavor != particleflavor::TOPOLOGY) {
+                // check if all particle types are topology flavored, only vertices touched by the reaction can differ
+                for (const auto ix : topology.changedVertices()) {
+                    const auto &v = topology.vertexAt(ix);
+                    if (!v.deactivated() && types.infoOf(topology.typeOf(v)).flavor != particleflavor::TOPOLOGY) {
                         log::warn("The topology contained particles that were not topology flavored.");
                         valid = false;
                     }
@@ -107,23 +130,21 @@ std::vector<GraphTopology> StructuralTopologyReaction::execute(GraphTopology &to
                 throw TopologyReactionException(
                         "The topology was invalid after the reaction, see previous warning messages.");
             } else {
-                // if valid, update force field
-                topology.configure();
-                // and update reaction rates
-                topology.updateReactionRates(topology_types.structuralReactionsOf(topology.type()));
+                // if valid, update the force field terms affected by the reaction
+                topology.reconfigure();
+                // and flag the reaction rates to be updated before the next evaluation
+                topology.invalidateReactionRates();
             }
         } else {
-            if (!topology.graph().isConnected()) {
-                auto subTopologies = topology.connectedComponents();
-                assert(subTopologies.size() > 1 && "This should be at least 2 as the graph is not connected.");
-                return std::move(subTopologies);
-            }
+            // the largest component stays in this topology, all others are moved into new ones
+            auto subTopologies = topology.splitOffComponents(provider);
             if(!topology.isNormalParticle(*kernel)) {
-                // if valid, update force field
-                topology.configure();
-                // and update reaction rates
-                topology.updateReactionRates(topology_types.structuralReactionsOf(topology.type()));
+                // if valid, update the force field terms affected by the reaction
+                topology.reconfigure();
+                // and flag the reaction rates to be updated before the next evaluation
+                topology.invalidateReactionRates();
             }
+            return subTopologies;
         }
     }
     return {};
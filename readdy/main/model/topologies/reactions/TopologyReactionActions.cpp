@@ -54,7 +54,9 @@ TopologyReactionAction::TopologyReactionAction(GraphTopology *const topology) :
 
 ChangeParticleType::ChangeParticleType(GraphTopology *const topology, Graph::PersistentVertexIndex v,
                                        ParticleTypeId type_to)
-        : TopologyReactionAction(topology), _vertex(v), type_to(type_to), previous_type(type_to){}
+        : TopologyReactionAction(topology), _vertex(v), type_to(type_to), previous_type(type_to){
+    topology->markVertexChanged(v);
+}
 
 AddEdge::AddEdge(GraphTopology *const topology, Graph::Edge edge)
         : TopologyReactionAction(topology), label_edge_(std::move(edge)) {}
@@ -196,6 +196,19 @@ SCENARIO("Testing graphs basic functionality", "[graphs]") {
         graph.addEdge(v3, target);
 
         REQUIRE(graph.graphDistance(source, target) == 2);
+
+        WHEN("bounding the depth of the search") {
+            decltype(graph)::DistanceScratch scratch;
+            THEN("paths longer than the bound are not found and the scratch buffers can be reused") {
+                REQUIRE(graph.graphDistance(source, target, 1, scratch) == -1);
+                REQUIRE(graph.graphDistance(source, target, 2, scratch) == 2);
+                REQUIRE(graph.graphDistance(source, target, 5, scratch) == 2);
+                REQUIRE(graph.graphDistance(source, v2, 1, scratch) == -1);
+                REQUIRE(graph.graphDistance(source, v2, 2, scratch) == 2);
+                REQUIRE(graph.graphDistance(source, source, 0, scratch) == 0);
+                REQUIRE(std::none_of(scratch.visited.begin(), scratch.visited.end(), [](char c) { return c; }));
+            }
+        }
     }
 
     GIVEN("A graph with two vertices") {
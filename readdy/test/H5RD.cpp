@@ -321,3 +321,80 @@ TEST_CASE("Reading and writing of compound VLEN data set", "[vlen]") {
         REQUIRE("stuffs" == group.containedDataSets()[0]);
     }
 }
+
+TEST_CASE("Write combining of appends", "[combining]") {
+    using namespace h5rd;
+    SECTION("Regular data set") {
+        auto f = File::create("test.h5", File::Flag::OVERWRITE);
+        auto group = f->createGroup("/combined");
+        auto ds = group.createDataSet<int>("ints", {4}, {UNLIMITED_DIMS});
+        ds->setWriteCombining(4);
+        REQUIRE(ds->writeCombining() == 4);
+        for (int i = 0; i < 3; ++i) {
+            ds->append({1}, &i);
+        }
+        // nothing written yet
+        REQUIRE(ds->getFileSpace()->dims()[0] == 0);
+        {
+            int i = 3;
+            ds->append({1}, &i);
+        }
+        // a full chunk is written at once
+        REQUIRE(ds->getFileSpace()->dims()[0] == 4);
+        {
+            int i = 4;
+            ds->append({1}, &i);
+            ds->flush();
+        }
+        std::vector<int> data;
+        group.read("ints", data);
+        REQUIRE(data == std::vector<int>{0, 1, 2, 3, 4});
+    }
+    SECTION("Changing block shape") {
+        auto f = File::create("test.h5", File::Flag::OVERWRITE);
+        auto group = f->createGroup("/combined");
+        auto ds = group.createDataSet<int>("pairs", {10, 2}, {UNLIMITED_DIMS, 2});
+        ds->setWriteCombining(10);
+        std::array<int, 6> values{1, 2, 3, 4, 5, 6};
+        ds->append({1, 2}, values.data());
+        ds->append({2, 2}, values.data() + 2);
+        REQUIRE(ds->getFileSpace()->dims()[0] == 0);
+        ds->commitPending();
+        REQUIRE(ds->getFileSpace()->dims()[0] == 3);
+        std::vector<int> data;
+        group.read("pairs", data);
+        REQUIRE(data == std::vector<int>{1, 2, 3, 4, 5, 6});
+    }
+    SECTION("Pending appends are written when the file is closed") {
+        {
+            auto f = File::create("test.h5", File::Flag::OVERWRITE);
+            auto group = f->createGroup("/combined");
+            auto ds = group.createDataSet<double>("doubles", {100}, {UNLIMITED_DIMS});
+            auto vlen = group.createVLENDataSet<int>("vlen", {100}, {UNLIMITED_DIMS});
+            ds->setWriteCombining(100);
+            vlen->setWriteCombining(100);
+            for (int i = 0; i < 10; ++i) {
+                auto x = static_cast<double>(i);
+                ds->append({1}, &x);
+                std::vector<int> entry(static_cast<std::size_t>(i), i);
+                vlen->append({1}, &entry);
+            }
+            // the data sets outlive the file
+            f->close();
+        }
+        auto f = File::open("test.h5", File::Flag::READ_ONLY);
+        auto group = f->getSubgroup("/combined");
+        std::vector<double> data;
+        group.read("doubles", data);
+        REQUIRE(data.size() == 10);
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            REQUIRE(data[i] == static_cast<double>(i));
+        }
+        std::vector<std::vector<int>> vlenData;
+        group.readVLEN("vlen", vlenData);
+        REQUIRE(vlenData.size() == 10);
+        for (std::size_t i = 0; i < vlenData.size(); ++i) {
+            REQUIRE(vlenData[i] == std::vector<int>(i, static_cast<int>(i)));
+        }
+    }
+}
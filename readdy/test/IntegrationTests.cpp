@@ -794,3 +794,115 @@ TEMPLATE_TEST_CASE("Particles form complexes with predetermined number of bonds"
         REQUIRE(std::get<0>(entry.second).size() - 1 == std::get<1>(entry.second));
     }
 }
+
+TEMPLATE_TEST_CASE("Diffusion constant and RDF match analytical values", "[.integration][precision]",
+                   SingleCPU, CPU) {
+    /**
+     * Both checks compare against analytical values instead of a stored double precision trajectory, so that the
+     * same test validates a build with READDY_SINGLE_PRECISION as well as the default build.
+     */
+    auto kernel = create<TestType>();
+    auto &ctx = kernel->context();
+    readdy::scalar dt{1e-2};
+
+    SECTION("Diffusion constant") {
+        // close to the box boundary, where positions lie in the binade [32, 64) with the coarsest spacing of single
+        // precision numbers inside the box, yet about three standard deviations of the displacement away from the wall
+        readdy::scalar diffusionConstant{1.5};
+        readdy::Vec3 origin{45, 45, 45};
+        ctx.boxSize() = {{100, 100, 100}};
+        ctx.periodicBoundaryConditions() = {{false, false, false}};
+        ctx.particleTypes().add("A", diffusionConstant);
+
+        std::size_t nParticles{4000};
+        for (std::size_t i = 0; i < nParticles; ++i) {
+            kernel->addParticle("A", origin);
+        }
+
+        auto &&bd = kernel->actions().eulerBDIntegrator(dt);
+        std::size_t nSteps{100};
+        for (std::size_t t = 0; t < nSteps; ++t) {
+            bd->perform();
+        }
+
+        double msd{0.};
+        for (const auto &p : kernel->stateModel().getParticles()) {
+            msd += (p.pos() - origin).normSquared();
+        }
+        msd /= static_cast<double>(nParticles);
+
+        // <|x(t) - x(0)|^2> = 6 D t, the statistical error of the mean is below 1.5%
+        REQUIRE(msd / (6. * nSteps * dt) == Catch::Approx(diffusionConstant).epsilon(0.05));
+    }
+
+    SECTION("Radial distribution function of a dilute soft sphere gas") {
+        readdy::scalar length{10.};
+        ctx.boxSize() = {{length, length, length}};
+        ctx.periodicBoundaryConditions() = {{true, true, true}};
+        ctx.particleTypes().add("A", 1.);
+        readdy::scalar forceConstant{10.}, interactionDistance{1.};
+        ctx.potentials().addHarmonicRepulsion("A", "A", forceConstant, interactionDistance);
+
+        std::size_t nParticles{50};
+        for (std::size_t i = 0; i < nParticles; ++i) {
+            readdy::Vec3 pos{readdy::model::rnd::uniform_real() * length - 0.5 * length,
+                             readdy::model::rnd::uniform_real() * length - 0.5 * length,
+                             readdy::model::rnd::uniform_real() * length - 0.5 * length};
+            kernel->addParticle("A", pos);
+        }
+
+        std::vector<readdy::scalar> binBorders;
+        for (int i = 0; i <= 15; ++i) {
+            binBorders.push_back(static_cast<readdy::scalar>(0.1 * i));
+        }
+        std::vector<double> rdf(binBorders.size() - 1, 0.);
+        std::vector<readdy::scalar> binCenters;
+        std::size_t nFrames{0};
+        auto density = static_cast<readdy::scalar>(nParticles) / (length * length * length);
+        auto &&obs = kernel->observe().radialDistribution(5, binBorders, {"A"}, {"A"}, density);
+        obs->setCallback([&](const readdy::model::observables::RadialDistribution::result_type &result) {
+            binCenters = result.first;
+            for (std::size_t i = 0; i < rdf.size(); ++i) {
+                rdf[i] += result.second[i];
+            }
+            ++nFrames;
+        });
+
+        auto &&bd = kernel->actions().eulerBDIntegrator(dt);
+        auto &&forces = kernel->actions().calculateForces();
+        auto &&initNeighborList = kernel->actions().createNeighborList(interactionDistance);
+        auto &&neighborList = kernel->actions().updateNeighborList();
+
+        initNeighborList->perform();
+        neighborList->perform();
+        forces->perform();
+        std::size_t nEquilibrationSteps{1000};
+        for (std::size_t t = 0; t < nEquilibrationSteps; ++t) {
+            bd->perform();
+            neighborList->perform();
+            forces->perform();
+        }
+
+        auto &&connection = kernel->connectObservable(obs.get());
+        std::size_t nSteps{50000};
+        for (readdy::TimeStep t = 0; t < nSteps; ++t) {
+            bd->perform();
+            neighborList->perform();
+            forces->perform();
+            kernel->evaluateObservables(t);
+        }
+
+        // in the low density limit g(r) = exp(-U(r) / kBT), the particle density corrects this by a few percent
+        REQUIRE(nFrames == nSteps / 5);
+        for (std::size_t i = 0; i < rdf.size(); ++i) {
+            auto r = binCenters[i];
+            if (r < 0.5) {
+                continue;
+            }
+            auto overlap = std::min(r - interactionDistance, static_cast<readdy::scalar>(0.));
+            auto energy = 0.5 * forceConstant * overlap * overlap;
+            auto expected = std::exp(-energy / ctx.kBT());
+            CHECK(rdf[i] / static_cast<double>(nFrames) == Catch::Approx(expected).margin(0.1));
+        }
+    }
+}
@@ -47,6 +47,8 @@
 #include <readdy/testing/Utils.h>
 #include <readdy/testing/KernelTest.h>
 #include <readdy/model/compartments/Compartments.h>
+#include <readdy/model/compartments/CompartmentGrid.h>
+#include <readdy/model/Context.h>
 
 namespace m = readdy::model;
 using namespace readdytesting::kernel;
@@ -124,3 +126,47 @@ TEMPLATE_TEST_CASE("Test compartments.", "[compartments]", SingleCPU, CPU) {
         }
     }
 }
+
+TEST_CASE("Test compartment grid.", "[compartments]") {
+    readdy::model::Context ctx;
+    ctx.boxSize() = {{10, 10, 10}};
+    ctx.particleTypes().add("A", 1.);
+    ctx.particleTypes().add("B", 1.);
+    ctx.particleTypes().add("C", 1.);
+    using labels = m::compartments::Compartment::label_conversion_map;
+    // the label-based sphere overload converts inside of the sphere if largerOrLess is false
+    ctx.compartments().addSphere(labels{{"A", "B"}}, "sphere", readdy::Vec3(0, 0, 0), 2., false);
+    ctx.compartments().addGeometryCompartmentWithLabels(labels{{"B", "C"}}, "box",
+            readdy::model::geometry::Box<readdy::scalar>{.v0 = {1, -1, -1}, .v1 = {4, 1, 1}}, true);
+    ctx.compartments().addCapsule(labels{{"A", "C"}}, "capsule", readdy::Vec3(0, 3, 0), readdy::Vec3(0, 0, 1),
+                                  4., 1., true);
+    ctx.compartments().addPlane(labels{{"C", "A"}}, "plane", readdy::Vec3(1, 0, 0), 4.5, true);
+
+    m::compartments::CompartmentGrid grid(ctx.compartments(), ctx.particleTypes(), ctx.boxSize(), 32);
+    REQUIRE(grid.upToDate(ctx.compartments(), ctx.particleTypes(), ctx.boxSize()));
+    REQUIRE(grid.voxelState(readdy::Vec3(0, 0, 0)) == 0);
+    REQUIRE(grid.voxelState(readdy::Vec3(-4.9, -4.9, -4.9)) == m::compartments::CompartmentGrid::outside);
+    REQUIRE(grid.voxelState(readdy::Vec3(4.9, 0, 0)) == 3);
+
+    const auto &compartments = ctx.compartments().get();
+    for (int i = 0; i < 10000; ++i) {
+        readdy::Vec3 pos{readdy::model::rnd::uniform_real<readdy::scalar>(-5, 5),
+                         readdy::model::rnd::uniform_real<readdy::scalar>(-5, 5),
+                         readdy::model::rnd::uniform_real<readdy::scalar>(-5, 5)};
+        for (readdy::ParticleTypeId type = 0; type < 3; ++type) {
+            auto expected = type;
+            for (const auto &compartment : compartments) {
+                if (compartment->isContained(pos)) {
+                    const auto it = compartment->getConversions().find(expected);
+                    if (it != compartment->getConversions().end()) {
+                        expected = it->second;
+                    }
+                }
+            }
+            REQUIRE(grid.convert(pos, type) == expected);
+        }
+    }
+
+    ctx.particleTypes().add("D", 1.);
+    REQUIRE_FALSE(grid.upToDate(ctx.compartments(), ctx.particleTypes(), ctx.boxSize()));
+}
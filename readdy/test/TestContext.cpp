@@ -216,6 +216,40 @@ TEST_CASE("Test context.", "[context]") {
             CHECK(reaction.allow_self_connection());
             CHECK(reaction.mode() == readdy::model::top::reactions::STRMode::TT_FUSION_ALLOW_SELF);
         }
+        SECTION("Lookup by types") {
+            auto check = [](const auto &registry) {
+                const auto &types = registry.particleTypeRegistry();
+                auto tt = registry.idOf("T");
+                auto ab = registry.spatialReactionsByType(types.idOf("A"), tt, types.idOf("B"), tt);
+                REQUIRE(ab.size() == 3);
+                CHECK(ab[0].name() == "MyFusionReaction");
+                CHECK(ab[1].name() == "MySelfFusionReaction");
+                CHECK(ab[2].name() == "MyEnzymaticTT");
+                auto ba = registry.spatialReactionsByType(types.idOf("B"), tt, types.idOf("A"), tt);
+                REQUIRE(ba.size() == 3);
+                CHECK(ba.data() == ab.data());
+
+                auto ap = registry.spatialReactionsByType(types.idOf("A"), tt, types.idOf("P"), readdy::EmptyTopologyId);
+                REQUIRE(ap.size() == 2);
+                CHECK(ap[0].name() == "MyTPFusion");
+                CHECK(ap[1].name() == "MyEnzymaticTP");
+                CHECK(registry.spatialReactionsByType(types.idOf("P"), readdy::EmptyTopologyId,
+                                                      types.idOf("A"), tt).size() == 2);
+
+                CHECK(registry.spatialReactionsByType(types.idOf("A"), registry.idOf("TT"),
+                                                      types.idOf("B"), tt).empty());
+                CHECK(registry.spatialReactionsByType(types.idOf("A"), tt, types.idOf("A"), tt).empty());
+                CHECK(registry.spatialReactionsByType(types.idOf("A"), readdy::EmptyTopologyId,
+                                                      types.idOf("P"), readdy::EmptyTopologyId).empty());
+                CHECK(registry.spatialReactionsByType(types.idOf("C"), tt, types.idOf("Q"), tt).empty());
+            };
+            check(topologies);
+            // the lookup table of a copy refers to the reactions of the copy
+            Context copy(context);
+            check(copy.topologyRegistry());
+            CHECK(copy.topologyRegistry().spatialReactionsByType("A", "T", "B", "T").data()
+                  != topologies.spatialReactionsByType("A", "T", "B", "T").data());
+        }
     }
     SECTION("Reactions") {
         context.particleTypes().add("A", 1.);
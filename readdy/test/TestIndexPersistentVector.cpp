@@ -153,4 +153,34 @@ TEMPLATE_TEST_CASE("Test the index persistent vector class.", "[index-persistent
         REQUIRE(vec.n_deactivated() == 0);
         REQUIRE_FALSE(vec.begin()->deactivated);
     }
+
+    SECTION("Compaction") {
+        for (int i = 0; i < 6; ++i) {
+            vec.emplace_back(i, false);
+        }
+        vec.erase(vec.begin() + 1);
+        vec.erase(vec.begin() + 4);
+        REQUIRE(vec.next_blank() == &vec.at(4));
+
+        std::vector<int> removed;
+        auto mapping = vec.compact([&removed](Element &&element) {
+            CHECK(element.deactivated);
+            removed.push_back(element.val);
+        });
+
+        REQUIRE(vec.size() == 4);
+        REQUIRE(vec.n_deactivated() == 0);
+        REQUIRE(vec.next_blank() == nullptr);
+        REQUIRE(removed == std::vector<int>{1, 4});
+        REQUIRE(mapping == std::vector<std::ptrdiff_t>{0, -1, 1, 2, -1, 3});
+        for (std::size_t i = 0; i < mapping.size(); ++i) {
+            if (mapping[i] >= 0) {
+                CHECK(vec.at(static_cast<std::size_t>(mapping[i])).val == static_cast<int>(i));
+                CHECK_FALSE(vec.at(static_cast<std::size_t>(mapping[i])).deactivated);
+            }
+        }
+
+        vec.push_back({});
+        REQUIRE(vec.size() == 5);
+    }
 }
@@ -44,9 +44,13 @@
  * @date 27.06.16
  */
 
+#include <optional>
+#include <random>
+
 #include <catch2/catch_template_test_macros.hpp>
 #include <catch2/catch_approx.hpp>
 
+#include <readdy/model/potentials/PotentialGrid.h>
 #include <readdy/plugin/KernelProvider.h>
 #include <readdy/testing/KernelTest.h>
 #include <readdy/testing/Utils.h>
@@ -503,5 +507,395 @@ TEMPLATE_TEST_CASE("Test potentials", "[potentials]", SingleCPU, CPU) {
             readdy::testing::vec3eq(collectedForces[id0Idx], forceOnParticle0, 1e-8);
             readdy::testing::vec3eq(collectedForces[id1Idx], forceOnParticle1, 1e-8);
         }
+        SECTION("Tabulated") {
+            // same setup as the Lennard-Jones section, with the potential given as table
+            auto calculateForces = kernel->actions().calculateForces();
+            context.particleTypes().add("A", 1.0);
+            context.boxSize() = {{10, 10, 10}};
+            auto id0 = kernel->addParticle("A", {0, 0, 0});
+            auto id1 = kernel->addParticle("A", {0, 0, .09});
+            auto id2 = kernel->addParticle("A", {2, 0, 0});
+            auto id3 = kernel->addParticle("A", {2, 0, .09});
+
+            readdy::model::potentials::LennardJones lj(0, 0, 3, 2, 1.0, false, 1.0, .1);
+            std::vector<readdy::scalar> distances, energies, forces;
+            for (int i = 0; i <= 4000; ++i) {
+                const readdy::scalar r = .05 + i * (1. - .05) / 4000.;
+                readdy::Vec3 x{0, 0, r};
+                readdy::Vec3 f{0, 0, 0};
+                lj.calculateForce(f, x);
+                distances.push_back(r);
+                energies.push_back(lj.calculateEnergy(x));
+                // the force on the first particle points along -x for a repulsive potential
+                forces.push_back(-f.z);
+            }
+            context.potentials().addTabulated("A", "A", distances, energies, forces);
+
+            auto pObs = kernel->observe().particles(1);
+            std::vector<readdy::ParticleId> ids;
+            pObs->setCallback([&ids](const readdy::model::observables::Particles::result_type &result) {
+                const auto &recordedIds = std::get<1>(result);
+                ids.insert(ids.end(), recordedIds.begin(), recordedIds.end());
+            });
+            auto connParticles = kernel->connectObservable(pObs.get());
+            auto fObs = kernel->observe().forces(1);
+            std::vector<readdy::Vec3> collectedForces;
+            fObs->setCallback([&collectedForces](const readdy::model::observables::Forces::result_type &result) {
+                collectedForces.insert(collectedForces.end(), result.begin(), result.end());
+            });
+            auto conn = kernel->connectObservable(fObs.get());
+
+            auto initNeighborList = kernel->actions().createNeighborList(context.calculateMaxCutoff());
+            initNeighborList->perform();
+            auto updateNeighborList = kernel->actions().updateNeighborList();
+            updateNeighborList->perform();
+            calculateForces->perform();
+            kernel->evaluateObservables(1);
+
+            REQUIRE(stateModel.energy() == Catch::Approx(2.0 * 0.925925925926).epsilon(1e-4));
+            readdy::Vec3 forceOnParticle0{0, 0, static_cast<readdy::scalar>(-123.45679012)};
+            for (auto [id, sign] : {std::make_tuple(id0, 1), std::make_tuple(id1, -1),
+                                    std::make_tuple(id2, 1), std::make_tuple(id3, -1)}) {
+                auto idx = std::find(ids.begin(), ids.end(), id) - ids.begin();
+                readdy::testing::vec3eq(collectedForces[idx], static_cast<readdy::scalar>(sign) * forceOnParticle0,
+                                        1e-2);
+            }
+        }
+    }
+}
+
+TEST_CASE("Tabulated potential", "[potentials]") {
+    using TabulatedPotential = readdy::model::potentials::TabulatedPotential;
+    // 12-6 Lennard-Jones with epsilon = 1, sigma = 1, and cutoff 2.5 as reference
+    readdy::model::potentials::LennardJones lj(0, 0, 12, 6, 2.5, true, 1., 1.);
+    auto tabulate = [&lj](std::size_t n) {
+        std::vector<readdy::scalar> distances, energies, forces;
+        for (std::size_t i = 0; i < n; ++i) {
+            const readdy::scalar r = .8 + static_cast<readdy::scalar>(i) * (2.5 - .8) / static_cast<readdy::scalar>(n - 1);
+            readdy::Vec3 x{r, 0, 0};
+            readdy::Vec3 f{0, 0, 0};
+            lj.calculateForce(f, x);
+            distances.push_back(r);
+            energies.push_back(lj.calculateEnergy(x));
+            forces.push_back(-f.x);
+        }
+        return std::make_tuple(distances, energies, forces);
+    };
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<readdy::scalar> direction(-1, 1);
+    std::uniform_real_distribution<readdy::scalar> distance(.85, 2.45);
+    std::vector<readdy::Vec3> separations;
+    for (int i = 0; i < 1000; ++i) {
+        readdy::Vec3 x{direction(rng), direction(rng), direction(rng)};
+        separations.push_back(distance(rng) / x.norm() * x);
+    }
+
+    SECTION("Accuracy against Lennard-Jones") {
+        auto [distances, energies, forces] = tabulate(2000);
+        TabulatedPotential cubic(0, 0, distances, energies, forces, TabulatedPotential::Interpolation::CubicSpline);
+        TabulatedPotential linear(0, 0, distances, energies, forces, TabulatedPotential::Interpolation::Linear);
+        REQUIRE(cubic.getCutoffRadius() == Catch::Approx(2.5));
+        for (const auto &x : separations) {
+            readdy::Vec3 fRef{0, 0, 0}, fCubic{0, 0, 0}, fLinear{0, 0, 0};
+            lj.calculateForce(fRef, x);
+            cubic.calculateForce(fCubic, x);
+            linear.calculateForce(fLinear, x);
+            const auto eRef = lj.calculateEnergy(x);
+            REQUIRE(cubic.calculateEnergy(x) == Catch::Approx(eRef).margin(1e-6));
+            REQUIRE(linear.calculateEnergy(x) == Catch::Approx(eRef).margin(1e-3));
+            REQUIRE((fCubic - fRef).norm() < 1e-4 * std::max(static_cast<readdy::scalar>(1), fRef.norm()));
+            REQUIRE((fLinear - fRef).norm() < 1e-2 * std::max(static_cast<readdy::scalar>(1), fRef.norm()));
+        }
+    }
+
+    SECTION("Beyond the grid") {
+        auto [distances, energies, forces] = tabulate(100);
+        TabulatedPotential potential(0, 0, distances, energies, forces);
+        readdy::Vec3 force{0, 0, 0};
+        potential.calculateForce(force, {2.6, 0, 0});
+        REQUIRE(potential.calculateEnergy({2.6, 0, 0}) == 0);
+        REQUIRE(force == readdy::Vec3(0, 0, 0));
+        // continued constantly below the first grid point
+        REQUIRE(potential.calculateEnergy({.5, 0, 0}) == Catch::Approx(energies.front()));
+    }
+
+    SECTION("Invalid tables") {
+        std::vector<readdy::scalar> distances{1., 2., 3.}, values{1., 1., 1.};
+        REQUIRE_THROWS_AS(TabulatedPotential(0, 0, {1.}, {1.}, {1.}), std::invalid_argument);
+        REQUIRE_THROWS_AS(TabulatedPotential(0, 0, distances, {1., 1.}, values), std::invalid_argument);
+        REQUIRE_THROWS_AS(TabulatedPotential(0, 0, {1., 3., 2.}, values, values), std::invalid_argument);
+        REQUIRE_THROWS_AS(TabulatedPotential(0, 0, {-1., 1., 2.}, values, values), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Potential grid", "[potentials]") {
+    using PotentialGrid = readdy::model::potentials::PotentialGrid;
+    readdy::model::Context context;
+    context.particleTypes().add("A", 1.);
+    context.particleTypes().add("B", 1.);
+    context.boxSize() = {{10, 10, 10}};
+    context.periodicBoundaryConditions() = {{false, false, false}};
+    context.potentials().addSphericalBarrier("A", 1., 1., {1, 0, 0}, 2.);
+    context.potentials().addCylinder("A", 1., {0, 0, 0}, {0, 0, 1}, 3., true);
+    context.potentials().addBox("A", 1., {-4, -4, -4}, {8, 8, 8});
+    const auto &pot1 = context.potentials().potentialsOrder1();
+    auto typeA = context.particleTypes().idOf("A");
+    auto typeB = context.particleTypes().idOf("B");
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<readdy::scalar> coordinate(-5, 5);
+
+    SECTION("Interpolation against exact evaluation") {
+        PotentialGrid grid(pot1, context.boxSize(), .05);
+        REQUIRE(grid.nCells() == std::array<std::size_t, 3>{200, 200, 200});
+        for (int i = 0; i < 1000; ++i) {
+            readdy::Vec3 pos{coordinate(rng), coordinate(rng), coordinate(rng)};
+            readdy::Vec3 exactForce{0, 0, 0}, gridForce{0, 0, 0};
+            readdy::scalar exactEnergy{0}, gridEnergy{0};
+            for (const auto *potential : pot1.at(typeA)) {
+                potential->calculateForceAndEnergy(exactForce, exactEnergy, pos);
+            }
+            REQUIRE(grid.calculateForceAndEnergy(typeA, pos, gridForce, gridEnergy));
+            REQUIRE(gridEnergy == Catch::Approx(exactEnergy).margin(1e-2));
+            REQUIRE((gridForce - exactForce).norm() < 5e-2);
+        }
+    }
+
+    SECTION("Types without potentials and positions outside of the box") {
+        PotentialGrid grid(pot1, context.boxSize(), .5);
+        readdy::Vec3 force{0, 0, 0};
+        readdy::scalar energy{0};
+        REQUIRE(grid.calculateForceAndEnergy(typeB, {1, 1, 1}, force, energy));
+        REQUIRE(force == readdy::Vec3(0, 0, 0));
+        REQUIRE(energy == 0);
+        REQUIRE_FALSE(grid.calculateForceAndEnergy(typeA, {0, 0, 5.5}, force, energy));
+        REQUIRE(grid.calculateForceAndEnergy(typeA, {0, 0, 5.}, force, energy));
+    }
+
+    SECTION("Reuse") {
+        PotentialGrid grid(pot1, context.boxSize(), .5);
+        REQUIRE(grid.upToDate(pot1, context.boxSize(), .5));
+        REQUIRE_FALSE(grid.upToDate(pot1, context.boxSize(), .25));
+        REQUIRE_FALSE(grid.upToDate(pot1, {{10, 10, 11}}, .5));
+        context.potentials().addBox("B", 1., {-4, -4, -4}, {8, 8, 8});
+        REQUIRE_FALSE(grid.upToDate(context.potentials().potentialsOrder1(), context.boxSize(), .5));
+        REQUIRE_THROWS_AS(PotentialGrid(pot1, context.boxSize(), 0), std::invalid_argument);
+    }
+
+    SECTION("Potentials changed in place") {
+        using Box = readdy::model::potentials::Box<true>;
+        std::optional<Box> box;
+        box.emplace(typeA, 1., readdy::model::geometry::Box<readdy::scalar>{{-4, -4, -4}, {4, 4, 4}});
+        readdy::model::potentials::PotentialRegistry::PotentialsO1Map potentials{{typeA, {&*box}}};
+        PotentialGrid grid(potentials, context.boxSize(), .5);
+        REQUIRE(grid.upToDate(potentials, context.boxSize(), .5));
+        // same address, different parameters
+        box.emplace(typeA, 2., readdy::model::geometry::Box<readdy::scalar>{{-4, -4, -4}, {4, 4, 4}});
+        REQUIRE_FALSE(grid.upToDate(potentials, context.boxSize(), .5));
+    }
+
+    SECTION("User defined potentials are evaluated exactly") {
+        // depends on more than the position and must not be tabulated
+        struct Counting : public readdy::model::potentials::PotentialOrder1 {
+            explicit Counting(readdy::ParticleTypeId type) : PotentialOrder1(type) {}
+
+            readdy::scalar calculateEnergy(const readdy::Vec3 &) const override { return ++calls; }
+
+            void calculateForce(readdy::Vec3 &, const readdy::Vec3 &) const override {}
+
+            std::string describe() const override { return "counting"; }
+
+            std::string type() const override { return "Counting"; }
+
+            mutable int calls{0};
+        } counting(typeA);
+        auto potentials = pot1;
+        potentials[typeA].push_back(&counting);
+        PotentialGrid grid(potentials, context.boxSize(), .5);
+        REQUIRE(counting.calls == 0);
+        REQUIRE(grid.exactPotentials(typeA) == readdy::model::potentials::PotentialRegistry::PotentialsO1Collection{
+                &counting});
+        REQUIRE(grid.exactPotentials(typeB).empty());
+        REQUIRE_FALSE(PotentialGrid::parametersOf(counting).has_value());
+        REQUIRE(PotentialGrid::parametersOf(*pot1.at(typeA).front()).has_value());
+    }
+
+    SECTION("Maximal number of nodes") {
+        REQUIRE_THROWS_AS(PotentialGrid(pot1, {{1000, 1000, 1000}}, .1), std::invalid_argument);
+        REQUIRE_THROWS_AS(PotentialGrid(pot1, context.boxSize(), 1e-30), std::invalid_argument);
+    }
+
+    SECTION("CPU kernel") {
+        auto kernel = readdy::plugin::KernelProvider::getInstance().create("CPU");
+        auto &ctx = kernel->context();
+        ctx.particleTypes().add("A", 1.);
+        ctx.boxSize() = {{10, 10, 10}};
+        ctx.periodicBoundaryConditions() = {{false, false, false}};
+        ctx.potentials().addSphericalBarrier("A", 1., 1., {1, 0, 0}, 2.);
+        ctx.potentials().addBox("A", 1., {-4, -4, -4}, {8, 8, 8});
+        std::vector<readdy::Vec3> positions;
+        for (int i = 0; i < 100; ++i) {
+            positions.emplace_back(coordinate(rng), coordinate(rng), coordinate(rng));
+        }
+        // one particle outside of the box is evaluated exactly
+        positions.emplace_back(0, 0, 6);
+        for (const auto &pos : positions) {
+            kernel->addParticle("A", pos);
+        }
+        auto forces = kernel->actions().calculateForces();
+        forces->perform();
+        const auto exactEnergy = kernel->stateModel().energy();
+        ctx.kernelConfiguration().cpu.externalPotentials.grid_spacing = .05;
+        forces->perform();
+        REQUIRE(kernel->stateModel().energy() == Catch::Approx(exactEnergy).epsilon(1e-2));
+        ctx.kernelConfiguration().cpu.externalPotentials.grid_spacing = 0;
+        forces->perform();
+        REQUIRE(kernel->stateModel().energy() == Catch::Approx(exactEnergy));
+    }
+}
+
+TEST_CASE("Fused force and energy evaluation", "[potentials]") {
+    readdy::model::Context context;
+    context.particleTypes().add("A", 1.);
+    context.particleTypes().add("B", 1.);
+    auto &potentials = context.potentials();
+    potentials.addBox("A", 2., {-2, -2, -2}, {4, 4, 4});
+    potentials.addSphere("A", 1.5, {0, 0, 0}, 2.5, true);
+    potentials.addSphere("A", 1.5, {1, 0, 0}, 1., false);
+    potentials.addCapsule("A", 1., {0, 0, 0}, {0, 0, 1}, 2., 1.);
+    potentials.addSphericalBarrier("A", 1., 1., {0, 0, 0}, 1.5);
+    potentials.addSphericalBarrier("A", -1., .5, {1, 1, 0}, 1.);
+    potentials.addCylinder("A", 1., {0, 0, 0}, {1, 1, 0}, 1.5, true);
+    potentials.addCylinder("A", 1., {0, 0, 0}, {0, 1, 0}, 1., false);
+    potentials.addHarmonicRepulsion("A", "A", 2., 1.5);
+    potentials.addWeakInteractionPiecewiseHarmonic("A", "B", 10., 1., 2., 2.5);
+    potentials.addLennardJones("B", "B", 12, 6, 2.5, true, 1., 1.);
+    potentials.addLennardJones("A", "B", 9, 3, 2., false, 1.5, .8);
+    potentials.addScreenedElectrostatics("A", "A", -1., 1., 1., 1., 6, 3.);
+    potentials.addTabulated("B", "B", {.5, 1., 1.5, 2.}, {3., 1., .5, 0.}, {4., 2., .5, 0.});
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<readdy::scalar> coordinate(-3, 3);
+    std::vector<readdy::Vec3> positions;
+    for (int i = 0; i < 1000; ++i) {
+        positions.emplace_back(coordinate(rng), coordinate(rng), coordinate(rng));
+    }
+    auto approxEqual = [](readdy::scalar a, readdy::scalar b) {
+        return a == Catch::Approx(b).epsilon(1e-5).margin(1e-8);
+    };
+
+    SECTION("First order potentials") {
+        for (const auto &[type, pots] : potentials.potentialsOrder1()) {
+            for (const auto *potential : pots) {
+                for (const auto &position : positions) {
+                    readdy::Vec3 force{0, 0, 0}, fusedForce{1, 2, 3};
+                    readdy::scalar fusedEnergy{1};
+                    potential->calculateForce(force, position);
+                    const auto energy = potential->calculateEnergy(position);
+                    potential->calculateForceAndEnergy(fusedForce, fusedEnergy, position);
+                    REQUIRE(approxEqual(fusedEnergy - 1, energy));
+                    REQUIRE(approxEqual(fusedForce.x - 1, force.x));
+                    REQUIRE(approxEqual(fusedForce.y - 2, force.y));
+                    REQUIRE(approxEqual(fusedForce.z - 3, force.z));
+                }
+            }
+        }
+    }
+
+    SECTION("Second order potentials") {
+        for (const auto &[types, pots] : potentials.potentialsOrder2()) {
+            for (const auto *potential : pots) {
+                for (const auto &x_ij : positions) {
+                    if (x_ij.norm() < .3) continue;
+                    readdy::Vec3 force{0, 0, 0}, fusedForce{1, 2, 3};
+                    readdy::scalar fusedEnergy{1};
+                    potential->calculateForce(force, x_ij);
+                    const auto energy = potential->calculateEnergy(x_ij);
+                    potential->calculateForceAndEnergy(fusedForce, fusedEnergy, x_ij);
+                    REQUIRE(approxEqual(fusedEnergy - 1, energy));
+                    REQUIRE(approxEqual(fusedForce.x - 1, force.x));
+                    REQUIRE(approxEqual(fusedForce.y - 2, force.y));
+                    REQUIRE(approxEqual(fusedForce.z - 3, force.z));
+                }
+            }
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Evaluation modes of the force action", "[potentials]", SingleCPU, CPU) {
+    using Mode = readdy::model::actions::CalculateForces::Mode;
+    auto kernel = create<TestType>();
+    auto &context = kernel->context();
+    context.particleTypes().add("A", 1.);
+    context.particleTypes().add("T", 1., readdy::model::particleflavor::TOPOLOGY);
+    context.boxSize() = {{10, 10, 10}};
+    context.periodicBoundaryConditions() = {{false, false, false}};
+    context.potentials().addBox("A", 1., {-3, -3, -3}, {6, 6, 6});
+    context.potentials().addHarmonicRepulsion("A", "A", 1., 1.5);
+    context.potentials().addHarmonicRepulsion("A", "T", 1., 1.5);
+
+    // the bonds refer to the first two particles
+    auto top = kernel->stateModel().addTopology(0, {
+            readdy::model::Particle{0, 0, 0, context.particleTypes().idOf("T")},
+            readdy::model::Particle{1.5, 0, 0, context.particleTypes().idOf("T")}
+    });
+    {
+        readdy::model::top::pot::HarmonicBondPotential::bond_configurations bonds;
+        bonds.emplace_back(0, 1, 10.0, 1.0);
+        top->template addBondedPotential<readdy::model::top::pot::HarmonicBondPotential>(bonds);
+    }
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<readdy::scalar> coordinate(-4.5, 4.5);
+    for (int i = 0; i < 50; ++i) {
+        kernel->addParticle("A", {coordinate(rng), coordinate(rng), coordinate(rng)});
+    }
+    kernel->actions().createNeighborList(context.calculateMaxCutoff())->perform();
+    kernel->actions().updateNeighborList()->perform();
+
+    auto forces = [&]() {
+        std::vector<readdy::Vec3> result;
+        kernel->stateModel().forEachParticle([&](auto, auto, const auto &, const auto &force) {
+            result.push_back(force);
+        });
+        return result;
+    };
+
+    auto calculateForces = kernel->actions().calculateForces();
+    REQUIRE(calculateForces->mode() == Mode::forcesAndEnergy);
+    calculateForces->perform();
+    const auto referenceEnergy = kernel->stateModel().energy();
+    const auto referenceForces = forces();
+    REQUIRE(referenceEnergy > 0);
+
+    SECTION("Forces only") {
+        kernel->stateModel().energy() = -1;
+        calculateForces->mode() = Mode::forces;
+        calculateForces->perform();
+        REQUIRE(kernel->stateModel().energy() == -1);
+        const auto currentForces = forces();
+        REQUIRE(currentForces.size() == referenceForces.size());
+        for (std::size_t i = 0; i < currentForces.size(); ++i) {
+            REQUIRE(readdy::testing::vec3eq(currentForces[i], referenceForces[i], 1e-6));
+        }
+    }
+
+    SECTION("Energy only") {
+        kernel->stateModel().updateParticlePositions([](auto, auto, auto &position) {
+            position *= .9;
+        });
+        kernel->actions().updateNeighborList()->perform();
+        calculateForces->mode() = Mode::energy;
+        calculateForces->perform();
+        REQUIRE(kernel->stateModel().energy() != Catch::Approx(referenceEnergy));
+        const auto energy = kernel->stateModel().energy();
+        // the forces still belong to the previous configuration
+        const auto currentForces = forces();
+        REQUIRE(currentForces.size() == referenceForces.size());
+        for (std::size_t i = 0; i < currentForces.size(); ++i) {
+            REQUIRE(currentForces[i] == referenceForces[i]);
+        }
+        calculateForces->mode() = Mode::forcesAndEnergy;
+        calculateForces->perform();
+        REQUIRE(kernel->stateModel().energy() == Catch::Approx(energy));
     }
 }
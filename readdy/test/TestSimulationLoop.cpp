@@ -41,7 +41,11 @@
  */
 
 
+#include <map>
+#include <algorithm>
+
 #include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
 
 #include <readdy/testing/KernelTest.h>
 #include <readdy/testing/Utils.h>
@@ -116,4 +120,150 @@ TEMPLATE_TEST_CASE("Test simulation loop", "[loop]", SingleCPU, CPU) {
         loop.neighborListCutoff() += 0.1; // adding a skin/padding
         loop.run(10);
     }
+    SECTION("Energy computation") {
+        readdy::model::Context ctx;
+        ctx.particleTypes().add("A", 1.);
+        ctx.boxSize() = {{10., 10., 10.}};
+        ctx.potentials().addBox("A", 1., {-1, -1, -1}, {2, 2, 2});
+        readdy::Simulation simulation {create<TestType>(), ctx};
+        for (int i = 0; i < 10; ++i) {
+            simulation.addParticle("A", 3., 3., 3.);
+        }
+        std::vector<readdy::scalar> observed;
+        auto observable = simulation.observe().energy(3, [&observed](readdy::scalar e) {
+            observed.push_back(e);
+        });
+        auto loop = simulation.createLoop(.01);
+        std::vector<readdy::scalar> energies;
+        loop.addCallback([&energies, &loop](readdy::TimeStep) {
+            energies.push_back(loop.kernel()->stateModel().energy());
+        });
+        SECTION("In every step by default") {
+            loop.run(10);
+            REQUIRE(energies.size() == 11);
+            REQUIRE(energies[0] > 0);
+            for (std::size_t t = 1; t < energies.size(); ++t) {
+                REQUIRE(energies[t] != energies[t - 1]);
+            }
+        }
+        SECTION("Only when a connected observable reads it") {
+            // the observable is merely connected, not registered with the simulation
+            auto connection = loop.kernel()->connectObservable(observable.get());
+            loop.skipUnobservedEnergies(true);
+            loop.run(10);
+            REQUIRE(energies.size() == 11);
+            REQUIRE(observed.size() == 4);
+            REQUIRE(observed[0] > 0);
+            for (std::size_t t = 0; t < energies.size(); ++t) {
+                // in between, the energy of the last evaluation is kept
+                REQUIRE(energies[t] == observed[t / 3]);
+            }
+            REQUIRE(observed[1] != observed[0]);
+            connection.disconnect();
+            REQUIRE_FALSE(loop.kernel()->energyRequired(0));
+        }
+    }
+    SECTION("Compiled loop") {
+        /**
+         * The random number generators cannot be seeded, so all diffusion constants are zero and the reactions happen
+         * with probability one on disjoint pairs. This makes the trajectory deterministic, while the fusions still
+         * move particles and the forces, energy and virial are evaluated on an interacting configuration. The order
+         * in which the schedulers perform the events is random, so particles are compared sorted by position and
+         * sums over particles only agree up to rounding once reactions reorder the particle storage.
+         */
+        struct Outcome {
+            std::vector<std::tuple<readdy::scalar, readdy::scalar, readdy::scalar, readdy::ParticleTypeId>> particles;
+            std::map<readdy::ReactionId, std::size_t> reactionCounts;
+            std::vector<readdy::scalar> energies;
+            std::vector<readdy::Matrix33> virials;
+        };
+        auto simulate = [](bool compiled, const std::string &scheduler, bool withReactions) {
+            readdy::model::Context ctx;
+            ctx.particleTypes().add("A", 0.);
+            ctx.particleTypes().add("B", 0.);
+            ctx.particleTypes().add("C", 0.);
+            ctx.boxSize() = {{20., 20., 20.}};
+            ctx.periodicBoundaryConditions() = {{true, true, true}};
+            ctx.potentials().addHarmonicRepulsion("C", "C", 10., 1.5);
+            ctx.potentials().addHarmonicRepulsion("A", "B", 10., 1.5);
+            if (withReactions) {
+                ctx.reactions().add("fusion: A +(.2) B -> C", 1e8);
+            }
+            ctx.recordReactionCounts() = true;
+            ctx.recordReactionsWithPositions() = scheduler == "UncontrolledApproximation";
+            ctx.recordVirial() = true;
+            readdy::Simulation simulation {create<TestType>(), ctx};
+            for (int i = 0; i < 10; ++i) {
+                simulation.addParticle("A", static_cast<readdy::scalar>(i - 5), .5, 0.);
+                simulation.addParticle("B", static_cast<readdy::scalar>(i - 5) + .1, .5, 0.);
+            }
+            Outcome outcome;
+            auto countsHandle = simulation.registerObservable(simulation.observe().reactionCounts(
+                    1, [&outcome](const readdy::model::observables::ReactionCounts::result_type &result) {
+                        for (const auto &[id, count] : std::get<0>(result)) {
+                            outcome.reactionCounts[id] += count;
+                        }
+                    }));
+            auto virialHandle = simulation.registerObservable(simulation.observe().virial(
+                    1, [&outcome](const readdy::Matrix33 &result) { outcome.virials.push_back(result); }));
+            auto loop = simulation.createLoop(.001);
+            loop.useReactionScheduler(scheduler);
+            loop.useCompiledLoop(compiled);
+            loop.addCallback([&outcome, &loop](readdy::TimeStep) {
+                outcome.energies.push_back(loop.kernel()->stateModel().energy());
+            });
+            loop.run(5);
+            for (const auto &p : loop.kernel()->stateModel().getParticles()) {
+                outcome.particles.emplace_back(p.pos().x, p.pos().y, p.pos().z, p.type());
+            }
+            std::sort(outcome.particles.begin(), outcome.particles.end());
+            return outcome;
+        };
+        for (const auto &[scheduler, withReactions] : std::vector<std::tuple<std::string, bool>>{
+                {"Gillespie", true}, {"UncontrolledApproximation", true}, {"Gillespie", false}}) {
+            INFO("Reaction scheduler " << scheduler << ", reactions " << withReactions);
+            auto regular = simulate(false, scheduler, withReactions);
+            auto compiled = simulate(true, scheduler, withReactions);
+            REQUIRE(compiled.particles == regular.particles);
+            REQUIRE(compiled.reactionCounts == regular.reactionCounts);
+            REQUIRE(compiled.energies.size() == regular.energies.size());
+            REQUIRE(compiled.virials.size() == regular.virials.size());
+            if (!withReactions) {
+                REQUIRE(compiled.energies == regular.energies);
+                REQUIRE(compiled.virials == regular.virials);
+            }
+            for (std::size_t t = 0; t < regular.energies.size(); ++t) {
+                REQUIRE(compiled.energies[t] == Catch::Approx(regular.energies[t]));
+                for (std::size_t i = 0; i < 3; ++i) {
+                    for (std::size_t j = 0; j < 3; ++j) {
+                        REQUIRE(compiled.virials[t].at(i, j) == Catch::Approx(regular.virials[t].at(i, j)));
+                    }
+                }
+            }
+            REQUIRE(regular.energies.size() == 6);
+            REQUIRE(regular.energies.back() > 0);
+            REQUIRE(regular.virials.back().at(0, 0) != 0);
+            std::size_t nReactions{0};
+            for (const auto &[id, count] : regular.reactionCounts) {
+                nReactions += count;
+            }
+            REQUIRE(nReactions == (withReactions ? 10 : 0));
+            REQUIRE(regular.particles.size() == (withReactions ? 10 : 20));
+        }
+
+        readdy::model::Context ctx;
+        ctx.particleTypes().add("A", 1.);
+        ctx.reactions().add("conversion: A -> A", 1.);
+        readdy::Simulation simulation {create<TestType>(), ctx};
+        auto loop = simulation.createLoop(.001);
+        auto *kernel = loop.kernel();
+        auto &&integrator = kernel->actions().eulerBDIntegrator(.001);
+        auto &&reactions = kernel->actions().gillespie(.001);
+        auto &&forces = kernel->actions().calculateForces();
+        auto compiledStep = kernel->actions().compiledStep(integrator.get(), nullptr, reactions.get(), nullptr,
+                                                           forces.get());
+        // only the CPU kernel compiles steps, the loop falls back to the single actions otherwise
+        REQUIRE((compiledStep != nullptr) == (kernel->name() == std::string("CPU")));
+        REQUIRE(kernel->actions().compiledStep(nullptr, nullptr, reactions.get(), nullptr, forces.get()) == nullptr);
+    }
 }
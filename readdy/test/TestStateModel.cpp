@@ -212,4 +212,41 @@ TEMPLATE_TEST_CASE("Test state model", "[state-model]", SingleCPU, CPU) {
             readdy::testing::vec3eq(force, readdy::Vec3(0, 0, 0));
         }
     }
+
+    SECTION("Visit and update particles in place") {
+        m::Context &ctx = kernel->context();
+        auto &stateModel = kernel->stateModel();
+        ctx.particleTypes().add("A", 1.0);
+        ctx.particleTypes().add("B", 1.0);
+        ctx.boxSize() = {{4., 4., 4.}};
+        ctx.periodicBoundaryConditions() = {{true, true, true}};
+        auto typeIdA = ctx.particleTypes().idOf("A");
+        auto typeIdB = ctx.particleTypes().idOf("B");
+        stateModel.addParticles({m::Particle(0, 0, 0, typeIdA), m::Particle(1, 0, 0, typeIdB),
+                                 m::Particle(0, 1, 0, typeIdA)});
+
+        auto particles = stateModel.getParticles();
+        std::size_t i = 0;
+        stateModel.forEachParticle([&](readdy::ParticleTypeId type, readdy::ParticleId id, const readdy::Vec3 &pos,
+                                       const readdy::Vec3 &) {
+            REQUIRE(i < particles.size());
+            REQUIRE(type == particles[i].type());
+            REQUIRE(id == particles[i].id());
+            REQUIRE(pos == particles[i].pos());
+            ++i;
+        });
+        REQUIRE(i == particles.size());
+
+        stateModel.updateParticlePositions([&](readdy::ParticleTypeId type, readdy::ParticleId, readdy::Vec3 &pos) {
+            if (type == typeIdA) pos += readdy::Vec3(0, 0, 3);
+        });
+        for (const auto &p : stateModel.getParticles()) {
+            if (p.type() == typeIdA) {
+                // shifted out of the box and wrapped back in
+                REQUIRE(p.pos().z == Catch::Approx(-1));
+            } else {
+                readdy::testing::vec3eq(p.pos(), readdy::Vec3(1, 0, 0));
+            }
+        }
+    }
 }
@@ -342,4 +342,133 @@ TEMPLATE_TEST_CASE("Test topologies.", "[topologies]", SingleCPU, CPU) {
         REQUIRE(top->graph().isConnected());
         top->configure();
     }
+
+    SECTION("Incremental reconfiguration") {
+        auto &ctx = kernel->context();
+
+        ctx.particleTypes().add("Topology A", 1.0, readdy::model::particleflavor::TOPOLOGY);
+        ctx.particleTypes().add("Topology B", 1.0, readdy::model::particleflavor::TOPOLOGY);
+
+        ctx.topologyRegistry().configureBondPotential("Topology A", "Topology B", {1.0, 1.0});
+        ctx.topologyRegistry().configureBondPotential("Topology A", "Topology A", {1.0, 1.0});
+        ctx.topologyRegistry().configureAnglePotential("Topology B", "Topology A", "Topology A", {1.0, 1.0});
+        ctx.topologyRegistry().configureAnglePotential("Topology A", "Topology A", "Topology A", {2.0, 1.0});
+        ctx.topologyRegistry().configureTorsionPotential("Topology A", "Topology B", "Topology A", "Topology A",
+                                                         {1.0, 1.0, 3.0});
+        ctx.topologyRegistry().configureTorsionPotential("Topology A", "Topology A", "Topology A", "Topology A",
+                                                         {2.0, 1.0, 3.0});
+
+        ctx.boxSize() = {{10, 10, 10}};
+        auto a = ctx.particleTypes().idOf("Topology A");
+        auto b = ctx.particleTypes().idOf("Topology B");
+        auto top = kernel->stateModel().addTopology(0, {{0, 0, 0, a}, {1, 0, 0, a}, {1, 1, 0, b},
+                                                        {0, 1, 0, a}, {0, 2, 0, a}, {1, 2, 0, a}});
+        top->addEdge({0}, {1});
+        top->addEdge({1}, {2});
+        top->addEdge({2}, {3});
+        top->addEdge({3}, {4});
+        top->addEdge({4}, {5});
+        top->addEdge({5}, {0});
+        top->configure();
+
+        auto terms = [](const auto &topology) {
+            std::vector<std::vector<std::size_t>> result;
+            for (const auto &pot : topology.getBondedPotentials()) {
+                for (const auto &bond : pot->getBonds()) {
+                    result.push_back({2, bond.idx1, bond.idx2});
+                }
+            }
+            for (const auto &pot : topology.getAnglePotentials()) {
+                for (const auto &angle : dynamic_cast<const angle_bond &>(*pot).getAngles()) {
+                    result.push_back({3, angle.idx1, angle.idx2, angle.idx3});
+                }
+            }
+            for (const auto &pot : topology.getTorsionPotentials()) {
+                for (const auto &dih : dynamic_cast<const dihedral_bond &>(*pot).getDihedrals()) {
+                    result.push_back({4, dih.idx1, dih.idx2, dih.idx3, dih.idx4});
+                }
+            }
+            std::sort(result.begin(), result.end());
+            return result;
+        };
+
+        // breaking the ring keeps the topology connected
+        top->removeEdge({5}, {0});
+        REQUIRE(top->isConnectedAfterChanges());
+        top->addEdge({1}, {4});
+        top->reconfigure();
+        REQUIRE(top->changedVertices().empty());
+        auto incremental = terms(*top);
+        top->configure();
+        REQUIRE(incremental == terms(*top));
+
+        // removing a bridge disconnects it
+        top->removeEdge({3}, {4});
+        REQUIRE(top->isConnectedAfterChanges());
+        top->removeEdge({1}, {4});
+        REQUIRE_FALSE(top->isConnectedAfterChanges());
+        REQUIRE_FALSE(top->graph().isConnected());
+    }
+
+    SECTION("Split off the smaller component") {
+        auto &ctx = kernel->context();
+        ctx.particleTypes().add("Topology A", 1.0, readdy::model::particleflavor::TOPOLOGY);
+        ctx.topologyRegistry().configureBondPotential("Topology A", "Topology A", {1.0, 1.0});
+        ctx.boxSize() = {{10, 10, 10}};
+        auto a = ctx.particleTypes().idOf("Topology A");
+
+        // a shallow star with many leaves attached to a deep, but small chain
+        std::size_t nLeaves {200}, chainLength {10};
+        std::vector<readdy::model::Particle> particles;
+        for (std::size_t i = 0; i < 1 + nLeaves + chainLength; ++i) {
+            particles.emplace_back(0, 0, 0, a);
+        }
+        auto top = kernel->stateModel().addTopology(0, particles);
+        for (std::size_t i = 1; i <= nLeaves; ++i) {
+            top->addEdge({0}, {i});
+        }
+        top->addEdge({0}, {nLeaves + 1});
+        for (std::size_t i = nLeaves + 1; i < nLeaves + chainLength; ++i) {
+            top->addEdge({i}, {i + 1});
+        }
+        top->configure();
+
+        top->removeEdge({0}, {nLeaves + 1});
+        auto components = top->splitOffComponents();
+        REQUIRE(components.size() == 1);
+        REQUIRE(components.front().graph().nVertices() == chainLength);
+        REQUIRE(top->graph().nVertices() == 1 + nLeaves);
+        REQUIRE(top->graph().isConnected());
+    }
+
+    SECTION("Particle to vertex lookup") {
+        auto &ctx = kernel->context();
+        ctx.particleTypes().add("Topology A", 1.0, readdy::model::particleflavor::TOPOLOGY);
+        ctx.topologyRegistry().configureBondPotential("Topology A", "Topology A", {1.0, 1.0});
+        ctx.boxSize() = {{10, 10, 10}};
+        auto a = ctx.particleTypes().idOf("Topology A");
+        auto top = kernel->stateModel().addTopology(0, {{0, 0, 0, a}, {1, 0, 0, a}, {2, 0, 0, a}});
+        top->addEdge({0}, {1});
+        top->addEdge({1}, {2});
+        top->configure();
+
+        auto indices = top->particleIndices();
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            REQUIRE(top->vertexIndexForParticle(indices[i]).value == i);
+        }
+        top->removeVertex({2});
+        REQUIRE(top->vertexIteratorForParticle(indices[2]) == top->graph().vertices().end_persistent());
+        REQUIRE_THROWS(top->vertexIndexForParticle(indices[2]));
+        auto appended = top->appendParticle(indices[2], indices[0]);
+        REQUIRE(top->vertexIndexForParticle(indices[2]) == appended);
+        REQUIRE(top->isConnectedAfterChanges());
+
+        std::vector<std::size_t> oldToNew (*std::max_element(indices.begin(), indices.end()) + 1);
+        for (std::size_t i = 0; i < oldToNew.size(); ++i) {
+            oldToNew[i] = oldToNew.size() - 1 - i;
+        }
+        top->remapParticleIndices(oldToNew);
+        REQUIRE(top->vertexIndexForParticle(oldToNew[indices[2]]) == appended);
+        REQUIRE(top->vertexIndexForParticle(oldToNew[indices[1]]).value == 1);
+    }
 }
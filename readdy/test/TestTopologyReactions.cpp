@@ -44,6 +44,7 @@
  */
 
 #include <catch2/catch_template_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
 
 #include <readdy/model/topologies/GraphTopology.h>
 #include <readdy/testing/KernelTest.h>
@@ -160,6 +161,40 @@ TEMPLATE_TEST_CASE("Test topology reactions.", "[topologies]", SingleCPU, CPU) {
             REQUIRE(particles[v->data().particleIndex].type() == types.idOf("Topology A"));
         }
     }
+    SECTION("Batched and cached rates") {
+        auto tid = kernel->context().topologyRegistry().addType("Batched Topology Type");
+        auto topology = setUpSmallTopology(kernel.get(), tid);
+        auto other = setUpSmallTopology(kernel.get(), tid);
+        std::size_t nCalls {0};
+        {
+            auto reactionFunction = [&](model::top::GraphTopology &top) {
+                return model::top::reactions::Recipe(top);
+            };
+            auto batchRateFunction = [&](const std::vector<const model::top::GraphTopology *> &tops) {
+                ++nCalls;
+                std::vector<readdy::scalar> rates;
+                for (const auto *top : tops) {
+                    rates.push_back(static_cast<readdy::scalar>(top->nParticles()));
+                }
+                return rates;
+            };
+            model::top::reactions::StructuralTopologyReaction reaction{"batched", reactionFunction, batchRateFunction};
+            REQUIRE(reaction.hasBatchRateFunction());
+            kernel->context().topologyRegistry().addStructuralReaction(tid, reaction);
+        }
+        const auto &reaction = kernel->context().topologyRegistry().structuralReactionsOf(tid).front();
+        REQUIRE(reaction.rate(*topology) == 3);
+        auto rates = reaction.rates({topology, other});
+        REQUIRE(rates == std::vector<readdy::scalar>{3, 3});
+        REQUIRE(nCalls == 2);
+
+        REQUIRE(topology->reactionRatesDirty());
+        topology->setReactionRates({4});
+        REQUIRE_FALSE(topology->reactionRatesDirty());
+        REQUIRE(topology->cumulativeRate() == 4);
+        topology->invalidateReactionRates();
+        REQUIRE(topology->reactionRatesDirty());
+    }
     SECTION("Add a named edge") {
         // add edge between first and last vertex, creating a circular structure x_2 -> x_0 <-> x_1 <-> x_2 <- x_0
         auto tid = kernel->context().topologyRegistry().addType("TA");
@@ -221,15 +256,17 @@ TEMPLATE_TEST_CASE("Test topology reactions.", "[topologies]", SingleCPU, CPU) {
         topology->updateReactionRates(reactions);
         std::vector<model::Particle> particles = topology->fetchParticles();
         auto result = reactions.back().execute(*topology, kernel.get());
-        REQUIRE(result.size() == 2);
+        // the smaller component is split off, the larger one stays in the original topology
+        REQUIRE(result.size() == 1);
 
         const auto &top1 = result.at(0);
-        const auto &top2 = result.at(1);
+        const auto &top2 = *topology;
 
         // first topology should have only 1 particle
         REQUIRE(top1.nParticles() == 1);
         // second topology should have 2 particles
         REQUIRE(top2.nParticles() == 2);
+        REQUIRE_FALSE(top2.isDeactivated());
 
         SECTION("Second topology has one edge") {
             REQUIRE(top2.graph().vertices().begin()->neighbors().size() == 1);
@@ -244,6 +281,38 @@ TEMPLATE_TEST_CASE("Test topology reactions.", "[topologies]", SingleCPU, CPU) {
         REQUIRE(top2.fetchParticles().at(1) == particles.at(2));
     }
 
+    SECTION("Break bonds") {
+        ctx.topologyRegistry().addType("TA");
+        const auto a = ctx.particleTypes().idOf("Topology A");
+        const auto b = ctx.particleTypes().idOf("Topology B");
+        // all bonds are strongly compressed, but only the one between the two A particles can break
+        auto topology = kernel->stateModel().addTopology(ctx.topologyRegistry().idOf("TA"), {
+                model::Particle{-1.5, 0, 0, b}, model::Particle{-.5, 0, 0, a},
+                model::Particle{.5, 0, 0, a}, model::Particle{1.5, 0, 0, b}
+        });
+        topology->addEdge({0}, {1});
+        topology->addEdge({1}, {2});
+        topology->addEdge({2}, {3});
+        topology->configure();
+
+        model::actions::top::BreakConfig breakConfig;
+        breakConfig.addBreakablePair(a, a, 100., 1e10);
+        kernel->actions().breakBonds(1., breakConfig)->perform();
+
+        auto topologies = kernel->stateModel().getTopologies();
+        REQUIRE(topologies.size() == 2);
+        for (auto *top : topologies) {
+            REQUIRE(top->nParticles() == 2);
+            REQUIRE(top->graph().edges().size() == 1);
+            auto types = std::vector<ParticleTypeId>{};
+            for (const auto &p : top->fetchParticles()) {
+                types.push_back(p.type());
+            }
+            std::sort(types.begin(), types.end());
+            REQUIRE(types == std::vector<ParticleTypeId>{a, b});
+        }
+    }
+
     SECTION("Chain split up") {
         std::size_t n_chain_elements = 50;
         auto &toptypes = ctx.topologyRegistry();
@@ -690,3 +759,60 @@ TEMPLATE_TEST_CASE("Test topology reactions.", "[topologies]", SingleCPU, CPU) {
         }
     }
 }
+
+TEST_CASE("Benchmark spatial topology reaction gather.", "[.][benchmark][topologies]") {
+    model::Context ctx;
+    for (auto name : {"A", "B", "C", "D"}) {
+        ctx.particleTypes().addTopologyType(name, 1.);
+    }
+    for (auto name : {"P", "Q"}) {
+        ctx.particleTypes().add(name, 1.);
+    }
+    auto &registry = ctx.topologyRegistry();
+    for (auto name : {"T1", "T2", "T3"}) {
+        registry.addType(name);
+    }
+    registry.addSpatialReaction("fusion: T1(A)+T1(B) -> T2(A--B)", 1., 1.);
+    registry.addSpatialReaction("fusion_self: T1(A)+T1(B) -> T2(A--B) [self=true]", 1., 1.);
+    registry.addSpatialReaction("attach: T2(C)+(P) -> T2(C--D)", 1., 1.);
+    registry.addSpatialReaction("convert: T3(D)+(Q) -> T3(A) + (P)", 1., 1.);
+
+    // neighbor pairs of random particles, about half of them belonging to a topology
+    struct Candidate {
+        ParticleTypeId type;
+        TopologyTypeId topologyType;
+    };
+    std::vector<Candidate> candidates;
+    for (auto name : {"A", "B", "C", "D"}) {
+        for (auto topologyType : {"T1", "T2", "T3"}) {
+            candidates.push_back({ctx.particleTypes().idOf(name), registry.idOf(topologyType)});
+        }
+    }
+    for (auto name : {"P", "Q"}) {
+        for (int i = 0; i < 6; ++i) {
+            candidates.push_back({ctx.particleTypes().idOf(name), EmptyTopologyId});
+        }
+    }
+    const std::size_t nPairs = 1000000;
+    std::vector<std::tuple<Candidate, Candidate, scalar>> pairs;
+    pairs.reserve(nPairs);
+    for (std::size_t i = 0; i < nPairs; ++i) {
+        auto draw = [&]() {
+            return candidates[model::rnd::uniform_int<std::size_t>(0, candidates.size() - 1)];
+        };
+        pairs.emplace_back(draw(), draw(), model::rnd::uniform_real(0., 2.));
+    }
+
+    BENCHMARK("gather") {
+        std::size_t nEvents = 0;
+        for (const auto &[c1, c2, distSquared] : pairs) {
+            const auto reactions = registry.spatialReactionsByType(c1.type, c1.topologyType, c2.type, c2.topologyType);
+            for (const auto &reaction : reactions) {
+                if (distSquared < reaction.radius() * reaction.radius()) {
+                    ++nEvents;
+                }
+            }
+        }
+        return nEvents;
+    };
+}
@@ -36,6 +36,8 @@
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
 
+#include <optional>
+
 #include <nlohmann/json.hpp>
 
 #include <readdy/api/Simulation.h>
@@ -65,6 +67,105 @@ std::string getSelectedKernelType(sim &self) { /* discard const reference */ ret
 void addParticle(sim &self, const std::string &type, const vec &pos) { self.addParticle(type, pos[0], pos[1], pos[2]); }
 
 
+/**
+ * Fills a (n_particles, N)-shaped numpy array with `extract(type, id, pos, force, out)` for the particles of the given
+ * type (or all particles), reading the kernel's particle storage directly.
+ */
+template<typename T, std::size_t N, typename Extract>
+py::array_t<T> particleArray(sim &self, const std::optional<std::string> &type, Extract &&extract) {
+    std::optional<readdy::ParticleTypeId> typeId;
+    if (type) typeId = self.context().particleTypes().idOf(*type);
+    auto &stateModel = self.stateModel();
+
+    std::size_t n = 0;
+    stateModel.forEachParticle([&](readdy::ParticleTypeId t, readdy::ParticleId, const auto &, const auto &) {
+        if (!typeId || t == *typeId) ++n;
+    });
+    std::vector<std::size_t> shape{n};
+    if (N > 1) shape.push_back(N);
+    py::array_t<T, py::array::c_style> result(shape);
+    auto *out = result.mutable_data();
+    stateModel.forEachParticle([&](readdy::ParticleTypeId t, readdy::ParticleId id, const readdy::Vec3 &pos,
+                                   const readdy::Vec3 &force) {
+        if (!typeId || t == *typeId) {
+            extract(t, id, pos, force, out);
+            out += N;
+        }
+    });
+    return result;
+}
+
+/**
+ * Like particleArray() but fills the caller's array `out` in a single pass over the particles. `out` must be a
+ * writeable, C-contiguous array of dtype T and shape (n_particles, N), or (n_particles,) for N == 1. If the number of
+ * particles does not match, an error is raised after the pass and the content of `out` is undefined.
+ */
+template<typename T, std::size_t N, typename Extract>
+py::array particleArray(sim &self, const std::optional<std::string> &type, py::array out, Extract &&extract) {
+    const auto ndim = N > 1 ? 2 : 1;
+    if (!py::array_t<T, py::array::c_style>::check_(out) || !out.writeable() || out.ndim() != ndim
+        || (N > 1 && static_cast<std::size_t>(out.shape(1)) != N)) {
+        throw std::invalid_argument(fmt::format("out must be a writeable, C-contiguous array of dtype {} and shape {}",
+                                                std::string(py::str(py::dtype::of<T>())),
+                                                N > 1 ? fmt::format("(n, {})", N) : "(n,)"));
+    }
+    std::optional<readdy::ParticleTypeId> typeId;
+    if (type) typeId = self.context().particleTypes().idOf(*type);
+
+    const auto capacity = static_cast<std::size_t>(out.shape(0));
+    auto *data = static_cast<T *>(out.mutable_data());
+    std::size_t n = 0;
+    self.stateModel().forEachParticle([&](readdy::ParticleTypeId t, readdy::ParticleId id, const readdy::Vec3 &pos,
+                                          const readdy::Vec3 &force) {
+        if (!typeId || t == *typeId) {
+            if (n < capacity) extract(t, id, pos, force, data + n * N);
+            ++n;
+        }
+    });
+    if (n != capacity) {
+        throw std::invalid_argument(fmt::format("out has {} rows but there are {} particles", capacity, n));
+    }
+    return out;
+}
+
+/**
+ * Binds `name(type=None, out=None)` which either allocates the array or fills `out`.
+ */
+template<typename T, std::size_t N, typename Extract>
+void defParticleArray(py::class_<sim> &simulation, const char *name, Extract extract, const char *doc) {
+    using namespace pybind11::literals;
+    simulation.def(name, [extract](sim &self, const std::optional<std::string> &type,
+                                   const std::optional<py::array> &out) -> py::object {
+        if (out) {
+            return particleArray<T, N>(self, type, *out, extract);
+        }
+        return particleArray<T, N>(self, type, extract);
+    }, doc, "type"_a = py::none(), "out"_a = py::none());
+}
+
+void setPositions(sim &self, const py::array_t<readdy::scalar, py::array::c_style | py::array::forcecast> &positions,
+                  const std::optional<std::string> &type) {
+    std::optional<readdy::ParticleTypeId> typeId;
+    if (type) typeId = self.context().particleTypes().idOf(*type);
+    auto &stateModel = self.stateModel();
+
+    std::size_t n = 0;
+    stateModel.forEachParticle([&](readdy::ParticleTypeId t, readdy::ParticleId, const auto &, const auto &) {
+        if (!typeId || t == *typeId) ++n;
+    });
+    if (positions.ndim() != 2 || positions.shape(1) != 3 || static_cast<std::size_t>(positions.shape(0)) != n) {
+        throw std::invalid_argument(fmt::format("positions must be of shape ({}, 3), i.e., one position per "
+                                                "particle in the order of get_positions_array()", n));
+    }
+    const auto *in = positions.data();
+    stateModel.updateParticlePositions([&](readdy::ParticleTypeId t, readdy::ParticleId, readdy::Vec3 &pos) {
+        if (!typeId || t == *typeId) {
+            pos = {in[0], in[1], in[2]};
+            in += 3;
+        }
+    });
+}
+
 enum class ParticleTypeFlavor {
     NORMAL = 0, TOPOLOGY = 1, MEMBRANE = 2
 };
@@ -104,6 +205,13 @@ void exportApi(py::module &api) {
             .def("set_kernel_config", &sim::setKernelConfiguration)
             .def("get_selected_kernel_type", &getSelectedKernelType)
             .def("get_particle_positions", &sim::getParticlePositions)
+            .def("set_positions", &setPositions, R"topdoc(
+                Overwrites the positions of the particles (optionally only of the given type), in the order of
+                `get_positions_array`. Positions are wrapped back into the simulation box.
+
+                :param positions: (N, 3)-shaped array of positions
+                :param type: the particle type, None for all particles
+            )topdoc", "positions"_a, "type"_a = py::none())
             .def("kernel_supports_topologies", &sim::kernelSupportsTopologies)
             .def("create_topology_particle", [](sim &self, const std::string& type, readdy::Vec3 pos) {
                 auto particle = self.createTopologyParticle(type, pos);
@@ -161,6 +269,55 @@ void exportApi(py::module &api) {
                 py::gil_scoped_release release;
                 self.run(steps, timeStep);
             }, "n_steps"_a, "time_step"_a);
+    defParticleArray<readdy::scalar, 3>(simulation, "get_positions_array", [](auto, auto, const readdy::Vec3 &pos,
+                                                                              const auto &, readdy::scalar *out) {
+        out[0] = pos.x;
+        out[1] = pos.y;
+        out[2] = pos.z;
+    }, R"topdoc(
+        Positions of the particles (optionally only of the given type) in storage order, which is stable
+        until particles are added or removed or the simulation advances.
+
+        :param type: the particle type, None for all particles
+        :param out: optional writeable, C-contiguous (N, 3)-shaped array of scalars that is filled and returned
+        :return: (N, 3)-shaped array of positions
+    )topdoc");
+    defParticleArray<readdy::scalar, 3>(simulation, "get_forces_array", [](auto, auto, const auto &,
+                                                                           const readdy::Vec3 &force,
+                                                                           readdy::scalar *out) {
+        out[0] = force.x;
+        out[1] = force.y;
+        out[2] = force.z;
+    }, R"topdoc(
+        Forces acting on the particles as of the last force calculation, in the order of
+        `get_positions_array`.
+
+        :param type: the particle type, None for all particles
+        :param out: optional writeable, C-contiguous (N, 3)-shaped array of scalars that is filled and returned
+        :return: (N, 3)-shaped array of forces
+    )topdoc");
+    defParticleArray<readdy::ParticleTypeId, 1>(simulation, "get_types_array", [](readdy::ParticleTypeId t, auto,
+                                                                                  const auto &, const auto &,
+                                                                                  readdy::ParticleTypeId *out) {
+        *out = t;
+    }, R"topdoc(
+        Type ids of the particles in the order of `get_positions_array`.
+
+        :param type: the particle type, None for all particles
+        :param out: optional writeable, C-contiguous (N,)-shaped array of type ids that is filled and returned
+        :return: (N,)-shaped array of type ids
+    )topdoc");
+    defParticleArray<readdy::ParticleId, 1>(simulation, "get_ids_array", [](auto, readdy::ParticleId id,
+                                                                            const auto &, const auto &,
+                                                                            readdy::ParticleId *out) {
+        *out = id;
+    }, R"topdoc(
+        Unique ids of the particles in the order of `get_positions_array`.
+
+        :param type: the particle type, None for all particles
+        :param out: optional writeable, C-contiguous (N,)-shaped array of particle ids that is filled and returned
+        :return: (N,)-shaped array of particle ids
+    )topdoc");
     exportObservables(api, simulation);
 
     // actions and evaluate observables, i.e. things needed to build a custom simulation loop [experimental]
@@ -170,8 +327,9 @@ void exportApi(py::module &api) {
         using MkCkpt = readdy::model::actions::MakeCheckpoint;
 
         auto actionsModule = api.def_submodule("actions");
+        // actions may run on worker threads which acquire the GIL for python callbacks, e.g., rate functions
         py::class_<Action>(actionsModule, "Action")
-                .def("__call__", &Action::perform);
+                .def("__call__", &Action::perform, py::call_guard<py::gil_scoped_release>());
 
         py::class_<readdy::model::actions::top::BreakConfig>(actionsModule, "BreakConfig")
                 .def(py::init<>())
@@ -196,11 +354,13 @@ void exportApi(py::module &api) {
         .def("create_action_action_reaction", [](sim &self, const readdy::model::actions::top::ReactionConfig &reactionConfig) -> std::unique_ptr<Action> { return self.actions().actionReaction(reactionConfig);});
 
         // strictly not an action
-        py::class_<EvalObs>(actionsModule, "EvaluateObservables").def("__call__", &EvalObs::perform);
+        py::class_<EvalObs>(actionsModule, "EvaluateObservables").def("__call__", &EvalObs::perform,
+                                                                     py::call_guard<py::gil_scoped_release>());
         simulation.def("create_action_evaluate_observables", [](sim &self) -> std::unique_ptr<EvalObs> { return self.actions().evaluateObservables();});
 
         // strictly not an action
-        py::class_<MkCkpt>(actionsModule, "MakeCheckpoint").def("__call__", &MkCkpt::perform);
+        py::class_<MkCkpt>(actionsModule, "MakeCheckpoint").def("__call__", &MkCkpt::perform,
+                                                                py::call_guard<py::gil_scoped_release>());
         simulation.def("create_action_make_checkpoint", [](sim &self, const std::string &basePath, std::size_t maxNSaves) -> std::unique_ptr<MkCkpt> { return self.actions().makeCheckpoint(basePath, maxNSaves); });
     }
 
@@ -124,6 +124,18 @@ void exportKernelContext(py::module &module) {
                      return self.addScreenedElectrostatics(type1, type2, electrostaticStrength, inverseScreeningDepth,
                                                            repulsionStrength, repulsionDistance, exponent, cutoff);
                  })
+            .def("add_tabulated",
+                 [](PotentialRegistry &self, const std::string &type1, const std::string &type2,
+                    const std::vector<scalar> &distances, const std::vector<scalar> &energies,
+                    const std::vector<scalar> &forces, const std::string &interpolation) {
+                     using Interpolation = readdy::model::potentials::TabulatedPotential::Interpolation;
+                     if (interpolation != "linear" && interpolation != "cubic") {
+                         throw std::invalid_argument(fmt::format(
+                                 "Interpolation must be \"linear\" or \"cubic\", not \"{}\"", interpolation));
+                     }
+                     self.addTabulated(type1, type2, distances, energies, forces,
+                                       interpolation == "linear" ? Interpolation::Linear : Interpolation::CubicSpline);
+                 }, "type1"_a, "type2"_a, "distances"_a, "energies"_a, "forces"_a, "interpolation"_a = "cubic")
             .def("add_sphere",
                  [](PotentialRegistry &self, const std::string &particleType, scalar forceConstant, const Vec3 &origin,
                     scalar radius, bool inclusion) {
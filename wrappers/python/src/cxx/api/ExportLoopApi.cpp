@@ -76,19 +76,21 @@ void exportLoopApi(pybind11::module &module) {
                 self.run(steps);
             }, "n_steps"_a)
             .def("run_with_criterion", [](Loop& self, pybind11::object continuingCriterion) {
-                py::gil_scoped_release release;
                 auto pyFun = readdy::rpy::PyFunction<bool(const readdy::TimeStep current)>(continuingCriterion);
+                py::gil_scoped_release release;
                 self.run(pyFun);
             }, "continuing_criterion"_a, py::keep_alive<0, 1>())
-            .def("run_initialize", &Loop::runInitialize)
-            .def("run_initialize_neighbor_list", &Loop::runInitializeNeighborList)
-            .def("run_update_neighbor_list", &Loop::runUpdateNeighborList)
-            .def("run_clear_neighbor_list", &Loop::runClearNeighborList)
-            .def("run_forces", &Loop::runForces)
-            .def("run_evaluate_observables", &Loop::runEvaluateObservables)
-            .def("run_integrator", &Loop::runIntegrator)
-            .def("run_reactions", &Loop::runReactions)
-            .def("run_topology_reactions", &Loop::runTopologyReactions)
+            // the actions may run on worker threads which acquire the GIL for python callbacks, e.g., rate functions
+            .def("run_initialize", &Loop::runInitialize, py::call_guard<py::gil_scoped_release>())
+            .def("run_initialize_neighbor_list", &Loop::runInitializeNeighborList,
+                 py::call_guard<py::gil_scoped_release>())
+            .def("run_update_neighbor_list", &Loop::runUpdateNeighborList, py::call_guard<py::gil_scoped_release>())
+            .def("run_clear_neighbor_list", &Loop::runClearNeighborList, py::call_guard<py::gil_scoped_release>())
+            .def("run_forces", &Loop::runForces, "compute_energy"_a = true, py::call_guard<py::gil_scoped_release>())
+            .def("run_evaluate_observables", &Loop::runEvaluateObservables, py::call_guard<py::gil_scoped_release>())
+            .def("run_integrator", &Loop::runIntegrator, py::call_guard<py::gil_scoped_release>())
+            .def("run_reactions", &Loop::runReactions, py::call_guard<py::gil_scoped_release>())
+            .def("run_topology_reactions", &Loop::runTopologyReactions, py::call_guard<py::gil_scoped_release>())
             .def("use_integrator", [](Loop &self, std::string name) {
                 self.useIntegrator(name, self.timeStep());
             })
@@ -109,6 +111,8 @@ void exportLoopApi(pybind11::module &module) {
                 self.evaluateTopologyReactions(evaluate, timeStep.is_none() ? self.timeStep() : timeStep.cast<readdy::scalar>());
             }, "evaluate"_a, "timeStep"_a = py::none())
             .def("evaluate_observables", &Loop::evaluateObservables, "evaluate"_a)
+            .def("use_compiled_loop", &Loop::useCompiledLoop, "use"_a)
+            .def("skip_unobserved_energies", &Loop::skipUnobservedEnergies, "skip"_a)
             .def_property("neighbor_list_cutoff", [](const Loop &self) { return self.neighborListCutoff(); },
                           [](Loop &self, readdy::scalar distance) { self.neighborListCutoff() = distance; })
             .def("make_checkpoints", [](Loop &self, std::size_t stride, std::string basePath, std::size_t maxNSaves) {
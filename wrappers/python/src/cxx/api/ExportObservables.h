@@ -57,14 +57,38 @@ using rvp = py::return_value_policy;
 using sim = readdy::Simulation;
 using obs_handle_t = readdy::ObservableHandle;
 
+/**
+ * Turns a Python callback into an observable callback. If the callback is a PyCallbackBatch, the results are
+ * buffered and handed over in batches, otherwise each result is passed on directly.
+ */
+template<typename Result, typename Convert>
+std::function<void(const Result &)> pyObservableCallback(const py::object &callback, Convert convert) {
+    if (py::isinstance<readdy::rpy::PyCallbackBatch>(callback)) {
+        return callback.cast<std::shared_ptr<readdy::rpy::PyCallbackBatch>>()->bind<Result>(convert);
+    }
+    return [pyFun = readdy::rpy::PyFunction<void(py::object)>(callback), convert](const Result &result) mutable {
+        py::gil_scoped_acquire gil;
+        pyFun(convert(result));
+    };
+}
+
+template<typename Result>
+std::function<void(const Result &)> pyObservableCallback(const py::object &callback) {
+    if (py::isinstance<readdy::rpy::PyCallbackBatch>(callback)) {
+        return callback.cast<std::shared_ptr<readdy::rpy::PyCallbackBatch>>()->bind<Result>(
+                [](const Result &result) { return py::cast(result); });
+    }
+    return readdy::rpy::PyFunction<void(const Result &)>(callback);
+}
+
 inline obs_handle_t registerObservable_Reactions(sim &self, readdy::Stride stride,
                                                  const py::object& callback = py::none()) {
     if (callback.is_none()) {
         auto obs = self.observe().reactions(stride);
         return self.registerObservable(std::move(obs));
     } else {
-        auto internalCallback = [&self, callback](const readdy::model::observables::Reactions::result_type &reactions) mutable {
-            py::gil_scoped_acquire gil;
+        using Result = readdy::model::observables::Reactions::result_type;
+        auto convert = [&self](const Result &reactions) {
             std::vector<rpy::ReadableReactionRecord> converted {};
             converted.reserve(reactions.size());
             const auto &reactionRegistry = self.context().reactions();
@@ -72,13 +96,9 @@ inline obs_handle_t registerObservable_Reactions(sim &self, readdy::Stride strid
                 auto name = reactionRegistry.nameOf(reaction.id);
                 converted.emplace_back(rpy::convert(reaction, name));
             }
-            for(const auto &c : converted) {
-                std::stringstream ss;
-                ss << c;
-
-            }
-            callback(converted);
+            return py::cast(converted);
         };
+        auto internalCallback = pyObservableCallback<Result>(callback, convert);
         auto obs = self.observe().reactions(stride, internalCallback);
         return self.registerObservable(std::move(obs));
     }
@@ -90,7 +110,7 @@ inline obs_handle_t registerObservable_Topologies(sim &self, readdy::Stride stri
         auto obs = self.observe().topologies(stride);
         return self.registerObservable(std::move(obs));
     } else {
-        auto pyFun = readdy::rpy::PyFunction<void(const readdy::model::observables::Topologies::result_type&)>(callback);
+        auto pyFun = pyObservableCallback<readdy::model::observables::Topologies::result_type>(callback);
         auto obs = self.observe().topologies(stride, pyFun);
         return self.registerObservable(std::move(obs));
     }
@@ -103,9 +123,8 @@ inline obs_handle_t registerObservable_ReactionCounts(sim &self, readdy::Stride
         auto obs = self.observe().reactionCounts(stride);
         return self.registerObservable(std::move(obs));
     } else {
-        auto internalCallback = [&self, callback](const readdy::model::observables::ReactionCounts::result_type &result) mutable {
-            py::gil_scoped_acquire gil;
-
+        using Result = readdy::model::observables::ReactionCounts::result_type;
+        auto convert = [&self](const Result &result) {
             const auto& counts = std::get<0>(result);
             const auto& countsSpatial = std::get<1>(result);
             const auto& countsStructural = std::get<2>(result);
@@ -128,8 +147,9 @@ inline obs_handle_t registerObservable_ReactionCounts(sim &self, readdy::Stride
                 convertedStructural[std::string(topologyRegistry.structuralNameById(id))] = count;
             }
 
-            callback(std::make_tuple(converted, convertedSpatial, convertedStructural));
+            return py::cast(std::make_tuple(converted, convertedSpatial, convertedStructural));
         };
+        auto internalCallback = pyObservableCallback<Result>(callback, convert);
         auto obs = self.observe().reactionCounts(stride, internalCallback);
         return self.registerObservable(std::move(obs));
     }
@@ -142,7 +162,7 @@ registerObservable_Positions(sim &self, readdy::Stride stride,
         auto obs = self.observe().positions(stride, types);
         return self.registerObservable(std::move(obs));
     } else {
-        auto pyFun = readdy::rpy::PyFunction<void(const readdy::model::observables::Positions::result_type&)>(callbackFun);
+        auto pyFun = pyObservableCallback<readdy::model::observables::Positions::result_type>(callbackFun);
         auto obs = self.observe().positions(stride, types, pyFun);
         return self.registerObservable(std::move(obs));
     }
@@ -154,10 +174,10 @@ inline obs_handle_t registerObservable_Particles(sim &self, readdy::Stride strid
         auto obs = self.observe().particles(stride);
         return self.registerObservable(std::move(obs));
     } else {
-        auto internalCallback = [&self, callbackFun](const readdy::model::observables::Particles::result_type &r) mutable {
+        using Result = readdy::model::observables::Particles::result_type;
+        auto convert = [&self](const Result &r) {
             using particle_type = std::string;
             using result_type = std::tuple<std::vector<particle_type>, std::vector<readdy::ParticleId>, std::vector<readdy::Vec3>>;
-            py::gil_scoped_acquire gil;
             result_type result;
             std::get<0>(result).reserve(std::get<0>(r).size());
             std::get<1>(result) = std::get<1>(r);
@@ -169,8 +189,9 @@ inline obs_handle_t registerObservable_Particles(sim &self, readdy::Stride strid
             for(const auto particleType : std::get<0>(r)) {
                 names.push_back(types.nameOf(particleType));
             }
-            callbackFun(result);
+            return py::cast(result);
         };
+        auto internalCallback = pyObservableCallback<Result>(callbackFun, convert);
         auto obs = self.observe().particles(stride, internalCallback);
         return self.registerObservable(std::move(obs));
     }
@@ -192,8 +213,7 @@ registerObservable_RadialDistribution(sim &self, readdy::Stride stride, py::arra
         auto obs = self.observe().radialDistribution(stride, binBordersVec, typeCountFrom, typeCountTo, particleToDensity);
         return self.registerObservable(std::move(obs));
     } else {
-        auto pyFun = readdy::rpy::PyFunction<void(const readdy::model::observables::RadialDistribution::result_type&)>(
-                callbackFun);
+        auto pyFun = pyObservableCallback<readdy::model::observables::RadialDistribution::result_type>(callbackFun);
         auto obs = self.observe().radialDistribution(stride, binBordersVec, typeCountFrom, typeCountTo, particleToDensity, pyFun);
         return self.registerObservable(std::move(obs));
     }
@@ -215,7 +235,7 @@ registerObservable_HistogramAlongAxisObservable(sim &self, readdy::Stride stride
         auto obs = self.observe().histogramAlongAxis(stride, binBordersVec, std::move(types), axis);
         return self.registerObservable(std::move(obs));
     } else {
-        auto pyFun = readdy::rpy::PyFunction<void(const readdy::model::observables::HistogramAlongAxis::result_type&)>(callbackFun);
+        auto pyFun = pyObservableCallback<readdy::model::observables::HistogramAlongAxis::result_type>(callbackFun);
         auto obs = self.observe().histogramAlongAxis(stride, binBordersVec, std::move(types), axis, pyFun);
         return self.registerObservable(std::move(obs));
     }
@@ -228,7 +248,7 @@ registerObservable_NParticles(sim &self, readdy::Stride stride, std::vector<std:
         auto obs = self.observe().nParticles(stride, std::move(types));
         return self.registerObservable(std::move(obs));
     } else {
-        auto pyFun = readdy::rpy::PyFunction<void(const readdy::model::observables::NParticles::result_type&)>(callbackFun);
+        auto pyFun = pyObservableCallback<readdy::model::observables::NParticles::result_type>(callbackFun);
         auto obs = self.observe().nParticles(stride, std::move(types), pyFun);
         return self.registerObservable(std::move(obs));
     }
@@ -240,7 +260,7 @@ inline obs_handle_t registerObservable_ForcesObservable(sim &self, readdy::Strid
         auto obs = self.observe().forces(stride, std::move(types));
         return self.registerObservable(std::move(obs));
     } else {
-        auto pyFun = readdy::rpy::PyFunction<void(const readdy::model::observables::Forces::result_type&)>(callbackFun);
+        auto pyFun = pyObservableCallback<readdy::model::observables::Forces::result_type>(callbackFun);
         auto obs = self.observe().forces(stride, std::move(types), pyFun);
         return self.registerObservable(std::move(obs));
     }
@@ -251,7 +271,7 @@ inline obs_handle_t registerObservable_Energy(sim &self, readdy::Stride stride,
         auto obs = self.observe().energy(stride);
         return self.registerObservable(std::move(obs));
     } else {
-        auto pyFun = readdy::rpy::PyFunction<void(const readdy::model::observables::Energy::result_type&)>(callbackFun);
+        auto pyFun = pyObservableCallback<readdy::model::observables::Energy::result_type>(callbackFun);
         auto obs = self.observe().energy(stride, pyFun);
         return self.registerObservable(std::move(obs));
     }
@@ -263,7 +283,7 @@ inline obs_handle_t registerObservable_Virial(sim &self, readdy::Stride stride,
         auto obs = self.observe().virial(stride);
         return self.registerObservable(std::move(obs));
     } else {
-        auto pyFun = readdy::rpy::PyFunction<void(const readdy::model::observables::Virial::result_type&)>(callback);
+        auto pyFun = pyObservableCallback<readdy::model::observables::Virial::result_type>(callback);
         auto obs = self.observe().virial(stride, pyFun);
         return self.registerObservable(std::move(obs));
     }
@@ -280,6 +300,15 @@ inline obs_handle_t registerObservable_FlatTrajectory(sim& self, readdy::Stride
 template <typename type_, typename... options>
 void exportObservables(py::module &apiModule, py::class_<type_, options...> &simulation) {
     using namespace pybind11::literals;
+    py::class_<readdy::rpy::PyCallbackBatch, std::shared_ptr<readdy::rpy::PyCallbackBatch>>(apiModule, "CallbackBatch", R"doc(
+        Wraps an observable callback so that it is invoked with a list of `batch_size` consecutive results instead of
+        once per evaluation. The results are buffered without acquiring the GIL, call `flush` to deliver an
+        incomplete batch.
+    )doc")
+            .def(py::init<py::object, std::size_t>(), "callback"_a, "batch_size"_a)
+            .def("flush", &readdy::rpy::PyCallbackBatch::flush)
+            .def_property_readonly("batch_size", &readdy::rpy::PyCallbackBatch::batchSize);
+
     py::class_<obs_handle_t>(apiModule, "ObservableHandle")
             .def("enable_write_to_file", &obs_handle_t::enableWriteToFile, "file"_a, "data_set_name"_a, "chunk_size"_a)
             .def("flush", &obs_handle_t::flush)
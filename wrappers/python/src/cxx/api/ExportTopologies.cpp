@@ -86,6 +86,26 @@ struct rate_function_sink {
     }
 };
 
+struct batch_rate_function_sink {
+    std::shared_ptr<py::function> f;
+    batch_rate_function_sink(const py::function& f) : f(std::make_shared<py::function>(f)) {};
+
+    inline reactions::StructuralTopologyReaction::batch_rate_function::result_type operator()(
+            const std::vector<const top::GraphTopology*>& topologies) {
+        py::gil_scoped_acquire gil;
+        std::vector<PyTopology> pyTops;
+        pyTops.reserve(topologies.size());
+        py::list args;
+        for (const auto *top : topologies) {
+            pyTops.emplace_back(const_cast<top::GraphTopology*>(top));
+        }
+        for (auto &pyTop : pyTops) {
+            args.append(py::cast(&pyTop, py::return_value_policy::reference));
+        }
+        auto rv = (*f)(args);
+        return rv.cast<reactions::StructuralTopologyReaction::batch_rate_function::result_type>();
+    }
+};
 
 struct NeighborIteratorState {
     PyTopology* top;
@@ -99,10 +119,12 @@ void exportTopologies(py::module &m) {
 
     py::class_<reaction_function_sink>(m, "ReactionFunction").def(py::init<py::function>());
     py::class_<rate_function_sink>(m, "RateFunction").def(py::init<py::function>());
+    py::class_<batch_rate_function_sink>(m, "BatchRateFunction").def(py::init<py::function>());
     py::class_<spatial_rate_function_sink>(m, "SpatialRateFunction").def(py::init<py::function>());
 
     py::class_<reactions::StructuralTopologyReaction>(m, "StructuralTopologyReaction")
             .def(py::init<std::string, reaction_function_sink, rate_function_sink>())
+            .def(py::init<std::string, reaction_function_sink, batch_rate_function_sink>())
             .def("rate", &reactions::StructuralTopologyReaction::rate, "topology"_a)
             .def("expects_connected_after_reaction", &reactions::StructuralTopologyReaction::expects_connected_after_reaction)
             .def("expect_connected_after_reaction", &reactions::StructuralTopologyReaction::expect_connected_after_reaction)
@@ -48,6 +48,10 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/functional.h>
 
+#include <memory>
+#include <vector>
+#include <stdexcept>
+
 namespace readdy {
 namespace rpy {
 
@@ -95,5 +99,73 @@ protected:
     std::shared_ptr<pybind11::object> py_obj;
 };
 
+/**
+ * Wraps a Python callable such that the arguments of up to `batchSize` calls are buffered on the C++ side and handed
+ * over as one list. The GIL is thus only acquired once per batch, results that did not fill a batch yet are delivered
+ * on flush().
+ */
+class PyCallbackBatch {
+public:
+    PyCallbackBatch(pybind11::object object, std::size_t batchSize)
+            : py_obj(new pybind11::object(std::move(object)), [](pybind11::object *o) {
+                pybind11::gil_scoped_acquire lock;
+                delete o;
+            }), _batchSize(batchSize) {
+        if (_batchSize == 0) {
+            throw std::invalid_argument("The batch size of a callback must be positive");
+        }
+    }
+
+    /**
+     * Creates the C++ side callback that buffers its arguments. A batch can only be bound once.
+     * @param convert converts one buffered argument into a Python object, called while holding the GIL
+     * @return the buffering callback
+     */
+    template<typename T, typename Convert>
+    std::function<void(const T &)> bind(Convert convert) {
+        if (_deliver) {
+            throw std::logic_error("This callback batch is already bound to an observable");
+        }
+        auto buffer = std::make_shared<std::vector<T>>();
+        buffer->reserve(_batchSize);
+        _deliver = std::make_shared<std::function<void()>>([buffer, pyObj = py_obj, convert]() {
+            if (buffer->empty()) {
+                return;
+            }
+            pybind11::gil_scoped_acquire lock;
+            pybind11::list batch;
+            for (const auto &item : *buffer) {
+                batch.append(convert(item));
+            }
+            buffer->clear();
+            (*pyObj)(batch);
+        });
+        return [buffer, deliver = _deliver, n = _batchSize](const T &item) {
+            buffer->push_back(item);
+            if (buffer->size() >= n) {
+                (*deliver)();
+            }
+        };
+    }
+
+    /**
+     * Hands all buffered arguments to the Python callable.
+     */
+    void flush() {
+        if (_deliver) {
+            (*_deliver)();
+        }
+    }
+
+    [[nodiscard]] std::size_t batchSize() const {
+        return _batchSize;
+    }
+
+protected:
+    std::shared_ptr<pybind11::object> py_obj;
+    std::size_t _batchSize;
+    std::shared_ptr<std::function<void()>> _deliver;
+};
+
 }
 }
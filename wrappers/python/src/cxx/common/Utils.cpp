@@ -635,6 +635,95 @@ std::vector<std::vector<TrajectoryParticle>> read_trajectory(const std::string &
     return std::move(result);
 }
 
+/**
+ * Reads a (flat) trajectory frame range by frame range and returns it in columnar form, i.e., as a handful of numpy
+ * arrays instead of one python object per particle. Only the requested frames are read from the file, which stays
+ * open for the lifetime of the reader, so that trajectories that do not fit into memory can be processed chunk-wise.
+ */
+class TrajectoryReader {
+public:
+    TrajectoryReader(const std::string &filename, const std::string &name)
+            : file([&filename] {
+                  readdy::io::BloscFilter bloscFilter;
+                  bloscFilter.registerFilter();
+                  return h5rd::File::open(filename, h5rd::File::Flag::READ_ONLY);
+              }()),
+              group(file->getSubgroup("readdy/trajectory/" + name)),
+              entryTypes(readdy::model::observables::util::getTrajectoryEntryTypes(file->ref())) {
+        _nFrames = group.getDataset<std::size_t>("limits")->getFileSpace()->dims()[0];
+    }
+
+    [[nodiscard]] std::size_t nFrames() const {
+        return _nFrames;
+    }
+
+    /**
+     * Reads the frames [begin, end), the range is clamped to the available frames.
+     * @return a tuple (time, offsets, types, ids, flavors, positions), where the particles of the i-th frame are
+     *         located at [offsets[i], offsets[i+1]) in types (N,), ids (N,), flavors (N,) and positions (N, 3)
+     */
+    py::tuple read(std::size_t begin, std::size_t end) {
+        end = std::min(end, _nFrames);
+        begin = std::min(begin, end);
+        const auto n = end - begin;
+
+        std::vector<std::size_t> limits;
+        std::vector<readdy::TimeStep> time;
+        std::vector<readdy::model::observables::TrajectoryEntry> entries;
+        {
+            py::gil_scoped_release release;
+            if (n > 0) {
+                group.readSelection("limits", limits, {begin, 0}, {1, 1}, {n, 2});
+                group.readSelection("time", time, {begin}, {1}, {n});
+                // frames are stored back to back, so the whole range is one hyperslab of records
+                if (limits.back() > limits.front()) {
+                    group.readSelection("records", entries, &std::get<0>(entryTypes), &std::get<1>(entryTypes),
+                                        {limits.front()}, {1}, {limits.back() - limits.front()});
+                }
+            }
+        }
+
+        const auto nParticles = entries.size();
+        py::array_t<readdy::TimeStep, py::array::c_style> timeArr(std::vector<std::size_t>{n});
+        py::array_t<std::size_t, py::array::c_style> offsetsArr(std::vector<std::size_t>{n + 1});
+        py::array_t<readdy::ParticleTypeId, py::array::c_style> typesArr(std::vector<std::size_t>{nParticles});
+        py::array_t<readdy::ParticleId, py::array::c_style> idsArr(std::vector<std::size_t>{nParticles});
+        py::array_t<readdy::model::ParticleFlavor, py::array::c_style> flavorsArr(std::vector<std::size_t>{nParticles});
+        py::array_t<readdy::scalar, py::array::c_style> positionsArr(std::vector<std::size_t>{nParticles, 3});
+        {
+            auto t = timeArr.mutable_unchecked<1>();
+            auto offsets = offsetsArr.mutable_unchecked<1>();
+            for (std::size_t i = 0; i < n; ++i) {
+                t(i) = time[i];
+                offsets(i) = limits[2 * i] - limits.front();
+            }
+            offsets(n) = n > 0 ? limits.back() - limits.front() : 0;
+        }
+        {
+            auto types = typesArr.mutable_unchecked<1>();
+            auto ids = idsArr.mutable_unchecked<1>();
+            auto flavors = flavorsArr.mutable_unchecked<1>();
+            auto positions = positionsArr.mutable_unchecked<2>();
+            for (std::size_t i = 0; i < nParticles; ++i) {
+                const auto &entry = entries[i];
+                types(i) = entry.typeId;
+                ids(i) = entry.id;
+                flavors(i) = entry.flavor;
+                positions(i, 0) = entry.pos.x;
+                positions(i, 1) = entry.pos.y;
+                positions(i, 2) = entry.pos.z;
+            }
+        }
+        return py::make_tuple(timeArr, offsetsArr, typesArr, idsArr, flavorsArr, positionsArr);
+    }
+
+private:
+    std::shared_ptr<h5rd::File> file;
+    h5rd::Group group;
+    readdy::model::observables::util::CompoundH5Types entryTypes;
+    std::size_t _nFrames;
+};
+
 void exportUtils(py::module &m) {
     using namespace pybind11::literals;
     py::class_<TrajectoryParticle>(m, "TrajectoryParticle")
@@ -720,5 +809,17 @@ void exportUtils(py::module &m) {
           "begin"_a = 0, "end"_a = std::numeric_limits<int>::max(), "stride"_a = 1);
     m.def("read_reaction_observable", &read_reactions_obs, "filename"_a, "name"_a);
     m.def("trajectory_length", &trajectoryLength, "filename"_a, "name"_a);
+    py::class_<TrajectoryReader>(m, "TrajectoryReader")
+            .def(py::init<const std::string &, const std::string &>(), "filename"_a, "name"_a)
+            .def_property_readonly("n_frames", &TrajectoryReader::nFrames)
+            .def("__len__", &TrajectoryReader::nFrames)
+            .def("read", &TrajectoryReader::read, "begin"_a, "end"_a, R"docs(
+                Reads the frames [begin, end) of the trajectory in columnar form.
+
+                :param begin: first frame
+                :param end: one past the last frame, clamped to the number of frames
+                :return: a tuple (time, offsets, types, ids, flavors, positions) of numpy arrays, the particles of the
+                         i-th frame are located at [offsets[i], offsets[i+1]) in the particle arrays
+            )docs");
     py::add_ostream_redirect(m, "ostream_redirect");
 }
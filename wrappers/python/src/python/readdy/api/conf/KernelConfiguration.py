@@ -48,6 +48,9 @@ class CPUKernelConfiguration(object):
     def __init__(self):
         self._n_threads = -1
         self._cll_radius = 1
+        self._reorder_interval = 0
+        self._reorder_threshold = 0.
+        self._potential_grid_spacing = 0.
 
     @property
     def n_threads(self):
@@ -67,14 +70,62 @@ class CPUKernelConfiguration(object):
             raise ValueError("Only strictly positive cell linked list radii permitted!")
         self._cll_radius = value
 
+    @property
+    def reorder_interval(self):
+        """
+        Reorder the particles along a space-filling curve every `reorder_interval` neighbor list updates,
+        0 disables periodic reordering.
+        """
+        return self._reorder_interval
+
+    @reorder_interval.setter
+    def reorder_interval(self, value):
+        if value < 0:
+            raise ValueError("The reorder interval must be non-negative!")
+        self._reorder_interval = value
+
+    @property
+    def reorder_threshold(self):
+        """
+        Reorder the particles once their memory locality has degraded by this fraction of the way towards a random
+        order, 0 disables locality-triggered reordering.
+        """
+        return self._reorder_threshold
+
+    @reorder_threshold.setter
+    def reorder_threshold(self, value):
+        if value < 0 or value > 1:
+            raise ValueError("The reorder threshold must be within [0, 1]!")
+        self._reorder_threshold = value
+
+    @property
+    def potential_grid_spacing(self):
+        """
+        If positive, the built-in external (first order) potentials acting on each particle type are tabulated on a grid
+        with at most this spacing over the simulation box and interpolated trilinearly, 0 evaluates them exactly.
+        The grid may have at most 2^23 nodes.
+        """
+        return self._potential_grid_spacing
+
+    @potential_grid_spacing.setter
+    def potential_grid_spacing(self, value):
+        if value < 0:
+            raise ValueError("The potential grid spacing must be non-negative!")
+        self._potential_grid_spacing = value
+
     def to_json(self):
         import json
         return json.dumps({"CPU": {
             "neighbor_list": {
                 "cll_radius": self.cell_linked_list_radius,
+                "reorder_interval": self.reorder_interval,
+                "reorder_threshold": self.reorder_threshold,
             },
             "thread_config": {
                 "n_threads": self.n_threads,
+            },
+            "external_potentials": {
+                "grid_spacing": self.potential_grid_spacing,
             }
         }
         })
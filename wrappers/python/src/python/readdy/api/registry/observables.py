@@ -42,6 +42,7 @@ import numpy as _np
 
 from typing import Optional as _Optional, Dict as _Dict, Union as _Union, Callable as _Callable
 from readdy.util.observable_utils import calculate_pressure as _calculate_pressure
+from readdy._internal.readdybinding.api import CallbackBatch as _CallbackBatch
 
 def _parse_save_args(save_args):
     assert save_args is None or isinstance(save_args, (dict, bool)), \
@@ -60,6 +61,35 @@ class Observables(object):
         self._sim = self._simulation._simulation
         # fixme why keep this in py side, the enable_write_to_file logic can be performed by cpp Simulation
         self._observable_handles = []
+        self._callback_batch_size = 1
+        self._callback_batches = []
+
+    @property
+    def callback_batch_size(self) -> int:
+        """
+        The number of consecutive results that are handed to the callback of an observable at once. With a value
+        of n > 1, the callbacks of observables registered afterwards are invoked with a list of n results, which
+        avoids entering the Python interpreter for every evaluation. Results of an incomplete batch are delivered
+        at the end of a simulation run.
+        :return: the callback batch size
+        """
+        return self._callback_batch_size
+
+    @callback_batch_size.setter
+    def callback_batch_size(self, value: int):
+        assert value > 0, "The callback batch size must be positive but was {}".format(value)
+        self._callback_batch_size = value
+
+    def _batched(self, callback):
+        if callback is None or self._callback_batch_size == 1:
+            return callback
+        batch = _CallbackBatch(callback, self._callback_batch_size)
+        self._callback_batches.append(batch)
+        return batch
+
+    def _flush_callbacks(self):
+        for batch in self._callback_batches:
+            batch.flush()
 
     def rdf(self, stride, bin_borders, types_count_from, types_count_to, particle_to_density,
             callback: _Optional[_Callable]=None, save: _Optional[_Union[_Dict, str]]='default'):
@@ -90,7 +120,7 @@ class Observables(object):
             "types_count_to={} has an invalid type".format(types_count_to)
         handle = self._sim.register_observable_radial_distribution(stride, bin_borders, types_count_from,
                                                                    types_count_to,
-                                                                   particle_to_density, callback)
+                                                                   particle_to_density, self._batched(callback))
         self._add_observable_handle(*_parse_save_args(save), handle)
 
     def reactions(self, stride, callback: _Optional[_Callable]=None, save: _Optional[_Union[_Dict, str]]='default'):
@@ -103,7 +133,7 @@ class Observables(object):
         """
         if isinstance(save, str) and save == 'default':
             save = {"name": "reactions", "chunk_size": 500}
-        handle = self._sim.register_observable_reactions(stride, callback)
+        handle = self._sim.register_observable_reactions(stride, self._batched(callback))
 
         self._add_observable_handle(*_parse_save_args(save), handle)
 
@@ -122,7 +152,7 @@ class Observables(object):
 
         if types is None:
             types = []
-        handle = self._sim.register_observable_particle_positions(stride, types, callback)
+        handle = self._sim.register_observable_particle_positions(stride, types, self._batched(callback))
         self._add_observable_handle(*_parse_save_args(save), handle)
 
     def particles(self, stride, callback: _Optional[_Callable]=None, save: _Optional[_Union[_Dict, str]]='default'):
@@ -136,7 +166,7 @@ class Observables(object):
         if isinstance(save, str) and save == 'default':
             save = {"name": "particles", "chunk_size": 100}
 
-        handle = self._sim.register_observable_particles(stride, callback)
+        handle = self._sim.register_observable_particles(stride, self._batched(callback))
         self._add_observable_handle(*_parse_save_args(save), handle)
 
     def number_of_particles(self, stride, types=None, callback: _Optional[_Callable]=None,
@@ -154,7 +184,7 @@ class Observables(object):
 
         if types is None:
             types = []
-        handle = self._sim.register_observable_n_particles(stride, types, callback)
+        handle = self._sim.register_observable_n_particles(stride, types, self._batched(callback))
 
         self._add_observable_handle(*_parse_save_args(save), handle)
 
@@ -169,7 +199,7 @@ class Observables(object):
         if isinstance(save, str) and save == 'default':
             save = {"name": "energy", "chunk_size": 10000}
 
-        handle = self._sim.register_observable_energy(stride, callback)
+        handle = self._sim.register_observable_energy(stride, self._batched(callback))
 
         self._add_observable_handle(*_parse_save_args(save), handle)
 
@@ -188,7 +218,7 @@ class Observables(object):
 
         if types is None:
             types = []
-        handle = self._sim.register_observable_forces(stride, types, callback)
+        handle = self._sim.register_observable_forces(stride, types, self._batched(callback))
 
         self._add_observable_handle(*_parse_save_args(save), handle)
 
@@ -205,7 +235,7 @@ class Observables(object):
         if isinstance(save, str) and save == 'default':
             save = {"name": "reaction_counts", "chunk_size": 500}
 
-        handle = self._sim.register_observable_reaction_counts(stride, callback)
+        handle = self._sim.register_observable_reaction_counts(stride, self._batched(callback))
 
         self._add_observable_handle(*_parse_save_args(save), handle)
 
@@ -222,7 +252,7 @@ class Observables(object):
         if isinstance(save, str) and save == 'default':
             save = {"name": "topologies", "chunk_size": 1000}
 
-        handle = self._sim.register_observable_topologies(stride, callback)
+        handle = self._sim.register_observable_topologies(stride, self._batched(callback))
         self._add_observable_handle(*_parse_save_args(save), handle)
 
     def virial(self, stride, callback: _Optional[_Callable]=None, save: _Optional[_Union[_Dict, str]]='default'):
@@ -237,8 +267,11 @@ class Observables(object):
 
         internal_callback = None
         if callback is not None:
-            internal_callback = lambda x: callback(_np.ndarray((3,3), buffer=x))
-        handle = self._sim.register_observable_virial(stride, internal_callback)
+            if self._callback_batch_size > 1:
+                internal_callback = lambda xs: callback([_np.ndarray((3, 3), buffer=x) for x in xs])
+            else:
+                internal_callback = lambda x: callback(_np.ndarray((3,3), buffer=x))
+        handle = self._sim.register_observable_virial(stride, self._batched(internal_callback))
         self._add_observable_handle(*_parse_save_args(save), handle)
 
     def pressure(self, stride, physical_particles=None,
@@ -264,9 +297,10 @@ class Observables(object):
 
         class PressureCallback(object):
 
-            def __init__(self, user_callback, kbt, volume):
+            def __init__(self, user_callback, kbt, volume, batched):
 
                 self._user_callback = user_callback
+                self._batched = batched
                 self._n = None
                 self._v = None
                 self._kbt = kbt
@@ -283,14 +317,20 @@ class Observables(object):
                 self.n_particles_callback = pressure_callback_n_particles if user_callback is not None else None
                 self.virial_callback = pressure_callback_virial if user_callback is not None else None
 
+            def _pressure(self, n, v):
+                return _calculate_pressure(box_volume=self._volume, kbt=self._kbt, n_particles=n, virial=v)
+
             def _eval_user_callback(self):
                 if self._n is not None and self._v is not None:
-                    self._user_callback(_calculate_pressure(box_volume=self._volume, kbt=self._kbt,
-                                                            n_particles=self._n, virial=self._v))
+                    if self._batched:
+                        self._user_callback([self._pressure(n, v) for n, v in zip(self._n, self._v)])
+                    else:
+                        self._user_callback(self._pressure(self._n, self._v))
                     self._n = None
                     self._v = None
 
-        pressure_callback = PressureCallback(callback, self._sim.context.kbt, self._sim.context.box_volume())
+        pressure_callback = PressureCallback(callback, self._sim.context.kbt, self._sim.context.box_volume(),
+                                             self._callback_batch_size > 1)
         self.number_of_particles(stride, types=physical_particles, callback=pressure_callback.n_particles_callback,
                                  save=save_n_particles)
         self.virial(stride, callback=pressure_callback.virial_callback, save=save_virial)
@@ -134,6 +134,42 @@ class PotentialRegistry(object):
         sigma = self._units.convert(sigma, self._units.length_unit)
         self._registry.add_lennard_jones(particle_type1, particle_type2, m, n, cutoff, shift, epsilon, sigma)
 
+    def add_tabulated(self, particle_type1, particle_type2, distances, energies=None, forces=None,
+                      energy_function=None, force_function=None, interpolation="cubic"):
+        """
+        Adds a pair potential between particles of type `particle_type1` and `particle_type2` that is given by tables
+        of energies and forces on a grid of distances. Instead of tables, functions of the distance can be provided,
+        they are sampled once on the grid. If no forces are given, they are obtained from the energies by finite
+        differences. In between grid points, energies and forces are interpolated in the squared distance, beyond the
+        last grid point the potential vanishes.
+
+        :param particle_type1: first particle type
+        :param particle_type2: second particle type
+        :param distances: strictly increasing grid of distances, the last one acts as cutoff [length]
+        :param energies: energies at the grid points [energy]
+        :param forces: force magnitudes -dV/dr at the grid points, positive values are repulsive [energy / length]
+        :param energy_function: alternatively to `energies`, a callable mapping an array of distances to energies
+        :param force_function: alternatively to `forces`, a callable mapping an array of distances to forces
+        :param interpolation: either "cubic" (natural cubic spline) or "linear"
+        """
+        distances = _np.asarray(self._units.convert(distances, self._units.length_unit), dtype=float)
+        assert (energies is None) != (energy_function is None), "provide either energies or an energy function"
+        assert forces is None or force_function is None, "provide either forces or a force function"
+        if energy_function is not None:
+            energies = energy_function(distances)
+        energies = _np.asarray(self._units.convert(energies, self._units.energy_unit), dtype=float)
+        if force_function is not None:
+            forces = force_function(distances)
+        if forces is None:
+            forces = -_np.gradient(energies, distances)
+        else:
+            forces = _np.asarray(self._units.convert(forces, self._units.energy_unit / self._units.length_unit),
+                                 dtype=float)
+        assert distances.shape == energies.shape == forces.shape, \
+            "distances, energies, and forces must have the same shape"
+        self._registry.add_tabulated(particle_type1, particle_type2, distances.tolist(), energies.tolist(),
+                                     forces.tolist(), interpolation)
+
     def add_screened_electrostatics(self, particle_type1, particle_type2, electrostatic_strength,
                                     inverse_screening_depth, repulsion_strength, repulsion_distance, exponent, cutoff):
         """
@@ -162,7 +162,8 @@ class TopologyRegistry(object):
             )
 
 
-    def add_structural_reaction(self, name, topology_type, reaction_function, rate_function, expect_connected=False):
+    def add_structural_reaction(self, name, topology_type, reaction_function, rate_function, expect_connected=False,
+                                batch_rate_function=False):
         """
         Adds a spatially independent structural topology reaction for a certain topology type. It basically consists
         out of two functions:
@@ -175,14 +176,23 @@ class TopologyRegistry(object):
         as possible. The reaction function is evaluated when the actual reaction takes place. Also the rate is expected
         to be returned in terms of the magnitude w.r.t. the default units.
 
+        If `batch_rate_function` is set, the rate function instead takes a list of all topologies of the type whose
+        rates need to be updated and returns a sequence (e.g., a numpy array) of rates of the same length. This allows
+        to vectorize the rate evaluation for many topologies.
+
         :param name: name of the structural reaction, has to be unique; otherwise an exception is raised
         :param topology_type: the topology type for which this reaction is evaluated
         :param reaction_function: the reaction function, as described above
         :param rate_function: the rate function, as described above
         :param expect_connected: can trigger a raise if set to true and the topology's connectivity graph decayed into
                                  two or more independent components.
+        :param batch_rate_function: whether the rate function evaluates a list of topologies at once
         """
-        fun1, fun2 = _top.ReactionFunction(lambda x: reaction_function(x)._get()), _top.RateFunction(rate_function)
+        fun1 = _top.ReactionFunction(lambda x: reaction_function(x)._get())
+        if batch_rate_function:
+            fun2 = _top.BatchRateFunction(rate_function)
+        else:
+            fun2 = _top.RateFunction(rate_function)
         reaction = _top.StructuralTopologyReaction(name, fun1, fun2)
         if expect_connected:
             reaction.expect_connected_after_reaction()
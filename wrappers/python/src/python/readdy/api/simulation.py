@@ -78,6 +78,8 @@ class Simulation(object):
         self._evaluate_topology_reactions = True
         self._evaluate_forces = True
         self._evaluate_observables = True
+        self._compiled_loop = False
+        self._skip_unobserved_energies = False
         self._skin = 0.
         self._integrator = "EulerBDIntegrator"
         self._reaction_handler = "Gillespie"
@@ -213,6 +215,44 @@ class Simulation(object):
         """
         self._evaluate_observables = value
 
+    @property
+    def compiled_loop(self) -> bool:
+        """
+        Returns whether the steps of the simulation are performed by a step function that the kernel compiled for
+        the configuration of the simulation. Kernels without such a step function perform the actions one by one.
+        :return: a boolean
+        """
+        return self._compiled_loop
+
+    @compiled_loop.setter
+    def compiled_loop(self, value: bool):
+        """
+        Sets whether the steps of the simulation are performed by a compiled step function, currently supported by
+        the CPU kernel.
+        :param value: a boolean value
+        """
+        assert isinstance(value, bool), "the value must be bool but was {}".format(type(value))
+        self._compiled_loop = value
+
+    @property
+    def skip_unobserved_energies(self) -> bool:
+        """
+        Returns whether the potential energy is only computed on time steps where an observable reads it. By default,
+        it is computed in every time step.
+        :return: a boolean
+        """
+        return self._skip_unobserved_energies
+
+    @skip_unobserved_energies.setter
+    def skip_unobserved_energies(self, value: bool):
+        """
+        Sets whether the potential energy is only computed on time steps where an observable, e.g., the energy
+        observable, reads it.
+        :param value: a boolean value
+        """
+        assert isinstance(value, bool), "the value must be bool but was {}".format(type(value))
+        self._skip_unobserved_energies = value
+
     @property
     def skin(self):
         """
@@ -513,6 +553,64 @@ class Simulation(object):
         """
         return self._simulation.current_particles
 
+    def get_positions_array(self, type=None, out=None):
+        """
+        Returns the positions of all particles (or of the particles of one type) as array, read from the kernel's
+        particle storage without creating an object per particle. The order is the one of `get_ids_array` and
+        `get_types_array` and stays valid until particles are added or removed or the simulation advances.
+
+        :param type: the particle type, None for all particles
+        :param out: optional C-contiguous (N, 3)-shaped nd-array of matching dtype that is filled in a single pass
+                    and returned instead of allocating a new array
+        :return: (N, 3)-shaped nd-array of positions [length]
+        """
+        return self._simulation.get_positions_array(type, out)
+
+    def get_forces_array(self, type=None, out=None):
+        """
+        Returns the forces acting on the particles as of the last force calculation, ordered as in
+        `get_positions_array`.
+
+        :param type: the particle type, None for all particles
+        :param out: optional C-contiguous (N, 3)-shaped nd-array of matching dtype that is filled in a single pass
+                    and returned instead of allocating a new array
+        :return: (N, 3)-shaped nd-array of forces
+        """
+        return self._simulation.get_forces_array(type, out)
+
+    def get_types_array(self, type=None, out=None):
+        """
+        Returns the type ids of the particles, ordered as in `get_positions_array`.
+
+        :param type: the particle type, None for all particles
+        :param out: optional C-contiguous (N,)-shaped nd-array of matching dtype that is filled in a single pass
+                    and returned instead of allocating a new array
+        :return: (N,)-shaped nd-array of type ids
+        """
+        return self._simulation.get_types_array(type, out)
+
+    def get_ids_array(self, type=None, out=None):
+        """
+        Returns the unique ids of the particles, ordered as in `get_positions_array`.
+
+        :param type: the particle type, None for all particles
+        :param out: optional C-contiguous (N,)-shaped nd-array of matching dtype that is filled in a single pass
+                    and returned instead of allocating a new array
+        :return: (N,)-shaped nd-array of particle ids
+        """
+        return self._simulation.get_ids_array(type, out)
+
+    def set_positions(self, positions, type=None):
+        """
+        Overwrites the positions of all particles (or of the particles of one type) in the order of
+        `get_positions_array`. Positions outside of the box are wrapped back in.
+
+        :param positions: (N, 3)-shaped nd-array of positions [length]
+        :param type: the particle type, None for all particles
+        """
+        positions = self._unit_conf.convert(positions, self.length_unit)
+        self._simulation.set_positions(positions, type)
+
     @property
     def current_topologies(self):
         """
@@ -550,6 +648,8 @@ class Simulation(object):
         loop.evaluate_topology_reactions(self.evaluate_topology_reactions, timestep)
         loop.use_reaction_scheduler(self.reaction_handler)
         loop.evaluate_observables(self.evaluate_observables)
+        loop.use_compiled_loop(self.compiled_loop)
+        loop.skip_unobserved_energies(self.skip_unobserved_energies)
         if self.integrator == "MdgfrdIntegrator":
             loop.neighbor_list_cutoff = max(2. * self._simulation.context.calculate_max_cutoff(), loop.neighbor_list_cutoff)
         if self._skin > 0.:
@@ -584,6 +684,7 @@ class Simulation(object):
             else:
 
                 loop.run(n_steps)
+            self._observables._flush_callbacks()
 
     def _run_custom_loop(self, custom_loop_function, show_summary=True):
         """
@@ -627,3 +728,4 @@ class Simulation(object):
             if show_summary:
                 print(self._simulation.context.describe())
             custom_loop_function()
+            self._observables._flush_callbacks()
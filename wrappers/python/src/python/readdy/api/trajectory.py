@@ -48,6 +48,7 @@ from readdy._internal.readdybinding.common.util import read_reaction_observable
 from readdy._internal.readdybinding.common.util import read_trajectory as _read_trajectory
 from readdy._internal.readdybinding.common.util import trajectory_length as _trajectory_length
 from readdy._internal.readdybinding.common.util import TrajectoryParticle
+from readdy._internal.readdybinding.common.util import TrajectoryReader as _TrajectoryReader
 from readdy._internal.readdybinding.common.util import read_topologies_observable as _read_topologies
 from readdy.util.observable_utils import calculate_pressure as _calculate_pressure
 
@@ -216,6 +217,85 @@ class GeneralInformation:
         return self._pbc
 
 
+class TrajectoryFrames(object):
+    """
+    A contiguous range of trajectory frames in columnar form. The particles of all frames are stored back to back,
+    the particles of the i-th frame in this range are located at `offsets[i]:offsets[i+1]` in `types`, `ids`,
+    `flavors` and `positions`.
+    """
+
+    def __init__(self, start, time, offsets, types, ids, flavors, positions):
+        self._start = start
+        self._time = time
+        self._offsets = offsets
+        self._types = types
+        self._ids = ids
+        self._flavors = flavors
+        self._positions = positions
+
+    @property
+    def start(self):
+        """
+        Index of the first frame in this range with respect to the whole trajectory.
+        """
+        return self._start
+
+    @property
+    def time(self):
+        """
+        The time steps of the frames, shape (n_frames,).
+        """
+        return self._time
+
+    @property
+    def offsets(self):
+        """
+        Offsets of the frames into the particle arrays, shape (n_frames + 1,).
+        """
+        return self._offsets
+
+    @property
+    def types(self):
+        """
+        Particle type ids, shape (N,). They can be made human-readable by `Trajectory.species_name(type_id)`.
+        """
+        return self._types
+
+    @property
+    def ids(self):
+        """
+        Unique particle ids, shape (N,).
+        """
+        return self._ids
+
+    @property
+    def flavors(self):
+        """
+        Particle flavors (0 = NORMAL, 1 = TOPOLOGY), shape (N,).
+        """
+        return self._flavors
+
+    @property
+    def positions(self):
+        """
+        Particle positions, shape (N, 3).
+        """
+        return self._positions
+
+    def __len__(self):
+        return len(self._time)
+
+    def frame(self, i):
+        """
+        Returns views of the particles of the i-th frame in this range.
+
+        :param i: the frame index relative to `start`
+        :return: a tuple (types, ids, flavors, positions)
+        """
+        begin, end = self._offsets[i], self._offsets[i + 1]
+        return self._types[begin:end], self._ids[begin:end], self._flavors[begin:end], self._positions[begin:end]
+
+
 class _CKPT(object):
     TOPOLOGY_CKPT = 'topologies_ckpt'
     POSITIONS_CKPT = 'trajectory_ckpt'
@@ -361,6 +441,42 @@ class Trajectory(object):
     def __len__(self):
         return _trajectory_length(self._filename, self._name)
 
+    def read_frames(self, start=0, stop=None) -> TrajectoryFrames:
+        """
+        Reads the frames [start, stop) in columnar form without creating an object per particle. Only the requested
+        frames are read from the file.
+
+        :param start: the first frame
+        :param stop: one past the last frame, None reads until the end of the trajectory
+        :return: the frames
+        """
+        if start < 0:
+            raise ValueError("The first frame must be non-negative, was {}".format(start))
+        reader = _TrajectoryReader(self._filename, self._name)
+        stop = len(reader) if stop is None else min(stop, len(reader))
+        start = min(start, stop)
+        return TrajectoryFrames(start, *reader.read(start, stop))
+
+    def iter_frames(self, chunk_size=1000, start=0, stop=None) -> _typing.Iterator[TrajectoryFrames]:
+        """
+        Iterates over the trajectory in chunks of `chunk_size` frames, so that only one chunk is held in memory at a
+        time. The file is kept open while iterating.
+
+        :param chunk_size: the number of frames per chunk
+        :param start: the first frame
+        :param stop: one past the last frame, None iterates until the end of the trajectory
+        :return: a generator of `TrajectoryFrames`
+        """
+        if chunk_size < 1:
+            raise ValueError("The chunk size must be positive, was {}".format(chunk_size))
+        if start < 0:
+            raise ValueError("The first frame must be non-negative, was {}".format(start))
+        reader = _TrajectoryReader(self._filename, self._name)
+        stop = len(reader) if stop is None else min(stop, len(reader))
+        for begin in range(start, stop, chunk_size):
+            end = min(begin + chunk_size, stop)
+            yield TrajectoryFrames(begin, *reader.read(begin, end))
+
     def read_observable_particle_positions(self, data_set_name=""):
         """
         Reads back the output of the particle_positions observable.
@@ -127,6 +127,44 @@ class TestCustomLoop(unittest.TestCase):
         self.assertEqual(ns[-1, 1], 0)
         self.assertEqual(ns[-1, 2], 1)
 
+    def test_topology_reactions_with_python_rate_function(self):
+        # the spatial reaction events are gathered on worker threads, which acquire the GIL for the rate function
+        system = readdy.ReactionDiffusionSystem(box_size=[10., 10., 10.], unit_system=None)
+        system.add_topology_species("A", 0.)
+        system.topologies.add_type("T")
+        system.topologies.configure_harmonic_bond("A", "A", 1., 1.)
+        n_calls = 0
+
+        def rate_function(top1, top2):
+            nonlocal n_calls
+            n_calls += 1
+            return 1e10
+
+        system.topologies.add_spatial_reaction("fusion: T(A) + T(A) -> T(A--A)", rate=rate_function, radius=1.)
+        simulation = system.simulation("CPU")
+        simulation.kernel_configuration.n_threads = 4
+        for x in [-4., -1.5, 1., 3.5]:
+            top = simulation.add_topology("T", ["A", "A"], np.array([[x, 0., 0.], [x + 1., 0., 0.]]))
+            top.graph.add_edge(0, 1)
+
+        def loop():
+            dt = 1e-3
+            init = simulation._actions.initialize_kernel()
+            create_nl = simulation._actions.create_neighbor_list(system.calculate_max_cutoff())
+            update_nl = simulation._actions.update_neighbor_list()
+            topology_reactions = simulation._actions.topology_reaction_handler(dt)
+
+            init()
+            create_nl()
+            for _ in range(10):
+                update_nl()
+                topology_reactions()
+
+        simulation._run_custom_loop(loop, show_summary=False)
+
+        self.assertGreater(n_calls, 0)
+        self.assertEqual(len(simulation.current_topologies), 1)
+
     def test_break_bonds_integration(self):
         # basically the "Break bonds due to pulling" test from IntegrationTests.cpp translated to python
         self._break_bonds_integration(True)  # test with pulling, topology is split in twain
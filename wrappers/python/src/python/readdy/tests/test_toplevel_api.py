@@ -265,6 +265,63 @@ class TestTopLevelAPI(ReaDDyTestCase):
         sim = rds.simulation("CPU")
         sim.add_particles("A", np.random.random((10000, 3)))
 
+    def _run_particle_arrays_test_for(self, kernel):
+        rds = readdy.ReactionDiffusionSystem([10., 10., 10.], unit_system=None)
+        rds.add_species("A")
+        rds.add_species("B")
+        sim = rds.simulation(kernel)
+        sim.add_particles("A", np.random.uniform(-4, 4, size=(100, 3)))
+        sim.add_particles("B", np.random.uniform(-4, 4, size=(50, 3)))
+
+        positions = sim.get_positions_array()
+        types = sim.get_types_array()
+        ids = sim.get_ids_array()
+        np.testing.assert_equal(positions.shape, (150, 3))
+        np.testing.assert_equal(types.shape, (150,))
+        np.testing.assert_equal(len(np.unique(ids)), 150)
+        np.testing.assert_equal(sim.get_positions_array("A").shape, (100, 3))
+        np.testing.assert_equal(sim.get_ids_array("B").shape, (50,))
+        np.testing.assert_equal(np.sum(types == rds._context.particle_types.id_of("A")), 100)
+
+        shifted = positions + np.array([.5, 0., 0.])
+        sim.set_positions(shifted)
+        np.testing.assert_almost_equal(sim.get_positions_array(), shifted)
+        np.testing.assert_equal(sim.get_ids_array(), ids)
+        with np.testing.assert_raises(ValueError):
+            sim.set_positions(np.zeros((10, 3)))
+
+        out = np.empty_like(positions)
+        np.testing.assert_equal(sim.get_positions_array(out=out) is out, True)
+        np.testing.assert_almost_equal(out, shifted)
+        out_ids = np.empty_like(ids)
+        sim.get_ids_array("B", out=out_ids[:50])
+        np.testing.assert_equal(out_ids[:50], sim.get_ids_array("B"))
+        with np.testing.assert_raises(ValueError):
+            sim.get_positions_array(out=np.empty((10, 3), dtype=positions.dtype))
+        with np.testing.assert_raises(ValueError):
+            sim.get_positions_array(out=np.empty((150, 3), dtype=np.int32))
+
+    def test_particle_arrays_scpu(self):
+        self._run_particle_arrays_test_for("SingleCPU")
+
+    def test_particle_arrays_cpu(self):
+        self._run_particle_arrays_test_for("CPU")
+
+    def test_batched_observable_callbacks(self):
+        rds = readdy.ReactionDiffusionSystem([10., 10., 10.], unit_system=None)
+        rds.add_species("A")
+        sim = rds.simulation("CPU")
+        sim.show_progress = False
+        sim.add_particles("A", np.random.uniform(-4, 4, size=(20, 3)))
+        unbatched, batches = [], []
+        sim.observe.number_of_particles(1, callback=lambda n: unbatched.append(n))
+        sim.observe.callback_batch_size = 4
+        sim.observe.number_of_particles(1, callback=lambda ns: batches.append(ns))
+        sim.run(10, 1e-3, False)
+        # 11 evaluations including the initial one, the incomplete last batch is flushed at the end of the run
+        np.testing.assert_equal([len(b) for b in batches], [4, 4, 3])
+        np.testing.assert_equal([n for b in batches for n in b], unbatched)
+
     def test_add_topology(self):
         rds = readdy.ReactionDiffusionSystem([10., 10., 10.])
         rds.topologies.add_type("toptype")
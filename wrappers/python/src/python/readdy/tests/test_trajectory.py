@@ -24,3 +24,38 @@ class TestTrajectory(unittest.TestCase):
 
     def test_trajectory_length(self):
         self.assertEqual(len(self.traj), 124)
+
+    def test_read_frames(self):
+        frames = self.traj.read_frames()
+        reference = self.traj.read()
+        self.assertEqual(len(frames), len(reference))
+        self.assertEqual(frames.offsets[-1], len(frames.ids))
+        for i, particles in enumerate(reference):
+            types, ids, flavors, positions = frames.frame(i)
+            self.assertEqual(len(ids), len(particles))
+            for j, p in enumerate(particles):
+                self.assertEqual(ids[j], p.id)
+                self.assertEqual(self.traj.species_name(types[j]), p.type)
+                self.assertEqual(frames.time[i], p.t)
+                np.testing.assert_equal(positions[j], p.position)
+
+    def test_iter_frames(self):
+        full = self.traj.read_frames(10, 100)
+        chunks = list(self.traj.iter_frames(chunk_size=7, start=10, stop=100))
+        self.assertEqual(sum(len(c) for c in chunks), len(full))
+        self.assertEqual(chunks[0].start, 10)
+        np.testing.assert_equal(np.concatenate([c.time for c in chunks]), full.time)
+        np.testing.assert_equal(np.concatenate([c.ids for c in chunks]), full.ids)
+        np.testing.assert_equal(np.concatenate([c.positions for c in chunks]), full.positions)
+
+    def test_frame_range_bounds(self):
+        with self.assertRaises(ValueError):
+            self.traj.read_frames(-1)
+        with self.assertRaises(ValueError):
+            next(self.traj.iter_frames(start=-1))
+        empty = self.traj.read_frames(200)
+        self.assertEqual(len(empty), 0)
+        self.assertEqual(empty.start, len(self.traj))
+        empty = self.traj.read_frames(50, 20)
+        self.assertEqual(len(empty), 0)
+        self.assertEqual(empty.start, 20)